@@ -0,0 +1,201 @@
+#ifndef CMDFX_BENCH_H
+#define CMDFX_BENCH_H
+
+// clock_gettime is hidden by strict C on glibc
+#if !defined(_WIN32) && !defined(__APPLE__) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+// Benchmarks time a function over a number of iterations. The iterations are
+// doubled until one trial takes at least --min-time milliseconds, then the
+// trials are repeated and reported as nanoseconds per iteration.
+//
+// usage: <benchmark> [--format csv|json] [--output path] [--filter text]
+//                    [--trials n] [--min-time ms]
+
+typedef void (*BenchFunction)(void* data, long iterations);
+
+typedef struct BenchResult {
+    const char* name;
+    int n;
+    long iterations;
+    int trials;
+    double median;
+    double min;
+    double max;
+} BenchResult;
+
+#define BENCH_MAX_RESULTS 128
+#define BENCH_MAX_TRIALS 101
+
+static const char* _benchSuite = "";
+static const char* _benchFormat = "csv";
+static const char* _benchOutput = 0;
+static const char* _benchFilter = 0;
+static int _benchTrials = 5;
+static double _benchMinTime = 20.0;
+
+static BenchResult _benchResults[BENCH_MAX_RESULTS];
+static int _benchCount = 0;
+
+static inline double benchNow() {
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double) counter.QuadPart * 1e9 / (double) frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+#endif
+}
+
+static inline void benchBegin(int argc, char** argv, const char* suite) {
+    _benchSuite = suite;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : 0;
+
+        if (strcmp(arg, "--format") == 0 && value) {
+            _benchFormat = value;
+            i++;
+        }
+        else if (strcmp(arg, "--output") == 0 && value) {
+            _benchOutput = value;
+            i++;
+        }
+        else if (strcmp(arg, "--filter") == 0 && value) {
+            _benchFilter = value;
+            i++;
+        }
+        else if (strcmp(arg, "--trials") == 0 && value) {
+            _benchTrials = atoi(value);
+            i++;
+        }
+        else if (strcmp(arg, "--min-time") == 0 && value) {
+            _benchMinTime = atof(value);
+            i++;
+        }
+        else {
+            fprintf(stderr, "%s: unknown argument '%s'\n", argv[0], arg);
+            exit(2);
+        }
+    }
+
+    if (strcmp(_benchFormat, "csv") != 0 && strcmp(_benchFormat, "json") != 0) {
+        fprintf(stderr, "%s: format must be csv or json\n", argv[0]);
+        exit(2);
+    }
+
+    if (_benchTrials < 1) _benchTrials = 1;
+    if (_benchTrials > BENCH_MAX_TRIALS) _benchTrials = BENCH_MAX_TRIALS;
+    if (_benchMinTime < 0) _benchMinTime = 0;
+}
+
+static inline int _benchCompare(const void* a, const void* b) {
+    double x = *(const double*) a;
+    double y = *(const double*) b;
+    return (x > y) - (x < y);
+}
+
+static inline double _benchRun(
+    BenchFunction function, void* data, long iterations
+) {
+    double start = benchNow();
+    function(data, iterations);
+    return benchNow() - start;
+}
+
+// times function(data, iterations); n is the size the benchmark runs at
+static inline void bench(
+    const char* name, int n, BenchFunction function, void* data
+) {
+    if (_benchFilter && strstr(name, _benchFilter) == 0) return;
+    if (_benchCount >= BENCH_MAX_RESULTS) return;
+
+    // warm up, then find how many iterations fill a trial
+    long iterations = 1;
+    double minTime = _benchMinTime * 1e6;
+    _benchRun(function, data, 1);
+    while (_benchRun(function, data, iterations) < minTime &&
+           iterations < (1L << 30))
+        iterations *= 2;
+
+    double times[BENCH_MAX_TRIALS];
+    for (int i = 0; i < _benchTrials; i++)
+        times[i] = _benchRun(function, data, iterations) / iterations;
+
+    qsort(times, _benchTrials, sizeof(double), _benchCompare);
+
+    int mid = _benchTrials / 2;
+    BenchResult* result = &_benchResults[_benchCount++];
+    result->name = name;
+    result->n = n;
+    result->iterations = iterations;
+    result->trials = _benchTrials;
+    result->median = _benchTrials % 2 ? times[mid]
+                                      : (times[mid - 1] + times[mid]) / 2;
+    result->min = times[0];
+    result->max = times[_benchTrials - 1];
+
+    fprintf(
+        stderr, "%s/%s n=%d: %.1f ns/op\n", _benchSuite, name, n,
+        result->median
+    );
+}
+
+// writes the results and returns the exit code of the benchmark
+static inline int benchEnd() {
+    FILE* out = stdout;
+    if (_benchOutput) {
+        out = fopen(_benchOutput, "w");
+        if (!out) {
+            fprintf(stderr, "cannot write '%s'\n", _benchOutput);
+            return 1;
+        }
+    }
+
+    int json = strcmp(_benchFormat, "json") == 0;
+    if (json)
+        fprintf(out, "{\"suite\": \"%s\", \"results\": [\n", _benchSuite);
+    else
+        fprintf(
+            out, "suite,name,n,iterations,trials,median_ns,min_ns,max_ns\n"
+        );
+
+    for (int i = 0; i < _benchCount; i++) {
+        BenchResult* r = &_benchResults[i];
+        if (json)
+            fprintf(
+                out,
+                "  {\"name\": \"%s\", \"n\": %d, \"iterations\": %ld, "
+                "\"trials\": %d, \"median_ns\": %.3f, \"min_ns\": %.3f, "
+                "\"max_ns\": %.3f}%s\n",
+                r->name, r->n, r->iterations, r->trials, r->median, r->min,
+                r->max, i + 1 < _benchCount ? "," : ""
+            );
+        else
+            fprintf(
+                out, "%s,%s,%d,%ld,%d,%.3f,%.3f,%.3f\n", _benchSuite, r->name,
+                r->n, r->iterations, r->trials, r->median, r->min, r->max
+            );
+    }
+
+    if (json) fprintf(out, "]}\n");
+    if (out != stdout) fclose(out);
+    return 0;
+}
+
+#endif
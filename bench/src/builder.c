@@ -0,0 +1,99 @@
+#include "bench.h"
+
+#include "cmdfx/core/builder.h"
+
+// a square grid and its side
+typedef struct Grid {
+    char** chars;
+    char*** strings;
+    int size;
+} Grid;
+
+static void rotate(void* data, long iterations) {
+    Grid* grid = data;
+    for (long i = 0; i < iterations; i++)
+        Char2DBuilder_rotate(grid->chars, 0.5);
+}
+
+static void gradient(void* data, long iterations) {
+    Grid* grid = data;
+    for (long i = 0; i < iterations; i++)
+        Char2DBuilder_gradient(
+            grid->chars, 0, 0, grid->size, grid->size, 'a', 'z',
+            GRADIENT_ANGLE_45
+        );
+}
+
+static void multiGradient(void* data, long iterations) {
+    Grid* grid = data;
+    for (long i = 0; i < iterations; i++)
+        Char2DBuilder_multiGradient(
+            grid->chars, 0, 0, grid->size, grid->size, 5, " .:-=",
+            GRADIENT_RADIAL
+        );
+}
+
+static void multiGradients(void* data, long iterations) {
+    Grid* grid = data;
+    double percentages[] = {0.1, 0.2, 0.3, 0.4};
+    for (long i = 0; i < iterations; i++)
+        Char2DBuilder_multiGradients(
+            grid->chars, 0, 0, grid->size, grid->size, 4, "#*+.", percentages,
+            GRADIENT_CONICAL
+        );
+}
+
+static void gradientForeground(void* data, long iterations) {
+    Grid* grid = data;
+    for (long i = 0; i < iterations; i++)
+        String2DBuilder_gradientForeground(
+            grid->strings, 0, 0, grid->size, grid->size, 0xFF0000, 0x0000FF,
+            GRADIENT_HORIZONTAL
+        );
+}
+
+static void multiGradientBackground(void* data, long iterations) {
+    Grid* grid = data;
+    int colors[] = {0xFF0000, 0x00FF00, 0x0000FF};
+    for (long i = 0; i < iterations; i++)
+        String2DBuilder_multiGradientBackground(
+            grid->strings, 0, 0, grid->size, grid->size, 3, colors,
+            GRADIENT_VERTICAL
+        );
+}
+
+int main(int argc, char** argv) {
+    benchBegin(argc, argv, "builder");
+
+    const int sizes[] = {16, 64, 256};
+    for (int i = 0; i < 3; i++) {
+        int size = sizes[i];
+        Grid grid = {
+            Char2DBuilder_createFilled(size, size, '#'),
+            String2DBuilder_createFilledForeground(size, size, 0), size
+        };
+
+        bench("Char2DBuilder_rotate", size, rotate, &grid);
+        bench("Char2DBuilder_gradient", size, gradient, &grid);
+        bench("Char2DBuilder_multiGradient", size, multiGradient, &grid);
+        bench("Char2DBuilder_multiGradients", size, multiGradients, &grid);
+        bench(
+            "String2DBuilder_gradientForeground", size, gradientForeground,
+            &grid
+        );
+        bench(
+            "String2DBuilder_multiGradientBackground", size,
+            multiGradientBackground, &grid
+        );
+
+        for (int j = 0; j < size; j++) {
+            free(grid.chars[j]);
+            for (int k = 0; k < size; k++) free(grid.strings[j][k]);
+            free(grid.strings[j]);
+        }
+        free(grid.chars);
+        free(grid.strings);
+    }
+
+    return benchEnd();
+}
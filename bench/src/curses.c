@@ -0,0 +1,57 @@
+#include "bench.h"
+
+#include "common/core/curses_backend.h"
+
+typedef struct Sequence {
+    const char* name;
+    const char* sgr;
+    int params;
+} Sequence;
+
+static void apply(void* data, long iterations) {
+    const char* sgr = ((Sequence*) data)->sgr;
+    for (long i = 0; i < iterations; i++) CmdFX_curses_applySgr(sgr);
+}
+
+// a different true color every call, so the color pair cache misses
+static void applyCycle(void* data, long iterations) {
+    char sgr[32];
+    int colors = *(int*) data;
+    for (long i = 0; i < iterations; i++) {
+        int c = (int) (i % colors);
+        snprintf(
+            sgr, sizeof(sgr), "\033[38;2;%d;%d;%dm", c % 256, c * 51 % 256,
+            c / 256 * 64
+        );
+        CmdFX_curses_applySgr(sgr);
+    }
+}
+
+int main(int argc, char** argv) {
+    benchBegin(argc, argv, "curses");
+
+    if (!CmdFX_curses_openOffscreen(200, 60))
+        fprintf(stderr, "curses: no offscreen curses, SGR is a no-op\n");
+
+    Sequence sequences[] = {
+        {"CmdFX_curses_applySgr/reset", "\033[0m", 1},
+        {"CmdFX_curses_applySgr/bold-red", "\033[1;31m", 2},
+        {"CmdFX_curses_applySgr/256", "\033[38;5;208;48;5;17m", 6},
+        {"CmdFX_curses_applySgr/truecolor", "\033[38;2;255;128;0m", 5},
+        {"CmdFX_curses_applySgr/mixed",
+         "\033[1;3;4;38;2;10;20;30;48;2;40;50;60m", 13},
+    };
+
+    for (int i = 0; i < 5; i++)
+        bench(sequences[i].name, sequences[i].params, apply, &sequences[i]);
+
+    const int colors[] = {16, 256, 1024};
+    for (int i = 0; i < 3; i++)
+        bench(
+            "CmdFX_curses_applySgr/color-cycle", colors[i], applyCycle,
+            (void*) &colors[i]
+        );
+
+    CmdFX_curses_shutdown();
+    return benchEnd();
+}
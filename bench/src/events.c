@@ -0,0 +1,40 @@
+#include "bench.h"
+
+#include "cmdfx/core/events.h"
+
+// an id no built-in event uses
+#define EVENT_ID 512
+
+static int calls = 0;
+
+static int listener(CmdFX_Event* event) {
+    (void) event;
+    calls++;
+    return 0;
+}
+
+static void dispatch(void* data, long iterations) {
+    (void) data;
+    CmdFX_Event event = {EVENT_ID, 0, 0};
+    for (long i = 0; i < iterations; i++)
+        free((void*) dispatchCmdFXEvent(&event));
+}
+
+int main(int argc, char** argv) {
+    benchBegin(argc, argv, "events");
+
+    const int sizes[] = {1, 16, 256};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < sizes[i]; j++)
+            addCmdFXEventListener(EVENT_ID, listener);
+
+        bench("dispatchCmdFXEvent", sizes[i], dispatch, 0);
+
+        for (int j = 0; j < sizes[i]; j++)
+            removeCmdFXEventListener(EVENT_ID, 0);
+    }
+
+    endCmdFXEventLoop();
+    shutdownCmdFXEvents();
+    return benchEnd();
+}
@@ -0,0 +1,41 @@
+#include "bench.h"
+
+#include "cmdfx/core/sprites.h"
+#include "cmdfx/physics/engine.h"
+
+#define MAX_BODIES 1024
+
+static CmdFX_Sprite* bodies[MAX_BODIES];
+static int count = 0;
+
+// draws n 3x3 bodies on a grid where neighbours in a row overlap, so the
+// collision response runs as well
+static void spawn(int n) {
+    for (int i = 0; i < n; i++) {
+        CmdFX_Sprite* body = Sprite_createFilled(3, 3, '@', 0, 0);
+        Sprite_draw(1 + (i % 64) * 2, 1 + (i / 64) * 4, body);
+        bodies[count++] = body;
+    }
+}
+
+static void despawn() {
+    while (count > 0) Sprite_free(bodies[--count]);
+}
+
+static void tick(void* data, long iterations) {
+    (void) data;
+    for (long i = 0; i < iterations; i++) free(Engine_tick());
+}
+
+int main(int argc, char** argv) {
+    benchBegin(argc, argv, "physics");
+
+    const int sizes[] = {1, 16, 64, 256, 1024};
+    for (int i = 0; i < 5; i++) {
+        spawn(sizes[i]);
+        bench("Engine_tick", sizes[i], tick, 0);
+        despawn();
+    }
+
+    return benchEnd();
+}
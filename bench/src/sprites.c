@@ -0,0 +1,72 @@
+#include "bench.h"
+
+#include "cmdfx/core/sprites.h"
+#include "common/core/curses_backend.h"
+
+#define WIDTH 200
+#define HEIGHT 60
+#define MAX_SPRITES 1024
+
+// internal; draws a sprite at its position without registering it
+extern void Sprite_draw0(CmdFX_Sprite* sprite);
+
+static CmdFX_Sprite* sprites[MAX_SPRITES];
+static int count = 0;
+
+// draws n overlapping 8x4 sprites spread over the screen
+static void spawn(int n, int ansi) {
+    for (int i = 0; i < n; i++) {
+        CmdFX_Sprite* sprite = Sprite_createFilled(8, 4, '#', 0, i % 4);
+        if (ansi) Sprite_setForegroundAll(sprite, (i * 0x10305) & 0xFFFFFF);
+
+        int x = 1 + (i * 7) % (WIDTH - 9);
+        int y = 1 + (i * 3) % (HEIGHT - 5);
+        Sprite_draw(x, y, sprite);
+        sprites[count++] = sprite;
+    }
+}
+
+static void despawn() {
+    while (count > 0) Sprite_free(sprites[--count]);
+}
+
+static void drawAll(void* data, long iterations) {
+    (void) data;
+    for (long i = 0; i < iterations; i++)
+        for (int j = 0; j < count; j++) Sprite_draw0(sprites[j]);
+}
+
+static void colliding(void* data, long iterations) {
+    (void) data;
+    for (long i = 0; i < iterations; i++)
+        free(Sprite_getCollidingSprites(sprites[i % count]));
+}
+
+int main(int argc, char** argv) {
+    benchBegin(argc, argv, "sprites");
+
+    // draw for real, but into a screen nobody sees
+    if (!CmdFX_curses_openOffscreen(WIDTH, HEIGHT))
+        fprintf(stderr, "sprites: no offscreen curses, drawing is a no-op\n");
+
+    const int sizes[] = {1, 16, 64, 256};
+    for (int i = 0; i < 4; i++) {
+        spawn(sizes[i], 0);
+        bench("Sprite_draw0", sizes[i], drawAll, 0);
+        despawn();
+
+        spawn(sizes[i], 1);
+        bench("Sprite_draw0/ansi", sizes[i], drawAll, 0);
+        despawn();
+    }
+
+    const int crowds[] = {16, 256, 1024};
+    for (int i = 0; i < 3; i++) {
+        spawn(crowds[i], 0);
+        bench("Sprite_getCollidingSprites", crowds[i], colliding, 0);
+        despawn();
+    }
+
+    CmdFX_curses_shutdown();
+    return benchEnd();
+}
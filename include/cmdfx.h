@@ -10,6 +10,7 @@
 
 // Core Library
 
+#include "cmdfx/core/assets.h"
 #include "cmdfx/core/builder.h"
 #include "cmdfx/core/canvas.h"
 #include "cmdfx/core/costumes.h"
@@ -18,10 +19,13 @@
 #include "cmdfx/core/scenes.h"
 #include "cmdfx/core/screen.h"
 #include "cmdfx/core/sprites.h"
+#include "cmdfx/core/tilemap.h"
 #include "cmdfx/core/util.h"
 
 #include "cmdfx/core/animation/canvas.h"
+#include "cmdfx/core/animation/reveal.h"
 #include "cmdfx/core/animation/sprites.h"
+#include "cmdfx/core/animation/tween.h"
 
 // Physics Engine
 
@@ -28,6 +28,7 @@ namespace CmdFX
 
 // Core Library
 
+#include "cmdfx/core/assets.hpp"
 #include "cmdfx/core/builder.hpp"
 #include "cmdfx/core/canvas.hpp"
 #include "cmdfx/core/costumes.hpp"
@@ -35,6 +36,7 @@ namespace CmdFX
 #include "cmdfx/core/scenes.hpp"
 #include "cmdfx/core/screen.hpp"
 #include "cmdfx/core/sprites.hpp"
+#include "cmdfx/core/tilemap.hpp"
 #include "cmdfx/core/util.hpp"
 
 // Physics Engine
@@ -0,0 +1,198 @@
+/**
+ * @file reveal.h
+ * @author Gregory Mitchell (me@gmitch215.xyz)
+ * @brief Non-blocking progressive reveal queue for canvas.h
+ * @version 1.0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+
+#include "cmdfx/core/canvas.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Utility Functions - Shapes
+
+/**
+ * @brief Reveals a horizontal line at the specified position over time.
+ *
+ * This is the non-blocking counterpart of `Canvas_hLine_anim`. The line is
+ * rasterized once into a list of cells and queued; each call to
+ * `Canvas_updateReveals` or `Canvas_tickReveals` draws the cells that are due
+ * by then, so the line is complete once the time has passed.
+ *
+ * @param x The X position of the line.
+ * @param y The Y position of the line.
+ * @param width The width of the line.
+ * @param c The character to use when drawing the line.
+ * @param time The amount of time, in seconds, to draw the line.
+ * @return The ID of the reveal, or `-1` if an error occurred.
+ */
+int Canvas_hLine_reveal(int x, int y, int width, char c, double time);
+
+/**
+ * @brief Reveals a vertical line at the specified position over time.
+ *
+ * This is the non-blocking counterpart of `Canvas_vLine_anim`.
+ *
+ * @param x The X position of the line.
+ * @param y The Y position of the line.
+ * @param height The height of the line.
+ * @param c The character to use when drawing the line.
+ * @param time The amount of time, in seconds, to draw the line.
+ * @return The ID of the reveal, or `-1` if an error occurred.
+ */
+int Canvas_vLine_reveal(int x, int y, int height, char c, double time);
+
+/**
+ * @brief Reveals a rectangle at the specified position over time.
+ *
+ * This is the non-blocking counterpart of `Canvas_rect_anim`. The outline is
+ * drawn clockwise from the top-left corner.
+ *
+ * @param x The X position of the rectangle.
+ * @param y The Y position of the rectangle.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ * @param c The character to use when drawing the rectangle.
+ * @param time The amount of time, in seconds, to draw the rectangle.
+ * @return The ID of the reveal, or `-1` if an error occurred.
+ */
+int Canvas_rect_reveal(
+    int x, int y, int width, int height, char c, double time
+);
+
+/**
+ * @brief Reveals a filled rectangle at the specified position over time.
+ *
+ * This is the non-blocking counterpart of `Canvas_fillRect_anim`. The
+ * rectangle is filled row by row.
+ *
+ * @param x The X position of the rectangle.
+ * @param y The Y position of the rectangle.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ * @param c The character to use when drawing the rectangle.
+ * @param time The amount of time, in seconds, to draw the rectangle.
+ * @return The ID of the reveal, or `-1` if an error occurred.
+ */
+int Canvas_fillRect_reveal(
+    int x, int y, int width, int height, char c, double time
+);
+
+/**
+ * @brief Reveals a line between two points over time.
+ *
+ * This is the non-blocking counterpart of `Canvas_line_anim`. The line is
+ * rasterized with one cell per step along its longest axis, so it has no
+ * gaps.
+ *
+ * @param x0 The X position of the start of the line.
+ * @param y0 The Y position of the start of the line.
+ * @param x1 The X position of the end of the line.
+ * @param y1 The Y position of the end of the line.
+ * @param c The character to use when drawing the line.
+ * @param time The amount of time, in seconds, to draw the line.
+ * @return The ID of the reveal, or `-1` if an error occurred.
+ */
+int Canvas_line_reveal(int x0, int y0, int x1, int y1, char c, double time);
+
+// Utility Functions - Text
+
+/**
+ * @brief Reveals text at the specified position over time.
+ *
+ * This is the non-blocking counterpart of `Canvas_drawText_anim`.
+ *
+ * @param x The X position of the text.
+ * @param y The Y position of the text.
+ * @param text The text to draw. It is copied into the reveal.
+ * @param time The amount of time, in seconds, to draw the text.
+ * @return The ID of the reveal, or `-1` if an error occurred.
+ */
+int Canvas_drawText_reveal(int x, int y, const char* text, double time);
+
+/**
+ * @brief Reveals ASCII art text at the specified position over time.
+ *
+ * This is the non-blocking counterpart of `Canvas_drawAsciiText_anim`. The
+ * letters are laid out like `Canvas_drawAsciiText`, and each letter is
+ * revealed row by row.
+ *
+ * @param x The X position of the text.
+ * @param y The Y position of the text.
+ * @param character The character to use when drawing the text.
+ * @param text The text to draw.
+ * @param time The amount of time, in seconds, to draw the text.
+ * @return The ID of the reveal, or `-1` if an error occurred.
+ */
+int Canvas_drawAsciiText_reveal(
+    int x, int y, char character, const char* text, double time
+);
+
+// Reveal Queue
+
+/**
+ * @brief Cancels a reveal.
+ *
+ * Cells that were already drawn stay on the canvas.
+ *
+ * @param id The ID of the reveal.
+ * @return `0` if successful, or `-1` if the reveal is not active.
+ */
+int Canvas_cancelReveal(int id);
+
+/**
+ * @brief Checks whether a reveal is still drawing.
+ *
+ * @param id The ID of the reveal.
+ * @return `1` if the reveal is active, `0` otherwise.
+ */
+int Canvas_isRevealing(int id);
+
+/**
+ * @brief Gets the number of cells a reveal has drawn so far.
+ *
+ * @param id The ID of the reveal.
+ * @return The number of cells drawn, or `-1` if the reveal is not active.
+ */
+int Canvas_getRevealedCells(int id);
+
+/**
+ * @brief Gets the number of reveals still drawing.
+ *
+ * @return The number of active reveals.
+ */
+int Canvas_getRevealCount();
+
+/**
+ * @brief Advances every reveal by the given time.
+ *
+ * Each reveal draws the cells that are due after the time, in proportion to
+ * how much of its duration has passed. All of the cells of one update are
+ * drawn under a single canvas lock and refresh. Finished reveals are
+ * removed.
+ *
+ * @param seconds The time, in seconds, since the last update.
+ * @return The number of reveals still drawing.
+ */
+int Canvas_updateReveals(double seconds);
+
+/**
+ * @brief Advances every reveal by the time since the last tick.
+ *
+ * This is meant to be called once per frame from the main loop. The first
+ * tick only records the current time.
+ *
+ * @return The number of reveals still drawing.
+ */
+int Canvas_tickReveals();
+
+#ifdef __cplusplus
+}
+#endif
@@ -27,6 +27,9 @@ extern "C" {
  * constant speed. The sprite will be redrawn at each position during the
  * animation.
  *
+ * This method blocks until the animation is over; `Tween_moveTo` animates
+ * the sprite from the main loop instead.
+ *
  * @param sprite The sprite to move.
  * @param x The new X position of the sprite.
  * @param y The new Y position of the sprite.
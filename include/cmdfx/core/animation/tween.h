@@ -0,0 +1,233 @@
+/**
+ * @file tween.h
+ * @author Gregory Mitchell (me@gmitch215.xyz)
+ * @brief Non-blocking Tween API for animating sprites
+ * @version 1.0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+
+#include "cmdfx/core/sprites.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Represents an easing curve.
+ *
+ * An easing curve maps the progress of a tween, from `0` to `1`, to the
+ * fraction of the way between its start and end values.
+ */
+enum CmdFX_Easing
+{
+    /**
+     * @brief Constant speed.
+     */
+    EASING_LINEAR = 0,
+    /**
+     * @brief Starts slow and speeds up (quadratic).
+     */
+    EASING_IN_QUAD = 1,
+    /**
+     * @brief Starts fast and slows down (quadratic).
+     */
+    EASING_OUT_QUAD = 2,
+    /**
+     * @brief Speeds up, then slows down (quadratic).
+     */
+    EASING_IN_OUT_QUAD = 3,
+    /**
+     * @brief Starts slow and speeds up (cubic).
+     */
+    EASING_IN_CUBIC = 4,
+    /**
+     * @brief Starts fast and slows down (cubic).
+     */
+    EASING_OUT_CUBIC = 5,
+    /**
+     * @brief Speeds up, then slows down (cubic).
+     */
+    EASING_IN_OUT_CUBIC = 6,
+    /**
+     * @brief Starts slow and speeds up (sine).
+     */
+    EASING_IN_SINE = 7,
+    /**
+     * @brief Starts fast and slows down (sine).
+     */
+    EASING_OUT_SINE = 8,
+    /**
+     * @brief Speeds up, then slows down (sine).
+     */
+    EASING_IN_OUT_SINE = 9
+};
+
+/**
+ * @brief The callback function to be called when a tween completes.
+ *
+ * This function is called once the tween has reached its end value. It is
+ * not called for cancelled tweens. Tweens can be started and cancelled from
+ * inside the callback.
+ *
+ * @param id The ID of the tween that completed.
+ * @param sprite The sprite that was animated.
+ * @param data The user data given to `Tween_setCallback`.
+ */
+typedef void (*CmdFX_TweenCallback)(int id, CmdFX_Sprite* sprite, void* data);
+
+/**
+ * @brief Applies an easing curve.
+ *
+ * @param easing The easing curve.
+ * @param t The progress, from `0` to `1`. Values outside are clamped.
+ * @return The eased progress.
+ */
+double Tween_ease(enum CmdFX_Easing easing, double t);
+
+// Tweens
+
+/**
+ * @brief Moves a sprite to the given position over time.
+ *
+ * Unlike `Sprite_moveTo_anim`, this method returns immediately. The sprite
+ * moves from its current position each time `Tween_update` or `Tween_tick`
+ * is called, until the time has passed.
+ *
+ * @param sprite The sprite to move.
+ * @param x The new X position of the sprite.
+ * @param y The new Y position of the sprite.
+ * @param time The time, in seconds, for the animation.
+ * @param easing The easing curve of the animation.
+ * @return The ID of the tween, or `-1` if an error occurred.
+ */
+int Tween_moveTo(
+    CmdFX_Sprite* sprite, int x, int y, double time, enum CmdFX_Easing easing
+);
+
+/**
+ * @brief Changes the z-index of a sprite over time.
+ *
+ * @param sprite The sprite to change.
+ * @param z The new z-index of the sprite.
+ * @param time The time, in seconds, for the animation.
+ * @param easing The easing curve of the animation.
+ * @return The ID of the tween, or `-1` if an error occurred.
+ */
+int Tween_setZ(
+    CmdFX_Sprite* sprite, int z, double time, enum CmdFX_Easing easing
+);
+
+/**
+ * @brief Fades the foreground color of a sprite over time.
+ *
+ * The color is interpolated with `lerp_color` and applied to the whole
+ * sprite with `Sprite_setForegroundAll` whenever it changes.
+ *
+ * @param sprite The sprite to change.
+ * @param from The starting color, in RGB format.
+ * @param to The ending color, in RGB format.
+ * @param time The time, in seconds, for the animation.
+ * @param easing The easing curve of the animation.
+ * @return The ID of the tween, or `-1` if an error occurred.
+ */
+int Tween_foreground(
+    CmdFX_Sprite* sprite, int from, int to, double time,
+    enum CmdFX_Easing easing
+);
+
+/**
+ * @brief Fades the background color of a sprite over time.
+ *
+ * The color is interpolated with `lerp_color` and applied to the whole
+ * sprite with `Sprite_setBackgroundAll` whenever it changes.
+ *
+ * @param sprite The sprite to change.
+ * @param from The starting color, in RGB format.
+ * @param to The ending color, in RGB format.
+ * @param time The time, in seconds, for the animation.
+ * @param easing The easing curve of the animation.
+ * @return The ID of the tween, or `-1` if an error occurred.
+ */
+int Tween_background(
+    CmdFX_Sprite* sprite, int from, int to, double time,
+    enum CmdFX_Easing easing
+);
+
+/**
+ * @brief Sets the callback called when a tween completes.
+ *
+ * @param id The ID of the tween.
+ * @param callback The callback, or `NULL` to remove it.
+ * @param data The user data passed to the callback.
+ * @return `0` if successful, or `-1` if the tween is not active.
+ */
+int Tween_setCallback(int id, CmdFX_TweenCallback callback, void* data);
+
+/**
+ * @brief Cancels a tween.
+ *
+ * The sprite keeps the values it was given by the last update, and the
+ * completion callback is not called.
+ *
+ * @param id The ID of the tween.
+ * @return `0` if successful, or `-1` if the tween is not active.
+ */
+int Tween_cancel(int id);
+
+/**
+ * @brief Cancels all tweens of a sprite.
+ *
+ * This is called automatically by `Sprite_free`.
+ *
+ * @param sprite The sprite, or `NULL` to cancel every tween.
+ * @return The number of tweens cancelled.
+ */
+int Tween_cancelAll(CmdFX_Sprite* sprite);
+
+/**
+ * @brief Checks whether a tween is still running.
+ *
+ * @param id The ID of the tween.
+ * @return `1` if the tween is active, `0` otherwise.
+ */
+int Tween_isActive(int id);
+
+/**
+ * @brief Gets the number of running tweens.
+ *
+ * @return The number of running tweens.
+ */
+int Tween_getCount();
+
+// Engine
+
+/**
+ * @brief Advances every tween by the given time.
+ *
+ * Tweens are stored in one contiguous array and updated in a single pass;
+ * sprites are only changed when their animated value changes. Completed
+ * tweens are removed. Sprites are changed and callbacks are called after the
+ * pass, once the tweens are unlocked.
+ *
+ * @param seconds The time, in seconds, since the last update.
+ * @return The number of tweens still running.
+ */
+int Tween_update(double seconds);
+
+/**
+ * @brief Advances every tween by the time since the last tick.
+ *
+ * This is meant to be called once per frame from the main loop. The first
+ * tick only records the current time.
+ *
+ * @return The number of tweens still running.
+ */
+int Tween_tick();
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,244 @@
+/**
+ * @file assets.h
+ * @author Gregory Mitchell (me@gmitch215.xyz)
+ * @brief Binary Asset API for memory-mapped sprites and scenes
+ * @version 1.0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "cmdfx/core/scenes.h"
+#include "cmdfx/core/sprites.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The version of the binary asset format written by this library.
+ */
+#define CMDFX_ASSET_VERSION 1
+
+/**
+ * @brief The size of the header at the start of a binary asset file, in
+ * bytes.
+ *
+ * The header begins with the magic `CFXA` followed by, in little-endian
+ * order: the format version and asset kind (16 bits each), then the width,
+ * height, frame count, z-index, style count, glyph offset, style ID offset,
+ * style table offset and style table size (32 bits each).
+ *
+ * The header is followed by the glyph grids (`height` rows of `width + 1`
+ * bytes per frame, each row NUL-terminated), the style ID grids (one 16-bit
+ * ID per cell per frame, where `0` is no style and `n` is the `n`th style)
+ * and the style table (NUL-terminated ANSI strings).
+ */
+#define CMDFX_ASSET_HEADER_SIZE 48
+
+/**
+ * @brief Represents the kind of object stored in an asset.
+ */
+enum CmdFX_AssetKind
+{
+    /**
+     * @brief A sprite, with one frame per costume.
+     */
+    ASSET_SPRITE = 1,
+    /**
+     * @brief A scene, with a single frame.
+     */
+    ASSET_SCENE = 2
+};
+
+/**
+ * @brief Represents a loaded binary asset.
+ *
+ * The asset file is mapped into memory and never copied: the glyph rows and
+ * ANSI strings of the frames point directly into the mapped pages. Sprites
+ * and scenes created from the asset share these grids; the first time one of
+ * them is modified, it copies its grids into buffers of its own
+ * (copy-on-write), so the mapped data is never changed.
+ *
+ * The file stays mapped until the asset has been freed and every sprite and
+ * scene created from it has been freed or modified.
+ */
+typedef struct CmdFX_Asset {
+    /**
+     * @brief The kind of object stored in the asset.
+     */
+    enum CmdFX_AssetKind kind;
+    /**
+     * @brief The width of the frames.
+     */
+    int width;
+    /**
+     * @brief The height of the frames.
+     */
+    int height;
+    /**
+     * @brief The number of frames in the asset.
+     */
+    int frameCount;
+    /**
+     * @brief The z-index given to sprites and scenes created from the asset.
+     */
+    int z;
+    /**
+     * @brief The glyph grid of each frame.
+     *
+     * Each grid is a NULL-terminated array of `height` rows that point into
+     * the mapped file. They must not be modified or freed.
+     */
+    char*** frames;
+    /**
+     * @brief The ANSI grid of each frame.
+     *
+     * Each grid is a NULL-terminated array of `height` rows of `width` cells
+     * that point into the mapped file, or are `NULL` for unstyled cells.
+     * They must not be modified or freed.
+     */
+    char**** ansiFrames;
+    /**
+     * @brief The contents of the asset file.
+     *
+     * For text sprite files loaded through the cache, this holds the rows
+     * read from the file instead.
+     */
+    void* data;
+    /**
+     * @brief The size of the asset file, in bytes.
+     */
+    unsigned long size;
+} CmdFX_Asset;
+
+/**
+ * @brief Loads a binary asset from a file.
+ *
+ * The file is memory-mapped, so loading does not read or copy the glyph and
+ * ANSI data; if the file can't be mapped, it is read into memory instead.
+ *
+ * @param path The path to the asset file.
+ * @return A pointer to the asset, or `NULL` if the file could not be read
+ * or is not a valid asset.
+ */
+CmdFX_Asset* Asset_load(const char* path);
+
+/**
+ * @brief Frees an asset.
+ *
+ * Sprites and scenes created from the asset stay valid. The file is unmapped
+ * once none of them borrow its data anymore.
+ *
+ * @param asset The asset to free.
+ * @return `0` if the asset was freed successfully, or `-1` if an error
+ * occurred.
+ */
+int Asset_free(CmdFX_Asset* asset);
+
+/**
+ * @brief Loads an asset through the asset cache.
+ *
+ * Assets are cached by path and by a hash of their content: loading a path
+ * that is already cached doesn't touch the file, and a file whose content
+ * matches a cached one reuses that asset. Both binary assets and text sprite
+ * files (read the same way as `Sprite_loadFromFile`) can be loaded.
+ *
+ * A cached asset stays in the cache for as long as it is referenced, by the
+ * returned pointer or by a sprite or scene created from it. Each call must
+ * be matched by a call to `Asset_free`. Files changed on disk are only read
+ * again once their asset has left the cache.
+ *
+ * @param path The path to the file.
+ * @return A pointer to the asset, or `NULL` if the file could not be read
+ * or is not a valid sprite file.
+ */
+CmdFX_Asset* Asset_loadCached(const char* path);
+
+/**
+ * @brief Checks whether a path is in the asset cache.
+ *
+ * @param path The path to the file.
+ * @return `1` if the path is cached, `0` otherwise.
+ */
+int Asset_isCached(const char* path);
+
+/**
+ * @brief Loads a sprite through the asset cache.
+ *
+ * This is a shortcut for `Asset_loadCached` and `Asset_createSprite`. The
+ * glyph and ANSI data are shared with every other sprite loaded from the
+ * same file, so spawning many copies of a sprite only allocates each
+ * sprite's own state.
+ *
+ * @param path The path to the file.
+ * @param z The z-index of the sprite.
+ * @return A pointer to the sprite, or `NULL` if an error occurred.
+ */
+CmdFX_Sprite* Asset_loadSprite(const char* path, int z);
+
+/**
+ * @brief Creates a sprite from an asset.
+ *
+ * The sprite shows the first frame and borrows its grids from the asset
+ * without copying them. If the asset has more than one frame, the frames are
+ * copied into the sprite's costumes, in order.
+ *
+ * @param asset The asset.
+ * @return A pointer to the sprite, or `NULL` if an error occurred.
+ */
+CmdFX_Sprite* Asset_createSprite(CmdFX_Asset* asset);
+
+/**
+ * @brief Creates a scene from an asset.
+ *
+ * The scene borrows the grids of the first frame from the asset without
+ * copying them.
+ *
+ * @param asset The asset.
+ * @return A pointer to the scene, or `NULL` if an error occurred.
+ */
+CmdFX_Scene* Asset_createScene(CmdFX_Asset* asset);
+
+/**
+ * @brief Saves a sprite to a binary asset file.
+ *
+ * The sprite's costumes are saved as its frames; a sprite without costumes
+ * is saved as a single frame.
+ *
+ * @param sprite The sprite to save.
+ * @param path The path to the asset file.
+ * @return `0` if the sprite was saved successfully, or `-1` if an error
+ * occurred.
+ */
+int Asset_saveSprite(CmdFX_Sprite* sprite, const char* path);
+
+/**
+ * @brief Saves a scene to a binary asset file.
+ *
+ * @param scene The scene to save.
+ * @param path The path to the asset file.
+ * @return `0` if the scene was saved successfully, or `-1` if an error
+ * occurred.
+ */
+int Asset_saveScene(CmdFX_Scene* scene, const char* path);
+
+/**
+ * @brief Converts a text sprite file into a binary asset file.
+ *
+ * The text file is read the same way as `Sprite_loadFromFile`.
+ *
+ * @param input The path to the text file.
+ * @param output The path to the asset file.
+ * @param z The z-index stored in the asset.
+ * @return `0` if the file was converted successfully, or `-1` if an error
+ * occurred.
+ */
+int Asset_convertFromText(const char* input, const char* output, int z);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,101 @@
+/**
+ * @file assets.hpp
+ * @author Gregory Mitchell (me@gmitch215.xyz)
+ * @brief C++ Extensions for the CmdFX Binary Asset API
+ * @version 1.0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+
+extern "C" {
+#include "cmdfx/core/assets.h"
+}
+
+#include <string>
+
+namespace CmdFX
+{
+
+/**
+ * @brief A C++ wrapper around a CmdFX_Asset struct.
+ *
+ * This class is a wrapper around the CmdFX_Asset struct. The destructor
+ * will free the asset when the object is destroyed; sprites and scenes
+ * created from it stay valid.
+ */
+class Asset final {
+  private:
+    CmdFX_Asset* asset;
+
+  public:
+    Asset(CmdFX_Asset* asset) : asset(asset) {
+    }
+    Asset(const std::string& path) {
+        asset = Asset_load(path.c_str());
+    }
+
+    ~Asset() {
+        if (asset) {
+            Asset_free(asset);
+        }
+    }
+
+    static Asset loadCached(const std::string& path) {
+        return Asset(Asset_loadCached(path.c_str()));
+    }
+
+    static bool isCached(const std::string& path) {
+        return Asset_isCached(path.c_str()) != 0;
+    }
+
+    static CmdFX_Sprite* loadSprite(const std::string& path, int z) {
+        return Asset_loadSprite(path.c_str(), z);
+    }
+
+    CmdFX_Asset* getAsset() {
+        return asset;
+    }
+
+    bool isLoaded() const {
+        return asset != nullptr;
+    }
+
+    int getWidth() const {
+        return asset->width;
+    }
+
+    int getHeight() const {
+        return asset->height;
+    }
+
+    int getFrameCount() const {
+        return asset->frameCount;
+    }
+
+    CmdFX_Sprite* createSprite() {
+        return Asset_createSprite(asset);
+    }
+
+    CmdFX_Scene* createScene() {
+        return Asset_createScene(asset);
+    }
+
+    static int saveSprite(CmdFX_Sprite* sprite, const std::string& path) {
+        return Asset_saveSprite(sprite, path.c_str());
+    }
+
+    static int saveScene(CmdFX_Scene* scene, const std::string& path) {
+        return Asset_saveScene(scene, path.c_str());
+    }
+
+    static int convertFromText(
+        const std::string& input, const std::string& output, int z
+    ) {
+        return Asset_convertFromText(input.c_str(), output.c_str(), z);
+    }
+};
+
+} // namespace CmdFX
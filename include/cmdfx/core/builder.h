@@ -390,6 +390,8 @@ int Char2DBuilder_resizeAndCenter(char** array, int width, int height);
  *
  * This method rotates a 2D Character Array by a specific number of radians.
  * The rotation will be done around the center of the 2D Character Array.
+ * Every cell samples the source cell that rotates onto it, so the result
+ * has no holes; cells that no source cell reaches are cleared to spaces.
  *
  * @param array The 2D Character Array.
  * @param radians The number of radians to rotate.
@@ -453,8 +455,8 @@ int Char2DBuilder_replaceAll(char** array, char find, char replace);
 /**
  * @brief Scales a 2D Character Array.
  *
- * This method scales a 2D Character Array by a specific factor. The scaling
- * will be done around the center of the 2D Character Array.
+ * This method scales a 2D Character Array by a specific factor. Every cell
+ * of the new 2D Character Array samples its nearest source cell.
  *
  * The original 2D Character Array will be freed.
  *
@@ -959,6 +961,8 @@ int String2DBuilder_fillPolygon(
  *
  * This method rotates a 2D String Array by a specific number of radians.
  * The rotation will be done around the center of the 2D String Array.
+ * Every cell samples the source cell that rotates onto it; cells that no
+ * source cell reaches are set to an empty String.
  *
  * @param array The 2D String Array.
  * @param radians The number of radians to rotate.
@@ -1008,8 +1012,9 @@ int String2DBuilder_replaceAll(char*** array, char* find, char* replace);
 /**
  * @brief Scales a 2D String Array.
  *
- * This method scales a 2D String Array by a specific factor. The scaling
- * will be done around the center of the 2D String Array.
+ * This method scales a 2D String Array by a specific factor. Every cell of
+ * the new 2D String Array samples its nearest source cell, with its own copy
+ * of the String.
  *
  * The original 2D String Array will be freed.
  *
@@ -1019,6 +1024,39 @@ int String2DBuilder_replaceAll(char*** array, char* find, char* replace);
  */
 char*** String2DBuilder_scale(char*** array, double scale);
 
+// Utility Functions - Gradients (Color)
+
+/**
+ * @brief Fills a grid of RGB colors with a gradient.
+ *
+ * This method writes packed RGB colors straight into `rgb`, which holds
+ * `height` rows of `width` colors one after another. The colors are
+ * interpolated like `lerp_color`, a row at a time with `hsv_to_rgb_batch`,
+ * and horizontal and vertical gradients compute a single row or column
+ * that is copied to the rest of the grid.
+ *
+ * Each percentage is the share of the gradient between a color and the
+ * next one, so the last percentage is not used. If `percentages` is `NULL`
+ * or has no positive shares, the colors are spaced evenly.
+ *
+ * The String gradient functions use this method, then write each color as
+ * an ANSI code.
+ *
+ * @param rgb The grid of RGB colors to fill.
+ * @param width The width of the grid.
+ * @param height The height of the grid.
+ * @param numColors The number of colors in the gradient.
+ * @param colors The RGB colors in the gradient.
+ * @param percentages The percentages of each color in the gradient, or
+ * `NULL` for equal intervals.
+ * @param direction The direction of the gradient.
+ * @return 0 if successful, -1 if an error occurred.
+ */
+int Color2DBuilder_gradient(
+    int* rgb, int width, int height, int numColors, int* colors,
+    double* percentages, enum CmdFX_GradientDirection direction
+);
+
 // Utility Functions - Gradients (String)
 
 /**
@@ -334,6 +334,15 @@ int gradient(
     );
 }
 
+int gradient(
+    int* rgb, int width, int height, int numColors, int* colors,
+    double* percentages, enum CmdFX_GradientDirection direction
+) {
+    return Color2DBuilder_gradient(
+        rgb, width, height, numColors, colors, percentages, direction
+    );
+}
+
 int gradientForeground(
     char*** array, int x, int y, int width, int height, int start, int end,
     enum CmdFX_GradientDirection direction
@@ -91,6 +91,12 @@ typedef struct CmdFX_SpriteCostumes {
  * were already created for the sprite, this will return the pointer
  * to the costumes.
  *
+ * These costumes are not stored in a frame atlas: their frames are not known
+ * yet, and the slots later take ownership of the grids passed to
+ * `Sprite_setCostumeAt`, each of which can have its own size. Switching still
+ * swaps pointers without copying. Use `Sprite_createCostumeAtlas` when every
+ * frame is known up front.
+ *
  * @param sprite The sprite to create the costume for.
  * @param costumeCount The number of costumes to create.
  * @return The sprite costumes, or `NULL` if an error occurred.
@@ -99,6 +105,32 @@ CmdFX_SpriteCostumes* Sprite_createCostumes(
     CmdFX_Sprite* sprite, int costumeCount
 );
 
+/**
+ * @brief Creates a sprite costumes holder backed by a frame atlas.
+ *
+ * This method works like `Sprite_createCostumes`, but copies every costume
+ * into one contiguous frame atlas: the current sprite data becomes costume 0,
+ * followed by `frames` in order. The frames and ANSI frames are copied, so
+ * the caller keeps ownership of them. `ansiFrames` can be `NULL`, as can any
+ * of its entries, for costumes without ANSI codes.
+ *
+ * The sprite shows its costumes directly from the atlas, so switching between
+ * them is a pointer swap that also updates the sprite's width and height.
+ * Atlas costumes are read-only: modifying the sprite while it shows one gives
+ * that costume a copy of its own first.
+ *
+ * If costumes were already created for the sprite, this will return `NULL`.
+ *
+ * @param sprite The sprite to create the costumes for.
+ * @param frames The costumes to add after the current sprite data.
+ * @param ansiFrames The ANSI data of the costumes, or `NULL`.
+ * @param frameCount The number of costumes in `frames`.
+ * @return The sprite costumes, or `NULL` if an error occurred.
+ */
+CmdFX_SpriteCostumes* Sprite_createCostumeAtlas(
+    CmdFX_Sprite* sprite, char*** frames, char**** ansiFrames, int frameCount
+);
+
 /**
  * @brief Gets the sprite costumes.
  *
@@ -164,6 +196,8 @@ char*** Sprite_getAnsiCostume(CmdFX_Sprite* sprite, int costumeIndex);
  * will switch the `data` and the `ansiData` inside the sprite, and
  * set the old data and ANSI data to the costume index.
  *
+ * Switching never copies the costume, only the pointers to it.
+ *
  * @param sprite The sprite to switch the costume for.
  * @param costumeIndex The index of the costume to switch to.
  * @return 0 if successful, -1 if an error occurred.
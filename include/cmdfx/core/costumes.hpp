@@ -42,6 +42,15 @@ class SpriteCostumes final {
         : sprite(std::move(sprite)) {
         costumes = Sprite_createCostumes(this->sprite->getSprite(), count);
     }
+    SpriteCostumes(
+        std::unique_ptr<Sprite> sprite, char*** frames, char**** ansiFrames,
+        int frameCount
+    )
+        : sprite(std::move(sprite)) {
+        costumes = Sprite_createCostumeAtlas(
+            this->sprite->getSprite(), frames, ansiFrames, frameCount
+        );
+    }
 
     ~SpriteCostumes() {
         if (costumes) {
@@ -476,11 +476,91 @@ int Scene_switchToRegistered(int uid, int x, int y);
  */
 int Scene_scroll(int uid, int dx, int dy);
 
+/**
+ * @brief Marks a region of a scene as needing to be repainted.
+ *
+ * Registered scenes keep track of the regions that changed or were painted
+ * over since they were last drawn. The Scene Engine only repaints these
+ * regions on each tick, and skips scenes that have none.
+ *
+ * The scene data manipulation functions mark their regions automatically.
+ * This function is useful after changing `scene->data` or `scene->ansiData`
+ * directly, or after drawing over a scene with the Canvas API.
+ *
+ * @param scene The registered scene to mark.
+ * @param x The top-left X position in the scene.
+ * @param y The top-left Y position in the scene.
+ * @param width The width of the region.
+ * @param height The height of the region.
+ * @return `0` if the region was marked, or `-1` if an error occurred.
+ */
+int Scene_markDirty(CmdFX_Scene* scene, int x, int y, int width, int height);
+
+/**
+ * @brief Checks if the specified scene has regions waiting to be repainted.
+ *
+ * @param scene The scene to check.
+ * @return `1` if the scene is dirty, or `0` if it is not or it is not
+ * registered.
+ */
+int Scene_isDirty(CmdFX_Scene* scene);
+
+/**
+ * @brief Sets whether a scene is backed by an off-screen surface.
+ *
+ * A backed scene is rendered once into an off-screen surface the size of the
+ * whole scene. Drawing, scrolling and repainting it copy the visible region
+ * from that surface instead of walking every cell of `data` and `ansiData`,
+ * which makes panning across scenes much larger than the terminal cheap.
+ *
+ * Changes made through the scene data manipulation functions, or marked with
+ * `Scene_markDirty`, are rendered into the surface before the next copy. The
+ * surface is created on the first draw; if there is no terminal, the scene is
+ * drawn cell by cell as usual.
+ *
+ * The scene must be registered with the Scene Engine. Unregistering the scene
+ * releases its surface.
+ *
+ * @param scene The registered scene to change.
+ * @param backed `1` to back the scene with a surface, `0` to release it.
+ * @return `0` if the scene was changed successfully, or `-1` if an error
+ * occurred.
+ */
+int Scene_setBacked(CmdFX_Scene* scene, int backed);
+
+/**
+ * @brief Checks if the specified scene is backed by an off-screen surface.
+ *
+ * @param scene The scene to check.
+ * @return `1` if the scene is backed, or `0` if it is not.
+ */
+int Scene_isBacked(CmdFX_Scene* scene);
+
+/**
+ * @brief Marks every drawn scene under a region of the screen as needing to
+ * be repainted.
+ *
+ * This is called automatically when sprites are removed or moved and when
+ * the screen is cleared, so scenes underneath are restored by the next tick
+ * of the Scene Engine.
+ *
+ * @param x The x-coordinate of the top-left corner of the region.
+ * @param y The y-coordinate of the top-left corner of the region.
+ * @param width The width of the region.
+ * @param height The height of the region.
+ */
+void Canvas_markScenesDirty(int x, int y, int width, int height);
+
 /**
  * @brief Ticks the CmdFX Scene Engine.
  *
  * This function calls all of the necessary things apart of the Scene Engine
- * to keep scenes redrawn every frame.
+ * to keep scenes redrawn every frame. Only the dirty regions of registered,
+ * drawn scenes are repainted.
+ *
+ * While the Scene Engine is running, changes made through the scene data
+ * manipulation functions are deferred to the next tick instead of being
+ * painted immediately.
  */
 void tickCmdFXSceneEngine();
 
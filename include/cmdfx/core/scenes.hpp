@@ -280,6 +280,45 @@ class Scene final {
         if (scene->uid < 0) return -1;
         return Scene_scroll(scene->uid, dx, dy);
     }
+
+    /**
+     * @brief Marks a region of the scene as needing to be repainted.
+     *
+     * @param x The top-left X position in the scene.
+     * @param y The top-left Y position in the scene.
+     * @param width The width of the region.
+     * @param height The height of the region.
+     * @return `0` if the region was marked, or `-1` if an error occurred.
+     */
+    int markDirty(int x, int y, int width, int height) {
+        return Scene_markDirty(scene, x, y, width, height);
+    }
+
+    /**
+     * @brief Checks if the scene has regions waiting to be repainted.
+     * @return `true` if the scene is dirty, or `false` if it is not.
+     */
+    bool isDirty() const {
+        return Scene_isDirty(scene);
+    }
+
+    /**
+     * @brief Sets whether the scene is backed by an off-screen surface.
+     * @param backed `true` to back the scene, `false` to release it.
+     * @return `0` if the scene was changed successfully, or `-1` if an error
+     * occurred.
+     */
+    int setBacked(bool backed) {
+        return Scene_setBacked(scene, backed ? 1 : 0);
+    }
+
+    /**
+     * @brief Checks if the scene is backed by an off-screen surface.
+     * @return `true` if the scene is backed, or `false` if it is not.
+     */
+    bool isBacked() const {
+        return Scene_isBacked(scene);
+    }
 };
 
 namespace Canvas
@@ -306,6 +345,19 @@ int getDrawnScenesCount() {
     return Canvas_getDrawnScenesCount();
 }
 
+/**
+ * @brief Marks every drawn scene under a region of the screen as needing to
+ * be repainted.
+ *
+ * @param x The x-coordinate of the top-left corner of the region.
+ * @param y The y-coordinate of the top-left corner of the region.
+ * @param width The width of the region.
+ * @param height The height of the region.
+ */
+void markScenesDirty(int x, int y, int width, int height) {
+    Canvas_markScenesDirty(x, y, width, height);
+}
+
 /**
  * @brief Gets the registered scenes.
  * @return A vector of pointers to the registered scenes.
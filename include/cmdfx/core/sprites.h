@@ -416,12 +416,114 @@ CmdFX_Sprite* Sprite_createFilled(
  * This method does not draw the sprite to the terminal. To draw the sprite,
  * use the `Sprite_draw` method.
  *
+ * Every call reads the file again. To load the same file many times, use
+ * `Asset_loadSprite`, which reads it once and shares its data.
+ *
  * @param path The path to the file to load the sprite from.
  * @param z The Z-index of the sprite.
  * @return A pointer to the new sprite, or 0 if an error occurred.
  */
 CmdFX_Sprite* Sprite_loadFromFile(const char* path, int z);
 
+// Utility Methods - Sprite Templates
+
+/**
+ * @brief Represents a template that sprites can be instantiated from.
+ *
+ * A template holds one immutable copy of a sprite's text and ANSI data.
+ * Every sprite instantiated from it shares that data instead of copying it,
+ * so large numbers of identical sprites (bullets, particles, enemies) only
+ * allocate their own state, such as their position and Z-index.
+ *
+ * An instance copies the template's data the first time it is modified (for
+ * example with `Sprite_setChar` or `Sprite_setAnsi`), so changes never reach
+ * the template or the other instances.
+ */
+typedef struct CmdFX_SpriteTemplate {
+    /**
+     * @brief The width of the template.
+     */
+    int width;
+    /**
+     * @brief The height of the template.
+     */
+    int height;
+    /**
+     * @brief The text data shared by the instances.
+     *
+     * This must not be modified while the template has instances.
+     */
+    char** data;
+    /**
+     * @brief The ANSI data shared by the instances.
+     *
+     * This is always allocated, with `NULL` for cells without ANSI codes. It
+     * must not be modified while the template has instances.
+     */
+    char*** ansi;
+} CmdFX_SpriteTemplate;
+
+/**
+ * @brief Creates a new sprite template.
+ *
+ * The template takes ownership of the data, the same way `Sprite_create`
+ * does.
+ *
+ * @param data The text data for the template.
+ * @param ansi The ANSI data for the template, or `NULL` for none.
+ * @return A pointer to the new template, or 0 if an error occurred.
+ */
+CmdFX_SpriteTemplate* SpriteTemplate_create(char** data, char*** ansi);
+
+/**
+ * @brief Creates a new sprite template filled with a character.
+ *
+ * @param width The width of the template.
+ * @param height The height of the template.
+ * @param c The character to fill the template with.
+ * @param ansi The ANSI code to apply to every character, or `NULL` for none.
+ * The string is copied.
+ * @return A pointer to the new template, or 0 if an error occurred.
+ */
+CmdFX_SpriteTemplate* SpriteTemplate_createFilled(
+    int width, int height, char c, char* ansi
+);
+
+/**
+ * @brief Frees a sprite template.
+ *
+ * Sprites instantiated from the template stay valid. The template's data is
+ * freed once none of them share it anymore.
+ *
+ * @param spriteTemplate The template to free.
+ */
+void SpriteTemplate_free(CmdFX_SpriteTemplate* spriteTemplate);
+
+/**
+ * @brief Creates a new sprite from a template.
+ *
+ * The sprite shares the template's data until it is modified. It should be
+ * freed with `Sprite_free` when it is no longer needed.
+ *
+ * @param spriteTemplate The template to instantiate.
+ * @param z The Z-index of the sprite.
+ * @return A pointer to the new sprite, or 0 if an error occurred.
+ */
+CmdFX_Sprite* SpriteTemplate_instantiate(
+    CmdFX_SpriteTemplate* spriteTemplate, int z
+);
+
+/**
+ * @brief Checks whether a sprite shares its data with other sprites.
+ *
+ * Sprites instantiated from a template or created from an asset share their
+ * data until they are modified.
+ *
+ * @param sprite The sprite to check.
+ * @return `1` if the sprite's data is shared, `0` otherwise.
+ */
+int Sprite_isShared(CmdFX_Sprite* sprite);
+
 // Utility Methods - Sizing
 
 /**
@@ -771,6 +873,9 @@ int Sprite_setBackgroundGradientAll(
  * will be rotated around its center. If an error occurs, the method will
  * return 0.
  *
+ * The characters and their ANSI styles are rotated together through one
+ * precomputed index table, in place, so rotating every frame is cheap.
+ *
  * This method will also redraw the sprite if it is currently drawn.
  *
  * @param sprite The sprite to rotate.
@@ -825,6 +930,9 @@ int Sprite_vFlip(CmdFX_Sprite* sprite);
  * This method scales the sprite by the given factor. The sprite will be
  * scaled around its center. If an error occurs, the method will return 0.
  *
+ * The width and height of the sprite are updated to the scaled size, and the
+ * characters and their ANSI styles are scaled together.
+ *
  * This method will also redraw the sprite if it is currently drawn.
  *
  * @param sprite The sprite to scale.
@@ -846,6 +954,80 @@ int Sprite_scale(CmdFX_Sprite* sprite, double scale);
  */
 int Sprite_transpose(CmdFX_Sprite* sprite);
 
+// Utility Methods - Rotation Cache
+
+/**
+ * @brief Creates a rotation cache for the sprite.
+ *
+ * This method snapshots the sprite's current characters and ANSI codes and
+ * prepares one frame for each of `steps` evenly spaced angles, stored in a
+ * single block. Each frame is rotated the first time it is used, or ahead of
+ * time with `Sprite_bakeRotationCache`. Afterwards, `Sprite_setRotation`
+ * only swaps the sprite to a cached frame, so spinning a sprite costs no
+ * trigonometry per frame and doesn't accumulate error like repeated calls to
+ * `Sprite_rotate` do.
+ *
+ * The sprite is switched to the unrotated frame. It borrows the cached
+ * frames, so changing its characters or ANSI codes afterwards gives it its
+ * own copy of the current frame. Creating a cache again replaces the
+ * previous one.
+ *
+ * @param sprite The sprite to create the rotation cache for.
+ * @param steps The number of angles to cache, such as `16` or `32`.
+ * @return 0 if the cache was created, -1 if an error occurred.
+ */
+int Sprite_createRotationCache(CmdFX_Sprite* sprite, int steps);
+
+/**
+ * @brief Rotates every frame of the sprite's rotation cache.
+ *
+ * This method computes every frame that hasn't been used yet. It can be run
+ * on a thread launched with `CmdFX_launchThread` to precompute the frames in
+ * the background; `Sprite_setRotation` can be called meanwhile, and the
+ * thread must be joined before the cache is freed.
+ *
+ * @param sprite The sprite to bake the rotation cache of.
+ * @return The number of frames computed, or -1 if the sprite has no
+ * rotation cache.
+ */
+int Sprite_bakeRotationCache(CmdFX_Sprite* sprite);
+
+/**
+ * @brief Sets the rotation of the sprite from its rotation cache.
+ *
+ * This method swaps the sprite to the cached frame closest to the given
+ * angle, rotating it first if it hasn't been used before. The angle is
+ * absolute and measured from the frame the cache was created with.
+ *
+ * This method will also redraw the sprite if it is currently drawn.
+ *
+ * @param sprite The sprite to rotate.
+ * @param radians The angle of the sprite in radians.
+ * @return The index of the frame that was used, or -1 if the sprite has no
+ * rotation cache or an error occurred.
+ */
+int Sprite_setRotation(CmdFX_Sprite* sprite, double radians);
+
+/**
+ * @brief Gets the number of angles in the sprite's rotation cache.
+ *
+ * @param sprite The sprite to check.
+ * @return The number of cached angles, or 0 if the sprite has no rotation
+ * cache.
+ */
+int Sprite_getRotationSteps(CmdFX_Sprite* sprite);
+
+/**
+ * @brief Frees the sprite's rotation cache.
+ *
+ * If the sprite is showing a cached frame, it keeps its own copy of that
+ * frame. This is done automatically by `Sprite_free`.
+ *
+ * @param sprite The sprite to free the rotation cache of.
+ * @return 0 if the cache was freed, -1 if the sprite has no rotation cache.
+ */
+int Sprite_freeRotationCache(CmdFX_Sprite* sprite);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
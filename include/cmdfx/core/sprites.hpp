@@ -243,6 +243,26 @@ class Sprite final {
         return Sprite_getRotationAngle(sprite);
     }
 
+    int createRotationCache(int steps) {
+        return Sprite_createRotationCache(sprite, steps);
+    }
+
+    int bakeRotationCache() {
+        return Sprite_bakeRotationCache(sprite);
+    }
+
+    int setRotation(double radians) {
+        return Sprite_setRotation(sprite, radians);
+    }
+
+    int getRotationSteps() {
+        return Sprite_getRotationSteps(sprite);
+    }
+
+    int freeRotationCache() {
+        return Sprite_freeRotationCache(sprite);
+    }
+
     int hFlip() {
         return Sprite_hFlip(sprite);
     }
@@ -258,6 +278,55 @@ class Sprite final {
     int transpose() {
         return Sprite_transpose(sprite);
     }
+
+    bool isShared() const {
+        return Sprite_isShared(sprite) != 0;
+    }
+};
+
+/**
+ * @brief A C++ wrapper around a CmdFX_SpriteTemplate struct.
+ *
+ * This class is a wrapper around the CmdFX_SpriteTemplate struct. The
+ * destructor will free the template when the object is destroyed; sprites
+ * instantiated from it stay valid.
+ */
+class SpriteTemplate final {
+  private:
+    CmdFX_SpriteTemplate* spriteTemplate;
+
+  public:
+    SpriteTemplate(CmdFX_SpriteTemplate* spriteTemplate)
+        : spriteTemplate(spriteTemplate) {
+    }
+    SpriteTemplate(char** text, char*** ansi) {
+        spriteTemplate = SpriteTemplate_create(text, ansi);
+    }
+    SpriteTemplate(int width, int height, char c, char* ansi) {
+        spriteTemplate = SpriteTemplate_createFilled(width, height, c, ansi);
+    }
+
+    ~SpriteTemplate() {
+        if (spriteTemplate) {
+            SpriteTemplate_free(spriteTemplate);
+        }
+    }
+
+    CmdFX_SpriteTemplate* getSpriteTemplate() {
+        return spriteTemplate;
+    }
+
+    int getWidth() const {
+        return spriteTemplate->width;
+    }
+
+    int getHeight() const {
+        return spriteTemplate->height;
+    }
+
+    CmdFX_Sprite* instantiate(int z) {
+        return SpriteTemplate_instantiate(spriteTemplate, z);
+    }
 };
 
 namespace Canvas
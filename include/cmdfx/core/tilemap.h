@@ -0,0 +1,233 @@
+/**
+ * @file tilemap.h
+ * @author Gregory Mitchell (me@gmitch215.xyz)
+ * @brief Tile Map API for large, chunk-streamed worlds
+ * @version 1.0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdio.h>
+
+#include "cmdfx/core/scenes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The width and height of a tile map chunk, in tiles.
+ *
+ * Tile maps are loaded from their file in square chunks of this size. Only
+ * the chunks around the camera are kept in memory.
+ */
+#define TILEMAP_CHUNK_SIZE 32
+
+/**
+ * @brief Represents a loaded chunk of a tile map.
+ */
+typedef struct CmdFX_TileChunk {
+    /**
+     * @brief The X index of the chunk.
+     *
+     * The chunk covers the tiles starting at `x * TILEMAP_CHUNK_SIZE`.
+     */
+    int x;
+    /**
+     * @brief The Y index of the chunk.
+     *
+     * The chunk covers the tiles starting at `y * TILEMAP_CHUNK_SIZE`.
+     */
+    int y;
+    /**
+     * @brief The tiles in the chunk.
+     *
+     * This is a 2D array of `TILEMAP_CHUNK_SIZE` by `TILEMAP_CHUNK_SIZE`
+     * characters. Tiles outside of the world are `' '`.
+     */
+    char** tiles;
+} CmdFX_TileChunk;
+
+/**
+ * @brief Represents a CmdFX Tile Map.
+ *
+ * A tile map is a world of characters that is too large to be kept in a
+ * single scene. The world is stored in a file and read in fixed-size chunks
+ * as the camera moves; chunks far from the camera are unloaded.
+ *
+ * The visible part of the world is shown through a registered scene the size
+ * of the viewport, so tile maps are drawn, layered and repainted by the Scene
+ * Engine like any other scene.
+ */
+typedef struct CmdFX_TileMap {
+    /**
+     * @brief The width of the world, in tiles.
+     */
+    int width;
+    /**
+     * @brief The height of the world, in tiles.
+     */
+    int height;
+    /**
+     * @brief The X position of the top-left tile shown in the viewport.
+     */
+    int cameraX;
+    /**
+     * @brief The Y position of the top-left tile shown in the viewport.
+     */
+    int cameraY;
+    /**
+     * @brief The number of chunks kept loaded around the viewport.
+     *
+     * Chunks within this many chunks of the viewport are loaded ahead of
+     * time and kept in memory, so small camera movements don't read from the
+     * file. This can be changed directly and applies on the next camera move.
+     * Defaults to `1`.
+     */
+    int loadRadius;
+    /**
+     * @brief The registered scene showing the viewport.
+     *
+     * Its data is overwritten whenever the camera moves. It is owned by the
+     * tile map and freed with it.
+     */
+    CmdFX_Scene* scene;
+    /**
+     * @brief The chunks currently in memory.
+     */
+    CmdFX_TileChunk** chunks;
+    /**
+     * @brief The number of chunks currently in memory.
+     */
+    int chunkCount;
+    /**
+     * @brief The ANSI codes applied to each tile character.
+     *
+     * Set with `TileMap_setTileAnsi`. Characters without an entry have no
+     * color.
+     */
+    char* palette[256];
+    /**
+     * @brief The file the world is read from.
+     */
+    FILE* file;
+    /**
+     * @brief The number of bytes between the starts of two rows in the file.
+     */
+    long stride;
+} CmdFX_TileMap;
+
+/**
+ * @brief Loads a tile map from a file.
+ *
+ * The file is a text file with one line per row of tiles. Every line must be
+ * the same length, which is the width of the world; the number of lines is
+ * its height. Rows are read directly from their position in the file, so
+ * only the chunks around the camera are ever read.
+ *
+ * The file is kept open until the tile map is freed.
+ *
+ * @param path The path to the file.
+ * @param viewportWidth The width of the viewport, in tiles.
+ * @param viewportHeight The height of the viewport, in tiles.
+ * @return A pointer to the tile map, or `NULL` if the file could not be
+ * read or the viewport could not be created.
+ */
+CmdFX_TileMap* TileMap_loadFromFile(
+    const char* path, int viewportWidth, int viewportHeight
+);
+
+/**
+ * @brief Frees a tile map.
+ *
+ * This removes the tile map from the screen, frees its viewport scene and
+ * loaded chunks, and closes its file.
+ *
+ * @param map The tile map to free.
+ * @return `0` if the tile map was freed successfully, or `-1` if an error
+ * occurred.
+ */
+int TileMap_free(CmdFX_TileMap* map);
+
+/**
+ * @brief Draws the tile map's viewport at the specified position on the
+ * screen.
+ *
+ * @param map The tile map to draw.
+ * @param x The x-coordinate of the top-left corner of the viewport.
+ * @param y The y-coordinate of the top-left corner of the viewport.
+ * @return `0` if the tile map was drawn successfully, or `-1` if an error
+ * occurred.
+ */
+int TileMap_draw(CmdFX_TileMap* map, int x, int y);
+
+/**
+ * @brief Removes the tile map's viewport from the screen.
+ *
+ * @param map The tile map to remove.
+ * @return `0` if the tile map was removed successfully, or `-1` if an error
+ * occurred.
+ */
+int TileMap_remove(CmdFX_TileMap* map);
+
+/**
+ * @brief Moves the camera to the specified tile.
+ *
+ * The camera is the top-left tile shown in the viewport. Chunks that come
+ * into range are loaded, chunks that leave it are unloaded, and only the
+ * chunks intersecting the viewport are copied into it. The camera may move
+ * outside of the world, in which case the missing tiles are blank.
+ *
+ * If the viewport is drawn, it is repainted by the Scene Engine.
+ *
+ * @param map The tile map.
+ * @param x The X position of the camera, in tiles.
+ * @param y The Y position of the camera, in tiles.
+ * @return `0` if the camera was moved successfully, or `-1` if an error
+ * occurred.
+ */
+int TileMap_setCamera(CmdFX_TileMap* map, int x, int y);
+
+/**
+ * @brief Moves the camera by the specified amount.
+ *
+ * @param map The tile map.
+ * @param dx The amount to move the camera in the x direction.
+ * @param dy The amount to move the camera in the y direction.
+ * @return `0` if the camera was moved successfully, or `-1` if an error
+ * occurred.
+ */
+int TileMap_moveCamera(CmdFX_TileMap* map, int dx, int dy);
+
+/**
+ * @brief Gets the tile at the specified position in the world.
+ *
+ * Tiles in loaded chunks are read from memory; any other tile is read from
+ * the file without loading its chunk.
+ *
+ * @param map The tile map.
+ * @param x The X position of the tile.
+ * @param y The Y position of the tile.
+ * @return The tile, or `0` if the position is outside of the world or an
+ * error occurred.
+ */
+char TileMap_getTile(CmdFX_TileMap* map, int x, int y);
+
+/**
+ * @brief Sets the ANSI code applied to every tile of a character.
+ *
+ * @param map The tile map.
+ * @param tile The tile character.
+ * @param ansi The ANSI code, or `NULL` to remove it. The string is copied.
+ * @return `0` if the ANSI code was set successfully, or `-1` if an error
+ * occurred.
+ */
+int TileMap_setTileAnsi(CmdFX_TileMap* map, char tile, const char* ansi);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file tilemap.hpp
+ * @author Gregory Mitchell (me@gmitch215.xyz)
+ * @brief C++ Extensions for the CmdFX Tile Map API
+ * @version 1.0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+
+extern "C" {
+#include "cmdfx/core/tilemap.h"
+}
+
+#include <string>
+
+namespace CmdFX
+{
+
+/**
+ * @brief A C++ wrapper around a CmdFX_TileMap struct.
+ *
+ * This class is a wrapper around the CmdFX_TileMap struct. The destructor
+ * will free the tile map, its viewport scene and its loaded chunks when the
+ * object is destroyed.
+ */
+class TileMap final {
+  private:
+    CmdFX_TileMap* map;
+
+  public:
+    TileMap(CmdFX_TileMap* map) : map(map) {
+    }
+    TileMap(const std::string& path, int viewportWidth, int viewportHeight) {
+        map = TileMap_loadFromFile(
+            path.c_str(), viewportWidth, viewportHeight
+        );
+    }
+
+    ~TileMap() {
+        if (map) {
+            TileMap_free(map);
+        }
+    }
+
+    CmdFX_TileMap* getTileMap() {
+        return map;
+    }
+
+    int getWidth() const {
+        return map->width;
+    }
+
+    int getHeight() const {
+        return map->height;
+    }
+
+    int getCameraX() const {
+        return map->cameraX;
+    }
+
+    int getCameraY() const {
+        return map->cameraY;
+    }
+
+    int getLoadRadius() const {
+        return map->loadRadius;
+    }
+
+    void setLoadRadius(int radius) {
+        map->loadRadius = radius;
+    }
+
+    int draw(int x, int y) {
+        return TileMap_draw(map, x, y);
+    }
+
+    int remove() {
+        return TileMap_remove(map);
+    }
+
+    int setCamera(int x, int y) {
+        return TileMap_setCamera(map, x, y);
+    }
+
+    int moveCamera(int dx, int dy) {
+        return TileMap_moveCamera(map, dx, dy);
+    }
+
+    char getTile(int x, int y) {
+        return TileMap_getTile(map, x, y);
+    }
+
+    int setTileAnsi(char tile, const std::string& ansi) {
+        return TileMap_setTileAnsi(map, tile, ansi.c_str());
+    }
+
+    int clearTileAnsi(char tile) {
+        return TileMap_setTileAnsi(map, tile, nullptr);
+    }
+};
+
+} // namespace CmdFX
@@ -63,6 +63,175 @@ void sleepMillis(unsigned long millis);
  */
 void sleepNanos(unsigned long long nanos);
 
+// Instrumentation
+
+/** The number of recent timings kept for each frame stage. */
+#define CMDFX_FRAME_STATS_SAMPLES 1024
+
+/**
+ * @brief The stages of a frame that can be timed.
+ */
+typedef enum CmdFX_FrameStage
+{
+    /**
+     * @brief Draining the queued input events and dispatching them.
+     *
+     * Only drains that handled at least one event are timed.
+     */
+    CMDFX_FRAME_STAGE_INPUT = 0,
+    /**
+     * @brief A call to `Engine_tick`.
+     */
+    CMDFX_FRAME_STAGE_ENGINE_TICK,
+    /**
+     * @brief `Engine_applyMotion` over every sprite a physics tick modified.
+     */
+    CMDFX_FRAME_STAGE_APPLY_MOTION,
+    /**
+     * @brief A call to `tickCmdFXSceneEngine`.
+     */
+    CMDFX_FRAME_STAGE_SCENE_TICK,
+    /**
+     * @brief Drawing a sprite into the screen buffer.
+     *
+     * Each sprite draw is timed on its own, so a frame that draws several
+     * sprites records several timings rather than one for the whole frame.
+     */
+    CMDFX_FRAME_STAGE_SPRITE_DRAW,
+    /**
+     * @brief Flushing the screen buffer to the terminal.
+     *
+     * Each flush is timed on its own. Every sprite draw flushes, so a frame
+     * that draws several sprites records several timings.
+     *
+     * Flushes made by another stage, such as a scene tick, are also part of
+     * that stage's time.
+     */
+    CMDFX_FRAME_STAGE_FLUSH,
+    /**
+     * @brief The number of stages.
+     */
+    CMDFX_FRAME_STAGE_COUNT
+} CmdFX_FrameStage;
+
+/**
+ * @brief The timings of a frame stage.
+ *
+ * The times are in milliseconds of wall time, taken over the last
+ * `CMDFX_FRAME_STATS_SAMPLES` timings of the stage.
+ */
+typedef struct CmdFX_StageStats {
+    /**
+     * @brief The number of times the stage ran while timing was enabled.
+     */
+    unsigned long count;
+    /**
+     * @brief The number of recent timings the summary is taken over.
+     */
+    int samples;
+    /**
+     * @brief The mean time of the stage.
+     */
+    double mean;
+    /**
+     * @brief The median time of the stage.
+     */
+    double p50;
+    /**
+     * @brief The time 95% of the stage's runs finished within.
+     */
+    double p95;
+    /**
+     * @brief The time 99% of the stage's runs finished within.
+     */
+    double p99;
+    /**
+     * @brief The longest time of the stage.
+     */
+    double max;
+} CmdFX_StageStats;
+
+/**
+ * @brief The timings of every frame stage.
+ */
+typedef struct CmdFX_FrameStats {
+    /**
+     * @brief The timings of each stage, indexed by `CmdFX_FrameStage`.
+     */
+    CmdFX_StageStats stages[CMDFX_FRAME_STAGE_COUNT];
+} CmdFX_FrameStats;
+
+/**
+ * @brief Enables or disables frame stage timing.
+ *
+ * Timing is disabled by default, and costs a single check per stage while
+ * disabled. Timings are kept while disabled; use `CmdFX_resetFrameStats`
+ * to clear them.
+ *
+ * @param enabled 1 to time frame stages, 0 to stop.
+ */
+void CmdFX_setFrameStatsEnabled(int enabled);
+
+/**
+ * @brief Checks if frame stage timing is enabled.
+ * @return 1 if frame stages are timed, 0 otherwise.
+ */
+int CmdFX_isFrameStatsEnabled();
+
+/**
+ * @brief Gets the timings of every frame stage.
+ *
+ * This can be called from any thread while the stages are running. Stages
+ * that have not run are zeroed.
+ *
+ * @param stats The timings to fill.
+ * @return 0 if successful, -1 if an error occurred.
+ */
+int CmdFX_getFrameStats(CmdFX_FrameStats* stats);
+
+/**
+ * @brief Clears the timings of every frame stage.
+ */
+void CmdFX_resetFrameStats();
+
+/**
+ * @brief Gets the name of a frame stage.
+ * @param stage The stage.
+ * @return The name of the stage, or NULL if the stage is invalid.
+ */
+const char* CmdFX_getFrameStageName(CmdFX_FrameStage stage);
+
+// Tracing
+
+/**
+ * @brief Starts recording a trace of engine activity.
+ *
+ * The trace records spans for physics ticks, scene ticks, event dispatch
+ * and listener callbacks, curses refreshes, sound periods and contended
+ * waits on the internal mutexes, each tagged with the thread that ran it.
+ * Spans are kept in memory, one buffer per thread, and written to `path`
+ * as Chrome trace-event JSON by `CmdFX_stopTrace`, or at exit if the trace
+ * is still running. The file can be opened in Perfetto or `about:tracing`.
+ *
+ * @param path The file to write the trace to.
+ * @return 0 if successful, -1 if a trace is already running or the file
+ * could not be opened.
+ */
+int CmdFX_startTrace(const char* path);
+
+/**
+ * @brief Stops the running trace and writes it to its file.
+ * @return 0 if successful, -1 if no trace is running or the file could not
+ * be written.
+ */
+int CmdFX_stopTrace();
+
+/**
+ * @brief Checks if a trace is running.
+ * @return 1 if a trace is running, 0 otherwise.
+ */
+int CmdFX_isTracing();
+
 // Math
 
 /**
@@ -146,6 +315,59 @@ int hsv_to_rgb(double h, double s, double v);
  */
 int lerp_color(int rgb1, int rgb2, double t);
 
+// Math - Batches
+
+/**
+ * @brief Converts an array of RGB colors to HSV.
+ *
+ * The results are written to separate arrays, one per component. They are
+ * the same as those of `rgb_to_hsv`, but the conversion is written without
+ * branches or calls, so the compiler can vectorize it.
+ *
+ * @param rgb The RGB colors.
+ * @param h The array of hues.
+ * @param s The array of saturations.
+ * @param v The array of values.
+ * @param count The number of colors.
+ */
+void rgb_to_hsv_batch(
+    const int* rgb, double* h, double* s, double* v, int count
+);
+
+/**
+ * @brief Converts arrays of HSV components to RGB colors.
+ *
+ * This gives the same results as `hsv_to_rgb`. Hues outside `[0, 360)` are
+ * wrapped in a separate pass; the conversion itself is written without
+ * branches or calls, so the compiler can vectorize it.
+ *
+ * @param h The array of hues.
+ * @param s The array of saturations.
+ * @param v The array of values.
+ * @param rgb The array of RGB colors to write to.
+ * @param count The number of colors.
+ */
+void hsv_to_rgb_batch(
+    const double* h, const double* s, const double* v, int* rgb, int count
+);
+
+/**
+ * @brief Linearly interpolates between two colors at many points.
+ *
+ * This gives the same results as calling `lerp_color` for every factor, but
+ * converts the two colors to HSV only once and interpolates the factors in
+ * batches.
+ *
+ * @param rgb1 The first color in RGB format.
+ * @param rgb2 The second color in RGB format.
+ * @param t The interpolation factors.
+ * @param rgb The array of interpolated colors to write to.
+ * @param count The number of factors.
+ */
+void lerp_color_batch(
+    int rgb1, int rgb2, const double* t, int* rgb, int count
+);
+
 // Multithreading
 
 /**
@@ -45,6 +45,44 @@ void sleepNanos(unsigned long long nanos) {
     ::sleepNanos(nanos);
 }
 
+// Instrumentation
+
+void setFrameStatsEnabled(int enabled) {
+    CmdFX_setFrameStatsEnabled(enabled);
+}
+
+int isFrameStatsEnabled() {
+    return CmdFX_isFrameStatsEnabled();
+}
+
+CmdFX_FrameStats getFrameStats() {
+    CmdFX_FrameStats stats = {};
+    CmdFX_getFrameStats(&stats);
+    return stats;
+}
+
+void resetFrameStats() {
+    CmdFX_resetFrameStats();
+}
+
+const char* getFrameStageName(CmdFX_FrameStage stage) {
+    return CmdFX_getFrameStageName(stage);
+}
+
+// Tracing
+
+int startTrace(const char* path) {
+    return CmdFX_startTrace(path);
+}
+
+int stopTrace() {
+    return CmdFX_stopTrace();
+}
+
+int isTracing() {
+    return CmdFX_isTracing();
+}
+
 // Math
 
 double clamp(double value, double min, double max) {
@@ -83,6 +121,20 @@ int lerpColor(int rgb1, int rgb2, double t) {
     return lerp_color(rgb1, rgb2, t);
 }
 
+void rgbToHsv(const int* rgb, double* h, double* s, double* v, int count) {
+    rgb_to_hsv_batch(rgb, h, s, v, count);
+}
+
+void hsvToRgb(
+    const double* h, const double* s, const double* v, int* rgb, int count
+) {
+    hsv_to_rgb_batch(h, s, v, rgb, count);
+}
+
+void lerpColor(int rgb1, int rgb2, const double* t, int* rgb, int count) {
+    lerp_color_batch(rgb1, rgb2, t, rgb, count);
+}
+
 // Multithreading
 
 ThreadID launchThread(void (*func)(void*), void* arg) {
@@ -13,17 +13,62 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+
+/**
+ * @brief Statistics about the output stream of the sound engine.
+ */
+typedef struct CmdFX_SoundStats {
+    /**
+     * @brief The number of times the device ran out of audio to play.
+     *
+     * Each underrun is heard as a click or a gap.
+     */
+    unsigned long underruns;
+    /**
+     * @brief The number of periods written with less than a period queued.
+     *
+     * Late writes are near misses; a rising count means underruns are close.
+     */
+    unsigned long lateWrites;
+    /**
+     * @brief The number of periods rendered since the output was opened.
+     */
+    unsigned long periods;
+    /**
+     * @brief The rate of the output, in frames per second.
+     */
+    int rate;
+    /**
+     * @brief The number of frames rendered at a time.
+     */
+    int periodFrames;
+    /**
+     * @brief The number of frames the device buffers ahead of playback.
+     */
+    int bufferFrames;
+    /**
+     * @brief The achieved output latency, in milliseconds.
+     *
+     * This is the time a sound waits in the device buffer before it is heard.
+     */
+    double latency;
+} CmdFX_SoundStats;
 /**
  * @brief Play a sound file.
  *
- * Supported formats:
- * - WAV
- * - MP3
- * - OGG
- * - FLAC
- * - AAC
+ * Supported formats, on all platforms:
+ * - WAV with 8-, 16-, 24- or 32-bit integer PCM data
+ * - WAV with 32- or 64-bit floating point data
+ * - WAV with mono or stereo IMA ADPCM data
  *
- * Formats should be available on all platforms.
+ * Files may have any sample rate and number of channels. They are resampled
+ * to the output rate as they play; mono files play on both sides, and
+ * channels past the first two are dropped.
+ *
+ * Every sound is played as a voice of the engine's software mixer, which
+ * mixes all voices into a single output stream. Playing a sound that is
+ * already playing starts another voice of it, so overlapping effects don't
+ * cut each other off.
  *
  * @param soundFile The path to the sound file to play.
  * @return int 0 on success, or a negative error code on failure.
@@ -119,6 +164,272 @@ int Sound_setVolume(const char* soundFile, double volume);
  */
 int Sound_setVolumeAll(double volume);
 
+/**
+ * @brief Checks whether a sound file is playing.
+ *
+ * A paused sound is not playing.
+ *
+ * @param soundFile The path to the sound file.
+ * @return int 1 if any voice of the sound is playing, 0 otherwise.
+ */
+int Sound_isPlaying(const char* soundFile);
+
+/**
+ * @brief Get the balance of a sound file.
+ *
+ * @param soundFile The path to the sound file.
+ * @param pan Pointer to store the balance (-1.0 left to 1.0 right).
+ * @return int 0 on success, or a negative error code on failure.
+ */
+int Sound_getPan(const char* soundFile, double* pan);
+
+/**
+ * @brief Set the balance of a sound file.
+ *
+ * A centered sound plays at full volume on both sides; panning it to one
+ * side fades the other side out.
+ *
+ * @param soundFile The path to the sound file.
+ * @param pan The balance (-1.0 left to 1.0 right).
+ * @return int 0 on success, or a negative error code on failure.
+ */
+int Sound_setPan(const char* soundFile, double pan);
+
+// Sample Bank
+
+/**
+ * @brief Load a sound file into the sample bank.
+ *
+ * The file is read and decoded once, and every play of the returned handle
+ * shares the decoded samples, so playing it costs no file I/O. IMA ADPCM
+ * files are kept compressed instead, at a quarter of the memory of 16-bit
+ * data, and are decoded a block at a time as they play. The path
+ * functions above load their sound on first use as well; loading a path
+ * that is already loaded returns its existing handle.
+ *
+ * Handles are never reused while the engine runs, and become invalid after
+ * `Sound_cleanup`.
+ *
+ * @param soundFile The path to the sound file to load.
+ * @return int The handle of the sound (always positive), or a negative error
+ * code on failure.
+ */
+int Sound_load(const char* soundFile);
+
+/**
+ * @brief Load a sound file into the sample bank for streaming.
+ *
+ * This is meant for long sounds like music. The file is not decoded up front;
+ * each play reads it in small chunks on a background thread, a fraction of a
+ * second ahead of playback, and loops by seeking back to its start. The
+ * handle is played and controlled like any other, and the path functions
+ * stream it as well once it is loaded.
+ *
+ * IMA ADPCM files are small enough to keep in memory, so they are loaded
+ * like `Sound_load` does instead.
+ *
+ * @param soundFile The path to the sound file to load.
+ * @return int The handle of the sound (always positive), or a negative error
+ * code on failure.
+ */
+int Sound_loadStreamed(const char* soundFile);
+
+/**
+ * @brief Unload a sound from the sample bank.
+ *
+ * Every voice of the sound is stopped first.
+ *
+ * @param handle The handle of the sound.
+ * @return int 0 on success, or a negative error code on failure.
+ */
+int Sound_unload(int handle);
+
+/**
+ * @brief Play a loaded sound.
+ *
+ * This starts a voice without any file I/O or path lookup.
+ *
+ * @param handle The handle of the sound.
+ * @return int 0 on success, or a negative error code on failure.
+ */
+int Sound_playHandle(int handle);
+
+/**
+ * @brief Play a loaded sound in a loop.
+ *
+ * @param handle The handle of the sound.
+ * @param loopCount The number of times to loop the sound. Use -1 for
+ * infinite looping.
+ * @return int 0 on success, or a negative error code on failure.
+ */
+int Sound_playHandleLooped(int handle, int loopCount);
+
+/**
+ * @brief Stop every voice of a loaded sound.
+ *
+ * @param handle The handle of the sound.
+ * @return int 0 on success, or a negative error code on failure.
+ */
+int Sound_stopHandle(int handle);
+
+// Voices
+
+/**
+ * @brief Get the number of voices that can play at once.
+ *
+ * @return int The voice limit.
+ */
+int Sound_getVoiceLimit();
+
+/**
+ * @brief Set the number of voices that can play at once.
+ *
+ * When a sound is played with every voice in use, the quietest voice is
+ * stolen, and the oldest of those if several are equally quiet. Lowering the
+ * limit doesn't stop voices that are already playing.
+ *
+ * @param limit The voice limit, from 1 to 64. The default is 32.
+ * @return int 0 on success, or a negative error code on failure.
+ */
+int Sound_setVoiceLimit(int limit);
+
+/**
+ * @brief Get the number of voices in use.
+ *
+ * @return int The number of playing and paused voices.
+ */
+int Sound_getActiveVoices();
+
+// Output
+
+/**
+ * @brief Get the output latency the sound engine aims for.
+ *
+ * @return int The target latency, in milliseconds.
+ */
+int Sound_getLatency();
+
+/**
+ * @brief Set the output latency the sound engine aims for.
+ *
+ * The latency is the time between playing a sound and hearing it. The device
+ * buffer is sized to hold it, split into two periods that are mixed one at a
+ * time. Lower latencies make effects more responsive, but leave less room
+ * for the audio thread to be late; use `Sound_getStats` to watch for
+ * underruns. Devices may round the buffer to a size they support.
+ *
+ * If the output is open, it is reopened with the new latency. Playing voices
+ * keep playing.
+ *
+ * @param milliseconds The target latency, from 1 to 1000. The default is 20.
+ * @return int 0 on success, or a negative error code on failure.
+ */
+int Sound_setLatency(int milliseconds);
+
+/**
+ * @brief Get statistics about the output stream.
+ *
+ * The counters start from zero every time the output is opened. Before the
+ * output is opened, every field is zero except the rate.
+ *
+ * @param stats The statistics to fill.
+ * @return int 0 on success, or a negative error code on failure.
+ */
+int Sound_getStats(CmdFX_SoundStats* stats);
+
+/**
+ * @brief Reset the underrun, late write and period counters to zero.
+ */
+void Sound_resetStats();
+
+// Sinks
+
+/**
+ * @brief The sink that plays the mix on the platform's audio device.
+ *
+ * This is the default sink.
+ */
+#define CMDFX_SOUND_SINK_DEVICE 0
+/**
+ * @brief The sink that keeps the mix in memory.
+ *
+ * The most recent `CMDFX_SOUND_SINK_FRAMES` frames are kept in a ring, and
+ * can be read with `Sound_readSink`.
+ */
+#define CMDFX_SOUND_SINK_MEMORY 1
+/**
+ * @brief The sink that writes the mix to a 16-bit stereo WAV file.
+ *
+ * The file is complete once the sink is closed by `Sound_setSink` or
+ * `Sound_cleanup`.
+ */
+#define CMDFX_SOUND_SINK_FILE 2
+
+/**
+ * @brief The number of frames the memory sink keeps.
+ */
+#define CMDFX_SOUND_SINK_FRAMES 65536
+
+/**
+ * @brief Get the sink the mix is rendered to.
+ *
+ * @return int The sink, one of the `CMDFX_SOUND_SINK_*` constants.
+ */
+int Sound_getSink();
+
+/**
+ * @brief Set the sink the mix is rendered to.
+ *
+ * The memory and file sinks don't need a sound card, so they can be used to
+ * check the output of the engine or to measure how fast it mixes. In real
+ * time, they are fed a period at a time by a background thread at the
+ * output rate, like a device. Otherwise, nothing is rendered until
+ * `Sound_renderSink` is called, which renders as fast as possible.
+ *
+ * If the output is open, it is closed and the new sink is opened. Playing
+ * voices keep playing.
+ *
+ * @param sink The sink, one of the `CMDFX_SOUND_SINK_*` constants.
+ * @param filePath The path of the WAV file for `CMDFX_SOUND_SINK_FILE`,
+ * which is overwritten. Ignored by the other sinks.
+ * @param realtime 1 to render in real time, or 0 to render on demand.
+ * Ignored by `CMDFX_SOUND_SINK_DEVICE`.
+ * @return int 0 on success, or a negative error code on failure.
+ */
+int Sound_setSink(int sink, const char* filePath, int realtime);
+
+/**
+ * @brief Render the mix to an on-demand sink.
+ *
+ * The voices advance by the frames rendered, as if that much time had
+ * passed. Rendering opens the sink if it isn't already open.
+ *
+ * @param frames The number of frames to render.
+ * @return int The number of frames rendered, or a negative error code if
+ * the sink renders in real time or is the device.
+ */
+int Sound_renderSink(int frames);
+
+/**
+ * @brief Read the oldest frames from the memory sink.
+ *
+ * Frames that are read are removed from the sink.
+ *
+ * @param samples The interleaved stereo output, `frames * 2` samples long.
+ * @param frames The most frames to read.
+ * @return int The number of frames read, or a negative error code if the
+ * sink isn't the memory sink.
+ */
+int Sound_readSink(short* samples, int frames);
+
+/**
+ * @brief Stops every sound and shuts the sound engine down.
+ *
+ * This closes the output stream, stops the audio thread, and frees every
+ * decoded sound. The engine starts again on the next play.
+ */
+void Sound_cleanup();
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -82,6 +82,98 @@ void setVolumeAll(double volume) {
     Sound_setVolumeAll(volume);
 }
 
+bool isPlaying(std::string soundFile) {
+    return Sound_isPlaying(soundFile.c_str()) != 0;
+}
+
+double getPan(std::string soundFile) {
+    double pan = 0.0;
+    if (Sound_getPan(soundFile.c_str(), &pan) != 0) {
+        return 0.0;
+    }
+
+    return pan;
+}
+
+void setPan(std::string soundFile, double pan) {
+    Sound_setPan(soundFile.c_str(), pan);
+}
+
+int getVoiceLimit() {
+    return Sound_getVoiceLimit();
+}
+
+void setVoiceLimit(int limit) {
+    Sound_setVoiceLimit(limit);
+}
+
+int getActiveVoices() {
+    return Sound_getActiveVoices();
+}
+
+int getLatency() {
+    return Sound_getLatency();
+}
+
+bool setLatency(int milliseconds) {
+    return Sound_setLatency(milliseconds) != 0;
+}
+
+CmdFX_SoundStats getStats() {
+    CmdFX_SoundStats stats = {};
+    Sound_getStats(&stats);
+    return stats;
+}
+
+void resetStats() {
+    Sound_resetStats();
+}
+
+int getSink() {
+    return Sound_getSink();
+}
+
+bool setSink(int sink, std::string filePath = "", bool realtime = false) {
+    const char* path = filePath.empty() ? nullptr : filePath.c_str();
+    return Sound_setSink(sink, path, realtime) != 0;
+}
+
+int renderSink(int frames) {
+    return Sound_renderSink(frames);
+}
+
+int readSink(short* samples, int frames) {
+    return Sound_readSink(samples, frames);
+}
+
+int load(std::string soundFile) {
+    return Sound_load(soundFile.c_str());
+}
+
+int loadStreamed(std::string soundFile) {
+    return Sound_loadStreamed(soundFile.c_str());
+}
+
+int unload(int handle) {
+    return Sound_unload(handle);
+}
+
+int playHandle(int handle) {
+    return Sound_playHandle(handle);
+}
+
+int playHandleLooped(int handle, int loopCount) {
+    return Sound_playHandleLooped(handle, loopCount);
+}
+
+int stopHandle(int handle) {
+    return Sound_stopHandle(handle);
+}
+
+void cleanup() {
+    Sound_cleanup();
+}
+
 } // namespace Sound
 
 } // namespace CmdFX
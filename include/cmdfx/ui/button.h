@@ -216,9 +216,9 @@ int Button_isHidden(CmdFX_Button* button);
  * @brief Hides a button from the UI manager.
  *
  * This function hides the given button from the UI manager. The button
- * will still be present and will respond to mouse events, but it will not
- * be rendered on the screen. This is useful for temporarily hiding a button
- * without removing it from the UI manager.
+ * will still be present, but it will not be rendered on the screen or
+ * respond to mouse events until it is shown again. This is useful for
+ * temporarily hiding a button without removing it from the UI manager.
  *
  * @param button The button to hide.
  * @return 0 if successful, else -1
@@ -253,6 +253,26 @@ int Button_show(CmdFX_Button* button);
  */
 CmdFX_Button** Canvas_getAllButtonsAt(int x, int y);
 
+/**
+ * @brief Collects the buttons at the given position without allocating.
+ *
+ * This function writes up to `size` buttons whose rectangles contain the
+ * given position into `buffer`, in no particular order. Registered buttons
+ * are kept in a spatial index, so the lookup only examines buttons near the
+ * position rather than every registered button.
+ *
+ * If the returned count is greater than `size`, the buffer was too small and
+ * only the first `size` buttons were written. Passing a NULL buffer can be
+ * used to count the buttons at a position.
+ *
+ * @param x The x position to check.
+ * @param y The y position to check.
+ * @param buffer The buffer to write the buttons to, or NULL.
+ * @param size The number of buttons the buffer can hold.
+ * @return The number of buttons at the given position.
+ */
+int Canvas_collectButtonsAt(int x, int y, CmdFX_Button** buffer, int size);
+
 /**
  * @brief Gets the button at the given position.
  *
@@ -0,0 +1,68 @@
+/**
+ * @file asset-converter.c
+ * @author Gregory Mitchell (me@gmitch215.xyz)
+ * @date 2026-10-18
+ *
+ * This is an offline tool that converts text sprite files into binary CmdFX
+ * assets, which are memory-mapped when loaded instead of parsed.
+ *
+ * The first input file becomes the sprite and every following one becomes
+ * its next costume, so a whole animation can be stored in one asset:
+ *
+ *     asset-converter <output> <z> <input> [input...]
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cmdfx.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        printf("Usage: %s <output> <z> <input> [input...]\n", argv[0]);
+        return 1;
+    }
+
+    const char* output = argv[1];
+    int z = atoi(argv[2]);
+    int frameCount = argc - 3;
+
+    CmdFX_Sprite* sprite = Sprite_loadFromFile(argv[3], z);
+    if (sprite == 0) {
+        printf("Could not read '%s'.\n", argv[3]);
+        return 1;
+    }
+
+    if (frameCount > 1 && Sprite_createCostumes(sprite, frameCount) == 0) {
+        printf("Too many frames.\n");
+        Sprite_free(sprite);
+        return 1;
+    }
+
+    for (int i = 1; i < frameCount; i++) {
+        CmdFX_Sprite* frame = Sprite_loadFromFile(argv[3 + i], z);
+        if (frame == 0) {
+            printf("Could not read '%s'.\n", argv[3 + i]);
+            Sprite_free(sprite);
+            return 1;
+        }
+
+        // the costume takes over the frame's rows
+        Sprite_setCostumeAt(sprite, i, frame->data, 0);
+        frame->data = 0;
+        Sprite_free(frame);
+    }
+
+    if (Asset_saveSprite(sprite, output) != 0) {
+        printf("Could not write '%s'.\n", output);
+        Sprite_free(sprite);
+        return 1;
+    }
+
+    printf("Wrote %d frame(s) to '%s'.\n", frameCount, output);
+    Sprite_free(sprite);
+
+    return 0;
+}
@@ -0,0 +1,20 @@
+#include "common/core/animation/clock.h"
+
+// declared in src/<platform>/core/util.c
+extern unsigned long long _Platform_monotonicNanos();
+
+void CmdFX_batchClock_restart(CmdFX_BatchClock* clock) {
+    clock->lastTick = 0;
+}
+
+double CmdFX_batchClock_tick(CmdFX_BatchClock* clock) {
+    // 0 marks a restarted clock, so a reading of 0 is moved off it
+    unsigned long long now = _Platform_monotonicNanos();
+    if (now == 0) now = 1;
+
+    unsigned long long last = clock->lastTick;
+    clock->lastTick = now;
+
+    if (last == 0) return -1;
+    return (now - last) / 1000000000.0;
+}
@@ -0,0 +1,31 @@
+/**
+ * @file clock.h
+ * @brief Internal timing for batches of animations.
+ *
+ * This is a private header. Tweens and reveals advance by the time between
+ * two calls to their tick function. A batch starts timing when its first
+ * entry is queued, so the first tick after that only records the time and
+ * nothing jumps ahead by however long the queue was idle.
+ *
+ * Ticks are read from a monotonic clock in nanoseconds, so a change to the
+ * system time does not finish every queued animation at once.
+ */
+#pragma once
+
+/** The time of the last tick of an animation batch, in nanoseconds. */
+typedef struct CmdFX_BatchClock {
+    unsigned long long lastTick;
+} CmdFX_BatchClock;
+
+/**
+ * @brief Starts a new batch: the next tick only records the time.
+ * @param clock The clock of the batch.
+ */
+void CmdFX_batchClock_restart(CmdFX_BatchClock* clock);
+
+/**
+ * @brief Records a tick.
+ * @param clock The clock of the batch.
+ * @return The seconds since the previous tick, or `-1` if there was none.
+ */
+double CmdFX_batchClock_tick(CmdFX_BatchClock* clock);
@@ -0,0 +1,310 @@
+#include <stdlib.h>
+
+#include "cmdfx/core/animation/reveal.h"
+#include "cmdfx/core/canvas.h"
+#include "cmdfx/core/util.h"
+#include "common/core/animation/clock.h"
+#include "common/core/curses_backend.h"
+
+typedef struct _RevealCell {
+    int x;
+    int y;
+    char c;
+} _RevealCell;
+
+typedef struct _Reveal {
+    int id;
+    _RevealCell* cells;
+    int count;
+    int capacity;
+    int emitted;
+    double elapsed;
+    double duration;
+} _Reveal;
+
+// the queue is drawn under the canvas lock, so it shares it
+#define _CANVAS_MUTEX 7
+static _Reveal* _reveals = 0;
+static int _revealCount = 0;
+static int _revealCapacity = 0;
+static int _nextRevealId = 1;
+
+static CmdFX_BatchClock _clock = {0};
+
+extern char ASCII_MAP[128][8][5];
+extern char ASCII_EMPTY[8][5];
+void _initAsciiText();
+
+// Rasterization
+
+static int _pushCell(_Reveal* reveal, int x, int y, char c) {
+    if (reveal->count == reveal->capacity) {
+        int capacity = reveal->capacity == 0 ? 32 : reveal->capacity * 2;
+        _RevealCell* temp =
+            realloc(reveal->cells, sizeof(_RevealCell) * capacity);
+        if (temp == 0) return 0;
+
+        reveal->cells = temp;
+        reveal->capacity = capacity;
+    }
+
+    _RevealCell* cell = &reveal->cells[reveal->count++];
+    cell->x = x;
+    cell->y = y;
+    cell->c = c;
+
+    return 1;
+}
+
+static int _pushLine(
+    _Reveal* reveal, int x, int y, int dx, int dy, int n, char c
+) {
+    for (int i = 0; i < n; i++)
+        if (!_pushCell(reveal, x + i * dx, y + i * dy, c)) return 0;
+
+    return 1;
+}
+
+// queues a rasterized reveal; takes ownership of its cells
+static int _queueReveal(_Reveal* reveal, int ok, double time) {
+    if (!ok || reveal->count == 0) {
+        free(reveal->cells);
+        return -1;
+    }
+
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
+    if (_revealCount == _revealCapacity) {
+        int capacity = _revealCapacity == 0 ? 8 : _revealCapacity * 2;
+        _Reveal* temp = realloc(_reveals, sizeof(_Reveal) * capacity);
+        if (temp == 0) {
+            CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+            free(reveal->cells);
+            return -1;
+        }
+
+        _reveals = temp;
+        _revealCapacity = capacity;
+    }
+
+    // a new batch of reveals starts timing from the next tick
+    if (_revealCount == 0) CmdFX_batchClock_restart(&_clock);
+
+    reveal->id = _nextRevealId++;
+    reveal->emitted = 0;
+    reveal->elapsed = 0;
+    reveal->duration = time;
+    _reveals[_revealCount++] = *reveal;
+
+    int id = reveal->id;
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+
+    return id;
+}
+
+// Utility Functions - Shapes
+
+int Canvas_hLine_reveal(int x, int y, int width, char c, double time) {
+    if (x < 0 || y < 0) return -1;
+    if (width < 1) return -1;
+    if (time <= 0) return -1;
+
+    _Reveal reveal = {0};
+    int ok = _pushLine(&reveal, x, y, 1, 0, width, c);
+    return _queueReveal(&reveal, ok, time);
+}
+
+int Canvas_vLine_reveal(int x, int y, int height, char c, double time) {
+    if (x < 0 || y < 0) return -1;
+    if (height < 1) return -1;
+    if (time <= 0) return -1;
+
+    _Reveal reveal = {0};
+    int ok = _pushLine(&reveal, x, y, 0, 1, height, c);
+    return _queueReveal(&reveal, ok, time);
+}
+
+int Canvas_rect_reveal(
+    int x, int y, int width, int height, char c, double time
+) {
+    if (x < 0 || y < 0) return -1;
+    if (width < 1 || height < 1) return -1;
+    if (time <= 0) return -1;
+
+    int right = x + width - 1;
+    int bottom = y + height - 1;
+
+    // clockwise, without drawing a corner twice
+    _Reveal reveal = {0};
+    int ok = _pushLine(&reveal, x, y, 1, 0, width, c);
+    if (ok && height > 1)
+        ok = _pushLine(&reveal, right, y + 1, 0, 1, height - 1, c);
+    if (ok && height > 1 && width > 1)
+        ok = _pushLine(&reveal, right - 1, bottom, -1, 0, width - 1, c);
+    if (ok && height > 2 && width > 1)
+        ok = _pushLine(&reveal, x, bottom - 1, 0, -1, height - 2, c);
+
+    return _queueReveal(&reveal, ok, time);
+}
+
+int Canvas_fillRect_reveal(
+    int x, int y, int width, int height, char c, double time
+) {
+    if (x < 0 || y < 0) return -1;
+    if (width < 1 || height < 1) return -1;
+    if (time <= 0) return -1;
+
+    _Reveal reveal = {0};
+    int ok = 1;
+    for (int i = 0; ok && i < height; i++)
+        ok = _pushLine(&reveal, x, y + i, 1, 0, width, c);
+
+    return _queueReveal(&reveal, ok, time);
+}
+
+int Canvas_line_reveal(int x0, int y0, int x1, int y1, char c, double time) {
+    if (x0 < 0 || y0 < 0 || x1 < 0 || y1 < 0) return -1;
+    if (time <= 0) return -1;
+
+    int dx = x1 - x0;
+    int dy = y1 - y0;
+    int steps = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+
+    _Reveal reveal = {0};
+    int ok = 1;
+    for (int i = 0; ok && i <= steps; i++) {
+        // rounded to the nearest cell; a point is a single step
+        double t = steps == 0 ? 0 : (double) i / steps;
+        int x = x0 + (int) (dx * t + (dx < 0 ? -0.5 : 0.5));
+        int y = y0 + (int) (dy * t + (dy < 0 ? -0.5 : 0.5));
+        ok = _pushCell(&reveal, x, y, c);
+    }
+
+    return _queueReveal(&reveal, ok, time);
+}
+
+// Utility Functions - Text
+
+int Canvas_drawText_reveal(int x, int y, const char* text, double time) {
+    if (x < 0 || y < 0) return -1;
+    if (text == 0) return -1;
+    if (time <= 0) return -1;
+
+    _Reveal reveal = {0};
+    int ok = 1;
+    for (int i = 0; ok && text[i] != 0; i++)
+        ok = _pushCell(&reveal, x + i, y, text[i]);
+
+    return _queueReveal(&reveal, ok, time);
+}
+
+int Canvas_drawAsciiText_reveal(
+    int x, int y, char character, const char* text, double time
+) {
+    if (x < 0 || y < 0) return -1;
+    if (text == 0) return -1;
+    if (time <= 0) return -1;
+
+    _initAsciiText();
+
+    _Reveal reveal = {0};
+    int ok = 1;
+    for (int i = 0; ok && text[i] != 0; i++) {
+        unsigned char letter = (unsigned char) text[i];
+        char (*ascii)[5] = letter > 127 ? ASCII_EMPTY : ASCII_MAP[letter];
+
+        for (int j = 0; ok && j < 8; j++)
+            for (int k = 0; ok && k < 5; k++) {
+                char c = ascii[j][k];
+                if (c == '#' && character != ' ') c = character;
+                ok = _pushCell(&reveal, x + i * 5 + k, y + j, c);
+            }
+    }
+
+    return _queueReveal(&reveal, ok, time);
+}
+
+// Reveal Queue
+
+// the mutex must be held
+static int _findReveal(int id) {
+    for (int i = 0; i < _revealCount; i++)
+        if (_reveals[i].id == id) return i;
+
+    return -1;
+}
+
+int Canvas_cancelReveal(int id) {
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
+    int index = _findReveal(id);
+    if (index >= 0) {
+        free(_reveals[index].cells);
+        _reveals[index] = _reveals[--_revealCount];
+    }
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+
+    return index >= 0 ? 0 : -1;
+}
+
+int Canvas_isRevealing(int id) {
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
+    int active = _findReveal(id) >= 0;
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+
+    return active;
+}
+
+int Canvas_getRevealedCells(int id) {
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
+    int index = _findReveal(id);
+    int emitted = index >= 0 ? _reveals[index].emitted : -1;
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+
+    return emitted;
+}
+
+int Canvas_getRevealCount() {
+    return _revealCount;
+}
+
+int Canvas_updateReveals(double seconds) {
+    if (seconds < 0) seconds = 0;
+
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
+    int drawn = 0;
+    for (int i = 0; i < _revealCount;) {
+        _Reveal* reveal = &_reveals[i];
+        reveal->elapsed += seconds;
+
+        int due = reveal->count;
+        if (reveal->elapsed < reveal->duration)
+            due = (int) (reveal->count * (reveal->elapsed / reveal->duration));
+
+        for (; reveal->emitted < due; reveal->emitted++) {
+            _RevealCell* cell = &reveal->cells[reveal->emitted];
+            Canvas_setCursor(cell->x, cell->y);
+            CmdFX_curses_putCharHere(cell->c);
+            drawn = 1;
+        }
+
+        if (reveal->emitted < reveal->count) {
+            i++;
+            continue;
+        }
+
+        free(reveal->cells);
+        *reveal = _reveals[--_revealCount];
+    }
+
+    if (drawn) CmdFX_curses_refresh();
+    int count = _revealCount;
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+
+    return count;
+}
+
+int Canvas_tickReveals() {
+    double seconds = CmdFX_batchClock_tick(&_clock);
+    if (seconds < 0) return _revealCount;
+
+    return Canvas_updateReveals(seconds);
+}
@@ -0,0 +1,353 @@
+#include <stdlib.h>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include "cmdfx/core/animation/tween.h"
+#include "cmdfx/core/sprites.h"
+#include "cmdfx/core/util.h"
+#include "common/core/animation/clock.h"
+
+enum _TweenProperty
+{
+    _TWEEN_POSITION,
+    _TWEEN_Z,
+    _TWEEN_FOREGROUND,
+    _TWEEN_BACKGROUND
+};
+
+typedef struct _Tween {
+    int id;
+    enum _TweenProperty property;
+    enum CmdFX_Easing easing;
+    CmdFX_Sprite* sprite;
+    double elapsed;
+    double duration;
+    int from[2];
+    int to[2];
+    int last[2];
+    CmdFX_TweenCallback callback;
+    void* data;
+} _Tween;
+
+#define _TWEEN_MUTEX 13
+static _Tween* _tweens = 0;
+static int _tweenCount = 0;
+static int _tweenCapacity = 0;
+static int _nextTweenId = 1;
+
+// what a pass changed, applied once the lock is released; the buffer is
+// taken out of here for the length of a pass, so passes never share it
+typedef struct _TweenStep {
+    _Tween tween;
+    int changed;
+    int completed;
+} _TweenStep;
+
+static _TweenStep* _steps = 0;
+static int _stepCapacity = 0;
+
+static CmdFX_BatchClock _clock = {0};
+
+// Easing
+
+double Tween_ease(enum CmdFX_Easing easing, double t) {
+    if (t <= 0) return 0;
+    if (t >= 1) return 1;
+
+    switch (easing) {
+        case EASING_IN_QUAD:
+            return t * t;
+        case EASING_OUT_QUAD:
+            return t * (2 - t);
+        case EASING_IN_OUT_QUAD:
+            return t < 0.5 ? 2 * t * t : 1 - 2 * (1 - t) * (1 - t);
+        case EASING_IN_CUBIC:
+            return t * t * t;
+        case EASING_OUT_CUBIC:
+            return 1 - (1 - t) * (1 - t) * (1 - t);
+        case EASING_IN_OUT_CUBIC:
+            return t < 0.5 ? 4 * t * t * t
+                           : 1 - 4 * (1 - t) * (1 - t) * (1 - t);
+        case EASING_IN_SINE:
+            return 1 - cos(t * M_PI / 2);
+        case EASING_OUT_SINE:
+            return sin(t * M_PI / 2);
+        case EASING_IN_OUT_SINE:
+            return (1 - cos(t * M_PI)) / 2;
+        default:
+            return t;
+    }
+}
+
+// Tweens
+
+// moves a tween to its value at `t`; returns 1 if the value changed, in
+// which case `last` holds the new value
+static int _stepTween(_Tween* tween, double t) {
+    int value[2] = {0, 0};
+
+    switch (tween->property) {
+        case _TWEEN_POSITION:
+            for (int i = 0; i < 2; i++)
+                value[i] = (int) lround(
+                    tween->from[i] + (tween->to[i] - tween->from[i]) * t
+                );
+            if (value[0] == tween->last[0] && value[1] == tween->last[1])
+                return 0;
+            break;
+        case _TWEEN_Z:
+            value[0] = (int) lround(
+                tween->from[0] + (tween->to[0] - tween->from[0]) * t
+            );
+            if (value[0] == tween->last[0]) return 0;
+            break;
+        case _TWEEN_FOREGROUND:
+        case _TWEEN_BACKGROUND:
+            value[0] = lerp_color(tween->from[0], tween->to[0], t);
+            if (value[0] == tween->last[0]) return 0;
+            break;
+    }
+
+    tween->last[0] = value[0];
+    tween->last[1] = value[1];
+    return 1;
+}
+
+// changes the sprite to the tween's last value
+static void _applyTween(_Tween* tween) {
+    CmdFX_Sprite* sprite = tween->sprite;
+
+    switch (tween->property) {
+        case _TWEEN_POSITION:
+            Sprite_moveTo(sprite, tween->last[0], tween->last[1]);
+            break;
+        case _TWEEN_Z:
+            sprite->z = tween->last[0];
+            break;
+        case _TWEEN_FOREGROUND:
+            Sprite_setForegroundAll(sprite, tween->last[0]);
+            break;
+        case _TWEEN_BACKGROUND:
+            Sprite_setBackgroundAll(sprite, tween->last[0]);
+            break;
+    }
+}
+
+static int _addTween(
+    CmdFX_Sprite* sprite, enum _TweenProperty property, int from0, int from1,
+    int to0, int to1, double time, enum CmdFX_Easing easing
+) {
+    if (sprite == 0) return -1;
+    if (time < 0) return -1;
+
+    CmdFX_tryLockMutex(_TWEEN_MUTEX);
+    if (_tweenCount == _tweenCapacity) {
+        int capacity = _tweenCapacity == 0 ? 16 : _tweenCapacity * 2;
+        _Tween* temp = realloc(_tweens, sizeof(_Tween) * capacity);
+        if (temp == 0) {
+            CmdFX_tryUnlockMutex(_TWEEN_MUTEX);
+            return -1;
+        }
+
+        _tweens = temp;
+        _tweenCapacity = capacity;
+    }
+
+    // a new batch of tweens starts timing from the next tick
+    if (_tweenCount == 0) CmdFX_batchClock_restart(&_clock);
+
+    _Tween* tween = &_tweens[_tweenCount++];
+    tween->id = _nextTweenId++;
+    tween->property = property;
+    tween->easing = easing;
+    tween->sprite = sprite;
+    tween->elapsed = 0;
+    tween->duration = time;
+    tween->from[0] = from0;
+    tween->from[1] = from1;
+    tween->to[0] = to0;
+    tween->to[1] = to1;
+    tween->last[0] = from0;
+    tween->last[1] = from1;
+    tween->callback = 0;
+    tween->data = 0;
+
+    // colors aren't read from the sprite, so the first update paints `from`
+    if (property == _TWEEN_FOREGROUND || property == _TWEEN_BACKGROUND)
+        tween->last[0] = -1;
+
+    int id = tween->id;
+    CmdFX_tryUnlockMutex(_TWEEN_MUTEX);
+
+    return id;
+}
+
+int Tween_moveTo(
+    CmdFX_Sprite* sprite, int x, int y, double time, enum CmdFX_Easing easing
+) {
+    if (sprite == 0) return -1;
+    if (x < 1 || y < 1) return -1;
+
+    return _addTween(
+        sprite, _TWEEN_POSITION, sprite->x, sprite->y, x, y, time, easing
+    );
+}
+
+int Tween_setZ(
+    CmdFX_Sprite* sprite, int z, double time, enum CmdFX_Easing easing
+) {
+    if (sprite == 0) return -1;
+
+    return _addTween(sprite, _TWEEN_Z, sprite->z, 0, z, 0, time, easing);
+}
+
+int Tween_foreground(
+    CmdFX_Sprite* sprite, int from, int to, double time,
+    enum CmdFX_Easing easing
+) {
+    return _addTween(sprite, _TWEEN_FOREGROUND, from, 0, to, 0, time, easing);
+}
+
+int Tween_background(
+    CmdFX_Sprite* sprite, int from, int to, double time,
+    enum CmdFX_Easing easing
+) {
+    return _addTween(sprite, _TWEEN_BACKGROUND, from, 0, to, 0, time, easing);
+}
+
+// the mutex must be held
+static int _findTween(int id) {
+    for (int i = 0; i < _tweenCount; i++)
+        if (_tweens[i].id == id) return i;
+
+    return -1;
+}
+
+int Tween_setCallback(int id, CmdFX_TweenCallback callback, void* data) {
+    CmdFX_tryLockMutex(_TWEEN_MUTEX);
+    int index = _findTween(id);
+    if (index >= 0) {
+        _tweens[index].callback = callback;
+        _tweens[index].data = data;
+    }
+    CmdFX_tryUnlockMutex(_TWEEN_MUTEX);
+
+    return index >= 0 ? 0 : -1;
+}
+
+int Tween_cancel(int id) {
+    CmdFX_tryLockMutex(_TWEEN_MUTEX);
+    int index = _findTween(id);
+    if (index >= 0) _tweens[index] = _tweens[--_tweenCount];
+    CmdFX_tryUnlockMutex(_TWEEN_MUTEX);
+
+    return index >= 0 ? 0 : -1;
+}
+
+int Tween_cancelAll(CmdFX_Sprite* sprite) {
+    int count = 0;
+
+    CmdFX_tryLockMutex(_TWEEN_MUTEX);
+    for (int i = 0; i < _tweenCount;) {
+        if (sprite != 0 && _tweens[i].sprite != sprite) {
+            i++;
+            continue;
+        }
+
+        _tweens[i] = _tweens[--_tweenCount];
+        count++;
+    }
+    CmdFX_tryUnlockMutex(_TWEEN_MUTEX);
+
+    return count;
+}
+
+int Tween_isActive(int id) {
+    CmdFX_tryLockMutex(_TWEEN_MUTEX);
+    int active = _findTween(id) >= 0;
+    CmdFX_tryUnlockMutex(_TWEEN_MUTEX);
+
+    return active;
+}
+
+int Tween_getCount() {
+    return _tweenCount;
+}
+
+// Engine
+
+int Tween_update(double seconds) {
+    if (seconds < 0) seconds = 0;
+
+    CmdFX_tryLockMutex(_TWEEN_MUTEX);
+    _TweenStep* steps = _steps;
+    int capacity = _stepCapacity;
+    _steps = 0;
+    _stepCapacity = 0;
+
+    // every tween records at most one step
+    if (capacity < _tweenCount) {
+        _TweenStep* temp = realloc(steps, sizeof(_TweenStep) * _tweenCount);
+        if (temp == 0) {
+            free(steps);
+            int count = _tweenCount;
+            CmdFX_tryUnlockMutex(_TWEEN_MUTEX);
+            return count;
+        }
+
+        steps = temp;
+        capacity = _tweenCount;
+    }
+
+    int stepCount = 0;
+    for (int i = 0; i < _tweenCount;) {
+        _Tween* tween = &_tweens[i];
+        tween->elapsed += seconds;
+
+        double t = tween->duration <= 0 ? 1 : tween->elapsed / tween->duration;
+        int changed = _stepTween(tween, Tween_ease(tween->easing, t));
+        int completed = t >= 1 && tween->callback != 0;
+
+        if (changed || completed) {
+            _TweenStep* step = &steps[stepCount++];
+            step->tween = *tween;
+            step->changed = changed;
+            step->completed = completed;
+        }
+
+        if (t < 1) i++;
+        else *tween = _tweens[--_tweenCount];
+    }
+    CmdFX_tryUnlockMutex(_TWEEN_MUTEX);
+
+    // sprite changes and callbacks may lock the canvas or start and cancel
+    // tweens, so they run without the lock
+    for (int i = 0; i < stepCount; i++)
+        if (steps[i].changed) _applyTween(&steps[i].tween);
+
+    for (int i = 0; i < stepCount; i++) {
+        _Tween* tween = &steps[i].tween;
+        if (steps[i].completed)
+            tween->callback(tween->id, tween->sprite, tween->data);
+    }
+
+    CmdFX_tryLockMutex(_TWEEN_MUTEX);
+    if (_steps == 0) {
+        _steps = steps;
+        _stepCapacity = capacity;
+    } else
+        free(steps);
+
+    int count = _tweenCount;
+    CmdFX_tryUnlockMutex(_TWEEN_MUTEX);
+
+    return count;
+}
+
+int Tween_tick() {
+    double seconds = CmdFX_batchClock_tick(&_clock);
+    if (seconds < 0) return _tweenCount;
+
+    return Tween_update(seconds);
+}
@@ -0,0 +1,826 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cmdfx/core/assets.h"
+#include "cmdfx/core/builder.h"
+#include "cmdfx/core/costumes.h"
+#include "cmdfx/core/util.h"
+#include "common/core/shared.h"
+
+// Shared Data
+
+#define _SHARED_DATA_MUTEX 12
+
+void CmdFX_shared_retain(CmdFX_SharedData* shared) {
+    if (shared == 0) return;
+
+    CmdFX_tryLockMutex(_SHARED_DATA_MUTEX);
+    shared->references++;
+    CmdFX_tryUnlockMutex(_SHARED_DATA_MUTEX);
+}
+
+void CmdFX_shared_release(CmdFX_SharedData* shared) {
+    if (shared == 0) return;
+
+    CmdFX_tryLockMutex(_SHARED_DATA_MUTEX);
+    int references = --shared->references;
+    CmdFX_tryUnlockMutex(_SHARED_DATA_MUTEX);
+
+    if (references == 0 && shared->destroy != 0) shared->destroy(shared);
+}
+
+// Loading
+
+// a loaded asset; the asset itself holds one reference to its data, and
+// every sprite or scene borrowing it holds another
+typedef struct _LoadedAsset {
+    CmdFX_Asset asset;
+    CmdFX_SharedData shared;
+    int mapped;
+    int cached;
+
+    // pointer grids into the file, allocated once for all frames
+    char** rows;
+    char*** ansiRows;
+    char** cells;
+} _LoadedAsset;
+
+static _LoadedAsset* _getLoadedAsset(CmdFX_SharedData* shared) {
+    return (_LoadedAsset*) ((char*) shared - offsetof(_LoadedAsset, shared));
+}
+
+static void _uncache(_LoadedAsset* loaded);
+
+static void _destroyAsset(CmdFX_SharedData* shared) {
+    _LoadedAsset* loaded = _getLoadedAsset(shared);
+    CmdFX_Asset* asset = &loaded->asset;
+    if (loaded->cached) _uncache(loaded);
+
+    free(asset->frames);
+    free(asset->ansiFrames);
+    free(loaded->rows);
+    free(loaded->ansiRows);
+    free(loaded->cells);
+
+    if (loaded->mapped)
+        CmdFX_unmapFile(asset->data, asset->size);
+    else
+        free(asset->data);
+
+    free(loaded);
+}
+
+static unsigned long _readU16(const unsigned char* p) {
+    return (unsigned long) p[0] | (unsigned long) p[1] << 8;
+}
+
+static unsigned long _readU32(const unsigned char* p) {
+    return _readU16(p) | _readU16(p + 2) << 16;
+}
+
+static int _readI32(const unsigned char* p) {
+    unsigned long value = _readU32(p);
+    if (value < 0x80000000UL) return (int) value;
+
+    return -(int) (0xFFFFFFFFUL - value) - 1;
+}
+
+// reads a file that could not be mapped
+static void* _readFile(const char* path, unsigned long* size) {
+    FILE* file = fopen(path, "rb");
+    if (file == 0) return 0;
+
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0) length = ftell(file);
+    if (length <= 0 || fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return 0;
+    }
+
+    void* data = malloc(length);
+    if (data != 0 && fread(data, 1, length, file) != (size_t) length) {
+        free(data);
+        data = 0;
+    }
+    fclose(file);
+
+    *size = (unsigned long) length;
+    return data;
+}
+
+// allocates the pointer grids of every frame; glyph rows are left for the
+// caller to point at, the ANSI rows point at cells that start out unstyled
+static int _allocateGrids(
+    _LoadedAsset* loaded, unsigned long frameCount, unsigned long width,
+    unsigned long height
+) {
+    CmdFX_Asset* asset = &loaded->asset;
+
+    asset->frames = calloc(frameCount + 1, sizeof(char**));
+    asset->ansiFrames = calloc(frameCount + 1, sizeof(char***));
+    loaded->rows = calloc(frameCount * (height + 1), sizeof(char*));
+    loaded->ansiRows = calloc(frameCount * (height + 1), sizeof(char**));
+    loaded->cells = calloc(frameCount * height * (width + 1), sizeof(char*));
+    if (asset->frames == 0 || asset->ansiFrames == 0 || loaded->rows == 0 ||
+        loaded->ansiRows == 0 || loaded->cells == 0)
+        return -1;
+
+    for (unsigned long f = 0; f < frameCount; f++) {
+        asset->frames[f] = loaded->rows + f * (height + 1);
+        asset->ansiFrames[f] = loaded->ansiRows + f * (height + 1);
+
+        for (unsigned long i = 0; i < height; i++)
+            asset->ansiFrames[f][i] =
+                loaded->cells + (f * height + i) * (width + 1);
+    }
+
+    return 0;
+}
+
+// validates the file and points the frame grids into it
+static int _parseAsset(_LoadedAsset* loaded) {
+    CmdFX_Asset* asset = &loaded->asset;
+    unsigned char* p = (unsigned char*) asset->data;
+    unsigned long long size = asset->size;
+
+    if (size < CMDFX_ASSET_HEADER_SIZE) return -1;
+    if (memcmp(p, "CFXA", 4) != 0) return -1;
+    if (_readU16(p + 4) != CMDFX_ASSET_VERSION) return -1;
+
+    unsigned long kind = _readU16(p + 6);
+    unsigned long width = _readU32(p + 8);
+    unsigned long height = _readU32(p + 12);
+    unsigned long frameCount = _readU32(p + 16);
+    unsigned long styleCount = _readU32(p + 24);
+    unsigned long long glyphOffset = _readU32(p + 28);
+    unsigned long long idOffset = _readU32(p + 32);
+    unsigned long long styleOffset = _readU32(p + 36);
+    unsigned long long styleSize = _readU32(p + 40);
+
+    if (kind != ASSET_SPRITE && kind != ASSET_SCENE) return -1;
+    if (width < 1 || width > 0xFFFF || height < 1 || height > 0xFFFF)
+        return -1;
+    if (frameCount < 1 || frameCount > MAX_SPRITE_COSTUMES) return -1;
+    if (styleCount > 0xFFFF) return -1;
+
+    unsigned long long cells = (unsigned long long) width * height;
+    unsigned long long rows = (unsigned long long) frameCount * height;
+    if (glyphOffset + rows * (width + 1) > size) return -1;
+    if (idOffset + frameCount * cells * 2 > size) return -1;
+    if (styleOffset + styleSize > size) return -1;
+
+    asset->kind = (enum CmdFX_AssetKind) kind;
+    asset->width = (int) width;
+    asset->height = (int) height;
+    asset->frameCount = (int) frameCount;
+    asset->z = _readI32(p + 20);
+
+    // the style table is read once to find where each string starts
+    char** styles = calloc(styleCount + 1, sizeof(char*));
+    if (styles == 0) return -1;
+
+    unsigned long long offset = 0;
+    for (unsigned long i = 0; i < styleCount; i++) {
+        char* style = (char*) p + styleOffset + offset;
+        char* end = offset < styleSize
+                        ? memchr(style, 0, (size_t) (styleSize - offset))
+                        : 0;
+        if (end == 0) {
+            free(styles);
+            return -1;
+        }
+
+        styles[i] = style;
+        offset += end - style + 1;
+    }
+
+    if (_allocateGrids(loaded, frameCount, width, height) != 0) {
+        free(styles);
+        return -1;
+    }
+
+    char* glyphs = (char*) p + glyphOffset;
+    unsigned char* ids = p + idOffset;
+    for (unsigned long f = 0; f < frameCount; f++)
+        for (unsigned long i = 0; i < height; i++) {
+            char* row = glyphs + (f * height + i) * (width + 1);
+            if (row[width] != 0) {
+                free(styles);
+                return -1;
+            }
+
+            asset->frames[f][i] = row;
+            char** cellRow = asset->ansiFrames[f][i];
+
+            unsigned char* idRow = ids + (f * cells + i * width) * 2;
+            for (unsigned long j = 0; j < width; j++) {
+                unsigned long id = _readU16(idRow + j * 2);
+                if (id > styleCount) {
+                    free(styles);
+                    return -1;
+                }
+
+                cellRow[j] = id == 0 ? 0 : styles[id - 1];
+            }
+        }
+
+    free(styles);
+    return 0;
+}
+
+// turns a text sprite file into an asset held in memory; lines are read the
+// same way as `Sprite_loadFromFile`
+static int _parseText(_LoadedAsset* loaded) {
+    CmdFX_Asset* asset = &loaded->asset;
+    const char* text = (const char*) asset->data;
+    unsigned long size = asset->size;
+
+    unsigned long width = 0;
+    unsigned long height = 0;
+    unsigned long length = 0;
+    for (unsigned long i = 0; i < size; i++) {
+        if (text[i] != '\n') {
+            length++;
+            continue;
+        }
+
+        if (length > width) width = length;
+        length = 0;
+        height++;
+    }
+
+    if (length > 0) {
+        if (length > width) width = length;
+        height++;
+    }
+
+    if (width < 1 || width > 0xFFFF || height < 1 || height > 0xFFFF)
+        return -1;
+
+    char* glyphs = calloc(height * (width + 1), sizeof(char));
+    if (glyphs == 0) return -1;
+
+    if (_allocateGrids(loaded, 1, width, height) != 0) {
+        free(glyphs);
+        return -1;
+    }
+
+    for (unsigned long i = 0; i < height; i++)
+        asset->frames[0][i] = glyphs + i * (width + 1);
+
+    unsigned long row = 0;
+    unsigned long column = 0;
+    for (unsigned long i = 0; i < size; i++) {
+        if (text[i] == '\n') {
+            row++;
+            column = 0;
+            continue;
+        }
+
+        asset->frames[0][row][column++] = text[i];
+    }
+
+    // the file is no longer needed once its rows are copied
+    if (loaded->mapped)
+        CmdFX_unmapFile(asset->data, asset->size);
+    else
+        free(asset->data);
+
+    loaded->mapped = 0;
+    asset->data = glyphs;
+    asset->size = height * (width + 1);
+
+    asset->kind = ASSET_SPRITE;
+    asset->width = (int) width;
+    asset->height = (int) height;
+    asset->frameCount = 1;
+    asset->z = 0;
+
+    return 0;
+}
+
+CmdFX_Asset* Asset_load(const char* path) {
+    if (path == 0) return 0;
+
+    _LoadedAsset* loaded = (_LoadedAsset*) calloc(1, sizeof(_LoadedAsset));
+    if (loaded == 0) return 0;
+
+    loaded->shared.references = 1;
+    loaded->shared.destroy = _destroyAsset;
+
+    CmdFX_Asset* asset = &loaded->asset;
+    asset->data = CmdFX_mapFile(path, &asset->size);
+    loaded->mapped = asset->data != 0;
+    if (!loaded->mapped) asset->data = _readFile(path, &asset->size);
+
+    if (asset->data == 0 || _parseAsset(loaded) != 0) {
+        _destroyAsset(&loaded->shared);
+        return 0;
+    }
+
+    return asset;
+}
+
+int Asset_free(CmdFX_Asset* asset) {
+    if (asset == 0) return 0; // free(0) is a no-op
+
+    CmdFX_shared_release(&((_LoadedAsset*) asset)->shared);
+    return 0;
+}
+
+// Cache
+
+// every path an asset was loaded from; entries only point at their asset,
+// which removes them once its last reference is released
+typedef struct _CacheEntry {
+    char* path;
+    unsigned long long hash;
+    unsigned long size;
+    _LoadedAsset* asset;
+} _CacheEntry;
+
+static _CacheEntry* _cache = 0;
+static int _cacheCount = 0;
+static int _cacheCapacity = 0;
+
+// 64-bit FNV-1a
+static unsigned long long _hashContent(
+    const unsigned char* data, unsigned long size
+) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (unsigned long i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+// finds a cached asset by path, or by content when the path is NULL, and
+// takes a reference to it; the shared data mutex must be held
+static _LoadedAsset* _findCached(
+    const char* path, unsigned long long hash, unsigned long size
+) {
+    for (int i = 0; i < _cacheCount; i++) {
+        _CacheEntry* entry = &_cache[i];
+
+        // released assets are about to remove themselves
+        if (entry->asset->shared.references < 1) continue;
+
+        if (path != 0) {
+            if (strcmp(entry->path, path) != 0) continue;
+        }
+        else if (entry->hash != hash || entry->size != size)
+            continue;
+
+        entry->asset->shared.references++;
+        return entry->asset;
+    }
+
+    return 0;
+}
+
+// the shared data mutex must be held
+static void _addCached(
+    const char* path, unsigned long long hash, unsigned long size,
+    _LoadedAsset* loaded
+) {
+    if (_cacheCount == _cacheCapacity) {
+        int capacity = _cacheCapacity == 0 ? 8 : _cacheCapacity * 2;
+        _CacheEntry* temp = realloc(_cache, sizeof(_CacheEntry) * capacity);
+        if (temp == 0) return;
+
+        _cache = temp;
+        _cacheCapacity = capacity;
+    }
+
+    char* copy = malloc(strlen(path) + 1);
+    if (copy == 0) return;
+    strcpy(copy, path);
+
+    _CacheEntry* entry = &_cache[_cacheCount++];
+    entry->path = copy;
+    entry->hash = hash;
+    entry->size = size;
+    entry->asset = loaded;
+    loaded->cached = 1;
+}
+
+static void _uncache(_LoadedAsset* loaded) {
+    CmdFX_tryLockMutex(_SHARED_DATA_MUTEX);
+
+    int kept = 0;
+    for (int i = 0; i < _cacheCount; i++) {
+        if (_cache[i].asset == loaded) {
+            free(_cache[i].path);
+            continue;
+        }
+
+        _cache[kept++] = _cache[i];
+    }
+    _cacheCount = kept;
+
+    if (_cacheCount == 0) {
+        free(_cache);
+        _cache = 0;
+        _cacheCapacity = 0;
+    }
+
+    CmdFX_tryUnlockMutex(_SHARED_DATA_MUTEX);
+}
+
+CmdFX_Asset* Asset_loadCached(const char* path) {
+    if (path == 0) return 0;
+
+    CmdFX_tryLockMutex(_SHARED_DATA_MUTEX);
+    _LoadedAsset* cached = _findCached(path, 0, 0);
+    CmdFX_tryUnlockMutex(_SHARED_DATA_MUTEX);
+    if (cached != 0) return &cached->asset;
+
+    _LoadedAsset* loaded = (_LoadedAsset*) calloc(1, sizeof(_LoadedAsset));
+    if (loaded == 0) return 0;
+
+    loaded->shared.references = 1;
+    loaded->shared.destroy = _destroyAsset;
+
+    CmdFX_Asset* asset = &loaded->asset;
+    asset->data = CmdFX_mapFile(path, &asset->size);
+    loaded->mapped = asset->data != 0;
+    if (!loaded->mapped) asset->data = _readFile(path, &asset->size);
+
+    if (asset->data == 0) {
+        _destroyAsset(&loaded->shared);
+        return 0;
+    }
+
+    // the same content under another path is shared as well
+    unsigned long size = asset->size;
+    unsigned long long hash = _hashContent(asset->data, size);
+
+    CmdFX_tryLockMutex(_SHARED_DATA_MUTEX);
+    cached = _findCached(0, hash, size);
+    if (cached != 0) _addCached(path, hash, size, cached);
+    CmdFX_tryUnlockMutex(_SHARED_DATA_MUTEX);
+
+    if (cached != 0) {
+        _destroyAsset(&loaded->shared);
+        return &cached->asset;
+    }
+
+    int r = size >= 4 && memcmp(asset->data, "CFXA", 4) == 0
+                ? _parseAsset(loaded)
+                : _parseText(loaded);
+    if (r != 0) {
+        _destroyAsset(&loaded->shared);
+        return 0;
+    }
+
+    CmdFX_tryLockMutex(_SHARED_DATA_MUTEX);
+    _addCached(path, hash, size, loaded);
+    CmdFX_tryUnlockMutex(_SHARED_DATA_MUTEX);
+
+    return asset;
+}
+
+int Asset_isCached(const char* path) {
+    if (path == 0) return 0;
+
+    int found = 0;
+    CmdFX_tryLockMutex(_SHARED_DATA_MUTEX);
+    for (int i = 0; i < _cacheCount && !found; i++)
+        found = _cache[i].asset->shared.references > 0 &&
+                strcmp(_cache[i].path, path) == 0;
+    CmdFX_tryUnlockMutex(_SHARED_DATA_MUTEX);
+
+    return found;
+}
+
+CmdFX_Sprite* Asset_loadSprite(const char* path, int z) {
+    CmdFX_Asset* asset = Asset_loadCached(path);
+    if (asset == 0) return 0;
+
+    CmdFX_Sprite* sprite = Asset_createSprite(asset);
+    if (sprite != 0) sprite->z = z;
+
+    // the sprite keeps the asset alive on its own
+    Asset_free(asset);
+    return sprite;
+}
+
+// Creation
+
+// copies a frame into buffers owned by the caller
+static int _copyFrame(
+    CmdFX_Asset* asset, int frame, char*** data, char**** ansi
+) {
+    *data = Char2DBuilder_create(asset->width, asset->height);
+    *ansi = String2DBuilder_create(asset->width, asset->height);
+    if (*data == 0 || *ansi == 0) return -1;
+
+    for (int i = 0; i < asset->height; i++) {
+        memcpy((*data)[i], asset->frames[frame][i], asset->width + 1);
+
+        for (int j = 0; j < asset->width; j++) {
+            char* cell = asset->ansiFrames[frame][i][j];
+            if (cell == 0) continue;
+
+            (*ansi)[i][j] = malloc(strlen(cell) + 1);
+            if ((*ansi)[i][j] == 0) return -1;
+            strcpy((*ansi)[i][j], cell);
+        }
+    }
+
+    return 0;
+}
+
+CmdFX_Sprite* Asset_createSprite(CmdFX_Asset* asset) {
+    if (asset == 0) return 0;
+
+    CmdFX_Sprite* sprite =
+        Sprite_create(asset->frames[0], asset->ansiFrames[0], asset->z);
+    if (sprite == 0) return 0;
+
+    if (!_Sprite_setShared(sprite, &((_LoadedAsset*) asset)->shared)) {
+        sprite->data = 0;
+        sprite->ansi = 0;
+        Sprite_free(sprite);
+        return 0;
+    }
+
+    if (asset->frameCount == 1) return sprite;
+
+    // costumes own their buffers, so extra frames are copied
+    if (Sprite_createCostumes(sprite, asset->frameCount) == 0) {
+        Sprite_free(sprite);
+        return 0;
+    }
+
+    for (int f = 1; f < asset->frameCount; f++) {
+        char** data = 0;
+        char*** ansi = 0;
+        int r = _copyFrame(asset, f, &data, &ansi);
+        if (r == 0) r = Sprite_setCostumeAt(sprite, f, data, ansi);
+
+        if (r != 0) {
+            if (data != 0) {
+                for (int i = 0; i < asset->height; i++) free(data[i]);
+                free(data);
+            }
+            if (ansi != 0) {
+                for (int i = 0; i < asset->height; i++) {
+                    for (int j = 0; j < asset->width; j++) free(ansi[i][j]);
+                    free(ansi[i]);
+                }
+                free(ansi);
+            }
+
+            Sprite_free(sprite);
+            return 0;
+        }
+    }
+
+    return sprite;
+}
+
+CmdFX_Scene* Asset_createScene(CmdFX_Asset* asset) {
+    if (asset == 0) return 0;
+
+    CmdFX_Scene* scene = Scene_createFromData(asset->frames[0], 0);
+    if (scene == 0) return 0;
+
+    // rows may end early at a NUL, so the size comes from the asset
+    scene->width = asset->width;
+    scene->height = asset->height;
+    scene->ansiData = asset->ansiFrames[0];
+    scene->z = asset->z;
+
+    if (!_Scene_setShared(scene, &((_LoadedAsset*) asset)->shared)) {
+        scene->data = 0;
+        scene->ansiData = 0;
+        Scene_free(scene);
+        return 0;
+    }
+
+    return scene;
+}
+
+// Saving
+
+static void _writeU16(FILE* file, unsigned long value) {
+    fputc((int) (value & 0xFF), file);
+    fputc((int) (value >> 8 & 0xFF), file);
+}
+
+static void _writeU32(FILE* file, unsigned long value) {
+    _writeU16(file, value & 0xFFFF);
+    _writeU16(file, value >> 16 & 0xFFFF);
+}
+
+// finds or adds a style, returning its ID
+static int _styleId(char*** styles, int* styleCount, char* ansi) {
+    if (ansi == 0) return 0;
+
+    for (int i = 0; i < *styleCount; i++)
+        if (strcmp((*styles)[i], ansi) == 0) return i + 1;
+
+    if (*styleCount >= 0xFFFF) return -1;
+
+    char** temp = realloc(*styles, sizeof(char*) * (*styleCount + 1));
+    if (temp == 0) return -1;
+
+    *styles = temp;
+    (*styles)[(*styleCount)++] = ansi;
+
+    return *styleCount;
+}
+
+// writes the frames as an asset; each frame has its own size, and the asset
+// is as large as the largest one
+static int _writeAsset(
+    const char* path, enum CmdFX_AssetKind kind, int frameCount, int z,
+    char*** frames, char**** ansiFrames, int* widths, int* heights
+) {
+    int width = 0;
+    int height = 0;
+    for (int f = 0; f < frameCount; f++) {
+        if (widths[f] > width) width = widths[f];
+        if (heights[f] > height) height = heights[f];
+    }
+
+    if (width < 1 || width > 0xFFFF || height < 1 || height > 0xFFFF)
+        return -1;
+
+    unsigned long cells = (unsigned long) width * height;
+    unsigned short* ids =
+        (unsigned short*) calloc(frameCount * cells, sizeof(unsigned short));
+    if (ids == 0) return -1;
+
+    char** styles = 0;
+    int styleCount = 0;
+    unsigned long styleSize = 0;
+
+    for (int f = 0; f < frameCount; f++) {
+        if (ansiFrames[f] == 0) continue;
+
+        for (int i = 0; i < heights[f]; i++)
+            for (int j = 0; j < widths[f]; j++) {
+                char* ansi = ansiFrames[f][i][j];
+                int count = styleCount;
+                int id = _styleId(&styles, &styleCount, ansi);
+                if (id < 0) {
+                    free(ids);
+                    free(styles);
+                    return -1;
+                }
+
+                if (styleCount > count) styleSize += strlen(ansi) + 1;
+                ids[f * cells + i * width + j] = (unsigned short) id;
+            }
+    }
+
+    unsigned long glyphOffset = CMDFX_ASSET_HEADER_SIZE;
+    unsigned long idOffset =
+        glyphOffset + (unsigned long) frameCount * height * (width + 1);
+    idOffset += idOffset % 2; // style IDs are 16-bit aligned
+    unsigned long styleOffset = idOffset + frameCount * cells * 2;
+
+    FILE* file = fopen(path, "wb");
+    if (file == 0) {
+        free(ids);
+        free(styles);
+        return -1;
+    }
+
+    fwrite("CFXA", 1, 4, file);
+    _writeU16(file, CMDFX_ASSET_VERSION);
+    _writeU16(file, kind);
+    _writeU32(file, width);
+    _writeU32(file, height);
+    _writeU32(file, frameCount);
+    _writeU32(file, (unsigned long) z);
+    _writeU32(file, styleCount);
+    _writeU32(file, glyphOffset);
+    _writeU32(file, idOffset);
+    _writeU32(file, styleOffset);
+    _writeU32(file, styleSize);
+    _writeU32(file, 0); // reserved
+
+    // rows are padded with NULs, so shorter rows keep their length
+    char* row = (char*) malloc(width + 1);
+    for (int f = 0; row != 0 && f < frameCount; f++)
+        for (int i = 0; i < height; i++) {
+            memset(row, 0, width + 1);
+            if (i < heights[f] && frames[f][i] != 0)
+                for (int j = 0; j < widths[f] && frames[f][i][j] != 0; j++)
+                    row[j] = frames[f][i][j];
+
+            fwrite(row, 1, width + 1, file);
+        }
+    free(row);
+
+    if (ftell(file) % 2 != 0) fputc(0, file);
+    for (unsigned long i = 0; i < frameCount * cells; i++)
+        _writeU16(file, ids[i]);
+
+    for (int i = 0; i < styleCount; i++)
+        fwrite(styles[i], 1, strlen(styles[i]) + 1, file);
+
+    int r = ferror(file) ? -1 : 0;
+    if (fclose(file) != 0 || row == 0) r = -1;
+
+    free(ids);
+    free(styles);
+    return r;
+}
+
+int Asset_saveSprite(CmdFX_Sprite* sprite, const char* path) {
+    if (sprite == 0 || path == 0) return -1;
+    if (sprite->data == 0) return -1;
+
+    char** data = sprite->data;
+    char*** ansi = sprite->ansi;
+    int width = sprite->width;
+    int height = sprite->height;
+
+    char*** frames = &data;
+    char**** ansiFrames = &ansi;
+    int* widths = &width;
+    int* heights = &height;
+    int frameCount = 1;
+
+    CmdFX_SpriteCostumes* costumes = Sprite_getCostumes(sprite);
+    if (costumes != 0 && costumes->costumeCount > 1) {
+        int count = costumes->costumeCount;
+        frames = calloc(count, sizeof(char**));
+        ansiFrames = calloc(count, sizeof(char***));
+        widths = calloc(count, sizeof(int));
+        heights = calloc(count, sizeof(int));
+        if (frames == 0 || ansiFrames == 0 || widths == 0 || heights == 0) {
+            free(frames);
+            free(ansiFrames);
+            free(widths);
+            free(heights);
+            return -1;
+        }
+
+        // empty costume slots are skipped
+        frameCount = 0;
+        for (int i = 0; i < count; i++) {
+            char** costume = costumes->costumes[i];
+            if (costume == 0) continue;
+
+            frames[frameCount] = costume;
+            ansiFrames[frameCount] = costumes->ansiCostumes[i];
+            heights[frameCount] = getCharArrayHeight(costume);
+            widths[frameCount] = 0;
+            for (int j = 0; j < heights[frameCount]; j++) {
+                int length = strlen(costume[j]);
+                if (length > widths[frameCount]) widths[frameCount] = length;
+            }
+
+            frameCount++;
+        }
+    }
+
+    int r = _writeAsset(
+        path, ASSET_SPRITE, frameCount, sprite->z, frames, ansiFrames, widths,
+        heights
+    );
+
+    if (frames != &data) {
+        free(frames);
+        free(ansiFrames);
+        free(widths);
+        free(heights);
+    }
+
+    return r;
+}
+
+int Asset_saveScene(CmdFX_Scene* scene, const char* path) {
+    if (scene == 0 || path == 0) return -1;
+    if (scene->data == 0) return -1;
+
+    char** data = scene->data;
+    char*** ansi = scene->ansiData;
+    int width = scene->width;
+    int height = scene->height;
+
+    return _writeAsset(
+        path, ASSET_SCENE, 1, scene->z, &data, &ansi, &width, &height
+    );
+}
+
+int Asset_convertFromText(const char* input, const char* output, int z) {
+    if (input == 0 || output == 0) return -1;
+
+    CmdFX_Sprite* sprite = Sprite_loadFromFile(input, z);
+    if (sprite == 0) return -1;
+
+    int r = Asset_saveSprite(sprite, output);
+    Sprite_free(sprite);
+
+    return r;
+}
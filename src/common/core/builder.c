@@ -72,6 +72,263 @@ int _getLower(double factor, double* percentages, int size) {
     return size - 1;
 }
 
+// Transform Engine
+
+// maps every destination cell to the index of the source cell it samples,
+// or -1 outside the source; the inverse affine map `m` (source = m * cell
+// center) is split into per-column and per-row terms computed once, so each
+// cell costs two additions
+static int* _transformMap(
+    int width, int height, int newWidth, int newHeight, const double m[6]
+) {
+    double* cols = malloc(sizeof(double) * newWidth * 2);
+    double* rows = malloc(sizeof(double) * newHeight * 2);
+    int* map = malloc(sizeof(int) * newWidth * newHeight);
+    if (cols == 0 || rows == 0 || map == 0) {
+        free(cols);
+        free(rows);
+        free(map);
+        return 0;
+    }
+
+    for (int x = 0; x < newWidth; x++) {
+        cols[x * 2] = m[0] * (x + 0.5);
+        cols[x * 2 + 1] = m[3] * (x + 0.5);
+    }
+
+    for (int y = 0; y < newHeight; y++) {
+        rows[y * 2] = m[1] * (y + 0.5) + m[2];
+        rows[y * 2 + 1] = m[4] * (y + 0.5) + m[5];
+    }
+
+    for (int y = 0; y < newHeight; y++) {
+        int* out = map + y * newWidth;
+        double rowX = rows[y * 2];
+        double rowY = rows[y * 2 + 1];
+
+        for (int x = 0; x < newWidth; x++) {
+            int sx = (int) floor(cols[x * 2] + rowX);
+            int sy = (int) floor(cols[x * 2 + 1] + rowY);
+            out[x] = sx >= 0 && sx < width && sy >= 0 && sy < height
+                         ? sy * width + sx
+                         : -1;
+        }
+    }
+
+    free(cols);
+    free(rows);
+    return map;
+}
+
+// applies a map to glyph and style grids together; the source is read from
+// flat copies, so the output grids may be the source grids. The source style
+// strings are moved into the output (or freed if nothing samples them)
+//
+// glyph rows may end early, and so may style rows without glyphs, which end
+// at their first NULL like getStringArrayWidth; style rows paired with
+// glyphs hold `width` cells, where NULL means no style. Cells past the end
+// of a row read as blank, and are not written when transforming in place.
+// Every style string is allocated before either grid is touched, so a failed
+// allocation leaves both grids as they were
+static int _applyTransform(
+    char** data, char*** ansi, int width, int height, char** newData,
+    char*** newAnsi, int newWidth, int newHeight, const int* map
+) {
+    int cells = width * height;
+    int newCells = newWidth * newHeight;
+
+    int* lengths = malloc(sizeof(int) * height * 2);
+    if (lengths == 0) return -1;
+
+    int* glyphLengths = lengths;
+    int* styleLengths = lengths + height;
+    for (int y = 0; y < height; y++) {
+        glyphLengths[y] = 0;
+        if (data != 0)
+            while (glyphLengths[y] < width && data[y][glyphLengths[y]] != 0)
+                glyphLengths[y]++;
+
+        styleLengths[y] = width;
+        if (ansi != 0 && data == 0) {
+            styleLengths[y] = 0;
+            while (styleLengths[y] < width && ansi[y][styleLengths[y]] != 0)
+                styleLengths[y]++;
+        }
+    }
+
+    char* glyphs = 0;
+    if (data != 0) {
+        glyphs = malloc(cells);
+        if (glyphs == 0) {
+            free(lengths);
+            return -1;
+        }
+
+        for (int y = 0; y < height; y++) {
+            char* flat = glyphs + y * width;
+            memcpy(flat, data[y], glyphLengths[y]);
+            memset(flat + glyphLengths[y], ' ', width - glyphLengths[y]);
+        }
+    }
+
+    char** styles = 0;
+    char** placed = 0;
+    unsigned char* taken = 0;
+    if (ansi != 0 && newAnsi != 0) {
+        styles = calloc(cells, sizeof(char*));
+        placed = calloc(newCells, sizeof(char*));
+        taken = calloc(cells, 1);
+        if (styles == 0 || placed == 0 || taken == 0) {
+            free(lengths);
+            free(glyphs);
+            free(styles);
+            free(placed);
+            free(taken);
+            return -1;
+        }
+
+        for (int y = 0; y < height; y++)
+            memcpy(
+                styles + y * width, ansi[y], sizeof(char*) * styleLengths[y]
+            );
+
+        // the first cell takes the string, the others copy it; uncovered
+        // cells get an empty style instead of a terminator, so the grid keeps
+        // its measured width
+        int failed = 0;
+        for (int k = 0; !failed && k < newCells; k++) {
+            int y = k / newWidth;
+            int x = k % newWidth;
+            if (newAnsi == ansi && x >= styleLengths[y]) continue;
+
+            int i = map[k];
+            if (i >= 0 && styles[i] == 0) continue;
+            if (i >= 0 && !taken[i]) {
+                taken[i] = 1;
+                placed[k] = styles[i];
+                continue;
+            }
+
+            if (i < 0) placed[k] = calloc(1, 1);
+            else {
+                placed[k] = malloc(strlen(styles[i]) + 1);
+                if (placed[k] != 0) strcpy(placed[k], styles[i]);
+            }
+            failed = placed[k] == 0;
+        }
+
+        if (failed) {
+            for (int k = 0; k < newCells; k++)
+                if (map[k] < 0 || placed[k] != styles[map[k]]) free(placed[k]);
+
+            free(lengths);
+            free(glyphs);
+            free(styles);
+            free(placed);
+            free(taken);
+            return -1;
+        }
+    }
+
+    for (int y = 0; y < newHeight; y++) {
+        const int* row = map + y * newWidth;
+
+        if (newData != 0) {
+            char* out = newData[y];
+            int end = newData == data ? glyphLengths[y] : newWidth;
+            for (int x = 0; x < end; x++)
+                out[x] = row[x] < 0 ? ' ' : glyphs[row[x]];
+        }
+
+        if (placed != 0) {
+            char** out = newAnsi[y];
+            int end = newAnsi == ansi ? styleLengths[y] : newWidth;
+            for (int x = 0; x < end; x++) out[x] = placed[y * newWidth + x];
+        }
+    }
+
+    for (int i = 0; styles != 0 && i < cells; i++)
+        if (!taken[i]) free(styles[i]);
+
+    free(lengths);
+    free(glyphs);
+    free(styles);
+    free(placed);
+    free(taken);
+    return 0;
+}
+
+// maps every cell of a grid rotated around its center to the cell it
+// samples; also used by src/common/core/rotations.c
+int* _rotationMap(int width, int height, double radians) {
+    if (width <= 0 || height <= 0) return 0;
+
+    double c = cos(radians);
+    double s = sin(radians);
+    double cx = width / 2.0;
+    double cy = height / 2.0;
+    const double m[6] = {c,  s, cx - c * cx - s * cy,
+                         -s, c, cy + s * cx - c * cy};
+
+    return _transformMap(width, height, width, height, m);
+}
+
+// rotates glyph and style grids of the same size in place, around their
+// center; also used by src/common/core/sprites.c
+int _rotateGrids(
+    char** data, char*** ansi, int width, int height, double radians
+) {
+    int* map = _rotationMap(width, height, radians);
+    if (map == 0) return -1;
+
+    int r = _applyTransform(
+        data, ansi, width, height, data, ansi, width, height, map
+    );
+
+    free(map);
+    return r;
+}
+
+// scales glyph and style grids of the same size into new grids; the source
+// style strings are moved into the new grid, but the source rows are left
+// for the caller to free; also used by src/common/core/sprites.c
+int _scaleGrids(
+    char** data, char*** ansi, int width, int height, double scale,
+    char*** newData, char**** newAnsi, int* newWidth, int* newHeight
+) {
+    if (width <= 0 || height <= 0) return -1;
+    if (scale <= 0) return -1;
+
+    int w = (int) (width * scale);
+    int h = (int) (height * scale);
+    if (w <= 0 || h <= 0) return -1;
+
+    char** scaledData = data == 0 ? 0 : Char2DBuilder_create(w, h);
+    char*** scaledAnsi = ansi == 0 ? 0 : String2DBuilder_create(w, h);
+    const double m[6] = {1 / scale, 0, 0, 0, 1 / scale, 0};
+    int* map = _transformMap(width, height, w, h, m);
+
+    if ((data != 0 && scaledData == 0) || (ansi != 0 && scaledAnsi == 0) ||
+        map == 0 ||
+        _applyTransform(
+            data, ansi, width, height, scaledData, scaledAnsi, w, h, map
+        ) != 0) {
+        for (int i = 0; scaledData != 0 && i < h; i++) free(scaledData[i]);
+        free(scaledData);
+        for (int i = 0; scaledAnsi != 0 && i < h; i++) free(scaledAnsi[i]);
+        free(scaledAnsi);
+        free(map);
+        return -1;
+    }
+
+    free(map);
+    if (newData != 0) *newData = scaledData;
+    if (newAnsi != 0) *newAnsi = scaledAnsi;
+    if (newWidth != 0) *newWidth = w;
+    if (newHeight != 0) *newHeight = h;
+    return 0;
+}
+
 #pragma region Character Builder
 
 int getCharArrayWidth(char** array) {
@@ -716,49 +973,7 @@ int Char2DBuilder_rotate(char** array, double radians) {
     int width = getCharArrayWidth(array);
     int height = getCharArrayHeight(array);
 
-    if (width <= 0 || height <= 0) return -1;
-
-    int cx = width / 2;
-    int cy = height / 2;
-
-    char** tempArray = (char**) malloc(height * sizeof(char*));
-    if (tempArray == 0) return -1;
-
-    for (int i = 0; i < height; i++) {
-        tempArray[i] = (char*) malloc(width * sizeof(char));
-        if (tempArray[i] == 0) {
-            for (int j = 0; j < i; j++) free(tempArray[j]);
-            free(tempArray);
-            return -1;
-        }
-    }
-
-    for (int y = 0; y < height; y++)
-        for (int x = 0; x < width; x++) {
-            int newX =
-                (int) (cos(radians) * (x - cx) - sin(radians) * (y - cy) + cx);
-            int newY =
-                (int) (sin(radians) * (x - cx) + cos(radians) * (y - cy) + cy);
-
-            if (newX >= 0 && newX < width && newY >= 0 && newY < height)
-                tempArray[newY][newX] = array[y][x];
-            else
-                tempArray[newY][newX] = ' '; // Fill empty spaces outside bounds
-        }
-
-    // Copy rotated values
-    for (int y = 0; y < height; y++)
-        for (int x = 0; x < width; x++) {
-            array[y][x] = tempArray[y][x];
-        }
-
-    // Free the temporary array
-    for (int i = 0; i < height; i++) {
-        free(tempArray[i]);
-    }
-    free(tempArray);
-
-    return 0;
+    return _rotateGrids(array, 0, width, height, radians);
 }
 
 double Char2DBuilder_getRotationAngle(char** array) {
@@ -910,27 +1125,9 @@ char** Char2DBuilder_scale(char** array, double scale) {
     int width = getCharArrayWidth(array);
     int height = getCharArrayHeight(array);
 
-    if (width <= 0 || height <= 0) return 0;
-
-    char** scaled = (char**) malloc(height * scale * sizeof(char*));
-    if (scaled == 0) return 0;
-
-    for (int i = 0; i < height * scale; i++) {
-        scaled[i] = (char*) malloc(width * scale * sizeof(char));
-
-        if (scaled[i] == 0) {
-            for (int j = 0; j < i; j++) free(scaled[j]);
-            free(scaled);
-            return 0;
-        }
-    }
-
-    for (int y = 0; y < height; y++)
-        for (int x = 0; x < width; x++)
-            for (int sy = 0; sy < scale; sy++)
-                for (int sx = 0; sx < scale; sx++)
-                    scaled[(int) (y * scale + sy)][(int) (x * scale + sx)] =
-                        array[y][x];
+    char** scaled = 0;
+    if (_scaleGrids(array, 0, width, height, scale, &scaled, 0, 0, 0) != 0)
+        return 0;
 
     // Free the original array
     for (int i = 0; i < height; i++) {
@@ -958,7 +1155,8 @@ char** _generateCharGradientGrid(
                 _calculateGradientFactor(x, y, width, height, direction);
 
             int lower = _getLower(factor, percentages, numChars);
-            int upper = lower + 1;
+            // the last band has nothing above it to blend into
+            int upper = lower + 1 < numChars ? lower + 1 : lower;
 
             double range = percentages[upper] - percentages[lower];
             double interpFactor =
@@ -1674,50 +1872,7 @@ int String2DBuilder_rotate(char*** array, double radians) {
     int width = getStringArrayWidth(array);
     int height = getStringArrayHeight(array);
 
-    if (width <= 0 || height <= 0) return -1;
-
-    int cx = width / 2;
-    int cy = height / 2;
-
-    char*** tempArray = (char***) malloc(height * sizeof(char**));
-    if (tempArray == 0) return -1;
-
-    for (int i = 0; i < height; i++) {
-        tempArray[i] = (char**) calloc(width, sizeof(char*));
-        if (tempArray[i] == 0) {
-            for (int j = 0; j < i; j++) free(tempArray[j]);
-            free(tempArray);
-            return -1;
-        }
-    }
-
-    for (int y = 0; y < height; y++)
-        for (int x = 0; x < width; x++) {
-            int newX =
-                (int) (cos(radians) * (x - cx) - sin(radians) * (y - cy) + cx);
-            int newY =
-                (int) (sin(radians) * (x - cx) + cos(radians) * (y - cy) + cy);
-
-            if (newX >= 0 && newX < width && newY >= 0 && newY < height)
-                strcpy(tempArray[newY][newX], array[y][x]);
-        }
-
-    // Copy rotated values
-    for (int y = 0; y < height; y++)
-        for (int x = 0; x < width; x++) {
-            strcpy(array[y][x], tempArray[y][x]);
-        }
-
-    // Free the temporary array
-    for (int i = 0; i < height; i++) {
-        for (int j = 0; j < width; j++) {
-            free(tempArray[i][j]);
-        }
-        free(tempArray[i]);
-    }
-    free(tempArray);
-
-    return 0;
+    return _rotateGrids(0, array, width, height, radians);
 }
 
 int String2DBuilder_hFlip(char*** array) {
@@ -1824,35 +1979,12 @@ char*** String2DBuilder_scale(char*** array, double scale) {
     int width = getStringArrayWidth(array);
     int height = getStringArrayHeight(array);
 
-    if (width <= 0 || height <= 0) return 0;
-
-    char*** scaled = (char***) malloc(height * scale * sizeof(char**));
-    if (scaled == 0) return 0;
-
-    for (int i = 0; i < height * scale; i++) {
-        scaled[i] = (char**) malloc(width * scale * sizeof(char*));
-
-        if (scaled[i] == 0) {
-            for (int j = 0; j < i; j++) free(scaled[j]);
-            free(scaled);
-            return 0;
-        }
-    }
-
-    for (int y = 0; y < height; y++)
-        for (int x = 0; x < width; x++)
-            for (int sy = 0; sy < scale; sy++)
-                for (int sx = 0; sx < scale; sx++)
-                    strcpy(
-                        scaled[(int) (y * scale + sy)][(int) (x * scale + sx)],
-                        array[y][x]
-                    );
+    char*** scaled = 0;
+    if (_scaleGrids(0, array, width, height, scale, 0, &scaled, 0, 0) != 0)
+        return 0;
 
-    // Free the original array
+    // Free the original array; its strings now belong to the scaled one
     for (int i = 0; i < height; i++) {
-        for (int j = 0; j < width; j++) {
-            free(array[i][j]);
-        }
         free(array[i]);
     }
     free(array);
@@ -1862,66 +1994,174 @@ char*** String2DBuilder_scale(char*** array, double scale) {
 
 // Utility Functions - Gradient (ANSI)
 
-int** _generateColorGradientGrid(
-    int* colors, double* percentages, int numColors, int width, int height,
-    enum CmdFX_GradientDirection direction
+// converts the colors of a gradient to HSV once and places them at stops
+// between 0 and 1; each percentage is the share of the gradient between a
+// color and the next, and missing or empty percentages mean equal shares
+static void _gradientStops(
+    int* colors, double* percentages, int numColors, double* stops,
+    double* h, double* s, double* v
 ) {
-    int** grid = (int**) malloc(height * sizeof(int*));
-    for (int i = 0; i < height; i++) {
-        grid[i] = (int*) malloc(width * sizeof(int));
+    rgb_to_hsv_batch(colors, h, s, v, numColors);
+
+    double total = 0;
+    for (int i = 0; percentages != 0 && i < numColors - 1; i++)
+        if (percentages[i] > 0) total += percentages[i];
+
+    stops[0] = 0;
+    for (int i = 1; i < numColors; i++) {
+        double share = 1.0 / (numColors - 1);
+        if (total > 0)
+            share = percentages[i - 1] > 0 ? percentages[i - 1] / total : 0;
+
+        stops[i] = stops[i - 1] + share;
     }
+    stops[numColors - 1] = 1;
+}
 
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            double factor =
-                _calculateGradientFactor(x, y, width, height, direction);
+// colors a batch of gradient factors, a chunk at a time
+static void _gradientColors(
+    const double* factors, int count, const double* stops, const double* h,
+    const double* s, const double* v, int numColors, int* out
+) {
+    double hs[64], ss[64], vs[64];
+    for (int start = 0; start < count; start += 64) {
+        int n = count - start < 64 ? count - start : 64;
 
-            int lower = _getLower(factor, percentages, numColors);
-            int upper = lower + 1;
+        for (int i = 0; i < n; i++) {
+            double f = factors[start + i];
 
-            if (lower == upper)
-                grid[y][x] = colors[lower];
-            else {
-                double rangeFactor = (factor - percentages[lower]) /
-                                     (percentages[upper] - percentages[lower]);
-                grid[y][x] =
-                    lerp_color(colors[lower], colors[upper], rangeFactor);
-            }
+            int lower = 0;
+            while (lower < numColors - 2 && f > stops[lower + 1]) lower++;
+
+            double range = stops[lower + 1] - stops[lower];
+            double t = range > 0 ? (f - stops[lower]) / range : 0;
+
+            hs[i] = lerp_d(h[lower], h[lower + 1], t);
+            ss[i] = lerp_d(s[lower], s[lower + 1], t);
+            vs[i] = lerp_d(v[lower], v[lower + 1], t);
         }
+
+        hsv_to_rgb_batch(hs, ss, vs, out + start, n);
     }
+}
 
-    return grid;
+static double _gradientFactor(
+    int x, int y, int width, int height, enum CmdFX_GradientDirection direction
+) {
+    // single rows and columns divide by zero; NaN is clamped to the start
+    double factor = _calculateGradientFactor(x, y, width, height, direction);
+    if (!(factor > 0)) return 0;
+    if (factor > 1) return 1;
+
+    return factor;
 }
 
-char*** _toANSI(int prefix, int** grid, int width, int height) {
-    if (grid == 0) return 0;
+int Color2DBuilder_gradient(
+    int* rgb, int width, int height, int numColors, int* colors,
+    double* percentages, enum CmdFX_GradientDirection direction
+) {
+    if (rgb == 0 || colors == 0) return -1;
+    if (width < 1 || height < 1) return -1;
+    if (numColors < 1) return -1;
 
-    char*** ansi = (char***) malloc(height * sizeof(char**));
-    for (int i = 0; i < height; i++) {
-        ansi[i] = (char**) malloc(width * sizeof(char*));
-        for (int j = 0; j < width; j++) {
-            int rgb = grid[i][j];
+    if (numColors == 1) {
+        for (int i = 0; i < width * height; i++) rgb[i] = colors[0];
+        return 0;
+    }
 
-            int r = (rgb >> 16) & 0xFF;
-            int g = (rgb >> 8) & 0xFF;
-            int b = rgb & 0xFF;
+    int length = width > height ? width : height;
+    double* buffer = malloc(sizeof(double) * (numColors * 4 + length));
+    if (buffer == 0) return -1;
 
-            ansi[i][j] = (char*) malloc(22);
-            snprintf(ansi[i][j], 22, "\033[%d;2;%d;%d;%dm", prefix, r, g, b);
+    double* stops = buffer;
+    double* h = stops + numColors;
+    double* s = h + numColors;
+    double* v = s + numColors;
+    double* factors = v + numColors;
+    _gradientStops(colors, percentages, numColors, stops, h, s, v);
+
+    switch (direction) {
+        // every row is the same
+        case GRADIENT_HORIZONTAL:
+        case GRADIENT_HORIZONTAL_REVERSE:
+            for (int x = 0; x < width; x++)
+                factors[x] = _gradientFactor(x, 0, width, height, direction);
+            _gradientColors(factors, width, stops, h, s, v, numColors, rgb);
+
+            for (int y = 1; y < height; y++)
+                memcpy(rgb + y * width, rgb, sizeof(int) * width);
+            break;
+        // every row is a single color
+        case GRADIENT_VERTICAL:
+        case GRADIENT_VERTICAL_REVERSE: {
+            int* column = malloc(sizeof(int) * height);
+            if (column == 0) {
+                free(buffer);
+                return -1;
+            }
+
+            for (int y = 0; y < height; y++)
+                factors[y] = _gradientFactor(0, y, width, height, direction);
+            _gradientColors(
+                factors, height, stops, h, s, v, numColors, column
+            );
+
+            for (int y = 0; y < height; y++) {
+                int* row = rgb + y * width;
+                for (int x = 0; x < width; x++) row[x] = column[y];
+            }
+
+            free(column);
+            break;
         }
+        default:
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++)
+                    factors[x] =
+                        _gradientFactor(x, y, width, height, direction);
+                _gradientColors(
+                    factors, width, stops, h, s, v, numColors, rgb + y * width
+                );
+            }
+            break;
     }
 
-    return ansi;
+    free(buffer);
+    return 0;
 }
 
-void _freeGrid(int** grid, int width, int height) {
-    (void) width;
-    for (int i = 0; i < height; i++) free(grid[i]);
-    free(grid);
+static char* _putByte(char* out, int value) {
+    if (value >= 100) *out++ = '0' + value / 100;
+    if (value >= 10) *out++ = '0' + value / 10 % 10;
+    *out++ = '0' + value % 10;
+    return out;
 }
 
-// declared in src/common/core/sprites.c
-extern void _freeANSI(char*** ansi, int width, int height);
+// replaces a cell with a 24-bit color code, reusing its allocation; also
+// used by src/common/core/sprites.c
+int _setColorString(char** cell, int prefix, int rgb) {
+    // "\033[38;2;255;255;255m"
+    char* ansi = realloc(*cell, 20);
+    if (ansi == 0) return 0;
+
+    char* out = ansi;
+    *out++ = '\033';
+    *out++ = '[';
+    out = _putByte(out, prefix);
+    *out++ = ';';
+    *out++ = '2';
+    *out++ = ';';
+    out = _putByte(out, (rgb >> 16) & 0xFF);
+    *out++ = ';';
+    out = _putByte(out, (rgb >> 8) & 0xFF);
+    *out++ = ';';
+    out = _putByte(out, rgb & 0xFF);
+    *out++ = 'm';
+    *out = '\0';
+
+    *cell = ansi;
+    return 1;
+}
 
 int String2DBuilder_gradient0(
     char*** array, int x, int y, int width, int height, int prefix, int* colors,
@@ -1929,26 +2169,33 @@ int String2DBuilder_gradient0(
 ) {
     if (array == 0) return -1;
     if (x < 0 || y < 0) return -1;
+    if (width < 1 || height < 1) return -1;
 
     if (array[y] == 0) return -1;
     if (array[y][x] == 0) return -1;
     if (array[y][x + width - 1] == 0) return -1;
     if (array[y + height - 1] == 0) return -1;
 
-    int** grid = _generateColorGradientGrid(
-        colors, percentages, numColors, width, height, direction
-    );
-    char*** ansi = _toANSI(prefix, grid, width, height);
+    int* grid = malloc(sizeof(int) * width * height);
+    if (grid == 0) return -1;
+
+    if (Color2DBuilder_gradient(
+            grid, width, height, numColors, colors, percentages, direction
+        ) != 0) {
+        free(grid);
+        return -1;
+    }
 
+    int r = 0;
     for (int i = 0; i < height; i++) {
-        for (int j = 0; j < width; j++) {
-            free(array[y + i][x + j]);
-            array[y + i][x + j] = ansi[i][j];
-        }
+        char** row = array[y + i] + x;
+        const int* colorRow = grid + i * width;
+        for (int j = 0; j < width; j++)
+            if (!_setColorString(&row[j], prefix, colorRow[j])) r = -1;
     }
 
-    _freeGrid(grid, width, height);
-    return 0;
+    free(grid);
+    return r;
 }
 
 int String2DBuilder_gradientForeground(
@@ -1,3 +1,4 @@
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -6,6 +7,9 @@
 #include "cmdfx/core/canvas.h"
 #include "cmdfx/core/costumes.h"
 #include "cmdfx/core/sprites.h"
+#include "common/core/shared.h"
+
+void _freeANSI(char*** ansi, int width, int height);
 
 CmdFX_SpriteCostumes** _costumes = 0;
 int _costumeCount = 0;
@@ -43,31 +47,205 @@ static char*** _copyAnsiArray(char*** ansi) {
     return copy;
 }
 
+// Frame Atlas
+
+// every frame of an atlas lives in one allocation: this header, followed by
+// the frame tables, the row pointers, the ANSI cells, the glyphs and the
+// ANSI strings; frames are laid out with the same stride so a frame is found
+// by index, and borrowed by sprites like any other shared grid
+typedef struct _CostumeAtlas {
+    CmdFX_SharedData shared;
+    int frameCount;
+    char*** frames;
+    char**** ansiFrames;
+    int* widths;
+    int* heights;
+} _CostumeAtlas;
+
+// atlases of the sprites' costumes, indexed by uid - 1 like _costumes
+static _CostumeAtlas** _atlases = 0;
+
+static void _destroyAtlas(CmdFX_SharedData* shared) {
+    free((char*) shared - offsetof(_CostumeAtlas, shared));
+}
+
+// returns the frame index of a grid in the atlas, or -1 if the grid is not
+// part of it; `hint` is checked first, since slots rarely move
+static int _atlasFrame(_CostumeAtlas* atlas, char** data, int hint) {
+    if (atlas == 0 || data == 0) return -1;
+    if (hint >= 0 && hint < atlas->frameCount && atlas->frames[hint] == data)
+        return hint;
+
+    for (int i = 0; i < atlas->frameCount; i++)
+        if (atlas->frames[i] == data) return i;
+
+    return -1;
+}
+
+static int _isAtlasAnsi(_CostumeAtlas* atlas, char*** ansi) {
+    if (atlas == 0 || ansi == 0) return 0;
+
+    for (int i = 0; i < atlas->frameCount; i++)
+        if (atlas->ansiFrames[i] == ansi) return 1;
+
+    return 0;
+}
+
+static void _measureFrame(char** frame, int* width, int* height) {
+    *height = getCharArrayHeight(frame);
+    *width = 0;
+    for (int i = 0; i < *height; i++) {
+        int length = strlen(frame[i]);
+        if (length > *width) *width = length;
+    }
+}
+
+static _CostumeAtlas* _createAtlas(
+    char*** frames, char**** ansiFrames, int count
+) {
+    int width = 0;
+    int height = 0;
+    size_t styleSize = 0;
+    for (int f = 0; f < count; f++) {
+        int w, h;
+        _measureFrame(frames[f], &w, &h);
+        if (w > width) width = w;
+        if (h > height) height = h;
+
+        char*** ansi = ansiFrames[f];
+        for (int i = 0; ansi != 0 && i < h; i++)
+            for (int j = 0; j < w; j++)
+                if (ansi[i][j] != 0) styleSize += strlen(ansi[i][j]) + 1;
+    }
+
+    size_t rows = (size_t) count * (height + 1);
+    size_t cells = (size_t) count * height * (width + 1);
+
+    // pointer tables first, then the ints, then the bytes, so every part
+    // stays aligned
+    size_t size = sizeof(_CostumeAtlas);
+    size += count * (sizeof(char**) + sizeof(char***));
+    size += rows * (sizeof(char*) + sizeof(char**));
+    size += cells * sizeof(char*);
+    size += count * 2 * sizeof(int);
+    size += cells + styleSize;
+
+    _CostumeAtlas* atlas = calloc(1, size);
+    if (atlas == 0) return 0;
+
+    atlas->shared.references = 1;
+    atlas->shared.destroy = _destroyAtlas;
+    atlas->frameCount = count;
+    atlas->frames = (char***) (atlas + 1);
+    atlas->ansiFrames = (char****) (atlas->frames + count);
+
+    char** rowBlock = (char**) (atlas->ansiFrames + count);
+    char*** ansiRowBlock = (char***) (rowBlock + rows);
+    char** cellBlock = (char**) (ansiRowBlock + rows);
+    atlas->widths = (int*) (cellBlock + cells);
+    atlas->heights = atlas->widths + count;
+    char* glyphs = (char*) (atlas->heights + count);
+    char* styles = glyphs + cells;
+
+    for (int f = 0; f < count; f++) {
+        int w, h;
+        _measureFrame(frames[f], &w, &h);
+        atlas->widths[f] = w;
+        atlas->heights[f] = h;
+
+        char** frame = rowBlock + (size_t) f * (height + 1);
+        for (int i = 0; i < h; i++) {
+            frame[i] = glyphs + ((size_t) f * height + i) * (width + 1);
+            memcpy(frame[i], frames[f][i], strlen(frames[f][i]));
+        }
+        atlas->frames[f] = frame;
+
+        char*** ansi = ansiFrames[f];
+        if (ansi == 0) continue;
+
+        char*** ansiFrame = ansiRowBlock + (size_t) f * (height + 1);
+        for (int i = 0; i < h; i++) {
+            ansiFrame[i] = cellBlock + ((size_t) f * height + i) * (width + 1);
+            for (int j = 0; j < w; j++) {
+                if (ansi[i][j] == 0) continue;
+
+                size_t length = strlen(ansi[i][j]) + 1;
+                memcpy(styles, ansi[i][j], length);
+                ansiFrame[i][j] = styles;
+                styles += length;
+            }
+        }
+        atlas->ansiFrames[f] = ansiFrame;
+    }
+
+    return atlas;
+}
+
+// frees a costume's grids, unless they belong to the atlas
+static void _freeCostume(_CostumeAtlas* atlas, char** data, char*** ansi) {
+    if (data != 0 && _atlasFrame(atlas, data, -1) < 0) {
+        int height = getCharArrayHeight(data);
+        for (int i = 0; i < height; i++) free(data[i]);
+        free(data);
+    }
+
+    if (ansi != 0 && !_isAtlasAnsi(atlas, ansi)) {
+        int height = getStringArrayHeight(ansi);
+        int width = getStringArrayWidth(ansi);
+        for (int i = 0; i < height; i++) {
+            for (int j = 0; j < width; j++) free(ansi[i][j]);
+            free(ansi[i]);
+        }
+        free(ansi);
+    }
+}
+
+static void _releaseAtlas(int id) {
+    if (_atlases == 0 || _atlases[id] == 0) return;
+
+    CmdFX_shared_release(&_atlases[id]->shared);
+    _atlases[id] = 0;
+}
+
+// grows the registry until it has a slot for `id`
+static int _reserveCostumes(int id) {
+    if (id < 0) return 0;
+    if (id < _costumeCount) return 1;
+
+    int count = _costumeCount == 0 ? 4 : _costumeCount;
+    while (count <= id) count *= 2;
+
+    CmdFX_SpriteCostumes** temp =
+        realloc(_costumes, count * sizeof(CmdFX_SpriteCostumes*));
+    if (temp == 0) return 0;
+    _costumes = temp;
+
+    _CostumeAtlas** atlases =
+        realloc(_atlases, count * sizeof(_CostumeAtlas*));
+    if (atlases == 0) return 0;
+    _atlases = atlases;
+
+    for (int i = _costumeCount; i < count; i++) {
+        _costumes[i] = 0;
+        _atlases[i] = 0;
+    }
+    _costumeCount = count;
+
+    return 1;
+}
+
+// Costumes
+
 CmdFX_SpriteCostumes* Sprite_createCostumes(
     CmdFX_Sprite* sprite, int costumeCount
 ) {
     if (costumeCount < 1 || costumeCount > MAX_SPRITE_COSTUMES) return 0;
     if (sprite == 0) return 0;
     if (sprite->data == 0) return 0;
-
-    if (_costumes == 0) {
-        _costumes = calloc(4, sizeof(CmdFX_SpriteCostumes));
-        if (!_costumes) return 0;
-        _costumeCount = 4;
-    }
+    if (!_Sprite_ownData(sprite)) return 0;
 
     int id = sprite->uid - 1;
-    if (_costumeCount < id) {
-        CmdFX_SpriteCostumes** temp = realloc(
-            _costumes, _costumeCount * 2 * sizeof(CmdFX_SpriteCostumes)
-        );
-        if (!temp) return 0;
-        for (int i = _costumeCount; i < _costumeCount * 2; i++)
-            temp[i] = 0; // crealloc
-        _costumes = temp;
-        _costumeCount *= 2;
-    }
-
+    if (!_reserveCostumes(id)) return 0;
     if (_costumes[id] != 0) return _costumes[id];
 
     CmdFX_SpriteCostumes* spriteCostumes = malloc(sizeof(CmdFX_SpriteCostumes));
@@ -86,6 +264,10 @@ CmdFX_SpriteCostumes* Sprite_createCostumes(
         return 0;
     }
 
+    // no atlas here: the other slots are filled later with grids the caller
+    // hands over, so there is nothing to lay out yet; see
+    // Sprite_createCostumeAtlas for costumes known up front
+
     // adopt the live data/ansi as costume 0 so the original buffers survive
     // until the sprite and its costumes are freed; the sprite's live data
     // always aliases the active costume, and the registry is the sole owner
@@ -96,6 +278,85 @@ CmdFX_SpriteCostumes* Sprite_createCostumes(
     return spriteCostumes;
 }
 
+CmdFX_SpriteCostumes* Sprite_createCostumeAtlas(
+    CmdFX_Sprite* sprite, char*** frames, char**** ansiFrames, int frameCount
+) {
+    if (frameCount < 0 || frameCount >= MAX_SPRITE_COSTUMES) return 0;
+    if (frameCount > 0 && frames == 0) return 0;
+    if (sprite == 0) return 0;
+    if (sprite->data == 0) return 0;
+
+    int id = sprite->uid - 1;
+    if (!_reserveCostumes(id)) return 0;
+    if (_costumes[id] != 0) return 0;
+
+    int count = frameCount + 1;
+    char** sources[MAX_SPRITE_COSTUMES];
+    char*** ansiSources[MAX_SPRITE_COSTUMES];
+
+    sources[0] = sprite->data;
+    ansiSources[0] = sprite->ansi;
+    for (int i = 0; i < frameCount; i++) {
+        if (frames[i] == 0) return 0;
+        sources[i + 1] = frames[i];
+        ansiSources[i + 1] = ansiFrames == 0 ? 0 : ansiFrames[i];
+    }
+
+    CmdFX_SpriteCostumes* spriteCostumes = malloc(sizeof(CmdFX_SpriteCostumes));
+    if (!spriteCostumes) return 0;
+
+    spriteCostumes->costumeCount = count;
+    spriteCostumes->costumes = (char***) calloc(count + 1, sizeof(char**));
+    spriteCostumes->ansiCostumes =
+        (char****) calloc(count + 1, sizeof(char***));
+
+    _CostumeAtlas* atlas = _createAtlas(sources, ansiSources, count);
+    if (!spriteCostumes->costumes || !spriteCostumes->ansiCostumes ||
+        !atlas) {
+        free(spriteCostumes->costumes);
+        free(spriteCostumes->ansiCostumes);
+        free(spriteCostumes);
+        free(atlas);
+        return 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        spriteCostumes->costumes[i] = atlas->frames[i];
+        spriteCostumes->ansiCostumes[i] = atlas->ansiFrames[i];
+    }
+
+    // the sprite now shows costume 0 from the atlas; its old grids are
+    // dropped, or released if they were borrowed
+    char** data = sprite->data;
+    char*** ansi = sprite->ansi;
+    int width = sprite->width;
+    int height = sprite->height;
+    int borrowed = _Sprite_getShared(sprite) != 0;
+
+    sprite->data = atlas->frames[0];
+    sprite->ansi = atlas->ansiFrames[0];
+    if (!_Sprite_setShared(sprite, &atlas->shared)) {
+        sprite->data = data;
+        sprite->ansi = ansi;
+        free(spriteCostumes->costumes);
+        free(spriteCostumes->ansiCostumes);
+        free(spriteCostumes);
+        free(atlas);
+        return 0;
+    }
+    if (!borrowed) {
+        _freeCostume(0, data, 0);
+        if (ansi != 0) _freeANSI(ansi, width, height);
+    }
+
+    sprite->width = atlas->widths[0];
+    sprite->height = atlas->heights[0];
+
+    _costumes[id] = spriteCostumes;
+    _atlases[id] = atlas;
+    return spriteCostumes;
+}
+
 CmdFX_SpriteCostumes* Sprite_getCostumes(CmdFX_Sprite* sprite) {
     if (sprite == 0) return 0;
     if (sprite->data == 0) return 0;
@@ -116,32 +377,27 @@ int Sprite_setCostumeAt(
     if (spriteCostumes == 0) return -1;
     if (index < 0 || spriteCostumes->costumeCount < index) return -2;
 
+    // a sprite showing this costume from the atlas takes its own copy first,
+    // so replacing the slot never leaves it half borrowed
+    if (spriteCostumes->costumes[index] == sprite->data &&
+        !_Sprite_ownData(sprite))
+        return -1;
+
+    _CostumeAtlas* atlas = _atlases[sprite->uid - 1];
+
     char** oldData = spriteCostumes->costumes[index];
     // if the sprite is currently showing this costume, its live data aliases
     // the buffer being freed; re-point it to the new costume so it never
     // dangles (only a real buffer aliases; two null slots are not "active")
     int dataWasActive = oldData != 0 && oldData == sprite->data;
-    if (oldData != 0) {
-        int height = getCharArrayHeight(oldData);
-        for (int i = 0; i < height; i++) free(oldData[i]);
-        free(oldData);
-    }
+    _freeCostume(atlas, oldData, 0);
     spriteCostumes->costumes[index] = costume;
     if (dataWasActive) sprite->data = costume;
 
     if (ansiCostume != 0) {
         char*** oldAnsi = spriteCostumes->ansiCostumes[index];
         int ansiWasActive = oldAnsi != 0 && oldAnsi == sprite->ansi;
-        if (oldAnsi != 0) {
-            int height = getStringArrayHeight(oldAnsi);
-            int width = getStringArrayWidth(oldAnsi);
-
-            for (int i = 0; i < height; i++) {
-                for (int j = 0; j < width; j++) free(oldAnsi[i][j]);
-                free(oldAnsi[i]);
-            }
-            free(oldAnsi);
-        }
+        _freeCostume(atlas, 0, oldAnsi);
         spriteCostumes->ansiCostumes[index] = ansiCostume;
         if (ansiWasActive) sprite->ansi = ansiCostume;
     }
@@ -193,9 +449,26 @@ int Sprite_switchCostumeTo(CmdFX_Sprite* sprite, int costumeIndex) {
     if (spriteCostumes->costumes == 0) return -1;
     if (spriteCostumes->costumes[costumeIndex] == 0) return -1;
 
+    char** data = spriteCostumes->costumes[costumeIndex];
+    _CostumeAtlas* atlas = _atlases[sprite->uid - 1];
+    CmdFX_SharedData* shared = _Sprite_getShared(sprite);
+
+    // atlas frames are borrowed; the sprite already holds its reference
+    // when it switches between them
+    int frame = _atlasFrame(atlas, data, costumeIndex);
+    if (frame >= 0) {
+        if (shared != &atlas->shared &&
+            !_Sprite_setShared(sprite, &atlas->shared))
+            return -1;
+
+        sprite->width = atlas->widths[frame];
+        sprite->height = atlas->heights[frame];
+    } else if (shared != 0 && !_Sprite_setShared(sprite, 0))
+        return -1;
+
     // the live buffers alias the active costume; the previous costume is still
     // owned by the registry, so switching only re-points the aliases
-    sprite->data = spriteCostumes->costumes[costumeIndex];
+    sprite->data = data;
     sprite->ansi = spriteCostumes->ansiCostumes[costumeIndex];
 
     return 0;
@@ -259,33 +532,10 @@ int Sprite_removeCostume(CmdFX_Sprite* sprite, int costumeIndex) {
     if (costumeIndex < 0 || costumeIndex >= spriteCostumes->costumeCount)
         return -1;
 
-    if (spriteCostumes->costumes[costumeIndex] != 0) {
-        for (int j = 0;
-             j < getCharArrayHeight(spriteCostumes->costumes[costumeIndex]);
-             j++)
-            free(spriteCostumes->costumes[costumeIndex][j]);
-
-        free(spriteCostumes->costumes[costumeIndex]);
-    }
-    free(spriteCostumes->costumes[costumeIndex]);
-
-    if (spriteCostumes->ansiCostumes[costumeIndex] != 0) {
-        for (int j = 0;
-             j <
-             getStringArrayHeight(spriteCostumes->ansiCostumes[costumeIndex]);
-             j++) {
-            for (int i = 0; i < getStringArrayWidth(
-                                    spriteCostumes->ansiCostumes[costumeIndex]
-                                );
-                 i++)
-                free(spriteCostumes->ansiCostumes[costumeIndex][j][i]);
-
-            free(spriteCostumes->ansiCostumes[costumeIndex][j]);
-        }
-
-        free(spriteCostumes->ansiCostumes[costumeIndex]);
-    }
-    free(spriteCostumes->ansiCostumes[costumeIndex]);
+    _freeCostume(
+        _atlases[sprite->uid - 1], spriteCostumes->costumes[costumeIndex],
+        spriteCostumes->ansiCostumes[costumeIndex]
+    );
 
     for (int i = costumeIndex; i < spriteCostumes->costumeCount - 1; i++) {
         spriteCostumes->costumes[i] = spriteCostumes->costumes[i + 1];
@@ -314,31 +564,11 @@ int Sprite_resetCostumes(CmdFX_Sprite* sprite) {
     if (spriteCostumes->costumes[0] == 0) return -1;
     if (spriteCostumes->ansiCostumes[0] == 0) return -1;
 
-    for (int i = 1; i < spriteCostumes->costumeCount; i++) {
-        if (spriteCostumes->costumes[i] != 0) {
-            for (int j = 0; j < getCharArrayHeight(spriteCostumes->costumes[i]);
-                 j++)
-                free(spriteCostumes->costumes[i][j]);
-
-            free(spriteCostumes->costumes[i]);
-        }
-        free(spriteCostumes->costumes[i]);
-
-        if (spriteCostumes->ansiCostumes[i] != 0) {
-            for (int j = 0;
-                 j < getStringArrayHeight(spriteCostumes->ansiCostumes[i]);
-                 j++) {
-                for (int k = 0;
-                     k < getStringArrayWidth(spriteCostumes->ansiCostumes[i]);
-                     k++)
-                    free(spriteCostumes->ansiCostumes[i][j][k]);
-
-                free(spriteCostumes->ansiCostumes[i][j]);
-            }
-            free(spriteCostumes->ansiCostumes[i]);
-        }
-        free(spriteCostumes->ansiCostumes[i]);
-    }
+    _CostumeAtlas* atlas = _atlases[sprite->uid - 1];
+    for (int i = 1; i < spriteCostumes->costumeCount; i++)
+        _freeCostume(
+            atlas, spriteCostumes->costumes[i], spriteCostumes->ansiCostumes[i]
+        );
 
     spriteCostumes->costumeCount = 1;
     return 0;
@@ -358,35 +588,27 @@ int Sprite_freeCostumes(CmdFX_Sprite* sprite) {
 
     // the sprite's live data/ansi alias the active costume buffer, which is
     // about to be freed; copy them out first so the sprite stays usable after
-    // the registry is torn down
-    char** liveData = createCharArrayCopy(sprite->data);
-    char*** liveAnsi = _copyAnsiArray(sprite->ansi);
-
-    for (int i = 0; i < spriteCostumes->costumeCount; i++) {
-        char** data = spriteCostumes->costumes[i];
-        if (data != 0) {
-            int height = getCharArrayHeight(data);
-            for (int j = 0; j < height; j++) free(data[j]);
-            free(data);
-        }
-
-        char*** ansi = spriteCostumes->ansiCostumes[i];
-        if (ansi != 0) {
-            int height = getStringArrayHeight(ansi);
-            int width = getStringArrayWidth(ansi);
-            for (int j = 0; j < height; j++) {
-                for (int k = 0; k < width; k++) free(ansi[j][k]);
-                free(ansi[j]);
-            }
-            free(ansi);
-        }
+    // the registry is torn down (a sprite showing an atlas frame keeps
+    // borrowing it, and its reference keeps the atlas alive)
+    char** liveData = sprite->data;
+    char*** liveAnsi = sprite->ansi;
+    if (_Sprite_getShared(sprite) == 0) {
+        liveData = createCharArrayCopy(sprite->data);
+        liveAnsi = _copyAnsiArray(sprite->ansi);
     }
 
+    _CostumeAtlas* atlas = _atlases[sprite->uid - 1];
+    for (int i = 0; i < spriteCostumes->costumeCount; i++)
+        _freeCostume(
+            atlas, spriteCostumes->costumes[i], spriteCostumes->ansiCostumes[i]
+        );
+
     free(spriteCostumes->costumes);
     free(spriteCostumes->ansiCostumes);
     free(spriteCostumes);
 
     _costumes[sprite->uid - 1] = 0;
+    _releaseAtlas(sprite->uid - 1);
 
     sprite->data = liveData;
     sprite->ansi = liveAnsi;
@@ -405,6 +627,11 @@ int Sprite_getCurrentCostumeIndex(CmdFX_Sprite* sprite) {
     if (spriteCostumes->costumes == 0) return -1;
     if (spriteCostumes->ansiCostumes == 0) return -1;
 
+    // the live data aliases the active costume, so look for the buffer
+    // before comparing contents
+    for (int i = 0; i < spriteCostumes->costumeCount; i++)
+        if (spriteCostumes->costumes[i] == sprite->data) return i;
+
     for (int i = 0; i < spriteCostumes->costumeCount; i++) {
         char** data = spriteCostumes->costumes[i];
         if (compareCharArrays(data, sprite->data) != 0) continue;
@@ -429,10 +656,13 @@ int Sprite_resetAllCostumes() {
 
         free(_costumes[sprite->uid - 1]);
         _costumes[sprite->uid - 1] = 0;
+        _releaseAtlas(sprite->uid - 1);
     }
 
     free(_costumes);
     _costumes = 0;
+    free(_atlases);
+    _atlases = 0;
     _costumeCount = 0;
 
     return 0;
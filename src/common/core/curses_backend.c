@@ -1,3 +1,4 @@
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
@@ -5,6 +6,8 @@
 #include <curses.h>
 
 #include "common/core/curses_backend.h"
+#include "common/core/stats.h"
+#include "common/core/trace.h"
 
 // some attributes are missing on certain curses builds (notably PDCurses); fall
 // back to A_NORMAL (a no-op) so the SGR mapping still compiles everywhere
@@ -29,11 +32,26 @@ static int _echo = 1;
 static int _lineBuffered = 1;
 static int _hasColor = 0;
 
+#ifndef PDCURSES
+// the screen opened by CmdFX_curses_openOffscreen, if any
+static SCREEN* _offscreen = NULL;
+static FILE* _offscreenOut = NULL;
+static FILE* _offscreenIn = NULL;
+#endif
+
 // current drawing attributes; colors are curses color indices (-1 = default)
 static attr_t _curAttr = A_NORMAL;
 static int _curFg = -1;
 static int _curBg = -1;
 
+// whether cells can be read back whole, with wide characters and extended
+// color pairs, or only as chtype
+#if (defined(NCURSES_WIDECHAR) && NCURSES_WIDECHAR) || defined(PDC_WIDE)
+    #define _WIDE_CELLS 1
+#else
+    #define _WIDE_CELLS 0
+#endif
+
 // color pair cache (pair 0 is reserved by curses for the default)
 #define _MAX_PAIRS 256
 static short _pairFg[_MAX_PAIRS];
@@ -76,21 +94,8 @@ static void _applyCurrent() {
     attr_set(_curAttr, pair, NULL);
 }
 
-int CmdFX_curses_ensure() {
-    if (_initialized) return !_headless;
-    _initialized = 1;
-
-    // no tty means no curses; run headless so tests and pipes still work
-    if (!isatty(STDOUT_FILENO) || !isatty(STDIN_FILENO)) {
-        _headless = 1;
-        return 0;
-    }
-
-    if (initscr() == NULL) {
-        _headless = 1;
-        return 0;
-    }
-
+// configures a freshly started screen
+static void _setupScreen() {
     cbreak();
     noecho();
     keypad(stdscr, TRUE);
@@ -111,12 +116,71 @@ int CmdFX_curses_ensure() {
     atexit(CmdFX_curses_shutdown);
 
     refresh();
+}
+
+int CmdFX_curses_ensure() {
+    if (_initialized) return !_headless;
+    _initialized = 1;
+
+    // no tty means no curses; run headless so tests and pipes still work
+    if (!isatty(STDOUT_FILENO) || !isatty(STDIN_FILENO)) {
+        _headless = 1;
+        return 0;
+    }
+
+    if (initscr() == NULL) {
+        _headless = 1;
+        return 0;
+    }
+
+    _setupScreen();
     return 1;
 }
 
+int CmdFX_curses_openOffscreen(int width, int height) {
+#ifdef PDCURSES
+    (void) width;
+    (void) height;
+    return 0;
+#else
+    if (_initialized) return 0;
+    if (width < 1 || height < 1) return 0;
+
+    _offscreenOut = fopen("/dev/null", "w");
+    _offscreenIn = fopen("/dev/null", "r");
+    if (_offscreenOut != NULL && _offscreenIn != NULL)
+        _offscreen = newterm("xterm-256color", _offscreenOut, _offscreenIn);
+
+    if (_offscreen == NULL) {
+        if (_offscreenOut != NULL) fclose(_offscreenOut);
+        if (_offscreenIn != NULL) fclose(_offscreenIn);
+        _offscreenOut = NULL;
+        _offscreenIn = NULL;
+        return 0;
+    }
+
+    set_term(_offscreen);
+    resizeterm(height, width);
+    _initialized = 1;
+    _setupScreen();
+    return 1;
+#endif
+}
+
 void CmdFX_curses_shutdown() {
     if (_initialized && !_headless) endwin();
 
+#ifndef PDCURSES
+    if (_offscreen != NULL) {
+        delscreen(_offscreen);
+        fclose(_offscreenOut);
+        fclose(_offscreenIn);
+        _offscreen = NULL;
+        _offscreenOut = NULL;
+        _offscreenIn = NULL;
+    }
+#endif
+
     _initialized = 0;
     _headless = 0;
     _hasColor = 0;
@@ -292,7 +356,181 @@ void CmdFX_curses_clear() {
 
 void CmdFX_curses_refresh() {
     if (!CmdFX_curses_ensure()) return;
+
+    unsigned long long start = CmdFX_stats_begin();
+    unsigned long long span = CmdFX_trace_begin();
     refresh();
+    CmdFX_trace_end("refresh", "curses", span);
+    CmdFX_stats_end(CMDFX_FRAME_STAGE_FLUSH, start);
+}
+
+int CmdFX_curses_shiftRegion(
+    int x, int y, int width, int height, int dx, int dy
+) {
+    if (!CmdFX_curses_ensure()) return 0;
+    if (width < 1 || height < 1) return 0;
+    if (dx <= -width || dx >= width || dy <= -height || dy >= height) return 0;
+
+    int rows, cols;
+    getmaxyx(stdscr, rows, cols);
+    if (x < 1 || y < 1) return 0;
+    if (x - 1 + width > cols || y - 1 + height > rows) return 0;
+
+    if (dx == 0) {
+        // whole lines; idlok lets curses emit a terminal scroll region
+        WINDOW* region = derwin(stdscr, height, width, y - 1, x - 1);
+        if (region == NULL) return 0;
+
+        idlok(region, TRUE);
+        scrollok(region, TRUE);
+        wscrl(region, -dy);
+        wsyncup(region);
+        delwin(region);
+        return 1;
+    }
+
+    // terminals can't scroll sideways; move the cells in the curses buffer
+    int count = width - abs(dx);
+#if _WIDE_CELLS
+    cchar_t* cells = (cchar_t*) malloc(sizeof(cchar_t) * (count + 1));
+#else
+    // a chtype only has room for the pairs in A_COLOR; past those, a copy
+    // would lose colors, so have the caller redraw instead
+    if (_pairCount > PAIR_NUMBER(A_COLOR)) return 0;
+
+    chtype* cells = (chtype*) malloc(sizeof(chtype) * (count + 1));
+#endif
+    if (cells == 0) return 0;
+
+    int srcX = x - 1 + (dx < 0 ? -dx : 0);
+    int lines = height - abs(dy);
+    for (int k = 0; k < lines; k++) {
+        // copy in the direction of the shift so sources aren't overwritten
+        int i = dy > 0 ? lines - 1 - k : k;
+        int srcY = y - 1 + i + (dy < 0 ? -dy : 0);
+
+#if _WIDE_CELLS
+        mvin_wchnstr(srcY, srcX, cells, count);
+        mvadd_wchnstr(srcY + dy, srcX + dx, cells, count);
+#else
+        mvinchnstr(srcY, srcX, cells, count);
+        mvaddchnstr(srcY + dy, srcX + dx, cells, count);
+#endif
+    }
+
+    free(cells);
+    return 1;
+}
+
+// Surfaces
+
+struct CmdFX_CursesSurface {
+    WINDOW* pad;
+    int width;
+    int height;
+};
+
+CmdFX_CursesSurface* CmdFX_curses_createSurface(int width, int height) {
+    if (!CmdFX_curses_ensure()) return 0;
+    if (width < 1 || height < 1) return 0;
+
+    CmdFX_CursesSurface* surface =
+        (CmdFX_CursesSurface*) malloc(sizeof(CmdFX_CursesSurface));
+    if (surface == 0) return 0;
+
+    surface->pad = newpad(height, width);
+    if (surface->pad == NULL) {
+        free(surface);
+        return 0;
+    }
+
+    surface->width = width;
+    surface->height = height;
+    return surface;
+}
+
+void CmdFX_curses_freeSurface(CmdFX_CursesSurface* surface) {
+    if (surface == 0) return;
+
+    delwin(surface->pad);
+    free(surface);
+}
+
+void CmdFX_curses_putSurfaceChar(
+    CmdFX_CursesSurface* surface, int x, int y, char c, const char* sgr
+) {
+    if (surface == 0) return;
+    if (x < 0 || y < 0 || x >= surface->width || y >= surface->height) return;
+
+    if (sgr != 0) CmdFX_curses_applySgr(sgr);
+
+    short pair = _resolvePair(_curFg, _curBg);
+    wattr_set(surface->pad, _curAttr, pair, NULL);
+    // the bottom-right cell reports ERR since the cursor can't advance, but
+    // the character is still written
+    mvwaddch(surface->pad, y, x, (chtype) (unsigned char) c);
+
+    if (sgr != 0) CmdFX_curses_resetAttributes();
+}
+
+int CmdFX_curses_blitSurface(
+    CmdFX_CursesSurface* surface, int sx, int sy, int x, int y, int width,
+    int height, int overlay
+) {
+    if (surface == 0) return 0;
+    if (!CmdFX_curses_ensure()) return 0;
+
+    // clip to the surface
+    if (sx < 0) {
+        width += sx;
+        x -= sx;
+        sx = 0;
+    }
+    if (sy < 0) {
+        height += sy;
+        y -= sy;
+        sy = 0;
+    }
+    if (sx + width > surface->width) width = surface->width - sx;
+    if (sy + height > surface->height) height = surface->height - sy;
+
+    // clip to the screen
+    int rows, cols;
+    getmaxyx(stdscr, rows, cols);
+    if (x < 1) {
+        width -= 1 - x;
+        sx += 1 - x;
+        x = 1;
+    }
+    if (y < 1) {
+        height -= 1 - y;
+        sy += 1 - y;
+        y = 1;
+    }
+    if (x - 1 + width > cols) width = cols - (x - 1);
+    if (y - 1 + height > rows) height = rows - (y - 1);
+
+    if (width < 1 || height < 1) return 0;
+
+    return copywin(
+               surface->pad, stdscr, sy, sx, y - 1, x - 1, y - 2 + height,
+               x - 2 + width, overlay ? TRUE : FALSE
+           ) == OK;
+}
+
+char CmdFX_curses_getCharAt(int x, int y) {
+    if (!CmdFX_curses_ensure()) return 0;
+
+    int rows, cols;
+    getmaxyx(stdscr, rows, cols);
+    if (x < 1 || y < 1 || x > cols || y > rows) return 0;
+
+    int cy, cx;
+    getyx(stdscr, cy, cx);
+    chtype cell = mvinch(y - 1, x - 1);
+    move(cy, cx);
+
+    return (char) (cell & A_CHARTEXT);
 }
 
 void CmdFX_curses_setEcho(int enabled) {
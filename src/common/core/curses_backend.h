@@ -49,6 +49,17 @@ typedef struct CmdFX_CursesEvent {
  */
 int CmdFX_curses_ensure();
 
+/**
+ * @brief Starts curses on a screen of a fixed size that is never shown.
+ *
+ * Output goes to the null device, so drawing does all of its usual work
+ * without a terminal attached. Used by the benchmarks; call it before
+ * anything else touches the backend. Not supported with PDCurses.
+ *
+ * @return 1 if the screen was opened, 0 otherwise (the backend is unchanged).
+ */
+int CmdFX_curses_openOffscreen(int width, int height);
+
 /** @brief Tears the backend down (endwin) if it was initialized. */
 void CmdFX_curses_shutdown();
 
@@ -79,6 +90,63 @@ void CmdFX_curses_resetAttributes();
 void CmdFX_curses_clear();
 void CmdFX_curses_refresh();
 
+/**
+ * @brief Shifts the content of a screen region by (dx, dy) cells.
+ *
+ * Vertical shifts use the curses scroll region, which curses sends to the
+ * terminal as a hardware scroll (DECSTBM) where possible. Horizontal shifts
+ * move the cells in the curses buffer, so only changed cells are written out.
+ * Cells vacated by the shift keep stale content and should be redrawn.
+ *
+ * @return 1 if the region was shifted, 0 if headless, the region does not
+ * fit on screen or its colors can't be copied (redraw it instead).
+ */
+int CmdFX_curses_shiftRegion(
+    int x, int y, int width, int height, int dx, int dy
+);
+
+// Surfaces
+
+/**
+ * An off-screen character surface (a curses pad). Content is rendered into it
+ * once and copied onto the screen a region at a time.
+ */
+typedef struct CmdFX_CursesSurface CmdFX_CursesSurface;
+
+/** @return A new blank surface, or NULL if headless or out of memory. */
+CmdFX_CursesSurface* CmdFX_curses_createSurface(int width, int height);
+void CmdFX_curses_freeSurface(CmdFX_CursesSurface* surface);
+
+/**
+ * @brief Writes a character to a surface (coordinates are 0-based).
+ *
+ * The character takes the current attribute state, with the SGR sequence
+ * applied on top when it is not NULL.
+ */
+void CmdFX_curses_putSurfaceChar(
+    CmdFX_CursesSurface* surface, int x, int y, char c, const char* sgr
+);
+
+/**
+ * @brief Copies a region of a surface onto the screen.
+ *
+ * The region starts at (sx, sy) in the surface (0-based) and lands at (x, y)
+ * on the screen (1-based). It is clipped to the screen. With `overlay`, blank
+ * cells are skipped and leave the screen underneath as it was.
+ *
+ * @return 1 if the copy was made, 0 if headless or nothing was copied.
+ */
+int CmdFX_curses_blitSurface(
+    CmdFX_CursesSurface* surface, int sx, int sy, int x, int y, int width,
+    int height, int overlay
+);
+
+/**
+ * @return The character at (x, y) on the screen (1-based), or 0 if headless
+ * or off screen.
+ */
+char CmdFX_curses_getCharAt(int x, int y);
+
 // Terminal modes
 
 void CmdFX_curses_setEcho(int enabled);
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 
 #include "cmdfx/core/events.h"
+#include "common/core/trace.h"
 
 #define MAX_LISTENERS 1024
 
@@ -29,11 +30,14 @@ void shutdownCmdFXEvents() {
         CmdFX_EventCallback** list = _listeners[i];
         if (list == 0) continue;
 
+        for (unsigned int j = 0; j < _listenerSizes[i]; j++) free(list[j]);
         free(list);
     }
 
     free(_listeners);
+    free(_listenerSizes);
     _listeners = 0;
+    _listenerSizes = 0;
 }
 
 int addCmdFXEventListener(unsigned int id, CmdFX_EventCallback callback) {
@@ -94,6 +98,7 @@ int removeCmdFXEventListener(unsigned int eventId, unsigned int listenerId) {
     unsigned int size = _listenerSizes[eventId];
     if (list == 0 || listenerId >= size || list[listenerId] == 0) return 0;
 
+    free(list[listenerId]);
     list[listenerId] = 0;
 
     unsigned int nonNullCount = 0;
@@ -124,6 +129,7 @@ int removeCmdFXEventListener(unsigned int eventId, unsigned int listenerId) {
 
 const CmdFX_EventCallback** dispatchCmdFXEvent(CmdFX_Event* event) {
     if (!event || event->id >= MAX_LISTENERS) return 0;
+    if (_listeners == 0) return 0;
 
     CmdFX_EventCallback** list = _listeners[event->id];
     unsigned int size = _listenerSizes[event->id];
@@ -136,13 +142,19 @@ const CmdFX_EventCallback** dispatchCmdFXEvent(CmdFX_Event* event) {
 
     unsigned int count = 0;
 
+    unsigned long long span = CmdFX_trace_begin();
     for (unsigned int i = 0; i < size; i++) {
         if (list[i] != 0) {
             CmdFX_EventCallback callback = *list[i];
+            unsigned long long listenerSpan = CmdFX_trace_begin();
             int result = callback(event);
+            CmdFX_trace_endArg(
+                "listener", "events", listenerSpan, "event", event->id
+            );
             if (result == 0) called[count++] = list[i];
         }
     }
+    CmdFX_trace_endArg("dispatch", "events", span, "event", event->id);
 
     if (count == 0) {
         free(called);
@@ -0,0 +1,381 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include "cmdfx/core/costumes.h"
+#include "cmdfx/core/sprites.h"
+#include "cmdfx/core/util.h"
+#include "common/core/shared.h"
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+// declared in src/common/core/builder.c
+extern int* _rotationMap(int width, int height, double radians);
+
+// declared in src/common/core/sprites.c
+extern void Sprite_draw0(CmdFX_Sprite* sprite);
+extern void Sprite_remove0(CmdFX_Sprite* sprite);
+extern void _freeANSI(char*** ansi, int width, int height);
+
+// one allocation holding the unrotated snapshot and a frame for every step;
+// frames are filled in on first use and borrowed by the sprite like any other
+// shared grid. Style cells point into the snapshot's string pool, which
+// starts with the empty style used for uncovered cells
+typedef struct _RotationCache {
+    CmdFX_SharedData shared;
+    int steps;
+    int width;
+    int height;
+    char*** frames;
+    char**** ansiFrames;
+    char** styles;
+    char* glyphs;
+    char* empty;
+    unsigned char* rotated;
+} _RotationCache;
+
+#define _ROTATION_CACHE_MUTEX 14
+#define _CANVAS_MUTEX 7
+
+// rotation caches of the sprites, indexed by uid - 1
+static _RotationCache** _rotationCaches = 0;
+static int _rotationCacheCount = 0;
+
+static void _destroyRotationCache(CmdFX_SharedData* shared) {
+    free((char*) shared - offsetof(_RotationCache, shared));
+}
+
+// the mutex must be held
+static _RotationCache* _getRotationCache(CmdFX_Sprite* sprite) {
+    if (sprite == 0 || sprite->uid < 1) return 0;
+    if (sprite->uid > _rotationCacheCount) return 0;
+
+    return _rotationCaches[sprite->uid - 1];
+}
+
+// looks up the sprite's cache and takes a reference, so it outlives the
+// lock; give it back with CmdFX_shared_release
+static _RotationCache* _retainRotationCache(CmdFX_Sprite* sprite) {
+    CmdFX_tryLockMutex(_ROTATION_CACHE_MUTEX);
+    _RotationCache* cache = _getRotationCache(sprite);
+    if (cache != 0) CmdFX_shared_retain(&cache->shared);
+    CmdFX_tryUnlockMutex(_ROTATION_CACHE_MUTEX);
+
+    return cache;
+}
+
+// the mutex must be held
+static int _setRotationCache(CmdFX_Sprite* sprite, _RotationCache* cache) {
+    int id = sprite->uid - 1;
+    if (id >= _rotationCacheCount) {
+        int count = _rotationCacheCount == 0 ? 16 : _rotationCacheCount;
+        while (count <= id) count *= 2;
+
+        _RotationCache** temp =
+            realloc(_rotationCaches, sizeof(_RotationCache*) * count);
+        if (temp == 0) return 0;
+
+        for (int i = _rotationCacheCount; i < count; i++) temp[i] = 0;
+        _rotationCaches = temp;
+        _rotationCacheCount = count;
+    }
+
+    _rotationCaches[id] = cache;
+    return 1;
+}
+
+static _RotationCache* _createRotationCache(
+    char** data, char*** ansi, int width, int height, int steps
+) {
+    int cells = width * height;
+    int rowCells = height * (width + 1);
+
+    size_t poolSize = 1;
+    for (int y = 0; ansi != 0 && y < height; y++)
+        for (int x = 0; x < width; x++)
+            if (ansi[y][x] != 0) poolSize += strlen(ansi[y][x]) + 1;
+
+    // pointer-sized tables first, then the byte-sized ones
+    size_t size = sizeof(_RotationCache);
+    size += sizeof(char**) * steps;
+    size += sizeof(char*) * steps * (height + 1);
+    if (ansi != 0) {
+        size += sizeof(char***) * steps;
+        size += sizeof(char**) * steps * (height + 1);
+        size += sizeof(char*) * steps * rowCells;
+        size += sizeof(char*) * cells;
+    }
+    size += steps;
+    size += (size_t) steps * rowCells;
+    size += cells;
+    size += poolSize;
+
+    char* block = calloc(1, size);
+    if (block == 0) return 0;
+
+    _RotationCache* cache = (_RotationCache*) block;
+    cache->shared.references = 1;
+    cache->shared.destroy = _destroyRotationCache;
+    cache->steps = steps;
+    cache->width = width;
+    cache->height = height;
+
+    char* next = block + sizeof(_RotationCache);
+    cache->frames = (char***) next;
+    next += sizeof(char**) * steps;
+
+    char** rows = (char**) next;
+    next += sizeof(char*) * steps * (height + 1);
+
+    char*** ansiRows = 0;
+    char** ansiCells = 0;
+    if (ansi != 0) {
+        cache->ansiFrames = (char****) next;
+        next += sizeof(char***) * steps;
+
+        ansiRows = (char***) next;
+        next += sizeof(char**) * steps * (height + 1);
+
+        ansiCells = (char**) next;
+        next += sizeof(char*) * steps * rowCells;
+
+        cache->styles = (char**) next;
+        next += sizeof(char*) * cells;
+    }
+
+    cache->rotated = (unsigned char*) next;
+    next += steps;
+
+    char* glyphCells = next;
+    next += (size_t) steps * rowCells;
+
+    cache->glyphs = next;
+    next += cells;
+
+    cache->empty = next;
+
+    // frames are terminated like any other grid
+    for (int f = 0; f < steps; f++) {
+        cache->frames[f] = rows + f * (height + 1);
+        if (ansi != 0) cache->ansiFrames[f] = ansiRows + f * (height + 1);
+
+        for (int y = 0; y < height; y++) {
+            int offset = (f * height + y) * (width + 1);
+            cache->frames[f][y] = glyphCells + offset;
+            if (ansi != 0) cache->ansiFrames[f][y] = ansiCells + offset;
+        }
+    }
+
+    // rows may end early
+    for (int y = 0; y < height; y++) {
+        char* flat = cache->glyphs + y * width;
+        int x = 0;
+        for (; x < width && data[y][x] != 0; x++) flat[x] = data[y][x];
+        for (; x < width; x++) flat[x] = ' ';
+    }
+
+    char* style = cache->empty + 1;
+    for (int y = 0; ansi != 0 && y < height; y++)
+        for (int x = 0; x < width; x++) {
+            char* cell = ansi[y][x];
+            if (cell == 0) continue;
+
+            strcpy(style, cell);
+            cache->styles[y * width + x] = style;
+            style += strlen(cell) + 1;
+        }
+
+    return cache;
+}
+
+// the mutex must be held
+static int _rotateFrame(_RotationCache* cache, int frame) {
+    if (cache->rotated[frame]) return 1;
+
+    int width = cache->width;
+    int height = cache->height;
+    int* map = _rotationMap(width, height, 2 * M_PI * frame / cache->steps);
+    if (map == 0) return 0;
+
+    // uncovered cells get an empty style, like Sprite_rotate
+    for (int y = 0; y < height; y++) {
+        const int* row = map + y * width;
+        char* out = cache->frames[frame][y];
+        for (int x = 0; x < width; x++)
+            out[x] = row[x] < 0 ? ' ' : cache->glyphs[row[x]];
+
+        if (cache->ansiFrames == 0) continue;
+
+        char** ansiOut = cache->ansiFrames[frame][y];
+        for (int x = 0; x < width; x++)
+            ansiOut[x] = row[x] < 0 ? cache->empty : cache->styles[row[x]];
+    }
+
+    free(map);
+    cache->rotated[frame] = 1;
+    return 1;
+}
+
+// frees live grids the sprite owns, unless a costume slot holds them
+static void _freeLiveGrids(CmdFX_Sprite* sprite, char** data, char*** ansi) {
+    CmdFX_SpriteCostumes* costumes = Sprite_getCostumes(sprite);
+    for (int i = 0; costumes != 0 && i < costumes->costumeCount; i++) {
+        if (costumes->costumes[i] == data) data = 0;
+        if (costumes->ansiCostumes[i] == ansi) ansi = 0;
+    }
+
+    // a style grid's width can't be measured, since NULL cells mean no style
+    if (data != 0) {
+        for (int i = 0; i < sprite->height; i++) free(data[i]);
+        free(data);
+    }
+
+    if (ansi != 0) _freeANSI(ansi, sprite->width, sprite->height);
+}
+
+// swaps the sprite's live grids to a cached frame; the mutex must be held
+static int _showFrame(
+    CmdFX_Sprite* sprite, _RotationCache* cache, int frame
+) {
+    if (!_rotateFrame(cache, frame)) return 0;
+
+    CmdFX_SharedData* shared = _Sprite_getShared(sprite);
+    if (shared != &cache->shared) {
+        if (!_Sprite_setShared(sprite, &cache->shared)) return 0;
+
+        // borrowed grids were released with their owner's reference
+        if (shared == 0) _freeLiveGrids(sprite, sprite->data, sprite->ansi);
+    }
+
+    sprite->data = cache->frames[frame];
+    sprite->ansi = cache->ansiFrames == 0 ? 0 : cache->ansiFrames[frame];
+    sprite->width = cache->width;
+    sprite->height = cache->height;
+
+    return 1;
+}
+
+// Rotation Cache
+
+int Sprite_createRotationCache(CmdFX_Sprite* sprite, int steps) {
+    if (sprite == 0) return -1;
+    if (sprite->data == 0) return -1;
+    if (sprite->width <= 0 || sprite->height <= 0) return -1;
+    if (steps < 1) return -1;
+
+    _RotationCache* cache = _createRotationCache(
+        sprite->data, sprite->ansi, sprite->width, sprite->height, steps
+    );
+    if (cache == 0) return -1;
+
+    if (sprite->id != 0) {
+        CmdFX_tryLockMutex(_CANVAS_MUTEX);
+        Sprite_remove0(sprite);
+    }
+
+    CmdFX_tryLockMutex(_ROTATION_CACHE_MUTEX);
+    _RotationCache* old = _getRotationCache(sprite);
+
+    // the unrotated frame is the snapshot itself
+    int r = _setRotationCache(sprite, cache) && _showFrame(sprite, cache, 0);
+    if (r && old != 0) CmdFX_shared_release(&old->shared);
+    if (!r) {
+        if (_getRotationCache(sprite) == cache) _setRotationCache(sprite, old);
+        CmdFX_shared_release(&cache->shared);
+    }
+    CmdFX_tryUnlockMutex(_ROTATION_CACHE_MUTEX);
+
+    if (sprite->id != 0) {
+        Sprite_draw0(sprite);
+        CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+    }
+
+    return r ? 0 : -1;
+}
+
+int Sprite_bakeRotationCache(CmdFX_Sprite* sprite) {
+    _RotationCache* cache = _retainRotationCache(sprite);
+    if (cache == 0) return -1;
+
+    // one frame per lock, so Sprite_setRotation isn't held up by the bake;
+    // a cache that was replaced or freed meanwhile is no longer baked
+    int count = 0;
+    for (int i = 0; i < cache->steps; i++) {
+        CmdFX_tryLockMutex(_ROTATION_CACHE_MUTEX);
+        int current = _getRotationCache(sprite) == cache;
+        if (current && !cache->rotated[i] && _rotateFrame(cache, i)) count++;
+        CmdFX_tryUnlockMutex(_ROTATION_CACHE_MUTEX);
+
+        if (!current) break;
+    }
+
+    CmdFX_shared_release(&cache->shared);
+    return count;
+}
+
+int Sprite_setRotation(CmdFX_Sprite* sprite, double radians) {
+    if (sprite == 0) return -1;
+
+    _RotationCache* cache = _retainRotationCache(sprite);
+    if (cache == 0) return -1;
+
+    // nearest step, with the angle wrapped to one turn
+    double turns = radians / (2 * M_PI);
+    turns -= floor(turns);
+    int frame = (int) lround(turns * cache->steps) % cache->steps;
+
+    if (sprite->id != 0) {
+        CmdFX_tryLockMutex(_CANVAS_MUTEX);
+        Sprite_remove0(sprite);
+    }
+
+    // the cache may have been replaced or freed since it was looked up
+    CmdFX_tryLockMutex(_ROTATION_CACHE_MUTEX);
+    int r = _getRotationCache(sprite) == cache &&
+            _showFrame(sprite, cache, frame);
+    CmdFX_tryUnlockMutex(_ROTATION_CACHE_MUTEX);
+
+    if (sprite->id != 0) {
+        Sprite_draw0(sprite);
+        CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+    }
+
+    CmdFX_shared_release(&cache->shared);
+    return r ? frame : -1;
+}
+
+int Sprite_getRotationSteps(CmdFX_Sprite* sprite) {
+    CmdFX_tryLockMutex(_ROTATION_CACHE_MUTEX);
+    _RotationCache* cache = _getRotationCache(sprite);
+    int steps = cache == 0 ? 0 : cache->steps;
+    CmdFX_tryUnlockMutex(_ROTATION_CACHE_MUTEX);
+
+    return steps;
+}
+
+int Sprite_freeRotationCache(CmdFX_Sprite* sprite) {
+    CmdFX_tryLockMutex(_ROTATION_CACHE_MUTEX);
+    _RotationCache* cache = _getRotationCache(sprite);
+    if (cache == 0) {
+        CmdFX_tryUnlockMutex(_ROTATION_CACHE_MUTEX);
+        return -1;
+    }
+
+    // a sprite showing a cached frame keeps a copy of it
+    if (_Sprite_getShared(sprite) == &cache->shared &&
+        !_Sprite_ownData(sprite)) {
+        CmdFX_tryUnlockMutex(_ROTATION_CACHE_MUTEX);
+        return -1;
+    }
+
+    _rotationCaches[sprite->uid - 1] = 0;
+    CmdFX_shared_release(&cache->shared);
+    CmdFX_tryUnlockMutex(_ROTATION_CACHE_MUTEX);
+
+    return 0;
+}
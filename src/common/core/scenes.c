@@ -5,10 +5,14 @@
 #include "cmdfx/core/builder.h"
 #include "cmdfx/core/canvas.h"
 #include "cmdfx/core/scenes.h"
+#include "cmdfx/core/sprites.h"
 #include "cmdfx/core/util.h"
 #include "cmdfx/ui/button.h"
 #include "cmdfx/ui/scenes.h"
 #include "common/core/curses_backend.h"
+#include "common/core/shared.h"
+#include "common/core/stats.h"
+#include "common/core/trace.h"
 
 #define _CANVAS_MUTEX 7
 CmdFX_Scene** _drawnScenes = 0;
@@ -23,6 +27,752 @@ int Canvas_getDrawnScenesCount() {
     return _drawnScenesCount;
 }
 
+// Occupancy
+
+// the top-most and bottom-most drawn scene for every cell covered by a drawn
+// scene, so z-order queries are a single lookup instead of a scan over every
+// drawn scene; footprints snapshot what the maps were built from, so scenes
+// changed behind our back (e.g. `scene->z` set directly) trigger a rebuild.
+// the maps are only read and written with _CANVAS_MUTEX held
+
+typedef struct {
+    CmdFX_Scene* scene;
+    int x;
+    int y;
+    int width;
+    int height;
+    int z;
+} _SceneFootprint;
+
+static _SceneFootprint* _footprints = 0; // parallel to _drawnScenes
+static int _footprintsCapacity = 0;
+static CmdFX_Scene** _topScenes = 0;
+static CmdFX_Scene** _bottomScenes = 0;
+static int* _topZ = 0; // the footprint z each map cell was set with
+static int* _bottomZ = 0;
+static int _occupancyWidth = 0;
+static int _occupancyHeight = 0;
+static int _occupancyStale = 1;
+
+static int _footprintMatches(_SceneFootprint* footprint, CmdFX_Scene* scene) {
+    return footprint->scene == scene && footprint->x == scene->x &&
+           footprint->y == scene->y && footprint->width == scene->width &&
+           footprint->height == scene->height && footprint->z == scene->z;
+}
+
+static void _setFootprint(_SceneFootprint* footprint, CmdFX_Scene* scene) {
+    footprint->scene = scene;
+    footprint->x = scene->x;
+    footprint->y = scene->y;
+    footprint->width = scene->width;
+    footprint->height = scene->height;
+    footprint->z = scene->z;
+}
+
+static int _reserveFootprints(int count) {
+    if (count <= _footprintsCapacity) return 1;
+
+    int capacity = _footprintsCapacity == 0 ? 8 : _footprintsCapacity * 2;
+    while (capacity < count) capacity *= 2;
+
+    _SceneFootprint* footprints = (_SceneFootprint*) realloc(
+        _footprints, sizeof(_SceneFootprint) * capacity
+    );
+    if (footprints == 0) return 0;
+
+    _footprints = footprints;
+    _footprintsCapacity = capacity;
+    return 1;
+}
+
+// applies a footprint to the cells of the maps inside the given rect; later
+// footprints only win on a strictly higher (or lower) z, like the draw order
+static void _occupy(
+    _SceneFootprint* footprint, int x1, int y1, int x2, int y2
+) {
+    x1 = x1 > footprint->x ? x1 : footprint->x;
+    y1 = y1 > footprint->y ? y1 : footprint->y;
+    x2 = clamp_i(x2, 0, footprint->x + footprint->width);
+    y2 = clamp_i(y2, 0, footprint->y + footprint->height);
+
+    for (int i = y1; i < y2; i++)
+        for (int j = x1; j < x2; j++) {
+            int index = i * _occupancyWidth + j;
+
+            if (_topScenes[index] == 0 || footprint->z > _topZ[index]) {
+                _topScenes[index] = footprint->scene;
+                _topZ[index] = footprint->z;
+            }
+
+            if (_bottomScenes[index] == 0 || footprint->z < _bottomZ[index]) {
+                _bottomScenes[index] = footprint->scene;
+                _bottomZ[index] = footprint->z;
+            }
+        }
+}
+
+static void _rebuildOccupancy() {
+    _occupancyStale = 1;
+    if (!_reserveFootprints(_drawnScenesCount)) return;
+
+    int width = 0;
+    int height = 0;
+    for (int i = 0; i < _drawnScenesCount; i++) {
+        CmdFX_Scene* scene = _drawnScenes[i];
+        if (scene->x + scene->width > width) width = scene->x + scene->width;
+        if (scene->y + scene->height > height)
+            height = scene->y + scene->height;
+    }
+
+    // only ever grows, so scenes drawn again in place don't reallocate
+    if (width > _occupancyWidth || height > _occupancyHeight) {
+        if (width < _occupancyWidth) width = _occupancyWidth;
+        if (height < _occupancyHeight) height = _occupancyHeight;
+
+        CmdFX_Scene** top =
+            (CmdFX_Scene**) calloc(width * height, sizeof(CmdFX_Scene*));
+        CmdFX_Scene** bottom =
+            (CmdFX_Scene**) calloc(width * height, sizeof(CmdFX_Scene*));
+        int* topZ = (int*) malloc(sizeof(int) * width * height);
+        int* bottomZ = (int*) malloc(sizeof(int) * width * height);
+        if (top == 0 || bottom == 0 || topZ == 0 || bottomZ == 0) {
+            free(top);
+            free(bottom);
+            free(topZ);
+            free(bottomZ);
+            return;
+        }
+
+        free(_topScenes);
+        free(_bottomScenes);
+        free(_topZ);
+        free(_bottomZ);
+        _topScenes = top;
+        _bottomScenes = bottom;
+        _topZ = topZ;
+        _bottomZ = bottomZ;
+        _occupancyWidth = width;
+        _occupancyHeight = height;
+    }
+    else if (_topScenes != 0) {
+        int size = _occupancyWidth * _occupancyHeight;
+        memset(_topScenes, 0, sizeof(CmdFX_Scene*) * size);
+        memset(_bottomScenes, 0, sizeof(CmdFX_Scene*) * size);
+    }
+
+    for (int i = 0; i < _drawnScenesCount; i++) {
+        _setFootprint(&_footprints[i], _drawnScenes[i]);
+        _occupy(&_footprints[i], 0, 0, _occupancyWidth, _occupancyHeight);
+    }
+
+    _occupancyStale = 0;
+}
+
+// brings the maps up to date with the drawn scenes
+static void _syncOccupancy() {
+    if (!_occupancyStale)
+        for (int i = 0; i < _drawnScenesCount; i++)
+            if (!_footprintMatches(&_footprints[i], _drawnScenes[i])) {
+                _occupancyStale = 1;
+                break;
+            }
+
+    if (_occupancyStale) _rebuildOccupancy();
+}
+
+// called after a scene was appended to the drawn scenes
+static void _addOccupancy(CmdFX_Scene* scene) {
+    if (_occupancyStale) return;
+
+    if (scene->x + scene->width > _occupancyWidth ||
+        scene->y + scene->height > _occupancyHeight ||
+        !_reserveFootprints(_drawnScenesCount)) {
+        _occupancyStale = 1;
+        return;
+    }
+
+    _SceneFootprint* footprint = &_footprints[_drawnScenesCount - 1];
+    _setFootprint(footprint, scene);
+    _occupy(footprint, 0, 0, _occupancyWidth, _occupancyHeight);
+}
+
+// called before the drawn scene at the index is removed; the cells it
+// covered are recomputed from the remaining footprints
+static void _removeOccupancy(int index) {
+    if (_occupancyStale) return;
+    if (_footprints[index].scene != _drawnScenes[index]) {
+        _occupancyStale = 1;
+        return;
+    }
+
+    _SceneFootprint removed = _footprints[index];
+    for (int i = index; i < _drawnScenesCount - 1; i++)
+        _footprints[i] = _footprints[i + 1];
+
+    int x1 = removed.x;
+    int y1 = removed.y;
+    int x2 = removed.x + removed.width;
+    int y2 = removed.y + removed.height;
+
+    for (int i = y1; i < y2; i++)
+        for (int j = x1; j < x2; j++) {
+            _topScenes[i * _occupancyWidth + j] = 0;
+            _bottomScenes[i * _occupancyWidth + j] = 0;
+        }
+
+    for (int i = 0; i < _drawnScenesCount - 1; i++) {
+        _SceneFootprint* footprint = &_footprints[i];
+        if (footprint->x >= x2 || footprint->x + footprint->width <= x1)
+            continue;
+        if (footprint->y >= y2 || footprint->y + footprint->height <= y1)
+            continue;
+
+        _occupy(footprint, x1, y1, x2, y2);
+    }
+}
+
+// the maps must be in sync
+static CmdFX_Scene* _topSceneAt(int x, int y) {
+    if (x < 0 || y < 0) return 0;
+    if (x >= _occupancyWidth || y >= _occupancyHeight) return 0;
+
+    return _topScenes[y * _occupancyWidth + x];
+}
+
+static CmdFX_Scene* _bottomSceneAt(int x, int y) {
+    if (x < 0 || y < 0) return 0;
+    if (x >= _occupancyWidth || y >= _occupancyHeight) return 0;
+
+    return _bottomScenes[y * _occupancyWidth + x];
+}
+
+// Backing
+
+// backed scenes are rendered once into an off-screen surface and copied onto
+// the screen, so drawing and panning cost a copy of the visible region
+// instead of a cell-by-cell walk through `data` and `ansiData`
+
+typedef struct {
+    CmdFX_CursesSurface* surface;
+    int width;
+    int height;
+    int stale;
+    int rect[4]; // stale region: x1, y1, x2, y2 (exclusive)
+} _SceneBacking;
+
+static _SceneBacking** _sceneBackings = 0;
+
+static _SceneBacking* _getBacking(CmdFX_Scene* scene) {
+    if (_sceneBackings == 0) return 0;
+    if (scene->uid < 0 || scene->uid >= MAX_REGISTERED_SCENES) return 0;
+
+    return _sceneBackings[scene->uid];
+}
+
+static void _freeBacking(int uid) {
+    if (uid < 0 || uid >= MAX_REGISTERED_SCENES) return;
+    if (_sceneBackings == 0 || _sceneBackings[uid] == 0) return;
+
+    CmdFX_curses_freeSurface(_sceneBackings[uid]->surface);
+    free(_sceneBackings[uid]);
+    _sceneBackings[uid] = 0;
+}
+
+// called after scene data changed
+static void _invalidateBacking(
+    CmdFX_Scene* scene, int x1, int y1, int x2, int y2
+) {
+    _SceneBacking* backing = _getBacking(scene);
+    if (backing == 0) return;
+
+    if (!backing->stale) {
+        backing->stale = 1;
+        backing->rect[0] = x1;
+        backing->rect[1] = y1;
+        backing->rect[2] = x2;
+        backing->rect[3] = y2;
+        return;
+    }
+
+    int* rect = backing->rect;
+    if (x1 < rect[0]) rect[0] = x1;
+    if (y1 < rect[1]) rect[1] = y1;
+    if (x2 > rect[2]) rect[2] = x2;
+    if (y2 > rect[3]) rect[3] = y2;
+}
+
+// brings the surface up to date with the scene data
+static int _renderBacking(CmdFX_Scene* scene, _SceneBacking* backing) {
+    if (backing->surface == 0 || backing->width != scene->width ||
+        backing->height != scene->height) {
+        CmdFX_curses_freeSurface(backing->surface);
+        backing->surface =
+            CmdFX_curses_createSurface(scene->width, scene->height);
+        if (backing->surface == 0) return 0;
+
+        backing->width = scene->width;
+        backing->height = scene->height;
+        _invalidateBacking(scene, 0, 0, scene->width, scene->height);
+    }
+
+    if (!backing->stale) return 1;
+
+    int x1 = clamp_i(backing->rect[0], 0, scene->width);
+    int y1 = clamp_i(backing->rect[1], 0, scene->height);
+    int x2 = clamp_i(backing->rect[2], 0, scene->width);
+    int y2 = clamp_i(backing->rect[3], 0, scene->height);
+
+    for (int i = y1; i < y2; i++) {
+        int ended = 0;
+        for (int j = x1; j < x2; j++) {
+            char c = scene->data[i][j];
+            if (c == 0) ended = 1;
+
+            char* ansi = scene->ansiData != 0 && !ended
+                             ? scene->ansiData[i][j]
+                             : 0;
+            CmdFX_curses_putSurfaceChar(
+                backing->surface, j, i, ended ? ' ' : c, ansi
+            );
+        }
+    }
+
+    backing->stale = 0;
+    return 1;
+}
+
+// copies a region of a backed scene whose view (x1, y1, x2, y2 in the scene)
+// is drawn at (x, y); cells covered by other scenes are skipped, and so are
+// blank cells with `overlay`, like the unbacked paths
+static int _blitBacking(
+    CmdFX_Scene* scene, int x, int y, int* view, int x1, int y1, int x2, int y2,
+    int overlay
+) {
+    _SceneBacking* backing = _getBacking(scene);
+    if (backing == 0) return 0;
+    if (!_renderBacking(scene, backing)) return 0;
+
+    x1 = x1 < view[0] ? view[0] : x1;
+    y1 = y1 < view[1] ? view[1] : y1;
+    x2 = x2 > view[2] ? view[2] : x2;
+    y2 = y2 > view[3] ? view[3] : y2;
+
+    for (int i = y1; i < y2; i++) {
+        int cy = y + i - view[1];
+
+        // copy each run of cells this scene is on top of
+        int j = x1;
+        while (j < x2) {
+            while (j < x2 && _topSceneAt(x + j - view[0], cy) != scene) j++;
+
+            int start = j;
+            while (j < x2 && _topSceneAt(x + j - view[0], cy) == scene) j++;
+
+            if (j > start)
+                CmdFX_curses_blitSurface(
+                    backing->surface, start, i, x + start - view[0], cy,
+                    j - start, 1, overlay
+                );
+        }
+    }
+
+    return 1;
+}
+
+int Scene_setBacked(CmdFX_Scene* scene, int backed) {
+    if (scene == 0) return -1;
+    if (scene->uid < 0 || scene->uid >= MAX_REGISTERED_SCENES) return -1;
+
+    if (!backed) {
+        _freeBacking(scene->uid);
+        return 0;
+    }
+
+    if (_sceneBackings == 0) {
+        _sceneBackings = (_SceneBacking**) calloc(
+            MAX_REGISTERED_SCENES, sizeof(_SceneBacking*)
+        );
+        if (_sceneBackings == 0) return -1;
+    }
+
+    if (_sceneBackings[scene->uid] != 0) return 0;
+
+    // the surface itself is created on the first draw
+    _SceneBacking* backing = (_SceneBacking*) calloc(1, sizeof(_SceneBacking));
+    if (backing == 0) return -1;
+
+    _sceneBackings[scene->uid] = backing;
+    return 0;
+}
+
+int Scene_isBacked(CmdFX_Scene* scene) {
+    if (scene == 0) return 0;
+
+    return _getBacking(scene) != 0;
+}
+
+// Dirty Tracking
+
+// registered scenes collect the regions (in scene coordinates) that changed or
+// were painted over since their last paint; the scene engine repaints only
+// those and skips idle scenes entirely
+#define _SCENE_DIRTY_MUTEX 11
+#define _MAX_DIRTY_RECTS 8
+
+typedef struct {
+    int count;
+    int rects[_MAX_DIRTY_RECTS][4]; // x1, y1, x2, y2 (exclusive)
+} _SceneDirtyRegion;
+
+static _SceneDirtyRegion** _sceneDirtyRegions = 0;
+
+// defined by the platform scene engine loop
+extern int _scenesRunning;
+
+static int _rectArea(const int* rect) {
+    return (rect[2] - rect[0]) * (rect[3] - rect[1]);
+}
+
+static void _markDirty(CmdFX_Scene* scene, int x1, int y1, int x2, int y2) {
+    if (scene->uid < 0 || scene->uid >= MAX_REGISTERED_SCENES) return;
+
+    x1 = clamp_i(x1, 0, scene->width);
+    y1 = clamp_i(y1, 0, scene->height);
+    x2 = clamp_i(x2, 0, scene->width);
+    y2 = clamp_i(y2, 0, scene->height);
+    if (x1 >= x2 || y1 >= y2) return;
+
+    CmdFX_tryLockMutex(_SCENE_DIRTY_MUTEX);
+    if (_sceneDirtyRegions == 0) {
+        _sceneDirtyRegions = (_SceneDirtyRegion**) calloc(
+            MAX_REGISTERED_SCENES, sizeof(_SceneDirtyRegion*)
+        );
+        if (_sceneDirtyRegions == 0) {
+            CmdFX_tryUnlockMutex(_SCENE_DIRTY_MUTEX);
+            return;
+        }
+    }
+
+    _SceneDirtyRegion* region = _sceneDirtyRegions[scene->uid];
+    if (region == 0) {
+        region = (_SceneDirtyRegion*) calloc(1, sizeof(_SceneDirtyRegion));
+        if (region == 0) {
+            CmdFX_tryUnlockMutex(_SCENE_DIRTY_MUTEX);
+            return;
+        }
+        _sceneDirtyRegions[scene->uid] = region;
+    }
+
+    // already covered
+    for (int i = 0; i < region->count; i++) {
+        int* rect = region->rects[i];
+        if (x1 >= rect[0] && y1 >= rect[1] && x2 <= rect[2] && y2 <= rect[3]) {
+            CmdFX_tryUnlockMutex(_SCENE_DIRTY_MUTEX);
+            return;
+        }
+    }
+
+    if (region->count < _MAX_DIRTY_RECTS) {
+        int* rect = region->rects[region->count++];
+        rect[0] = x1;
+        rect[1] = y1;
+        rect[2] = x2;
+        rect[3] = y2;
+
+        CmdFX_tryUnlockMutex(_SCENE_DIRTY_MUTEX);
+        return;
+    }
+
+    // out of slots; grow the rect whose bounding box grows the least
+    int best = 0;
+    int bestGrowth = -1;
+    for (int i = 0; i < region->count; i++) {
+        int* rect = region->rects[i];
+        int merged[4] = {
+            rect[0] < x1 ? rect[0] : x1, rect[1] < y1 ? rect[1] : y1,
+            rect[2] > x2 ? rect[2] : x2, rect[3] > y2 ? rect[3] : y2
+        };
+
+        int growth = _rectArea(merged) - _rectArea(rect);
+        if (bestGrowth == -1 || growth < bestGrowth) {
+            best = i;
+            bestGrowth = growth;
+        }
+    }
+
+    int* rect = region->rects[best];
+    if (x1 < rect[0]) rect[0] = x1;
+    if (y1 < rect[1]) rect[1] = y1;
+    if (x2 > rect[2]) rect[2] = x2;
+    if (y2 > rect[3]) rect[3] = y2;
+
+    CmdFX_tryUnlockMutex(_SCENE_DIRTY_MUTEX);
+}
+
+static void _clearDirty(CmdFX_Scene* scene) {
+    if (scene->uid < 0 || scene->uid >= MAX_REGISTERED_SCENES) return;
+
+    CmdFX_tryLockMutex(_SCENE_DIRTY_MUTEX);
+    if (_sceneDirtyRegions != 0 && _sceneDirtyRegions[scene->uid] != 0)
+        _sceneDirtyRegions[scene->uid]->count = 0;
+    CmdFX_tryUnlockMutex(_SCENE_DIRTY_MUTEX);
+}
+
+static void _freeDirty(int uid) {
+    if (uid < 0 || uid >= MAX_REGISTERED_SCENES) return;
+
+    CmdFX_tryLockMutex(_SCENE_DIRTY_MUTEX);
+    if (_sceneDirtyRegions != 0) {
+        free(_sceneDirtyRegions[uid]);
+        _sceneDirtyRegions[uid] = 0;
+    }
+    CmdFX_tryUnlockMutex(_SCENE_DIRTY_MUTEX);
+}
+
+// gets the portion of the scene that is drawn on screen
+static void _getDrawnBounds(CmdFX_Scene* scene, int* bounds) {
+    bounds[0] = 0;
+    bounds[1] = 0;
+    bounds[2] = scene->width;
+    bounds[3] = scene->height;
+
+    if (scene->uid > -1 && _drawnSceneBounds != 0) {
+        int* drawn = _drawnSceneBounds[scene->uid];
+        if (drawn != 0) {
+            bounds[0] = clamp_i(drawn[0], 0, scene->width);
+            bounds[1] = clamp_i(drawn[1], 0, scene->height);
+            bounds[2] = clamp_i(drawn[2], 0, scene->width);
+            bounds[3] = clamp_i(drawn[3], 0, scene->height);
+        }
+    }
+}
+
+// paints a region of a drawn scene, including blank cells so cleared data is
+// erased from the screen; the canvas mutex must be held
+static void _paintRegion(CmdFX_Scene* scene, int x1, int y1, int x2, int y2) {
+    int bounds[4];
+    _getDrawnBounds(scene, bounds);
+
+    x1 = x1 < bounds[0] ? bounds[0] : x1;
+    y1 = y1 < bounds[1] ? bounds[1] : y1;
+    x2 = x2 > bounds[2] ? bounds[2] : x2;
+    y2 = y2 > bounds[3] ? bounds[3] : y2;
+
+    _syncOccupancy();
+    if (_blitBacking(scene, scene->x, scene->y, bounds, x1, y1, x2, y2, 0))
+        return;
+
+    for (int i = y1; i < y2; i++)
+        for (int j = x1; j < x2; j++) {
+            char c = scene->data[i][j];
+            if (c == 0) break;
+
+            int cx = scene->x + j - bounds[0];
+            int cy = scene->y + i - bounds[1];
+            if (_topSceneAt(cx, cy) != scene) continue;
+
+            Canvas_setCursor(cx, cy);
+
+            char* ansi = scene->ansiData != 0 ? scene->ansiData[i][j] : 0;
+            if (ansi != 0) CmdFX_curses_applySgr(ansi);
+            CmdFX_curses_putCharHere(c);
+            if (ansi != 0) CmdFX_curses_resetAttributes();
+        }
+}
+
+// repaints and clears the dirty regions of a scene
+static void _flushDirty(CmdFX_Scene* scene) {
+    if (scene->uid < 0 || scene->uid >= MAX_REGISTERED_SCENES) return;
+
+    CmdFX_tryLockMutex(_SCENE_DIRTY_MUTEX);
+    if (_sceneDirtyRegions == 0 || _sceneDirtyRegions[scene->uid] == 0 ||
+        _sceneDirtyRegions[scene->uid]->count == 0) {
+        CmdFX_tryUnlockMutex(_SCENE_DIRTY_MUTEX);
+        return;
+    }
+
+    // copy out so marking can continue while painting
+    _SceneDirtyRegion region = *_sceneDirtyRegions[scene->uid];
+    _sceneDirtyRegions[scene->uid]->count = 0;
+    CmdFX_tryUnlockMutex(_SCENE_DIRTY_MUTEX);
+
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
+    for (int i = 0; i < region.count; i++) {
+        int* rect = region.rects[i];
+        _paintRegion(scene, rect[0], rect[1], rect[2], rect[3]);
+    }
+    CmdFX_curses_refresh();
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+}
+
+// called after a scene's data changed: registered scenes are left for the
+// next scene engine tick while it runs, anything else is repainted right away
+static void _updateRegion(CmdFX_Scene* scene, int x1, int y1, int x2, int y2) {
+    _invalidateBacking(scene, x1, y1, x2, y2);
+    if (scene->x == -1 && scene->y == -1) return;
+
+    _markDirty(scene, x1, y1, x2, y2);
+    if (scene->uid > -1 && _scenesRunning) return;
+
+    if (scene->uid > -1) {
+        _flushDirty(scene);
+        return;
+    }
+
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
+    _paintRegion(scene, x1, y1, x2, y2);
+    CmdFX_curses_refresh();
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+}
+
+// marks the parts of drawn scenes under a screen region dirty
+static void _markScreenDirty(
+    CmdFX_Scene* except, int x, int y, int width, int height
+) {
+    for (int i = 0; i < _drawnScenesCount; i++) {
+        CmdFX_Scene* scene = _drawnScenes[i];
+        if (scene == 0 || scene == except) continue;
+        if (scene->uid < 0) continue;
+        if (scene->x == -1 && scene->y == -1) continue;
+
+        int bounds[4];
+        _getDrawnBounds(scene, bounds);
+
+        // screen region -> scene coordinates
+        int x1 = x - scene->x + bounds[0];
+        int y1 = y - scene->y + bounds[1];
+        _markDirty(scene, x1, y1, x1 + width, y1 + height);
+    }
+}
+
+int Scene_markDirty(CmdFX_Scene* scene, int x, int y, int width, int height) {
+    if (scene == 0) return -1;
+    if (scene->uid < 0) return -1;
+    if (width < 1 || height < 1) return -1;
+
+    _invalidateBacking(scene, x, y, x + width, y + height);
+    _markDirty(scene, x, y, x + width, y + height);
+    return 0;
+}
+
+int Scene_isDirty(CmdFX_Scene* scene) {
+    if (scene == 0) return 0;
+    if (scene->uid < 0 || scene->uid >= MAX_REGISTERED_SCENES) return 0;
+
+    CmdFX_tryLockMutex(_SCENE_DIRTY_MUTEX);
+    int dirty = _sceneDirtyRegions != 0 &&
+                _sceneDirtyRegions[scene->uid] != 0 &&
+                _sceneDirtyRegions[scene->uid]->count > 0;
+    CmdFX_tryUnlockMutex(_SCENE_DIRTY_MUTEX);
+
+    return dirty;
+}
+
+void Canvas_markScenesDirty(int x, int y, int width, int height) {
+    if (width < 1 || height < 1) return;
+
+    _markScreenDirty(0, x, y, width, height);
+}
+
+// Shared Data
+
+// scenes borrowing their grids, and the owner of each
+static CmdFX_Scene** _sharedScenes = 0;
+static CmdFX_SharedData** _sceneShares = 0;
+static int _sharedScenesCount = 0;
+
+static int _sharedSceneIndex(CmdFX_Scene* scene) {
+    for (int i = 0; i < _sharedScenesCount; i++)
+        if (_sharedScenes[i] == scene) return i;
+
+    return -1;
+}
+
+static void _unshareScene(int index) {
+    CmdFX_SharedData* shared = _sceneShares[index];
+
+    _sharedScenesCount--;
+    _sharedScenes[index] = _sharedScenes[_sharedScenesCount];
+    _sceneShares[index] = _sceneShares[_sharedScenesCount];
+
+    CmdFX_shared_release(shared);
+}
+
+int _Scene_setShared(CmdFX_Scene* scene, CmdFX_SharedData* shared) {
+    if (scene == 0) return 0;
+
+    int index = _sharedSceneIndex(scene);
+    if (index >= 0) _unshareScene(index);
+    if (shared == 0) return 1;
+
+    CmdFX_Scene** scenes = realloc(
+        _sharedScenes, sizeof(CmdFX_Scene*) * (_sharedScenesCount + 1)
+    );
+    if (scenes == 0) return 0;
+    _sharedScenes = scenes;
+
+    CmdFX_SharedData** shares = realloc(
+        _sceneShares, sizeof(CmdFX_SharedData*) * (_sharedScenesCount + 1)
+    );
+    if (shares == 0) return 0;
+    _sceneShares = shares;
+
+    CmdFX_shared_retain(shared);
+    _sharedScenes[_sharedScenesCount] = scene;
+    _sceneShares[_sharedScenesCount] = shared;
+    _sharedScenesCount++;
+
+    return 1;
+}
+
+CmdFX_SharedData* _Scene_getShared(CmdFX_Scene* scene) {
+    int index = _sharedSceneIndex(scene);
+    if (index < 0) return 0;
+
+    return _sceneShares[index];
+}
+
+int _Scene_ownData(CmdFX_Scene* scene) {
+    int index = _sharedSceneIndex(scene);
+    if (index < 0) return 1;
+
+    int width = scene->width;
+    int height = scene->height;
+
+    char** data = Char2DBuilder_create(width, height);
+    if (data == 0) return 0;
+
+    for (int i = 0; i < height; i++) {
+        char* row = scene->data[i];
+        for (int j = 0; j < width && row[j] != 0; j++) data[i][j] = row[j];
+    }
+
+    char*** ansiData = 0;
+    if (scene->ansiData != 0) {
+        ansiData = String2DBuilder_create(width, height);
+        if (ansiData == 0) {
+            for (int i = 0; i < height; i++) free(data[i]);
+            free(data);
+            return 0;
+        }
+
+        for (int i = 0; i < height; i++)
+            for (int j = 0; j < width; j++) {
+                char* cell = scene->ansiData[i][j];
+                if (cell == 0) continue;
+
+                ansiData[i][j] = malloc(strlen(cell) + 1);
+                if (ansiData[i][j] != 0) strcpy(ansiData[i][j], cell);
+            }
+    }
+
+    scene->data = data;
+    scene->ansiData = ansiData;
+    _unshareScene(index);
+
+    return 1;
+}
+
 CmdFX_Scene* Scene_create(int width, int height) {
     if (width < 1 || height < 1) return 0;
 
@@ -110,6 +860,7 @@ CmdFX_Scene* Scene_createFromData(char** data, char*** ansiData) {
 
 int Scene_clear(CmdFX_Scene* scene) {
     if (scene == 0) return -1;
+    if (!_Scene_ownData(scene)) return -1;
 
     int width = scene->width;
     int height = scene->height;
@@ -121,6 +872,7 @@ int Scene_clear(CmdFX_Scene* scene) {
             if (ansi) scene->ansiData[i][j] = 0;
         }
 
+    _updateRegion(scene, 0, 0, width, height);
     return 0;
 }
 
@@ -134,28 +886,32 @@ void Scene_draw0(
 
     CmdFX_tryLockMutex(_CANVAS_MUTEX);
 
-    for (int i = _y1; i < _y2; i++)
-        for (int j = _x1; j < _x2; j++) {
-            char c = scene->data[i][j];
-            if (c == 0) break;
-            if (c == ' ') continue;
-
-            // original values ensure that the scene is drawn in the correct
-            // position
-            int cx = (x + j) - x1;
-            int cy = (y + i) - y1;
-
-            if (!Scene_isOnTopAt(scene, cx, cy)) continue;
-
-            Canvas_setCursor(cx, cy);
-
-            // apply the cell color before drawing so it lands on this char, not
-            // the next one, then reset so an uncolored cell stays default
-            char* ansi = scene->ansiData != 0 ? scene->ansiData[i][j] : 0;
-            if (ansi != 0) Canvas_setAnsiCurrent(ansi);
-            CmdFX_curses_putCharHere(c);
-            if (ansi != 0) Canvas_resetFormat();
-        }
+    _syncOccupancy();
+    int view[4] = {x1, y1, _x2, _y2};
+    if (!_blitBacking(scene, x, y, view, _x1, _y1, _x2, _y2, 1))
+        for (int i = _y1; i < _y2; i++)
+            for (int j = _x1; j < _x2; j++) {
+                char c = scene->data[i][j];
+                if (c == 0) break;
+                if (c == ' ') continue;
+
+                // original values ensure that the scene is drawn in the correct
+                // position
+                int cx = (x + j) - x1;
+                int cy = (y + i) - y1;
+
+                if (_topSceneAt(cx, cy) != scene) continue;
+
+                Canvas_setCursor(cx, cy);
+
+                // apply the cell color before drawing so it lands on this
+                // char, not the next one, then reset so an uncolored cell
+                // stays default
+                char* ansi = scene->ansiData != 0 ? scene->ansiData[i][j] : 0;
+                if (ansi != 0) Canvas_setAnsiCurrent(ansi);
+                CmdFX_curses_putCharHere(c);
+                if (ansi != 0) Canvas_resetFormat();
+            }
 
     // draw buttons on the scene
     CmdFX_Button** buttons = Scene_getButtons(scene->uid);
@@ -188,6 +944,7 @@ void Scene_draw1(
 ) {
     (void) x;
     (void) y;
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
     if (_drawnScenes == 0) {
         _drawnScenes = (CmdFX_Scene**) malloc(sizeof(CmdFX_Scene*));
     }
@@ -199,6 +956,8 @@ void Scene_draw1(
 
     _drawnScenes[_drawnScenesCount] = scene;
     _drawnScenesCount++;
+    _addOccupancy(scene);
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
 
     if (scene->uid > -1) {
         if (_drawnSceneBounds == 0) {
@@ -227,6 +986,7 @@ int Scene_draw(CmdFX_Scene* scene, int x, int y) {
     // scene and actually paints it
     Scene_draw1(scene, x, y, 0, 0, scene->width, scene->height);
     Scene_draw0(scene, x, y, 0, 0, scene->width, scene->height);
+    _clearDirty(scene);
     return 0;
 }
 
@@ -243,13 +1003,12 @@ int Scene_drawPortion(
 
     Scene_draw1(scene, x, y, sx, sy, width, height);
     Scene_draw0(scene, x, y, sx, sy, width, height);
+    _clearDirty(scene);
     return 0;
 }
 
 CmdFX_Scene* Scene_getSceneAt(int x, int y) {
     if (x < 0 || y < 0) return 0;
-    if (_drawnScenes == 0) return 0;
-    if (_drawnScenesCount == 0) return 0;
 
     int width = Canvas_getWidth();
     int height = Canvas_getHeight();
@@ -258,32 +1017,10 @@ CmdFX_Scene* Scene_getSceneAt(int x, int y) {
         if (x >= width || y >= height) return 0;
     }
 
-    CmdFX_Scene** stack = malloc(sizeof(CmdFX_Scene*) * _drawnScenesCount);
-    if (stack == 0) return 0;
-
-    int stackCount = 0;
-    for (int i = 0; i < _drawnScenesCount; i++) {
-        CmdFX_Scene* scene = _drawnScenes[i];
-        if (scene == 0) continue;
-        if (scene->x == -1 && scene->y == -1) continue;
-
-        if (x >= scene->x && x < scene->x + scene->width && y >= scene->y &&
-            y < scene->y + scene->height) {
-            stack[stackCount] = scene;
-            stackCount++;
-        }
-    }
-
-    if (stackCount == 0) {
-        free(stack);
-        return 0;
-    }
-    CmdFX_Scene* top = stack[0];
-    for (int i = 1; i < stackCount; i++) {
-        CmdFX_Scene* scene = stack[i];
-        if (scene->z > top->z) top = scene;
-    }
-    free(stack);
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
+    _syncOccupancy();
+    CmdFX_Scene* top = _topSceneAt(x, y);
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
 
     return top;
 }
@@ -302,7 +1039,10 @@ int Scene_isOnTopAt(CmdFX_Scene* scene, int x, int y) {
     if (scene == 0) return -1;
     if (x < 0 || y < 0) return -1;
 
-    CmdFX_Scene* top = Scene_getSceneAt(x, y);
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
+    _syncOccupancy();
+    CmdFX_Scene* top = _topSceneAt(x, y);
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
     if (top == 0) return 0;
 
     return top == scene ? 1 : 0;
@@ -319,38 +1059,14 @@ int Scene_isOnBottomAt(CmdFX_Scene* scene, int x, int y) {
     if (scene == 0) return 0;
     if (x < 0 || y < 0) return 0;
 
-    if (_drawnScenesCount == 0) return 0;
-    if (_drawnScenes == 0) return 0;
     if (scene->x == -1 && scene->y == -1) return 0;
 
-    CmdFX_Scene** bottomScenes =
-        calloc(_drawnScenesCount, sizeof(CmdFX_Scene*));
-    if (bottomScenes == 0) return 0;
-
-    int c = 0;
-    for (int i = 0; i < _drawnScenesCount; i++) {
-        CmdFX_Scene* drawn = _drawnScenes[i];
-        if (drawn == 0) continue;
-        if (drawn->x == -1 && drawn->y == -1) continue;
-
-        if (x >= drawn->x && x < drawn->x + drawn->width && y >= drawn->y &&
-            y < drawn->y + drawn->height) {
-            bottomScenes[c++] = drawn;
-        }
-    }
-
-    CmdFX_Scene* bottom = bottomScenes[0];
-    if (bottom == 0 || c == 0) {
-        free(bottomScenes);
-        return 0;
-    }
-
-    for (int i = 1; i < c; i++) {
-        CmdFX_Scene* bottomScene = bottomScenes[i];
-        if (bottomScene->z < bottom->z) bottom = bottomScene;
-    }
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
+    _syncOccupancy();
+    CmdFX_Scene* bottom = _bottomSceneAt(x, y);
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+    if (bottom == 0) return 0;
 
-    free(bottomScenes);
     return bottom == scene ? 1 : 0;
 }
 
@@ -373,6 +1089,9 @@ void Scene_remove0(CmdFX_Scene* scene) {
             CmdFX_curses_resetAttributes();
         }
 
+    // scenes underneath are exposed again
+    _markScreenDirty(scene, scene->x, scene->y, width, height);
+
     // remove buttons on the scene
     CmdFX_Button** buttons = Scene_getButtons(scene->uid);
     int buttonCount = Scene_getButtonsCount(scene->uid);
@@ -393,11 +1112,14 @@ int Scene_remove(CmdFX_Scene* scene) {
         return 0; // already removed, default to success
 
     Scene_remove0(scene);
+
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
     scene->x = -1;
     scene->y = -1;
 
     for (int i = 0; i < _drawnScenesCount; i++)
         if (_drawnScenes[i] == scene) {
+            _removeOccupancy(i);
             for (int j = i; j < _drawnScenesCount - 1; j++)
                 _drawnScenes[j] = _drawnScenes[j + 1];
 
@@ -410,7 +1132,9 @@ int Scene_remove(CmdFX_Scene* scene) {
             _drawnScenesCount--;
             break;
         }
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
 
+    _clearDirty(scene);
     return 0;
 }
 
@@ -442,10 +1166,18 @@ int Scene_free(CmdFX_Scene* scene) {
 
     Scene_remove(scene);
 
+    // borrowed grids belong to their shared owner
+    int index = _sharedSceneIndex(scene);
+    if (index >= 0) {
+        scene->data = 0;
+        scene->ansiData = 0;
+        _unshareScene(index);
+    }
+
     int width = scene->width;
     int height = scene->height;
 
-    for (int i = 0; i < height; i++) free(scene->data[i]);
+    for (int i = 0; scene->data != 0 && i < height; i++) free(scene->data[i]);
     free(scene->data);
 
     if (scene->ansiData != 0) {
@@ -463,6 +1195,7 @@ int Scene_free(CmdFX_Scene* scene) {
 
     // remove buttons on the scene
     Scene_removeAllButtons(scene->uid);
+    _freeDirty(scene->uid);
 
     // unregister scene
     Scene_unregister(scene);
@@ -520,6 +1253,12 @@ int Scene_unregister(CmdFX_Scene* scene) {
     if (scene->uid == -1) return 0;
 
     int old = scene->uid;
+    _freeDirty(old);
+    _freeBacking(old);
+    if (_drawnSceneBounds != 0) {
+        free(_drawnSceneBounds[old]);
+        _drawnSceneBounds[old] = 0;
+    }
     _registeredScenes[scene->uid] = 0;
     scene->uid = -1;
 
@@ -542,6 +1281,51 @@ int Scene_switchToRegistered(int uid, int x, int y) {
     return Scene_switchTo(_registeredScenes[uid], x, y);
 }
 
+// shifts what is already on screen and paints only the exposed edges; only
+// possible when nothing else is drawn over the visible part of the scene
+static int _scrollInPlace(CmdFX_Scene* scene, int* old, int* bounds) {
+    int width = bounds[2] - bounds[0];
+    int height = bounds[3] - bounds[1];
+    if (width != old[2] - old[0] || height != old[3] - old[1]) return 0;
+    if (Scene_getButtonsCount(scene->uid) > 0) return 0;
+
+    int dx = bounds[0] - old[0];
+    int dy = bounds[1] - old[1];
+    if (abs(dx) >= width || abs(dy) >= height) return 0;
+
+    // sprites and other scenes on top would be shifted along with it
+    int x2 = scene->x + width;
+    int y2 = scene->y + height;
+    CmdFX_Sprite** sprites = Canvas_getDrawnSprites();
+    for (int i = 0; i < Canvas_getDrawnSpritesCount(); i++) {
+        CmdFX_Sprite* sprite = sprites[i];
+        if (sprite == 0) continue;
+        if (sprite->x >= x2 || sprite->x + sprite->width <= scene->x) continue;
+        if (sprite->y >= y2 || sprite->y + sprite->height <= scene->y) continue;
+        return 0;
+    }
+
+    _syncOccupancy();
+    for (int i = scene->y; i < y2; i++)
+        for (int j = scene->x; j < x2; j++)
+            if (_topSceneAt(j, i) != scene) return 0;
+
+    if (!CmdFX_curses_shiftRegion(
+            scene->x, scene->y, width, height, -dx, -dy
+        ))
+        return 0;
+
+    // newly exposed rows, then columns
+    int w = scene->width;
+    int h = scene->height;
+    if (dy > 0) _paintRegion(scene, 0, bounds[3] - dy, w, bounds[3]);
+    if (dy < 0) _paintRegion(scene, 0, bounds[1], w, bounds[1] - dy);
+    if (dx > 0) _paintRegion(scene, bounds[2] - dx, 0, bounds[2], h);
+    if (dx < 0) _paintRegion(scene, bounds[0], 0, bounds[0] - dx, h);
+
+    return 1;
+}
+
 int Scene_scroll(int uid, int dx, int dy) {
     if (uid < 0 || uid >= MAX_REGISTERED_SCENES) return -1;
     if (_registeredScenes == 0) return -1;
@@ -552,6 +1336,7 @@ int Scene_scroll(int uid, int dx, int dy) {
 
     int* bounds = _drawnSceneBounds[uid];
     if (bounds == 0) return -1;
+    int old[4] = {bounds[0], bounds[1], bounds[2], bounds[3]};
 
     int x1 = clamp_i(bounds[0] + dx, 0, scene->width);
     bounds[0] = x1;
@@ -562,8 +1347,17 @@ int Scene_scroll(int uid, int dx, int dy) {
     int y2 = clamp_i(bounds[3] + dy, 0, scene->height);
     bounds[3] = y2;
 
+    CmdFX_tryLockMutex(_CANVAS_MUTEX);
+    int scrolled = _scrollInPlace(scene, old, bounds);
+    if (scrolled) CmdFX_curses_refresh();
+    CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
+
+    // pending dirty regions are in scene coordinates and still apply
+    if (scrolled) return 0;
+
     Scene_remove0(scene);
     Scene_draw0(scene, scene->x, scene->y, x1, y1, x2, y2);
+    _clearDirty(scene);
 
     return 0;
 }
@@ -571,28 +1365,18 @@ int Scene_scroll(int uid, int dx, int dy) {
 void tickCmdFXSceneEngine() {
     if (_registeredScenes == 0) return;
 
-    for (int i = 0; i < Scene_getRegisteredScenesCount(); i++) {
+    // only dirty regions are repainted; idle scenes cost nothing
+    unsigned long long start = CmdFX_stats_begin();
+    unsigned long long span = CmdFX_trace_begin();
+    for (int i = 0; i < MAX_REGISTERED_SCENES; i++) {
         CmdFX_Scene* scene = _registeredScenes[i];
         if (scene == 0) continue;
         if (scene->x == -1 && scene->y == -1) continue;
 
-        int* bounds = _drawnSceneBounds[scene->uid];
-        int x1, y1, x2, y2;
-        if (bounds != 0) {
-            x1 = bounds[0];
-            y1 = bounds[1];
-            x2 = bounds[2];
-            y2 = bounds[3];
-        }
-        else {
-            x1 = 0;
-            y1 = 0;
-            x2 = scene->width;
-            y2 = scene->height;
-        }
-
-        Scene_draw0(scene, scene->x, scene->y, x1, y1, x2, y2);
+        _flushDirty(scene);
     }
+    CmdFX_trace_end("scene_tick", "scenes", span);
+    CmdFX_stats_end(CMDFX_FRAME_STAGE_SCENE_TICK, start);
 }
 
 // Scene Data Manipulation
@@ -600,6 +1384,7 @@ void tickCmdFXSceneEngine() {
 int Scene_setData(CmdFX_Scene* scene, char** data) {
     if (scene == 0) return -1;
     if (data == 0) return -1;
+    if (!_Scene_ownData(scene)) return -1;
 
     int height = getCharArrayHeight(data);
     int width = getCharArrayWidth(data);
@@ -632,18 +1417,25 @@ int Scene_setData(CmdFX_Scene* scene, char** data) {
                 if (i < oldHeight && j < oldWidth)
                     ansiCopy[i][j] = scene->ansiData[i][j];
 
-        for (int i = 0; i < oldHeight; i++)
-            for (int j = 0; j < oldWidth; j++) free(scene->ansiData[i][j]);
+        // cells that did not move into the copy are dropped
+        for (int i = 0; i < oldHeight; i++) {
+            for (int j = 0; j < oldWidth; j++)
+                if (i >= height || j >= width) free(scene->ansiData[i][j]);
+            free(scene->ansiData[i]);
+        }
         free(scene->ansiData);
+        scene->ansiData = ansiCopy;
     }
 
     scene->width = width;
     scene->height = height;
+    _invalidateBacking(scene, 0, 0, width, height);
 
     if (cx != -1 && cy != -1) {
         Scene_draw0(scene, cx, cy, 0, 0, width, height);
         scene->x = cx;
         scene->y = cy;
+        _clearDirty(scene);
     }
 
     return 0;
@@ -654,13 +1446,10 @@ int Scene_setChar(CmdFX_Scene* scene, int x, int y, char c) {
     if (scene->data == 0) return -1;
     if (x < 0 || y < 0) return -1;
     if (x >= scene->width || y >= scene->height) return -1;
+    if (!_Scene_ownData(scene)) return -1;
 
     scene->data[y][x] = c;
-    if (scene->x != -1 && scene->y != -1 &&
-        Scene_isOnTopAt(scene, scene->x + x, scene->y + y)) {
-        Canvas_setCursor(scene->x + x, scene->y + y);
-        CmdFX_curses_putCharHere(c);
-    }
+    _updateRegion(scene, x, y, x + 1, y + 1);
 
     return 0;
 }
@@ -668,6 +1457,7 @@ int Scene_setChar(CmdFX_Scene* scene, int x, int y, char c) {
 int Scene_setAnsiData(CmdFX_Scene* scene, char*** ansiData) {
     if (scene == 0) return -1;
     if (ansiData == 0) return -1;
+    if (!_Scene_ownData(scene)) return -1;
 
     int height = getStringArrayHeight(ansiData);
     int width = getStringArrayWidth(ansiData);
@@ -694,11 +1484,13 @@ int Scene_setAnsiData(CmdFX_Scene* scene, char*** ansiData) {
 
     scene->width = width;
     scene->height = height;
+    _invalidateBacking(scene, 0, 0, width, height);
 
     if (cx != -1 && cy != -1) {
         Scene_draw0(scene, cx, cy, 0, 0, width, height);
         scene->x = cx;
         scene->y = cy;
+        _clearDirty(scene);
     }
 
     return 0;
@@ -707,6 +1499,7 @@ int Scene_setAnsiData(CmdFX_Scene* scene, char*** ansiData) {
 int Scene_appendAnsiData(CmdFX_Scene* scene, char*** ansiData) {
     if (scene == 0) return -1;
     if (ansiData == 0) return -1;
+    if (!_Scene_ownData(scene)) return -1;
 
     int height = getStringArrayHeight(ansiData);
     int width = getStringArrayWidth(ansiData);
@@ -749,11 +1542,13 @@ int Scene_appendAnsiData(CmdFX_Scene* scene, char*** ansiData) {
 
     scene->width = width;
     scene->height = height;
+    _invalidateBacking(scene, 0, 0, width, height);
 
     if (cx != -1 && cy != -1) {
         Scene_draw0(scene, cx, cy, 0, 0, width, height);
         scene->x = cx;
         scene->y = cy;
+        _clearDirty(scene);
     }
 
     return 0;
@@ -766,14 +1561,7 @@ int Scene_setForeground(
     if (x < 0 || y < 0) return -1;
     if (width < 1 || height < 1) return -1;
     if (x + width > scene->width || y + height > scene->height) return -1;
-
-    int cx = scene->x;
-    int cy = scene->y;
-    if (cx != -1 && cy != -1) {
-        Scene_remove0(scene);
-        scene->x = -1;
-        scene->y = -1;
-    }
+    if (!_Scene_ownData(scene)) return -1;
 
     for (int i = y; i < y + height; i++)
         for (int j = x; j < x + width; j++) {
@@ -791,12 +1579,7 @@ int Scene_setForeground(
             }
         }
 
-    if (cx != -1 && cy != -1) {
-        Scene_draw0(scene, cx, cy, 0, 0, width, height);
-        scene->x = cx;
-        scene->y = cy;
-    }
-
+    _updateRegion(scene, x, y, x + width, y + height);
     return 0;
 }
 
@@ -812,14 +1595,7 @@ int Scene_setBackground(
     if (x < 0 || y < 0) return -1;
     if (width < 1 || height < 1) return -1;
     if (x + width > scene->width || y + height > scene->height) return -1;
-
-    int cx = scene->x;
-    int cy = scene->y;
-    if (cx != -1 && cy != -1) {
-        Scene_remove0(scene);
-        scene->x = -1;
-        scene->y = -1;
-    }
+    if (!_Scene_ownData(scene)) return -1;
 
     for (int i = y; i < y + height; i++)
         for (int j = x; j < x + width; j++) {
@@ -837,12 +1613,7 @@ int Scene_setBackground(
             }
         }
 
-    if (cx != -1 && cy != -1) {
-        Scene_draw0(scene, cx, cy, 0, 0, width, height);
-        scene->x = cx;
-        scene->y = cy;
-    }
-
+    _updateRegion(scene, x, y, x + width, y + height);
     return 0;
 }
 
@@ -0,0 +1,59 @@
+/**
+ * @file shared.h
+ * @brief Internal shared ownership of sprite and scene grids.
+ *
+ * This is a private header. Sprites and scenes normally own their character
+ * and ANSI grids. A grid can instead be borrowed from a reference-counted
+ * owner (for example a memory-mapped asset file), in which case many sprites
+ * and scenes point at the same rows and strings without copying them.
+ *
+ * A borrower holds one reference. Before anything writes to a borrowed grid,
+ * the borrower copies it into buffers of its own and drops its reference
+ * (copy-on-write), so the owner's data is never modified. When the last
+ * reference is released, the owner's `destroy` callback frees it.
+ */
+#pragma once
+
+#include "cmdfx/core/scenes.h"
+#include "cmdfx/core/sprites.h"
+
+/** A reference-counted owner of grids borrowed by sprites and scenes. */
+typedef struct CmdFX_SharedData {
+    int references;
+    void (*destroy)(struct CmdFX_SharedData* shared);
+} CmdFX_SharedData;
+
+// Reference Counting
+
+void CmdFX_shared_retain(CmdFX_SharedData* shared);
+void CmdFX_shared_release(CmdFX_SharedData* shared);
+
+// Borrowers
+
+/**
+ * Makes the sprite borrow its current data and ANSI grids from `shared`,
+ * taking a reference. Returns 1 on success and 0 on failure.
+ */
+int _Sprite_setShared(CmdFX_Sprite* sprite, CmdFX_SharedData* shared);
+CmdFX_SharedData* _Sprite_getShared(CmdFX_Sprite* sprite);
+
+/**
+ * Copies a borrowed sprite's grids into buffers it owns and releases its
+ * reference. Does nothing for sprites that own their grids. Returns 1 on
+ * success and 0 on failure.
+ */
+int _Sprite_ownData(CmdFX_Sprite* sprite);
+
+/** Scene counterparts of the sprite functions above. */
+int _Scene_setShared(CmdFX_Scene* scene, CmdFX_SharedData* shared);
+CmdFX_SharedData* _Scene_getShared(CmdFX_Scene* scene);
+int _Scene_ownData(CmdFX_Scene* scene);
+
+// File Mapping
+
+/**
+ * Maps a file into memory privately: writes to the mapping are copy-on-write
+ * and never reach the file. Returns `NULL` if the file can't be mapped.
+ */
+void* CmdFX_mapFile(const char* path, unsigned long* size);
+void CmdFX_unmapFile(void* data, unsigned long size);
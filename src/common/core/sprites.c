@@ -1,5 +1,6 @@
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -7,15 +8,19 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 
+#include "cmdfx/core/animation/tween.h"
 #include "cmdfx/core/builder.h"
 #include "cmdfx/core/canvas.h"
 #include "cmdfx/core/costumes.h"
+#include "cmdfx/core/scenes.h"
 #include "cmdfx/core/sprites.h"
 #include "cmdfx/core/util.h"
 #include "cmdfx/physics/force.h"
 #include "cmdfx/physics/mass.h"
 #include "cmdfx/physics/motion.h"
 #include "common/core/curses_backend.h"
+#include "common/core/shared.h"
+#include "common/core/stats.h"
 
 #define _SPRITE_DRAWN_MUTEX 0
 static CmdFX_Sprite** _sprites = 0;
@@ -27,8 +32,8 @@ static int _spriteUidCounter = 0;
 static int* _takenUids = 0;
 
 // Per-sprite locking utilities
-#define _FIRST_SPRITE_MUTEX_ID 11
-#define _RESERVED_MUTEX_COUNT 11 // # of reserved mutexes (0-10)
+#define _FIRST_SPRITE_MUTEX_ID 15
+#define _RESERVED_MUTEX_COUNT 15 // # of reserved mutexes (0-14)
 
 int _spriteMutexId(const CmdFX_Sprite* sprite) {
     if (sprite == 0) return -1;
@@ -223,9 +228,119 @@ CmdFX_Sprite* Sprite_create(char** data, char*** ansi, int z) {
     return sprite;
 }
 
+// Shared Data
+
+void _freeANSI(char*** ansi, int width, int height);
+
+// shared owners of borrowed sprites, indexed by uid - 1
+static CmdFX_SharedData** _spriteShared = 0;
+static int _spriteSharedCount = 0;
+
+int _Sprite_setShared(CmdFX_Sprite* sprite, CmdFX_SharedData* shared) {
+    if (sprite == 0 || sprite->uid < 1) return 0;
+
+    int id = sprite->uid - 1;
+    if (id >= _spriteSharedCount) {
+        int count = _spriteSharedCount == 0 ? 16 : _spriteSharedCount;
+        while (count <= id) count *= 2;
+
+        CmdFX_SharedData** temp =
+            realloc(_spriteShared, sizeof(CmdFX_SharedData*) * count);
+        if (temp == 0) return 0;
+
+        for (int i = _spriteSharedCount; i < count; i++) temp[i] = 0;
+        _spriteShared = temp;
+        _spriteSharedCount = count;
+    }
+
+    if (shared != 0) CmdFX_shared_retain(shared);
+    if (_spriteShared[id] != 0) CmdFX_shared_release(_spriteShared[id]);
+    _spriteShared[id] = shared;
+
+    return 1;
+}
+
+CmdFX_SharedData* _Sprite_getShared(CmdFX_Sprite* sprite) {
+    if (sprite == 0 || sprite->uid < 1) return 0;
+    if (sprite->uid > _spriteSharedCount) return 0;
+
+    return _spriteShared[sprite->uid - 1];
+}
+
+int _Sprite_ownData(CmdFX_Sprite* sprite) {
+    CmdFX_SharedData* shared = _Sprite_getShared(sprite);
+    if (shared == 0) return 1;
+
+    int width = sprite->width;
+    int height = sprite->height;
+
+    char** data = 0;
+    if (sprite->data != 0) {
+        data = calloc(height + 1, sizeof(char*));
+        if (data == 0) return 0;
+
+        for (int i = 0; i < height; i++) {
+            data[i] = calloc(width + 1, sizeof(char));
+            if (data[i] == 0) {
+                for (int j = 0; j < i; j++) free(data[j]);
+                free(data);
+                return 0;
+            }
+
+            // borrowed rows may be shorter than the sprite
+            char* row = sprite->data[i];
+            for (int j = 0; j < width && row[j] != 0; j++) data[i][j] = row[j];
+        }
+    }
+
+    char*** ansi = 0;
+    if (sprite->ansi != 0) {
+        ansi = calloc(height + 1, sizeof(char**));
+        for (int i = 0; ansi != 0 && i < height; i++) {
+            ansi[i] = calloc(width + 1, sizeof(char*));
+            if (ansi[i] == 0) {
+                _freeANSI(ansi, width, i);
+                ansi = 0;
+                break;
+            }
+
+            for (int j = 0; j < width; j++) {
+                char* cell = sprite->ansi[i][j];
+                if (cell == 0) continue;
+
+                ansi[i][j] = malloc(strlen(cell) + 1);
+                if (ansi[i][j] != 0) strcpy(ansi[i][j], cell);
+            }
+        }
+
+        if (ansi == 0) {
+            for (int i = 0; data != 0 && i < height; i++) free(data[i]);
+            free(data);
+            return 0;
+        }
+    }
+
+    // a borrowed costume frame is replaced by the copy in its slot, so the
+    // live data keeps aliasing the active costume
+    CmdFX_SpriteCostumes* costumes = Sprite_getCostumes(sprite);
+    for (int i = 0; costumes != 0 && i < costumes->costumeCount; i++) {
+        if (costumes->costumes[i] == sprite->data) costumes->costumes[i] = data;
+        if (sprite->ansi != 0 && costumes->ansiCostumes[i] == sprite->ansi)
+            costumes->ansiCostumes[i] = ansi;
+    }
+
+    sprite->data = data;
+    sprite->ansi = ansi;
+    _spriteShared[sprite->uid - 1] = 0;
+    CmdFX_shared_release(shared);
+
+    return 1;
+}
+
 void Sprite_free(CmdFX_Sprite* sprite) {
     if (sprite == 0) return;
     if (sprite->id > 0) Sprite_remove(sprite);
+    Tween_cancelAll(sprite);
 
     // Remove UID from Taken UIDs
     CmdFX_tryLockMutex(_SPRITE_UID_MUTEX);
@@ -260,21 +375,14 @@ void Sprite_free(CmdFX_Sprite* sprite) {
         }
 
         if (zeroCount > 0) {
-            int* temp = realloc(
-                _takenUids, sizeof(int) * (_spriteUidCounter - zeroCount)
-            );
-            if (temp != 0) {
-                _takenUids = temp;
-                for (int i = 0; i < _spriteUidCounter; i++)
-                    if (_takenUids[i] == 0) {
-                        for (int j = i; j < _spriteUidCounter - 1; j++) {
-                            _takenUids[j] = _takenUids[j + 1];
-                        }
-                        break;
-                    }
-
-                _spriteUidCounter -= zeroCount;
-            }
+            // compact before shrinking, or the tail is cut off unread
+            int k = 0;
+            for (int i = 0; i < _spriteUidCounter; i++)
+                if (_takenUids[i] != 0) _takenUids[k++] = _takenUids[i];
+            _spriteUidCounter = k;
+
+            int* temp = realloc(_takenUids, sizeof(int) * k);
+            if (temp != 0) _takenUids = temp;
         }
     }
     CmdFX_tryUnlockMutex(_SPRITE_UID_MUTEX);
@@ -282,9 +390,19 @@ void Sprite_free(CmdFX_Sprite* sprite) {
     // Free Sprite Costumes and Data
     // free the registry first; the live data aliases a costume buffer, so
     // Sprite_freeCostumes copies it out and leaves sprite->data owning its own
-    // independent buffer afterwards
+    // independent buffer afterwards (or still borrowing an atlas frame)
     if (Sprite_getCostumes(sprite) != 0) Sprite_freeCostumes(sprite);
 
+    // borrowed grids belong to their shared owner
+    CmdFX_SharedData* shared = _Sprite_getShared(sprite);
+    if (shared != 0) {
+        sprite->data = 0;
+        sprite->ansi = 0;
+        _spriteShared[sprite->uid - 1] = 0;
+        CmdFX_shared_release(shared);
+    }
+    Sprite_freeRotationCache(sprite);
+
     // free the sprite's own live buffers (its own after the costume teardown,
     // or the originals when no costumes were created)
     char** data = sprite->data;
@@ -318,6 +436,7 @@ void Sprite_draw0(CmdFX_Sprite* sprite) {
         sprite->y + sprite->height > Canvas_getHeight())
         return;
 
+    unsigned long long start = CmdFX_stats_begin();
     int hasAnsi = sprite->ansi != 0;
     for (int i = 0; i < sprite->height; i++) {
         char* line = sprite->data[i];
@@ -342,6 +461,8 @@ void Sprite_draw0(CmdFX_Sprite* sprite) {
             if (hasAnsi) Canvas_resetFormat();
         }
     }
+    CmdFX_stats_end(CMDFX_FRAME_STAGE_SPRITE_DRAW, start);
+
     CmdFX_curses_refresh();
 }
 
@@ -411,6 +532,9 @@ void Sprite_remove0(CmdFX_Sprite* sprite) {
         }
     }
     CmdFX_curses_refresh();
+
+    // scenes under the sprite need repainting by the scene engine
+    Canvas_markScenesDirty(sprite->x, sprite->y, sprite->width, sprite->height);
 }
 
 void Sprite_remove(CmdFX_Sprite* sprite) {
@@ -467,6 +591,7 @@ void Sprite_remove(CmdFX_Sprite* sprite) {
 int Sprite_setData(CmdFX_Sprite* sprite, char** data) {
     if (sprite == 0) return 0;
     if (data == 0) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
 
     CmdFX_tryLockMutex(_SPRITE_DATA_MUTEX);
     int width = 0;
@@ -529,6 +654,7 @@ int Sprite_setChar(CmdFX_Sprite* sprite, int x, int y, char c) {
     if (sprite == 0) return 0;
     if (sprite->data == 0) return 0;
     if (x < 0 || y < 0 || x >= sprite->width || y >= sprite->height) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
 
     CmdFX_tryLockMutex(_SPRITE_DATA_MUTEX);
     sprite->data[y][x] = c;
@@ -546,6 +672,7 @@ int Sprite_fillChar(
     if (sprite == 0) return 0;
     if (sprite->data == 0) return 0;
     if (x < 0 || y < 0 || x >= sprite->width || y >= sprite->height) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
 
     CmdFX_tryLockMutex(_SPRITE_DATA_MUTEX);
 
@@ -571,6 +698,7 @@ int Sprite_fillCharEmpty(
     if (sprite == 0) return 0;
     if (sprite->data == 0) return 0;
     if (x < 0 || y < 0 || x >= sprite->width || y >= sprite->height) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
 
     CmdFX_tryLockMutex(_SPRITE_DATA_MUTEX);
 
@@ -594,6 +722,7 @@ int Sprite_fillCharEmpty(
 int Sprite_fillCharAll(CmdFX_Sprite* sprite, char c) {
     if (sprite == 0) return 0;
     if (sprite->data == 0) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
 
     CmdFX_tryLockMutex(_SPRITE_DATA_MUTEX);
 
@@ -614,6 +743,7 @@ int Sprite_fillCharAll(CmdFX_Sprite* sprite, char c) {
 int Sprite_fillCharAllEmpty(CmdFX_Sprite* sprite, char c) {
     if (sprite == 0) return 0;
     if (sprite->data == 0) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
 
     CmdFX_tryLockMutex(_SPRITE_DATA_MUTEX);
 
@@ -637,6 +767,7 @@ int Sprite_setAnsi(CmdFX_Sprite* sprite, int x, int y, char* ansi) {
     if (ansi == 0) return 0; // Add null check for ansi parameter
     if (sprite->ansi == 0) return 0;
     if (x < 0 || y < 0 || x >= sprite->width || y >= sprite->height) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
 
     CmdFX_tryLockMutex(_SPRITE_DATA_MUTEX);
 
@@ -661,6 +792,7 @@ int Sprite_appendAnsi(CmdFX_Sprite* sprite, int x, int y, char* ansi) {
     if (ansi == 0) return 0;
     if (sprite->ansi == 0) return 0;
     if (x < 0 || y < 0 || x >= sprite->width || y >= sprite->height) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
 
     CmdFX_tryLockMutex(_SPRITE_DATA_MUTEX);
 
@@ -705,6 +837,7 @@ int Sprite_fillAnsi(
     if (ansi == 0) return 0;
     if (sprite->ansi == 0) return 0;
     if (x < 0 || y < 0 || x >= sprite->width || y >= sprite->height) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
 
     CmdFX_tryLockMutex(_SPRITE_DATA_MUTEX);
 
@@ -736,6 +869,7 @@ int Sprite_setAnsiAll(CmdFX_Sprite* sprite, char* ansi) {
     if (sprite == 0) return 0;
     if (ansi == 0) return 0;
     if (sprite->ansi == 0) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
 
     for (int i = 0; i < sprite->height; i++) {
         for (int j = 0; j < sprite->width; j++) {
@@ -757,6 +891,7 @@ int Sprite_setAnsiAll(CmdFX_Sprite* sprite, char* ansi) {
 int Sprite_appendAnsiAll(CmdFX_Sprite* sprite, char* ansi) {
     if (sprite == 0) return 0;
     if (sprite->ansi == 0) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
 
     for (int i = 0; i < sprite->height; i++) {
         for (int j = 0; j < sprite->width; j++) {
@@ -862,9 +997,130 @@ CmdFX_Sprite* Sprite_loadFromFile(const char* path, int z) {
     return sprite;
 }
 
+// Utility Methods - Sprite Templates
+
+// a template and the reference it holds on its own data
+typedef struct _SharedTemplate {
+    CmdFX_SpriteTemplate spriteTemplate;
+    CmdFX_SharedData shared;
+} _SharedTemplate;
+
+static void _destroyTemplate(CmdFX_SharedData* shared) {
+    _SharedTemplate* owner =
+        (_SharedTemplate*) ((char*) shared - offsetof(_SharedTemplate, shared));
+    CmdFX_SpriteTemplate* spriteTemplate = &owner->spriteTemplate;
+
+    if (spriteTemplate->data != 0) {
+        for (int i = 0; i < spriteTemplate->height; i++)
+            free(spriteTemplate->data[i]);
+        free(spriteTemplate->data);
+    }
+
+    if (spriteTemplate->ansi != 0)
+        _freeANSI(
+            spriteTemplate->ansi, spriteTemplate->width, spriteTemplate->height
+        );
+
+    free(owner);
+}
+
+CmdFX_SpriteTemplate* SpriteTemplate_create(char** data, char*** ansi) {
+    if (data == 0) return 0;
+
+    int width = 0;
+    int height = 0;
+    _getSpriteDimensions(data, &width, &height);
+    if (width == 0 || height == 0) return 0;
+
+    // instances must be able to set ANSI codes, so the grid always exists
+    char*** created = 0;
+    if (ansi == 0) {
+        ansi = created = String2DBuilder_create(width, height);
+        if (ansi == 0) return 0;
+    }
+
+    _SharedTemplate* owner = calloc(1, sizeof(_SharedTemplate));
+    if (owner == 0) {
+        if (created != 0) _freeANSI(created, width, height);
+        return 0;
+    }
+
+    owner->shared.references = 1;
+    owner->shared.destroy = _destroyTemplate;
+    owner->spriteTemplate.width = width;
+    owner->spriteTemplate.height = height;
+    owner->spriteTemplate.data = data;
+    owner->spriteTemplate.ansi = ansi;
+
+    return &owner->spriteTemplate;
+}
+
+CmdFX_SpriteTemplate* SpriteTemplate_createFilled(
+    int width, int height, char c, char* ansi
+) {
+    if (width <= 0 || height <= 0) return 0;
+
+    char** data = Char2DBuilder_createFilled(width, height, c);
+    if (data == 0) return 0;
+
+    char*** ansiData = ansi != 0
+                           ? String2DBuilder_createFilled(width, height, ansi)
+                           : String2DBuilder_create(width, height);
+    if (ansiData == 0) {
+        for (int i = 0; i < height; i++) free(data[i]);
+        free(data);
+        return 0;
+    }
+
+    CmdFX_SpriteTemplate* spriteTemplate =
+        SpriteTemplate_create(data, ansiData);
+    if (spriteTemplate == 0) {
+        for (int i = 0; i < height; i++) free(data[i]);
+        free(data);
+        _freeANSI(ansiData, width, height);
+    }
+
+    return spriteTemplate;
+}
+
+void SpriteTemplate_free(CmdFX_SpriteTemplate* spriteTemplate) {
+    if (spriteTemplate == 0) return;
+
+    CmdFX_shared_release(&((_SharedTemplate*) spriteTemplate)->shared);
+}
+
+CmdFX_Sprite* SpriteTemplate_instantiate(
+    CmdFX_SpriteTemplate* spriteTemplate, int z
+) {
+    if (spriteTemplate == 0) return 0;
+
+    CmdFX_Sprite* sprite =
+        Sprite_create(spriteTemplate->data, spriteTemplate->ansi, z);
+    if (sprite == 0) return 0;
+
+    sprite->width = spriteTemplate->width;
+    sprite->height = spriteTemplate->height;
+
+    CmdFX_SharedData* shared = &((_SharedTemplate*) spriteTemplate)->shared;
+    if (!_Sprite_setShared(sprite, shared)) {
+        sprite->data = 0;
+        sprite->ansi = 0;
+        Sprite_free(sprite);
+        return 0;
+    }
+
+    return sprite;
+}
+
+int Sprite_isShared(CmdFX_Sprite* sprite) {
+    return _Sprite_getShared(sprite) != 0;
+}
+
 // Utility Methods - Sizing
 
 int Sprite_resize0(CmdFX_Sprite* sprite, int width, int height, char padding) {
+    if (!_Sprite_ownData(sprite)) return 0;
+
     if (sprite->data == 0) {
         sprite->data = malloc(sizeof(char*) * sprite->height);
         if (sprite->data == 0) return 0;
@@ -980,6 +1236,8 @@ int Sprite_resizeWithPadding(
 }
 
 int Sprite_center0(CmdFX_Sprite* sprite) {
+    if (!_Sprite_ownData(sprite)) return 0;
+
     int left = sprite->width, right = 0, top = sprite->height, bottom = 0;
 
     // Find the bounding box of non-whitespace characters
@@ -1369,31 +1627,35 @@ void _freeANSI(char*** ansi, int width, int height) {
     free(ansi);
 }
 
+// declared in src/common/core/builder.c
+extern int _setColorString(char** cell, int prefix, int rgb);
+
 int Sprite_setGradient0(
     CmdFX_Sprite* sprite, int prefix, int x, int y, int width, int height,
     enum CmdFX_GradientDirection direction, int numColors, va_list* args
 ) {
-    int* colors = (int*) malloc(sizeof(int) * (numColors + 1));
+    if (sprite == 0 || sprite->ansi == 0) return 0;
+    if (width < 1 || height < 1) return 0;
+    if (!_Sprite_ownData(sprite)) return 0;
+
+    // the colors and the gradient share one allocation
+    int* colors = (int*) malloc(sizeof(int) * (numColors + width * height));
     if (colors == 0) return 0;
 
     for (int i = 0; i < numColors; i++) {
         colors[i] = va_arg(*args, int);
     }
 
-    char*** gradient = String2DBuilder_create(width, height);
-    if (gradient == 0) {
+    int* gradient = colors + numColors;
+    if (Color2DBuilder_gradient(
+            gradient, width, height, numColors, colors, 0, direction
+        ) != 0) {
         free(colors);
         return 0;
     }
-    if (prefix == 38)
-        String2DBuilder_multiGradientForegroundFull(
-            gradient, numColors, colors, direction
-        );
-    else
-        String2DBuilder_multiGradientBackgroundFull(
-            gradient, numColors, colors, direction
-        );
 
+    // the codes are written straight into the sprite's cells
+    int res = 1;
     for (int j = 0; j < height; j++) {
         int cy = y + j;
         if (cy < 0 || cy >= sprite->height) continue;
@@ -1402,13 +1664,12 @@ int Sprite_setGradient0(
             int cx = x + i;
             if (cx < 0 || cx >= sprite->width) continue;
 
-            free(sprite->ansi[cy][cx]);
-            sprite->ansi[cy][cx] = gradient[j][i];
+            int rgb = gradient[j * width + i];
+            if (!_setColorString(&sprite->ansi[cy][cx], prefix, rgb)) res = 0;
         }
     }
 
     free(colors);
-    _freeANSI(gradient, width, height);
 
     if (sprite->id != 0) {
         CmdFX_tryLockMutex(_CANVAS_MUTEX);
@@ -1417,7 +1678,7 @@ int Sprite_setGradient0(
         CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
     }
 
-    return 1;
+    return res;
 }
 
 int Sprite_setForegroundGradient(
@@ -1480,8 +1741,18 @@ int Sprite_setBackgroundGradientAll(
 
 // Utility Methods - Transformations
 
+// declared in src/common/core/builder.c
+extern int _rotateGrids(
+    char** data, char*** ansi, int width, int height, double radians
+);
+extern int _scaleGrids(
+    char** data, char*** ansi, int width, int height, double scale,
+    char*** newData, char**** newAnsi, int* newWidth, int* newHeight
+);
+
 int Sprite_rotate(CmdFX_Sprite* sprite, double radians) {
     if (sprite == 0) return -1;
+    if (!_Sprite_ownData(sprite)) return -1;
 
     // Remove Sprite if Drawn
     if (sprite->id != 0) {
@@ -1489,9 +1760,10 @@ int Sprite_rotate(CmdFX_Sprite* sprite, double radians) {
         Sprite_remove0(sprite);
     }
 
-    if (sprite->data != 0) Char2DBuilder_rotate(sprite->data, radians);
-
-    if (sprite->ansi != 0) String2DBuilder_rotate(sprite->ansi, radians);
+    // glyphs and styles share one transform table
+    int r = _rotateGrids(
+        sprite->data, sprite->ansi, sprite->width, sprite->height, radians
+    );
 
     // Redraw Sprite if Drawn
     if (sprite->id != 0) {
@@ -1499,7 +1771,7 @@ int Sprite_rotate(CmdFX_Sprite* sprite, double radians) {
         CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
     }
 
-    return 0;
+    return r;
 }
 
 double Sprite_getRotationAngle(CmdFX_Sprite* sprite) {
@@ -1511,6 +1783,7 @@ double Sprite_getRotationAngle(CmdFX_Sprite* sprite) {
 
 int Sprite_hFlip(CmdFX_Sprite* sprite) {
     if (sprite == 0) return -1;
+    if (!_Sprite_ownData(sprite)) return -1;
 
     // Remove Sprite if Drawn
     if (sprite->id != 0) {
@@ -1533,6 +1806,7 @@ int Sprite_hFlip(CmdFX_Sprite* sprite) {
 
 int Sprite_vFlip(CmdFX_Sprite* sprite) {
     if (sprite == 0) return -1;
+    if (!_Sprite_ownData(sprite)) return -1;
 
     // Remove Sprite if Drawn
     if (sprite->id != 0) {
@@ -1555,6 +1829,7 @@ int Sprite_vFlip(CmdFX_Sprite* sprite) {
 
 int Sprite_scale(CmdFX_Sprite* sprite, double scale) {
     if (sprite == 0) return -1;
+    if (!_Sprite_ownData(sprite)) return -1;
 
     // Remove Sprite if Drawn
     if (sprite->id != 0) {
@@ -1562,14 +1837,37 @@ int Sprite_scale(CmdFX_Sprite* sprite, double scale) {
         Sprite_remove0(sprite);
     }
 
-    if (sprite->data != 0) {
-        char** newData = Char2DBuilder_scale(sprite->data, scale);
-        sprite->data = newData;
-    }
+    char** data = 0;
+    char*** ansi = 0;
+    int width = 0;
+    int height = 0;
+    int r = _scaleGrids(
+        sprite->data, sprite->ansi, sprite->width, sprite->height, scale,
+        &data, &ansi, &width, &height
+    );
 
-    if (sprite->ansi != 0) {
-        char*** newAnsi = String2DBuilder_scale(sprite->ansi, scale);
-        sprite->ansi = newAnsi;
+    if (r == 0) {
+        // the style strings were moved into the new grid
+        for (int i = 0; sprite->data != 0 && i < sprite->height; i++)
+            free(sprite->data[i]);
+        free(sprite->data);
+        for (int i = 0; sprite->ansi != 0 && i < sprite->height; i++)
+            free(sprite->ansi[i]);
+        free(sprite->ansi);
+
+        // keep the active costume slot pointing at the live grids
+        CmdFX_SpriteCostumes* costumes = Sprite_getCostumes(sprite);
+        for (int i = 0; costumes != 0 && i < costumes->costumeCount; i++) {
+            if (costumes->costumes[i] == sprite->data)
+                costumes->costumes[i] = data;
+            if (sprite->ansi != 0 && costumes->ansiCostumes[i] == sprite->ansi)
+                costumes->ansiCostumes[i] = ansi;
+        }
+
+        sprite->data = data;
+        sprite->ansi = ansi;
+        sprite->width = width;
+        sprite->height = height;
     }
 
     // Redraw Sprite if Drawn
@@ -1578,11 +1876,12 @@ int Sprite_scale(CmdFX_Sprite* sprite, double scale) {
         CmdFX_tryUnlockMutex(_CANVAS_MUTEX);
     }
 
-    return 0;
+    return r;
 }
 
 int Sprite_transpose(CmdFX_Sprite* sprite) {
     if (sprite == 0) return -1;
+    if (!_Sprite_ownData(sprite)) return -1;
 
     // Remove Sprite if Drawn
     if (sprite->id != 0) {
@@ -0,0 +1,124 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cmdfx/core/util.h"
+#include "common/core/stats.h"
+
+// declared in src/<platform>/core/util.c
+extern unsigned long long _Platform_monotonicNanos();
+
+// a ring of the latest timings of a stage; writers claim a slot by bumping
+// the count, so a slot being written may briefly hold an older timing
+typedef struct _StageRing {
+    atomic_ullong samples[CMDFX_FRAME_STATS_SAMPLES];
+    atomic_ulong count;
+} _StageRing;
+
+static _StageRing _rings[CMDFX_FRAME_STAGE_COUNT];
+static atomic_int _enabled = 0;
+
+static const char* _stageNames[CMDFX_FRAME_STAGE_COUNT] = {
+    "input",
+    "engine_tick",
+    "apply_motion",
+    "scene_tick",
+    "sprite_draw",
+    "flush",
+};
+
+unsigned long long CmdFX_stats_begin() {
+    if (!atomic_load_explicit(&_enabled, memory_order_relaxed)) return 0;
+
+    unsigned long long now = _Platform_monotonicNanos();
+    return now == 0 ? 1 : now;
+}
+
+void CmdFX_stats_end(CmdFX_FrameStage stage, unsigned long long start) {
+    if (start == 0) return;
+    if (stage < 0 || stage >= CMDFX_FRAME_STAGE_COUNT) return;
+
+    unsigned long long now = _Platform_monotonicNanos();
+    unsigned long long elapsed = now > start ? now - start : 0;
+
+    _StageRing* ring = &_rings[stage];
+    unsigned long slot = atomic_fetch_add_explicit(
+        &ring->count, 1, memory_order_relaxed
+    );
+    atomic_store_explicit(
+        &ring->samples[slot % CMDFX_FRAME_STATS_SAMPLES], elapsed,
+        memory_order_relaxed
+    );
+}
+
+void CmdFX_setFrameStatsEnabled(int enabled) {
+    atomic_store(&_enabled, enabled ? 1 : 0);
+}
+
+int CmdFX_isFrameStatsEnabled() {
+    return atomic_load(&_enabled);
+}
+
+static int _compareSamples(const void* a, const void* b) {
+    unsigned long long x = *(const unsigned long long*) a;
+    unsigned long long y = *(const unsigned long long*) b;
+    return (x > y) - (x < y);
+}
+
+// nearest rank over sorted samples
+static double _percentile(
+    const unsigned long long* sorted, int n, int percent
+) {
+    int rank = (n * percent + 99) / 100;
+    if (rank < 1) rank = 1;
+    return sorted[rank - 1] / 1e6;
+}
+
+int CmdFX_getFrameStats(CmdFX_FrameStats* stats) {
+    if (stats == 0) return -1;
+
+    unsigned long long* sorted =
+        malloc(sizeof(unsigned long long) * CMDFX_FRAME_STATS_SAMPLES);
+    if (sorted == 0) return -1;
+
+    memset(stats, 0, sizeof(CmdFX_FrameStats));
+    for (int i = 0; i < CMDFX_FRAME_STAGE_COUNT; i++) {
+        _StageRing* ring = &_rings[i];
+        CmdFX_StageStats* stage = &stats->stages[i];
+
+        unsigned long count = atomic_load(&ring->count);
+        int n = count < CMDFX_FRAME_STATS_SAMPLES ? (int) count
+                                                  : CMDFX_FRAME_STATS_SAMPLES;
+        if (n == 0) continue;
+
+        double total = 0;
+        for (int j = 0; j < n; j++) {
+            sorted[j] = atomic_load_explicit(
+                &ring->samples[j], memory_order_relaxed
+            );
+            total += sorted[j];
+        }
+        qsort(sorted, n, sizeof(unsigned long long), _compareSamples);
+
+        stage->count = count;
+        stage->samples = n;
+        stage->mean = total / n / 1e6;
+        stage->p50 = _percentile(sorted, n, 50);
+        stage->p95 = _percentile(sorted, n, 95);
+        stage->p99 = _percentile(sorted, n, 99);
+        stage->max = sorted[n - 1] / 1e6;
+    }
+
+    free(sorted);
+    return 0;
+}
+
+void CmdFX_resetFrameStats() {
+    for (int i = 0; i < CMDFX_FRAME_STAGE_COUNT; i++)
+        atomic_store(&_rings[i].count, 0);
+}
+
+const char* CmdFX_getFrameStageName(CmdFX_FrameStage stage) {
+    if (stage < 0 || stage >= CMDFX_FRAME_STAGE_COUNT) return 0;
+    return _stageNames[stage];
+}
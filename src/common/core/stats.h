@@ -0,0 +1,30 @@
+/**
+ * @file stats.h
+ * @brief Internal frame stage timing for cmdfx.
+ *
+ * This is a private header. Each stage of a frame is wrapped in a begin/end
+ * pair, which records its elapsed time on a monotonic clock into a ring of
+ * the most recent timings for that stage. Rings are lock-free: any thread may
+ * record into any stage while another reads the summary through
+ * `CmdFX_getFrameStats`.
+ *
+ * While timing is disabled, a stage costs a single atomic load.
+ */
+#pragma once
+
+#include "cmdfx/core/util.h"
+
+/**
+ * @brief Starts timing a stage.
+ * @return The start time to pass to `CmdFX_stats_end`, or `0` if timing is
+ * disabled.
+ */
+unsigned long long CmdFX_stats_begin();
+
+/**
+ * @brief Records the time since a stage started.
+ * @param stage The stage that ran.
+ * @param start The start time from `CmdFX_stats_begin`. Nothing is recorded
+ * if it is `0`.
+ */
+void CmdFX_stats_end(CmdFX_FrameStage stage, unsigned long long start);
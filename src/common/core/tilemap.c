@@ -0,0 +1,329 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cmdfx/core/builder.h"
+#include "cmdfx/core/scenes.h"
+#include "cmdfx/core/tilemap.h"
+
+// defined by the platform scene engine loop
+extern int _scenesRunning;
+
+// Chunks
+
+// chunk index containing a tile, rounding toward negative infinity
+static int _chunkOf(int tile) {
+    if (tile >= 0) return tile / TILEMAP_CHUNK_SIZE;
+    return -((-tile + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE);
+}
+
+static CmdFX_TileChunk* _findChunk(CmdFX_TileMap* map, int cx, int cy) {
+    for (int i = 0; i < map->chunkCount; i++) {
+        CmdFX_TileChunk* chunk = map->chunks[i];
+        if (chunk->x == cx && chunk->y == cy) return chunk;
+    }
+
+    return 0;
+}
+
+static void _freeChunk(CmdFX_TileChunk* chunk) {
+    for (int i = 0; i < TILEMAP_CHUNK_SIZE; i++) free(chunk->tiles[i]);
+    free(chunk->tiles);
+    free(chunk);
+}
+
+static CmdFX_TileChunk* _loadChunk(CmdFX_TileMap* map, int cx, int cy) {
+    CmdFX_TileChunk* chunk = (CmdFX_TileChunk*) malloc(sizeof(CmdFX_TileChunk));
+    if (chunk == 0) return 0;
+
+    chunk->tiles =
+        Char2DBuilder_createFilled(TILEMAP_CHUNK_SIZE, TILEMAP_CHUNK_SIZE, ' ');
+    if (chunk->tiles == 0) {
+        free(chunk);
+        return 0;
+    }
+
+    chunk->x = cx;
+    chunk->y = cy;
+
+    int x0 = cx * TILEMAP_CHUNK_SIZE;
+    int y0 = cy * TILEMAP_CHUNK_SIZE;
+    int count = map->width - x0;
+    if (count > TILEMAP_CHUNK_SIZE) count = TILEMAP_CHUNK_SIZE;
+
+    // each chunk row is a single contiguous read from the file
+    for (int i = 0; i < TILEMAP_CHUNK_SIZE; i++) {
+        int y = y0 + i;
+        if (y >= map->height) break;
+
+        if (fseek(map->file, (long) y * map->stride + x0, SEEK_SET) != 0)
+            break;
+
+        char* row = chunk->tiles[i];
+        int read = (int) fread(row, 1, count, map->file);
+        for (int j = 0; j < read; j++)
+            if (row[j] == '\r' || row[j] == '\n' || row[j] == 0) row[j] = ' ';
+    }
+
+    return chunk;
+}
+
+// loads the chunks in range of the viewport and unloads the rest
+static int _streamChunks(CmdFX_TileMap* map) {
+    int radius = map->loadRadius < 0 ? 0 : map->loadRadius;
+
+    int cx1 = _chunkOf(map->cameraX) - radius;
+    int cy1 = _chunkOf(map->cameraY) - radius;
+    int cx2 = _chunkOf(map->cameraX + map->scene->width - 1) + radius;
+    int cy2 = _chunkOf(map->cameraY + map->scene->height - 1) + radius;
+
+    // chunks outside of the world are never loaded
+    int lastX = _chunkOf(map->width - 1);
+    int lastY = _chunkOf(map->height - 1);
+    if (cx1 < 0) cx1 = 0;
+    if (cy1 < 0) cy1 = 0;
+    if (cx2 > lastX) cx2 = lastX;
+    if (cy2 > lastY) cy2 = lastY;
+
+    int kept = 0;
+    for (int i = 0; i < map->chunkCount; i++) {
+        CmdFX_TileChunk* chunk = map->chunks[i];
+        if (chunk->x < cx1 || chunk->x > cx2 || chunk->y < cy1 ||
+            chunk->y > cy2) {
+            _freeChunk(chunk);
+            continue;
+        }
+
+        map->chunks[kept++] = chunk;
+    }
+    map->chunkCount = kept;
+
+    if (cx1 > cx2 || cy1 > cy2) return 0;
+
+    int needed = (cx2 - cx1 + 1) * (cy2 - cy1 + 1);
+    CmdFX_TileChunk** chunks = (CmdFX_TileChunk**) realloc(
+        map->chunks, sizeof(CmdFX_TileChunk*) * (needed > 0 ? needed : 1)
+    );
+    if (chunks == 0) return -1;
+    map->chunks = chunks;
+
+    for (int cy = cy1; cy <= cy2; cy++)
+        for (int cx = cx1; cx <= cx2; cx++) {
+            if (_findChunk(map, cx, cy) != 0) continue;
+
+            CmdFX_TileChunk* chunk = _loadChunk(map, cx, cy);
+            if (chunk == 0) return -1;
+
+            map->chunks[map->chunkCount++] = chunk;
+        }
+
+    return 0;
+}
+
+// gives a viewport cell its own copy of a palette entry, keeping the old
+// string when it already matches so most repaints allocate nothing
+static int _setCellAnsi(char** cell, const char* ansi) {
+    if (*cell == ansi) return 0;
+    if (*cell != 0 && ansi != 0 && strcmp(*cell, ansi) == 0) return 0;
+
+    char* copy = 0;
+    if (ansi != 0) {
+        int n = sizeof(char) * (strlen(ansi) + 1);
+        copy = malloc(n);
+        if (copy == 0) return -1;
+
+        memcpy(copy, ansi, n);
+    }
+
+    free(*cell);
+    *cell = copy;
+    return 0;
+}
+
+// copies the chunks intersecting the viewport into the viewport scene
+static int _renderViewport(CmdFX_TileMap* map) {
+    CmdFX_Scene* scene = map->scene;
+
+    for (int i = 0; i < scene->height; i++) {
+        char* row = scene->data[i];
+        int y = map->cameraY + i;
+
+        int j = 0;
+        while (j < scene->width) {
+            int x = map->cameraX + j;
+            int cx = _chunkOf(x);
+            int span = (cx + 1) * TILEMAP_CHUNK_SIZE - x;
+            if (span > scene->width - j) span = scene->width - j;
+
+            CmdFX_TileChunk* chunk = 0;
+            if (x >= 0 && x < map->width && y >= 0 && y < map->height)
+                chunk = _findChunk(map, cx, _chunkOf(y));
+
+            if (chunk == 0)
+                memset(row + j, ' ', span);
+            else
+                memcpy(
+                    row + j,
+                    chunk->tiles[y - chunk->y * TILEMAP_CHUNK_SIZE] +
+                        (x - cx * TILEMAP_CHUNK_SIZE),
+                    span
+                );
+
+            j += span;
+        }
+
+        // each cell owns its string, so the scene setters can free it
+        for (int k = 0; k < scene->width; k++) {
+            const char* ansi = map->palette[(unsigned char) row[k]];
+            if (_setCellAnsi(&scene->ansiData[i][k], ansi) != 0) return -1;
+        }
+    }
+
+    return 0;
+}
+
+// Tile Maps
+
+CmdFX_TileMap* TileMap_loadFromFile(
+    const char* path, int viewportWidth, int viewportHeight
+) {
+    if (path == 0) return 0;
+    if (viewportWidth < 1 || viewportHeight < 1) return 0;
+
+    FILE* file = fopen(path, "rb");
+    if (file == 0) return 0;
+
+    // the first line decides the width and the distance between rows
+    int width = 0;
+    long stride = 0;
+    int c;
+    while ((c = fgetc(file)) != EOF) {
+        stride++;
+        if (c == '\n') break;
+        if (c != '\r') width++;
+    }
+
+    if (width == 0 || fseek(file, 0, SEEK_END) != 0) {
+        fclose(file);
+        return 0;
+    }
+
+    long size = ftell(file);
+    int height = (int) ((size + stride - 1) / stride);
+
+    CmdFX_TileMap* map = (CmdFX_TileMap*) calloc(1, sizeof(CmdFX_TileMap));
+    if (map == 0) {
+        fclose(file);
+        return 0;
+    }
+
+    map->scene = Scene_create(viewportWidth, viewportHeight);
+    if (map->scene == 0 || Scene_register(map->scene) < 0) {
+        Scene_free(map->scene);
+        free(map);
+        fclose(file);
+        return 0;
+    }
+
+    map->width = width;
+    map->height = height;
+    map->loadRadius = 1;
+    map->file = file;
+    map->stride = stride;
+
+    if (_streamChunks(map) != 0 || _renderViewport(map) != 0) {
+        TileMap_free(map);
+        return 0;
+    }
+
+    return map;
+}
+
+int TileMap_free(CmdFX_TileMap* map) {
+    if (map == 0) return 0; // free(0) is a no-op
+
+    Scene_free(map->scene);
+
+    for (int i = 0; i < map->chunkCount; i++) _freeChunk(map->chunks[i]);
+    free(map->chunks);
+
+    for (int i = 0; i < 256; i++) free(map->palette[i]);
+    if (map->file != 0) fclose(map->file);
+
+    free(map);
+    return 0;
+}
+
+int TileMap_draw(CmdFX_TileMap* map, int x, int y) {
+    if (map == 0) return -1;
+
+    return Scene_draw(map->scene, x, y);
+}
+
+int TileMap_remove(CmdFX_TileMap* map) {
+    if (map == 0) return -1;
+
+    return Scene_remove(map->scene);
+}
+
+int TileMap_setCamera(CmdFX_TileMap* map, int x, int y) {
+    if (map == 0) return -1;
+
+    map->cameraX = x;
+    map->cameraY = y;
+    if (_streamChunks(map) != 0) return -1;
+    if (_renderViewport(map) != 0) return -1;
+
+    CmdFX_Scene* scene = map->scene;
+    if (scene->x == -1 && scene->y == -1) return 0;
+
+    Scene_markDirty(scene, 0, 0, scene->width, scene->height);
+    if (!_scenesRunning) tickCmdFXSceneEngine();
+
+    return 0;
+}
+
+int TileMap_moveCamera(CmdFX_TileMap* map, int dx, int dy) {
+    if (map == 0) return -1;
+
+    return TileMap_setCamera(map, map->cameraX + dx, map->cameraY + dy);
+}
+
+char TileMap_getTile(CmdFX_TileMap* map, int x, int y) {
+    if (map == 0) return 0;
+    if (x < 0 || y < 0 || x >= map->width || y >= map->height) return 0;
+
+    int cx = _chunkOf(x);
+    int cy = _chunkOf(y);
+    CmdFX_TileChunk* chunk = _findChunk(map, cx, cy);
+    if (chunk != 0)
+        return chunk->tiles[y - cy * TILEMAP_CHUNK_SIZE]
+                           [x - cx * TILEMAP_CHUNK_SIZE];
+
+    if (fseek(map->file, (long) y * map->stride + x, SEEK_SET) != 0) return 0;
+
+    int c = fgetc(map->file);
+    if (c == EOF) return 0;
+    if (c == '\r' || c == '\n') return ' ';
+
+    return (char) c;
+}
+
+int TileMap_setTileAnsi(CmdFX_TileMap* map, char tile, const char* ansi) {
+    if (map == 0) return -1;
+
+    char* copy = 0;
+    if (ansi != 0) {
+        int n = sizeof(char) * (strlen(ansi) + 1);
+        copy = malloc(n);
+        if (copy == 0) return -1;
+
+        strncpy(copy, ansi, n);
+    }
+
+    unsigned char index = (unsigned char) tile;
+    free(map->palette[index]);
+    map->palette[index] = copy;
+
+    return TileMap_setCamera(map, map->cameraX, map->cameraY);
+}
@@ -0,0 +1,301 @@
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cmdfx/core/util.h"
+#include "common/core/trace.h"
+
+#ifdef _MSC_VER
+    #define _THREAD_LOCAL __declspec(thread)
+#else
+    #define _THREAD_LOCAL _Thread_local
+#endif
+
+// events a thread can record in one trace; later ones are dropped
+#define _TRACE_EVENTS 16384
+
+// a buffer is owned by a live thread, free for any thread to claim, or
+// holding the events of an exited thread until the trace writes them
+#define _BUFFER_LIVE 0
+#define _BUFFER_IDLE 1
+#define _BUFFER_RETIRED 2
+
+typedef struct _TraceEvent {
+    const char* name;
+    const char* category;
+    const char* argName; // NULL for no argument
+    int arg;
+    unsigned long long start;
+    unsigned long long duration;
+} _TraceEvent;
+
+// a thread's events; only its thread writes them, and only while `writing`
+// is set, so the trace can wait for writers before reading
+typedef struct _TraceBuffer {
+    _TraceEvent events[_TRACE_EVENTS];
+    atomic_int count;
+    atomic_int writing;
+    atomic_ulong dropped;
+    _Atomic(const char*) name;
+    atomic_int state;
+    int tid;
+    struct _TraceBuffer* next;
+} _TraceBuffer;
+
+// buffers are kept for the life of the process and reused by every trace,
+// so a thread's pointer to its buffer never dangles; when a thread exits,
+// its buffer is handed to the next thread that records
+static _Atomic(_TraceBuffer*) _buffers = 0;
+static atomic_int _bufferCount = 0;
+static atomic_int _nextTid = 1;
+
+static atomic_int _tracing = 0;
+static FILE* _traceFile = 0;
+static unsigned long long _traceStart = 0;
+
+// declared in src/<platform>/core/util.c
+extern unsigned long long _Platform_monotonicNanos();
+extern int _Platform_releaseAtThreadExit(void* buffer);
+
+static _THREAD_LOCAL _TraceBuffer* _threadBuffer = 0;
+static _THREAD_LOCAL const char* _threadName = 0;
+
+
+static int _sameName(const char* a, const char* b) {
+    return a != 0 && b != 0 && strcmp(a, b) == 0;
+}
+
+// claims an idle buffer, or the retired buffer of an exited thread with the
+// same name, so a restarted thread keeps appending to its old timeline
+static _TraceBuffer* _claimBuffer() {
+    for (_TraceBuffer* b = atomic_load(&_buffers); b != 0; b = b->next) {
+        int state = _BUFFER_IDLE;
+        if (atomic_compare_exchange_strong(&b->state, &state, _BUFFER_LIVE))
+            return b;
+
+        state = _BUFFER_RETIRED;
+        if (_sameName(atomic_load(&b->name), _threadName) &&
+            atomic_compare_exchange_strong(&b->state, &state, _BUFFER_LIVE))
+            return b;
+    }
+
+    return 0;
+}
+
+static _TraceBuffer* _newBuffer() {
+    _TraceBuffer* buffer = calloc(1, sizeof(_TraceBuffer));
+    if (buffer == 0) return 0;
+
+    buffer->tid = atomic_fetch_add(&_nextTid, 1);
+
+    buffer->next = atomic_load(&_buffers);
+    while (!atomic_compare_exchange_weak(&_buffers, &buffer->next, buffer));
+
+    atomic_fetch_add(&_bufferCount, 1);
+    return buffer;
+}
+
+static _TraceBuffer* _getBuffer() {
+    if (_threadBuffer != 0) return _threadBuffer;
+
+    _TraceBuffer* buffer = _claimBuffer();
+    if (buffer == 0) buffer = _newBuffer();
+    if (buffer == 0) return 0;
+
+    atomic_store(&buffer->name, _threadName);
+
+    // if the platform cannot watch the thread, the buffer is never reused
+    _Platform_releaseAtThreadExit(buffer);
+
+    _threadBuffer = buffer;
+    return buffer;
+}
+
+void CmdFX_trace_releaseBuffer(void* buffer) {
+    _TraceBuffer* b = (_TraceBuffer*) buffer;
+    int recorded = atomic_load(&b->count) > 0 || atomic_load(&b->dropped) > 0;
+    atomic_store(&b->state, recorded ? _BUFFER_RETIRED : _BUFFER_IDLE);
+}
+
+int CmdFX_trace_countBuffers() {
+    return atomic_load(&_bufferCount);
+}
+
+static void _record(
+    const char* name, const char* category, const char* argName, int arg,
+    unsigned long long start
+) {
+    unsigned long long end = _Platform_monotonicNanos();
+
+    _TraceBuffer* buffer = _getBuffer();
+    if (buffer == 0) return;
+
+    // the trace stops by clearing _tracing and then waiting on `writing`, so
+    // either this sees it stopped or the trace sees this writing
+    atomic_store(&buffer->writing, 1);
+    if (!atomic_load(&_tracing)) {
+        atomic_store(&buffer->writing, 0);
+        return;
+    }
+
+    int n = atomic_load_explicit(&buffer->count, memory_order_relaxed);
+    if (n < _TRACE_EVENTS) {
+        _TraceEvent* event = &buffer->events[n];
+        event->name = name;
+        event->category = category;
+        event->argName = argName;
+        event->arg = arg;
+        event->start = start;
+        event->duration = end > start ? end - start : 0;
+        atomic_store_explicit(&buffer->count, n + 1, memory_order_release);
+    }
+    else
+        atomic_fetch_add_explicit(&buffer->dropped, 1, memory_order_relaxed);
+
+    atomic_store(&buffer->writing, 0);
+}
+
+unsigned long long CmdFX_trace_begin() {
+    if (!atomic_load_explicit(&_tracing, memory_order_relaxed)) return 0;
+
+    unsigned long long now = _Platform_monotonicNanos();
+    return now == 0 ? 1 : now;
+}
+
+void CmdFX_trace_end(
+    const char* name, const char* category, unsigned long long start
+) {
+    if (start == 0) return;
+    _record(name, category, 0, 0, start);
+}
+
+void CmdFX_trace_endArg(
+    const char* name, const char* category, unsigned long long start,
+    const char* argName, int arg
+) {
+    if (start == 0) return;
+    _record(name, category, argName, arg, start);
+}
+
+void CmdFX_trace_mutexWait(int id, unsigned long long start) {
+    if (start == 0) return;
+    if (_Platform_monotonicNanos() - start < CMDFX_TRACE_MIN_WAIT) return;
+
+    _record("mutex_wait", "mutex", "mutex", id, start);
+}
+
+void CmdFX_trace_nameThread(const char* name) {
+    _threadName = name;
+    if (_threadBuffer != 0) atomic_store(&_threadBuffer->name, name);
+}
+
+// Trace Files
+
+static double _micros(unsigned long long nanos) {
+    return nanos > _traceStart ? (nanos - _traceStart) / 1000.0 : 0;
+}
+
+static void _writeBuffer(_TraceBuffer* buffer) {
+    FILE* file = _traceFile;
+
+    const char* name = atomic_load(&buffer->name);
+    fprintf(
+        file,
+        ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+        "\"args\":{\"name\":\"",
+        buffer->tid
+    );
+    if (name != 0) fprintf(file, "%s\"}}", name);
+    else fprintf(file, "thread %d\"}}", buffer->tid);
+
+    int count = atomic_load_explicit(&buffer->count, memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+        _TraceEvent* event = &buffer->events[i];
+        fprintf(
+            file,
+            ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,"
+            "\"dur\":%.3f,\"pid\":1,\"tid\":%d",
+            event->name, event->category, _micros(event->start),
+            event->duration / 1000.0, buffer->tid
+        );
+        if (event->argName != 0)
+            fprintf(
+                file, ",\"args\":{\"%s\":%d}", event->argName, event->arg
+            );
+        fputc('}', file);
+    }
+}
+
+static void _stopAtExit() {
+    CmdFX_stopTrace();
+}
+
+int CmdFX_startTrace(const char* path) {
+    static int registered = 0;
+
+    if (path == 0) return -1;
+    if (_traceFile != 0) return -1;
+
+    _traceFile = fopen(path, "w");
+    if (_traceFile == 0) return -1;
+
+    // no writer records while _tracing is clear, so buffers can be emptied
+    for (_TraceBuffer* b = atomic_load(&_buffers); b != 0; b = b->next) {
+        atomic_store(&b->count, 0);
+        atomic_store(&b->dropped, 0);
+
+        int retired = _BUFFER_RETIRED;
+        atomic_compare_exchange_strong(&b->state, &retired, _BUFFER_IDLE);
+    }
+
+    if (!registered) {
+        atexit(_stopAtExit);
+        registered = 1;
+    }
+
+    _traceStart = _Platform_monotonicNanos();
+    atomic_store(&_tracing, 1);
+    return 0;
+}
+
+int CmdFX_isTracing() {
+    return atomic_load(&_tracing);
+}
+
+int CmdFX_stopTrace() {
+    if (_traceFile == 0) return -1;
+
+    atomic_store(&_tracing, 0);
+
+    unsigned long dropped = 0;
+    fprintf(
+        _traceFile,
+        "{\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\","
+        "\"pid\":1,\"args\":{\"name\":\"cmdfx\"}}"
+    );
+    for (_TraceBuffer* b = atomic_load(&_buffers); b != 0; b = b->next) {
+        // idle buffers belong to no thread and hold nothing from this trace
+        if (atomic_load(&b->state) == _BUFFER_IDLE) continue;
+        while (atomic_load(&b->writing));
+
+        _writeBuffer(b);
+        dropped += atomic_load(&b->dropped);
+
+        // the events of an exited thread are written, so its buffer is free
+        int retired = _BUFFER_RETIRED;
+        atomic_compare_exchange_strong(&b->state, &retired, _BUFFER_IDLE);
+    }
+    fprintf(
+        _traceFile,
+        "\n],\"displayTimeUnit\":\"ms\","
+        "\"otherData\":{\"droppedEvents\":\"%lu\"}}\n",
+        dropped
+    );
+
+    int result = ferror(_traceFile) ? -1 : 0;
+    if (fclose(_traceFile) != 0) result = -1;
+    _traceFile = 0;
+
+    return result;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file trace.h
+ * @brief Internal trace-event recording for cmdfx.
+ *
+ * This is a private header. While a trace is running (`CmdFX_startTrace`),
+ * spans of engine work are recorded into a buffer owned by the thread that
+ * ran them, so recording never takes a lock. The buffers are written out as
+ * Chrome trace-event JSON when the trace stops, or at exit. When a thread
+ * exits, its buffer is reused by a later thread once its events are written.
+ *
+ * Spans are timed on the same monotonic clock as the frame stats, so a
+ * change to the system time cannot shift or collapse them.
+ *
+ * Names and categories must be string literals; only the pointers are kept.
+ * While no trace is running, a span costs a single atomic load.
+ */
+#pragma once
+
+/**
+ * @brief Starts a span.
+ * @return The start time to pass to `CmdFX_trace_end`, or `0` if no trace is
+ * running.
+ */
+unsigned long long CmdFX_trace_begin();
+
+/**
+ * @brief Records a span that started at `start` and ends now.
+ * @param name The name of the span.
+ * @param category The category of the span.
+ * @param start The start time from `CmdFX_trace_begin`. Nothing is recorded
+ * if it is `0`.
+ */
+void CmdFX_trace_end(
+    const char* name, const char* category, unsigned long long start
+);
+
+/**
+ * @brief Records a span with a single integer argument.
+ * @param name The name of the span.
+ * @param category The category of the span.
+ * @param start The start time from `CmdFX_trace_begin`.
+ * @param argName The name of the argument.
+ * @param arg The value of the argument.
+ */
+void CmdFX_trace_endArg(
+    const char* name, const char* category, unsigned long long start,
+    const char* argName, int arg
+);
+
+/**
+ * @brief Records a wait on an internal mutex.
+ *
+ * Only waits of at least `CMDFX_TRACE_MIN_WAIT` nanoseconds are recorded,
+ * so uncontended locks stay out of the trace.
+ *
+ * @param id The ID of the mutex.
+ * @param start The start time from `CmdFX_trace_begin`, taken before the
+ * lock.
+ */
+void CmdFX_trace_mutexWait(int id, unsigned long long start);
+
+/** The shortest mutex wait recorded, in nanoseconds. */
+#define CMDFX_TRACE_MIN_WAIT 1000
+
+/**
+ * @brief Names the calling thread in traces.
+ *
+ * This can be called before any trace runs; threads that are never named
+ * appear by number.
+ *
+ * @param name The name of the thread.
+ */
+void CmdFX_trace_nameThread(const char* name);
+
+/**
+ * @brief Hands the trace buffer of an exiting thread back for reuse.
+ *
+ * The platform calls this on the thread's exit. Its events stay in the
+ * buffer until the running trace writes them, unless a thread of the same
+ * name claims it first and keeps recording into it.
+ *
+ * @param buffer The buffer the thread recorded into.
+ */
+void CmdFX_trace_releaseBuffer(void* buffer);
+
+/**
+ * @brief Counts the trace buffers allocated so far.
+ * @return The number of buffers, in use or idle.
+ */
+int CmdFX_trace_countBuffers();
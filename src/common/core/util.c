@@ -1,9 +1,11 @@
+#include <string.h>
 #include <time.h>
 
 #define _USE_MATH_DEFINES
 #include <math.h>
 
 #include "cmdfx/core/util.h"
+#include "common/core/trace.h"
 
 #define FLOAT_EPSILON 1e-8
 
@@ -150,6 +152,151 @@ int lerp_color(int rgb1, int rgb2, double t) {
     return hsv_to_rgb(h, s, v);
 }
 
+// Math - Batches
+
+// the batch kernels below give the same results as their scalar
+// counterparts, but they choose between cases with bit masks rather than
+// branches and call nothing but fabs, so their loops can be vectorized
+
+// masks of all ones or all zeros, from an int or from comparing two finite
+// doubles, where the sign of their difference stands in for `a < b`; the
+// compiler cannot vectorize double comparisons feeding integer masks
+static inline unsigned long long _maskIf(int pick) {
+    return -(unsigned long long) (pick != 0);
+}
+
+static inline unsigned long long _maskBelow(double a, double b) {
+    double difference = a - b;
+    unsigned long long bits;
+    memcpy(&bits, &difference, sizeof(bits));
+    return -(bits >> 63);
+}
+
+// picks `a` under the mask and `b` elsewhere; done on the bits, since a
+// ternary would let the compiler move the arithmetic behind a branch
+static inline double _select(unsigned long long mask, double a, double b) {
+    unsigned long long x, y;
+    memcpy(&x, &a, sizeof(x));
+    memcpy(&y, &b, sizeof(y));
+
+    x = (x & mask) | (y & ~mask);
+    memcpy(&a, &x, sizeof(a));
+    return a;
+}
+
+void rgb_to_hsv_batch(
+    const int* rgb, double* h, double* s, double* v, int count
+) {
+    for (int n = 0; n < count; n++) {
+        double r = ((rgb[n] >> 16) & 0xFF) / 255.0;
+        double g = ((rgb[n] >> 8) & 0xFF) / 255.0;
+        double b = (rgb[n] & 0xFF) / 255.0;
+
+        double min = _select(_maskBelow(r, g), r, g);
+        min = _select(_maskBelow(min, b), min, b);
+        double max = _select(_maskBelow(g, r), r, g);
+        max = _select(_maskBelow(b, max), max, b);
+        double delta = max - min;
+
+        // a gray divides by one instead, keeping the unused hues finite;
+        // (g - b) / delta is within one turn, so it needs no fmod
+        unsigned long long grey = _maskBelow(delta, 0.00001);
+        double d = _select(grey, 1.0, delta);
+        double hr = 60.0 * ((g - b) / d);
+        double hg = 60.0 * (((b - r) / d) + 2.0);
+        double hb = 60.0 * (((r - g) / d) + 4.0);
+
+        double hue =
+            _select(_maskBelow(fabs(g - max), FLOAT_EPSILON), hg, hb);
+        hue = _select(_maskBelow(fabs(r - max), FLOAT_EPSILON), hr, hue);
+        hue = _select(grey, 0.0, hue);
+
+        h[n] = _select(_maskBelow(hue, 0.0), hue + 360.0, hue);
+        s[n] = delta / _select(_maskBelow(0.0, max), max, 1.0);
+        v[n] = max;
+    }
+}
+
+static double _wrapHue(double h) {
+    if (h >= 0.0 && h < 360.0) return h;
+
+    h = fmod(h, 360.0);
+    return h < 0.0 ? h + 360.0 : h;
+}
+
+// hues must already be within [0, 360)
+static void _hsvToRgbKernel(
+    const double* h, const double* s, const double* v, int* rgb, int count
+) {
+    for (int n = 0; n < count; n++) {
+        // clamps the saturation at zero; exact for either sign
+        double sn = (s[n] + fabs(s[n])) * 0.5;
+        double vn = v[n];
+
+        double hh = h[n] / 60.0;
+        int i = (int) hh;
+        double f = hh - i;
+
+        double p = vn * (1.0 - sn);
+        double q = vn * (1.0 - (sn * f));
+        double t = vn * (1.0 - (sn * (1.0 - f)));
+
+        double r = _select(_maskIf(i == 4), t, vn);
+        r = _select(_maskIf(i == 2 || i == 3), p, r);
+        r = _select(_maskIf(i == 1), q, r);
+
+        double g = _select(_maskIf(i == 3), q, p);
+        g = _select(_maskIf(i == 1 || i == 2), vn, g);
+        g = _select(_maskIf(i == 0), t, g);
+
+        double b = _select(_maskIf(i >= 5), q, vn);
+        b = _select(_maskIf(i == 2), t, b);
+        b = _select(_maskIf(i < 2), p, b);
+
+        rgb[n] = ((int) (r * 255.0) << 16) | ((int) (g * 255.0) << 8) |
+                 (int) (b * 255.0);
+    }
+}
+
+void hsv_to_rgb_batch(
+    const double* h, const double* s, const double* v, int* rgb, int count
+) {
+    // hues are wrapped a chunk at a time first, so only a hue outside one
+    // turn pays for fmod and the kernel stays free of calls
+    double hues[64];
+    for (int start = 0; start < count; start += 64) {
+        int n = count - start < 64 ? count - start : 64;
+
+        for (int i = 0; i < n; i++) hues[i] = _wrapHue(h[start + i]);
+        _hsvToRgbKernel(hues, s + start, v + start, rgb + start, n);
+    }
+}
+
+void lerp_color_batch(
+    int rgb1, int rgb2, const double* t, int* rgb, int count
+) {
+    double h1, s1, v1;
+    rgb_to_hsv(rgb1, &h1, &s1, &v1);
+
+    double h2, s2, v2;
+    rgb_to_hsv(rgb2, &h2, &s2, &v2);
+
+    // the endpoints are converted once; the rest is done a chunk at a time
+    double h[64], s[64], v[64];
+    for (int start = 0; start < count; start += 64) {
+        int n = count - start < 64 ? count - start : 64;
+        const double* tn = t + start;
+
+        for (int i = 0; i < n; i++) {
+            h[i] = lerp_d(h1, h2, tn[i]);
+            s[i] = lerp_d(s1, s2, tn[i]);
+            v[i] = lerp_d(v1, v2, tn[i]);
+        }
+
+        hsv_to_rgb_batch(h, s, v, rgb + start, n);
+    }
+}
+
 // Multithreading
 
 void CmdFX_tryLockMutex(int id) {
@@ -159,7 +306,9 @@ void CmdFX_tryLockMutex(int id) {
     void* mutex = CmdFX_getInternalMutex(id);
     if (mutex == 0) return;
 
+    unsigned long long start = CmdFX_trace_begin();
     CmdFX_lockMutex(mutex);
+    CmdFX_trace_mutexWait(id, start);
 }
 
 void CmdFX_tryUnlockMutex(int id) {
@@ -9,6 +9,8 @@
 #include "cmdfx/physics/force.h"
 #include "cmdfx/physics/mass.h"
 #include "cmdfx/physics/motion.h"
+#include "common/core/stats.h"
+#include "common/core/trace.h"
 
 #define _STATIC_SPRITE_MUTEX 8
 
@@ -197,7 +199,7 @@ int Engine_cleanup() {
 extern void _lockSpritePair(const CmdFX_Sprite* a, const CmdFX_Sprite* b);
 extern void _unlockSpritePair(const CmdFX_Sprite* a, const CmdFX_Sprite* b);
 
-CmdFX_Sprite** Engine_tick() {
+static CmdFX_Sprite** _tick() {
     CmdFX_Sprite** sprites = Canvas_getDrawnSprites();
     if (sprites == 0) return 0;
 
@@ -301,3 +303,13 @@ CmdFX_Sprite** Engine_tick() {
     modified[c] = 0;
     return modified;
 }
+
+CmdFX_Sprite** Engine_tick() {
+    unsigned long long start = CmdFX_stats_begin();
+    unsigned long long span = CmdFX_trace_begin();
+    CmdFX_Sprite** modified = _tick();
+    CmdFX_trace_end("Engine_tick", "physics", span);
+    CmdFX_stats_end(CMDFX_FRAME_STAGE_ENGINE_TICK, start);
+
+    return modified;
+}
@@ -0,0 +1,509 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/core/trace.h"
+#include "common/sound/mixer.h"
+#include "common/sound/wave.h"
+
+typedef struct _MixerVoice {
+    int tag; // 0 if the voice is free
+    const CmdFX_MixerSample* sample;
+    CmdFX_MixerStream* stream;
+    int block; // the block of a compressed sample in the voice's cache
+    int position;
+    unsigned int fraction; // between frames, in 1/65536ths
+    int loops;
+    int paused;
+    float gains[CMDFX_MIXER_CHANNELS];
+    unsigned long order;
+} _MixerVoice;
+
+// frames mixed per pass, so the accumulator stays in cache
+#define _MIX_CHUNK 256
+// the step of a voice that plays at the mixer rate
+#define _UNIT_STEP 65536
+
+static _MixerVoice _voices[CMDFX_MIXER_MAX_VOICES];
+static int _rate = CMDFX_MIXER_RATE;
+static int _voiceLimit = CMDFX_MIXER_DEFAULT_VOICES;
+static unsigned long _nextOrder = 1;
+static float _masterGain = 1.0f;
+static float _mix[_MIX_CHUNK * CMDFX_MIXER_CHANNELS];
+
+// the decoded block of each voice playing a compressed sample
+static short _blockCache[CMDFX_MIXER_MAX_VOICES]
+                        [CMDFX_WAVE_MAX_BLOCK_FRAMES * CMDFX_MIXER_CHANNELS];
+
+// the output, as opened by the backend
+static int _latency = CMDFX_MIXER_DEFAULT_LATENCY;
+static int _periodFrames = 0;
+static int _bufferFrames = 0;
+static unsigned long _underruns = 0;
+static unsigned long _lateWrites = 0;
+static unsigned long _periods = 0;
+
+static double _clamp(double value, double min, double max) {
+    if (value < min) return min;
+    if (value > max) return max;
+    return value;
+}
+
+// a balance law, so a centered voice keeps its full gain on both sides
+static void _setGain(_MixerVoice* voice, double gain, double pan) {
+    gain = _clamp(gain, 0, 1);
+    pan = _clamp(pan, -1, 1);
+
+    voice->gains[0] = (float) (gain * (pan > 0 ? 1 - pan : 1));
+    voice->gains[1] = (float) (gain * (pan < 0 ? 1 + pan : 1));
+}
+
+static int _matches(const _MixerVoice* voice, int tag) {
+    return voice->tag != 0 && (tag == 0 || voice->tag == tag);
+}
+
+static void _releaseVoice(_MixerVoice* voice) {
+    if (voice->stream) voice->stream->released = 1;
+
+    voice->tag = 0;
+    voice->sample = NULL;
+    voice->stream = NULL;
+}
+
+// Voices
+
+static _MixerVoice* _stealVoice() {
+    _MixerVoice* victim = NULL;
+    float quietest = 0;
+
+    for (int i = 0; i < CMDFX_MIXER_MAX_VOICES; i++) {
+        _MixerVoice* voice = &_voices[i];
+        if (voice->tag == 0) continue;
+
+        float level = voice->gains[0] > voice->gains[1] ? voice->gains[0]
+                                                        : voice->gains[1];
+        if (victim == NULL || level < quietest ||
+            (level == quietest && voice->order < victim->order)) {
+            victim = voice;
+            quietest = level;
+        }
+    }
+
+    return victim;
+}
+
+static _MixerVoice* _allocVoice() {
+    int active = 0;
+    _MixerVoice* empty = NULL;
+
+    for (int i = 0; i < CMDFX_MIXER_MAX_VOICES; i++) {
+        if (_voices[i].tag != 0)
+            active++;
+        else if (empty == NULL)
+            empty = &_voices[i];
+    }
+
+    if (active < _voiceLimit && empty != NULL) return empty;
+    return _stealVoice();
+}
+
+int CmdFX_mixer_play(
+    const CmdFX_MixerSample* sample, int loops, double gain, double pan,
+    int tag
+) {
+    if (!sample || sample->frames < 1) return -1;
+    if (!sample->samples && !sample->blocks) return -1;
+    if (sample->rate < 1) return -1;
+    if (loops == 0 || loops < -1) return -1;
+    if (tag < 1) return -1;
+
+    _MixerVoice* voice = _allocVoice();
+    if (!voice) return -1;
+
+    _releaseVoice(voice);
+    voice->tag = tag;
+    voice->sample = sample;
+    voice->block = -1;
+    voice->position = 0;
+    voice->fraction = 0;
+    voice->loops = loops;
+    voice->paused = 0;
+    voice->order = _nextOrder++;
+    _setGain(voice, gain, pan);
+
+    return (int) (voice - _voices);
+}
+
+int CmdFX_mixer_playStream(
+    CmdFX_MixerStream* stream, double gain, double pan, int tag
+) {
+    if (!stream || !stream->data || stream->rate < 1) return -1;
+    if (tag < 1) return -1;
+
+    _MixerVoice* voice = _allocVoice();
+    if (!voice) return -1;
+
+    _releaseVoice(voice);
+    voice->tag = tag;
+    voice->stream = stream;
+    voice->position = 0;
+    voice->fraction = 0;
+    voice->loops = -1;
+    voice->paused = 0;
+    voice->order = _nextOrder++;
+    _setGain(voice, gain, pan);
+
+    return (int) (voice - _voices);
+}
+
+int CmdFX_mixer_stop(int tag) {
+    int count = 0;
+    for (int i = 0; i < CMDFX_MIXER_MAX_VOICES; i++) {
+        if (!_matches(&_voices[i], tag)) continue;
+
+        _releaseVoice(&_voices[i]);
+        count++;
+    }
+
+    return count;
+}
+
+int CmdFX_mixer_pause(int tag, int paused) {
+    paused = paused != 0;
+
+    int count = 0;
+    for (int i = 0; i < CMDFX_MIXER_MAX_VOICES; i++) {
+        if (!_matches(&_voices[i], tag)) continue;
+        if (_voices[i].paused == paused) continue;
+
+        _voices[i].paused = paused;
+        count++;
+    }
+
+    return count;
+}
+
+int CmdFX_mixer_setGain(int tag, double gain, double pan) {
+    int count = 0;
+    for (int i = 0; i < CMDFX_MIXER_MAX_VOICES; i++) {
+        if (!_matches(&_voices[i], tag)) continue;
+
+        _setGain(&_voices[i], gain, pan);
+        count++;
+    }
+
+    return count;
+}
+
+int CmdFX_mixer_count(int tag, int paused) {
+    int count = 0;
+    for (int i = 0; i < CMDFX_MIXER_MAX_VOICES; i++) {
+        if (!_matches(&_voices[i], tag)) continue;
+        if (paused != -1 && _voices[i].paused != (paused != 0)) continue;
+
+        count++;
+    }
+
+    return count;
+}
+
+int CmdFX_mixer_setRate(int rate) {
+    if (rate < 1) return -1;
+
+    _rate = rate;
+    return 0;
+}
+
+int CmdFX_mixer_getRate() {
+    return _rate;
+}
+
+void CmdFX_mixer_setMasterGain(double gain) {
+    _masterGain = (float) _clamp(gain, 0, 1);
+}
+
+int CmdFX_mixer_setVoiceLimit(int limit) {
+    if (limit < 1 || limit > CMDFX_MIXER_MAX_VOICES) return -1;
+
+    _voiceLimit = limit;
+    return 0;
+}
+
+int CmdFX_mixer_getVoiceLimit() {
+    return _voiceLimit;
+}
+
+// Device
+
+int CmdFX_mixer_setLatency(int milliseconds) {
+    if (milliseconds < 1 || milliseconds > 1000) return -1;
+
+    _latency = milliseconds;
+    return 0;
+}
+
+int CmdFX_mixer_getLatency() {
+    return _latency;
+}
+
+int CmdFX_mixer_getPeriodFrames() {
+    int frames = (int) ((long long) _latency * _rate / 1000);
+    frames /= CMDFX_MIXER_PERIODS;
+
+    // too short a period costs more in wakeups than it saves in latency
+    return frames < 32 ? 32 : frames;
+}
+
+void CmdFX_mixer_setDevice(int rate, int periodFrames, int bufferFrames) {
+    CmdFX_mixer_setRate(rate);
+    _periodFrames = periodFrames;
+    _bufferFrames = bufferFrames;
+    CmdFX_mixer_resetStats();
+}
+
+void CmdFX_mixer_countUnderrun() {
+    _underruns++;
+}
+
+void CmdFX_mixer_countLateWrite() {
+    _lateWrites++;
+}
+
+void CmdFX_mixer_getStats(CmdFX_SoundStats* stats) {
+    stats->underruns = _underruns;
+    stats->lateWrites = _lateWrites;
+    stats->periods = _periods;
+    stats->rate = _rate;
+    stats->periodFrames = _periodFrames;
+    stats->bufferFrames = _bufferFrames;
+    stats->latency = _bufferFrames * 1000.0 / _rate;
+}
+
+void CmdFX_mixer_resetStats() {
+    _underruns = 0;
+    _lateWrites = 0;
+    _periods = 0;
+}
+
+// Rendering
+
+static unsigned int _step(int rate) {
+    return (unsigned int) (((unsigned long long) rate * _UNIT_STEP) / _rate);
+}
+
+// the gain stage: a plain multiply-add over interleaved samples, which
+// compilers vectorize
+static void _mixFrames(
+    float* restrict dst, const short* restrict src, int count,
+    const float* gains
+) {
+    float left = gains[0];
+    float right = gains[1];
+    for (int i = 0; i < count * 2; i += 2) {
+        dst[i] += src[i] * left;
+        dst[i + 1] += src[i + 1] * right;
+    }
+}
+
+// mixes up to the given frames from a source of another rate, interpolating
+// between neighbouring frames; past the last frame of the source comes the
+// next frame if there is one, or the last frame is held
+static int _mixResampled(
+    float* dst, const short* src, int available, const short* next,
+    int* position, unsigned int* fraction, unsigned int step, int frames,
+    const float* gains
+) {
+    int pos = *position;
+    unsigned int frac = *fraction;
+
+    int i = 0;
+    for (; i < frames && pos < available; i++) {
+        const short* a = src + pos * 2;
+        const short* b = pos + 1 < available ? a + 2 : next ? next : a;
+        float t = frac * (1.0f / _UNIT_STEP);
+
+        dst[i * 2] += (a[0] + (b[0] - a[0]) * t) * gains[0];
+        dst[i * 2 + 1] += (a[1] + (b[1] - a[1]) * t) * gains[1];
+
+        frac += step;
+        pos += (int) (frac / _UNIT_STEP);
+        frac %= _UNIT_STEP;
+    }
+
+    *position = pos;
+    *fraction = frac;
+    return i;
+}
+
+// mixes up to the given frames from a source; returns the frames written,
+// which is fewer only when the source runs out
+static int _mixSource(
+    float* dst, const short* src, int available, const short* next,
+    int* position, unsigned int* fraction, unsigned int step, int frames,
+    const float* gains
+) {
+    if (step != _UNIT_STEP || *fraction != 0)
+        return _mixResampled(
+            dst, src, available, next, position, fraction, step, frames,
+            gains
+        );
+
+    int remaining = available - *position;
+    int count = frames < remaining ? frames : remaining;
+    if (count < 1) return 0;
+
+    _mixFrames(dst, src + *position * 2, count, gains);
+    *position += count;
+    return count;
+}
+
+static void _mixSample(_MixerVoice* voice, int frames) {
+    const CmdFX_MixerSample* sample = voice->sample;
+    unsigned int step = _step(sample->rate);
+    float* dst = _mix;
+
+    while (frames > 0 && voice->tag != 0) {
+        int count = _mixSource(
+            dst, sample->samples, sample->frames, NULL, &voice->position,
+            &voice->fraction, step, frames, voice->gains
+        );
+
+        dst += count * CMDFX_MIXER_CHANNELS;
+        frames -= count;
+
+        if (voice->position < sample->frames) break;
+
+        // a downsampled voice may step past the end, into the next loop
+        if (voice->loops == -1 || --voice->loops > 0)
+            voice->position -= sample->frames;
+        else
+            _releaseVoice(voice);
+    }
+}
+
+// plays a compressed sample a block at a time, decoding each block into the
+// voice's cache once as it is reached
+static void _mixCompressed(_MixerVoice* voice, int frames) {
+    const CmdFX_MixerSample* sample = voice->sample;
+    short* cache = _blockCache[voice - _voices];
+    unsigned int step = _step(sample->rate);
+    float* dst = _mix;
+
+    while (frames > 0 && voice->tag != 0) {
+        int block = voice->position / sample->blockFrames;
+        int start = block * sample->blockFrames;
+        int available = sample->frames - start;
+        if (available > sample->blockFrames) available = sample->blockFrames;
+
+        const unsigned char* data =
+            sample->blocks + (long) block * sample->blockSize;
+        if (voice->block != block) {
+            CmdFX_wave_decodeBlock(data, sample->channels, cache, available);
+            voice->block = block;
+        }
+
+        // every block starts with a raw frame, which lets interpolation
+        // reach into the next block without decoding it
+        short first[CMDFX_MIXER_CHANNELS];
+        const short* next = NULL;
+        if (start + available < sample->frames) {
+            CmdFX_wave_decodeBlock(
+                data + sample->blockSize, sample->channels, first, 1
+            );
+            next = first;
+        }
+
+        int position = voice->position - start;
+        int count = _mixSource(
+            dst, cache, available, next, &position, &voice->fraction, step,
+            frames, voice->gains
+        );
+
+        voice->position = start + position;
+        dst += count * CMDFX_MIXER_CHANNELS;
+        frames -= count;
+
+        if (voice->position < sample->frames) continue;
+
+        if (voice->loops == -1 || --voice->loops > 0)
+            voice->position -= sample->frames;
+        else
+            _releaseVoice(voice);
+    }
+}
+
+static void _mixStream(_MixerVoice* voice, int frames) {
+    CmdFX_MixerStream* stream = voice->stream;
+    unsigned int step = _step(stream->rate);
+    float* dst = _mix;
+
+    while (frames > 0) {
+        int filled = stream->frames[stream->chunk];
+        if (filled == 0) {
+            // the reader is behind; the rest of the pass stays silent
+            if (stream->ended) _releaseVoice(voice);
+            break;
+        }
+
+        const short* src = stream->data + stream->chunk *
+                                              CMDFX_MIXER_STREAM_FRAMES *
+                                              CMDFX_MIXER_CHANNELS;
+        int count = _mixSource(
+            dst, src, filled, NULL, &stream->position, &voice->fraction,
+            step, frames, voice->gains
+        );
+
+        dst += count * CMDFX_MIXER_CHANNELS;
+        frames -= count;
+
+        if (stream->position < filled) break;
+
+        // hand the chunk back to the reader
+        stream->frames[stream->chunk] = 0;
+        stream->chunk = (stream->chunk + 1) % CMDFX_MIXER_STREAM_CHUNKS;
+        stream->position -= filled;
+    }
+}
+
+// the output stage writes the clipped mix into the caller's buffer
+static void _writeMix(short* restrict out, int samples, float gain) {
+    const float* restrict mix = _mix;
+    for (int i = 0; i < samples; i++) {
+        float sample = mix[i] * gain;
+        sample = sample > 32767.0f ? 32767.0f : sample;
+        sample = sample < -32768.0f ? -32768.0f : sample;
+        out[i] = (short) sample;
+    }
+}
+
+void CmdFX_mixer_render(short* out, int frames) {
+    if (!out || frames < 1) return;
+
+    unsigned long long span = CmdFX_trace_begin();
+    int total = frames;
+
+    _periods++;
+    while (frames > 0) {
+        int count = frames < _MIX_CHUNK ? frames : _MIX_CHUNK;
+        int samples = count * CMDFX_MIXER_CHANNELS;
+        memset(_mix, 0, sizeof(float) * samples);
+
+        for (int i = 0; i < CMDFX_MIXER_MAX_VOICES; i++) {
+            _MixerVoice* voice = &_voices[i];
+            if (voice->tag == 0 || voice->paused) continue;
+
+            if (voice->stream)
+                _mixStream(voice, count);
+            else if (voice->sample->blocks)
+                _mixCompressed(voice, count);
+            else
+                _mixSample(voice, count);
+        }
+
+        _writeMix(out, samples, _masterGain);
+
+        out += samples;
+        frames -= count;
+    }
+
+    CmdFX_trace_endArg("sound_period", "sound", span, "frames", total);
+}
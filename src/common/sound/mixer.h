@@ -0,0 +1,235 @@
+/**
+ * @file mixer.h
+ * @brief Internal software mixer for the sound engine.
+ *
+ * This is a private header. Every platform backend owns a single output
+ * stream and a single audio thread (or device callback) that pulls mixed
+ * periods from here, so any number of overlapping sounds cost one device
+ * handle and one thread. The public `Sound_*` API starts and controls voices
+ * through these functions.
+ *
+ * None of these functions lock. Callers must hold the sound lock
+ * (`_Platform_lockSound`), which the audio thread also holds while rendering.
+ */
+#pragma once
+
+#include "cmdfx/sound/sound.h"
+
+/** The default output rate of the mixer, in frames per second. */
+#define CMDFX_MIXER_RATE 44100
+/** The number of interleaved output channels (stereo). */
+#define CMDFX_MIXER_CHANNELS 2
+/** The most voices that can ever play at once. */
+#define CMDFX_MIXER_MAX_VOICES 64
+/** The number of voices that can play at once by default. */
+#define CMDFX_MIXER_DEFAULT_VOICES 32
+/** The output latency backends aim for by default, in milliseconds. */
+#define CMDFX_MIXER_DEFAULT_LATENCY 20
+/** The number of periods in a device buffer. */
+#define CMDFX_MIXER_PERIODS 2
+
+/**
+ * Audio held in memory for voices to play.
+ *
+ * A sample is either decoded, interleaved 16-bit stereo, or IMA ADPCM blocks
+ * that each voice decodes a block at a time as it plays them.
+ */
+typedef struct CmdFX_MixerSample {
+    short* samples; // NULL for a compressed sample
+    int frames;
+    int rate; // resampled to the mixer rate as it plays
+
+    unsigned char* blocks; // NULL for a decoded sample
+    int blockSize;         // bytes per block
+    int blockFrames;       // frames per block, the last may hold fewer
+    int channels;          // channels in a block, 1 or 2
+} CmdFX_MixerSample;
+
+/** The number of chunks in a stream's ring (double-buffered). */
+#define CMDFX_MIXER_STREAM_CHUNKS 2
+/** The number of frames in each chunk of a stream, ~93ms at the mixer rate. */
+#define CMDFX_MIXER_STREAM_FRAMES 4096
+
+/**
+ * A ring of decoded chunks filled ahead of the mixer by a reader thread.
+ *
+ * A chunk holding `0` frames is empty and belongs to the reader, which may
+ * fill it without the sound lock; a chunk holding frames belongs to the
+ * mixer until it has played them. Chunks are filled and played in order.
+ */
+typedef struct CmdFX_MixerStream {
+    short* data; // CMDFX_MIXER_STREAM_CHUNKS chunks of interleaved stereo
+    int rate;    // resampled to the mixer rate as it plays
+    int frames[CMDFX_MIXER_STREAM_CHUNKS];
+    int chunk;    // the chunk the mixer is playing
+    int position; // the next frame of that chunk
+    int ended;    // set by the reader after it filled the last chunk
+    int released; // set by the mixer once no voice plays the stream
+} CmdFX_MixerStream;
+
+/**
+ * @brief Starts a voice playing a sample.
+ *
+ * If the voice limit is reached, the quietest voice is stolen, and the oldest
+ * of those if several are equally quiet. The sample must stay alive until
+ * every voice playing it has stopped.
+ *
+ * @param sample The sample to play.
+ * @param loops The number of times to play the sample, or `-1` to loop
+ * forever.
+ * @param gain The gain of the voice, from `0` to `1`.
+ * @param pan The balance of the voice, from `-1` (left) to `1` (right).
+ * @param tag The tag used to control the voice later. Must be positive.
+ * @return The voice slot, or `-1` if an error occurred.
+ */
+int CmdFX_mixer_play(
+    const CmdFX_MixerSample* sample, int loops, double gain, double pan,
+    int tag
+);
+
+/**
+ * @brief Starts a voice playing a stream.
+ *
+ * The voice plays until the stream has ended and its chunks are played,
+ * then marks the stream as released. If the reader falls behind, the voice
+ * plays silence until the next chunk is filled. Voices are stolen like
+ * sample voices, which also releases their streams.
+ *
+ * @param stream The stream to play. It must stay alive until released.
+ * @param gain The gain of the voice, from `0` to `1`.
+ * @param pan The balance of the voice, from `-1` (left) to `1` (right).
+ * @param tag The tag used to control the voice later. Must be positive.
+ * @return The voice slot, or `-1` if an error occurred.
+ */
+int CmdFX_mixer_playStream(
+    CmdFX_MixerStream* stream, double gain, double pan, int tag
+);
+
+/**
+ * @brief Stops every voice with a tag.
+ * @param tag The tag of the voices, or `0` for every voice.
+ * @return The number of voices stopped.
+ */
+int CmdFX_mixer_stop(int tag);
+
+/**
+ * @brief Pauses or resumes every voice with a tag.
+ * @param tag The tag of the voices, or `0` for every voice.
+ * @param paused `1` to pause the voices, `0` to resume them.
+ * @return The number of voices that changed state.
+ */
+int CmdFX_mixer_pause(int tag, int paused);
+
+/**
+ * @brief Sets the gain and balance of every voice with a tag.
+ * @param tag The tag of the voices, or `0` for every voice.
+ * @param gain The gain, from `0` to `1`.
+ * @param pan The balance, from `-1` (left) to `1` (right).
+ * @return The number of voices changed.
+ */
+int CmdFX_mixer_setGain(int tag, double gain, double pan);
+
+/**
+ * @brief Counts the voices with a tag.
+ * @param tag The tag of the voices, or `0` for every voice.
+ * @param paused `1` to count paused voices, `0` for playing ones, or `-1`
+ * for both.
+ * @return The number of voices.
+ */
+int CmdFX_mixer_count(int tag, int paused);
+
+/**
+ * @brief Sets the output rate of the mixer.
+ *
+ * Backends call this with the rate the device was opened at. Voices are
+ * resampled to it with linear interpolation, so samples of any rate can play
+ * together.
+ *
+ * @param rate The rate, in frames per second.
+ * @return `0` if successful, or `-1` if the rate is not positive.
+ */
+int CmdFX_mixer_setRate(int rate);
+
+/** @return The output rate of the mixer, in frames per second. */
+int CmdFX_mixer_getRate();
+
+/** @brief Sets the gain applied to the whole mix, from `0` to `1`. */
+void CmdFX_mixer_setMasterGain(double gain);
+
+/**
+ * @brief Sets the number of voices that can play at once.
+ *
+ * Voices above a lowered limit keep playing until they finish; only new
+ * voices are affected.
+ *
+ * @param limit The limit, from `1` to `CMDFX_MIXER_MAX_VOICES`.
+ * @return `0` if successful, or `-1` if the limit is out of range.
+ */
+int CmdFX_mixer_setVoiceLimit(int limit);
+
+/** @return The number of voices that can play at once. */
+int CmdFX_mixer_getVoiceLimit();
+
+// Device
+
+/**
+ * @brief Sets the output latency backends aim for.
+ *
+ * This only takes effect when the output is next opened.
+ *
+ * @param milliseconds The latency, from `1` to `1000`.
+ * @return `0` if successful, or `-1` if the latency is out of range.
+ */
+int CmdFX_mixer_setLatency(int milliseconds);
+
+/** @return The output latency backends aim for, in milliseconds. */
+int CmdFX_mixer_getLatency();
+
+/**
+ * @brief Gets the period size backends should ask their device for.
+ *
+ * The device buffer is `CMDFX_MIXER_PERIODS` periods long, so it holds the
+ * target latency at the current rate.
+ *
+ * @return The number of frames in a period.
+ */
+int CmdFX_mixer_getPeriodFrames();
+
+/**
+ * @brief Records the buffer the output was opened with.
+ *
+ * This also sets the output rate and resets the counters.
+ *
+ * @param rate The rate of the device, in frames per second.
+ * @param periodFrames The frames rendered at a time.
+ * @param bufferFrames The frames the device buffers ahead of playback.
+ */
+void CmdFX_mixer_setDevice(int rate, int periodFrames, int bufferFrames);
+
+/** @brief Counts a time the device ran out of frames to play. */
+void CmdFX_mixer_countUnderrun();
+
+/** @brief Counts a period written with less than a period left queued. */
+void CmdFX_mixer_countLateWrite();
+
+/**
+ * @brief Fills the output statistics.
+ * @param stats The statistics to fill.
+ */
+void CmdFX_mixer_getStats(CmdFX_SoundStats* stats);
+
+/** @brief Resets the output counters. */
+void CmdFX_mixer_resetStats();
+
+/**
+ * @brief Mixes the next frames of every playing voice.
+ *
+ * Voices are resampled to the mixer rate and summed into a float
+ * accumulator at their gain and balance, which is scaled by the master gain
+ * and clipped to 16 bits into the output. The samples themselves are never
+ * modified. Finished voices are released. Each call counts as a period.
+ *
+ * @param out The interleaved stereo output, `frames * 2` samples long.
+ * @param frames The number of frames to mix.
+ */
+void CmdFX_mixer_render(short* out, int frames);
@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cmdfx/core/util.h"
+#include "cmdfx/sound/sound.h"
+#include "common/core/trace.h"
+#include "common/sound/mixer.h"
+#include "common/sound/sink.h"
+#include "common/sound/wave.h"
+
+// Forward declarations for platform-specific functions
+
+extern void _Platform_lockSound();
+extern void _Platform_unlockSound();
+extern int _Platform_startSinkThread(void (*func)());
+extern void _Platform_joinSinkThread();
+
+// the bytes of interleaved stereo frames
+#define _FRAMES_SIZE(frames) (sizeof(short) * (frames) * CMDFX_MIXER_CHANNELS)
+
+static int _sink = 0; // 0 while no sink is open
+static int _realtime = 0;
+static int _running = 0;
+
+// the period each render is split into, sized from the target latency
+static short* _period = NULL;
+static int _periodFrames = 0;
+
+// the memory sink's ring of the most recent frames
+static short* _ring = NULL;
+static int _ringStart = 0;
+static int _ringFrames = 0;
+
+static FILE* _file = NULL;
+static long _fileFrames = 0;
+
+// Output
+
+// keeps the newest frames, dropping the oldest once the ring is full
+static void _writeRing(const short* samples, int frames) {
+    if (frames > CMDFX_SOUND_SINK_FRAMES) {
+        samples += (frames - CMDFX_SOUND_SINK_FRAMES) * CMDFX_MIXER_CHANNELS;
+        frames = CMDFX_SOUND_SINK_FRAMES;
+    }
+
+    // the frames wrap around the end of the ring at most once
+    int end = (_ringStart + _ringFrames) % CMDFX_SOUND_SINK_FRAMES;
+    int first = CMDFX_SOUND_SINK_FRAMES - end;
+    if (first > frames) first = frames;
+
+    memcpy(_ring + end * CMDFX_MIXER_CHANNELS, samples, _FRAMES_SIZE(first));
+    memcpy(
+        _ring, samples + first * CMDFX_MIXER_CHANNELS,
+        _FRAMES_SIZE(frames - first)
+    );
+
+    _ringFrames += frames;
+    if (_ringFrames > CMDFX_SOUND_SINK_FRAMES) {
+        int dropped = _ringFrames - CMDFX_SOUND_SINK_FRAMES;
+        _ringStart = (_ringStart + dropped) % CMDFX_SOUND_SINK_FRAMES;
+        _ringFrames = CMDFX_SOUND_SINK_FRAMES;
+    }
+}
+
+// renders a period, which only the file sink writes outside the lock
+static int _renderPeriod(int frames, int late) {
+    _Platform_lockSound();
+    if (late) CmdFX_mixer_countLateWrite();
+    CmdFX_mixer_render(_period, frames);
+    if (_ring) _writeRing(_period, frames);
+    _Platform_unlockSound();
+
+    if (!_file) return 0;
+    if (CmdFX_wave_writeFrames(_file, _period, frames) != 0) return -1;
+
+    _fileFrames += frames;
+    return 0;
+}
+
+// Sink Thread
+
+// feeds the sink at the mixer rate, catching up on any periods it overslept
+static void _sinkLoop() {
+    CmdFX_trace_nameThread("sound");
+
+    int rate = CmdFX_mixer_getRate();
+    int bufferFrames = _periodFrames * CMDFX_MIXER_PERIODS;
+    unsigned long start = currentTimeMillis();
+    long long rendered = 0;
+
+    while (1) {
+        _Platform_lockSound();
+        int running = _running;
+        _Platform_unlockSound();
+
+        if (!running) break;
+
+        long long elapsed = (long long) (currentTimeMillis() - start);
+        long long due = elapsed * rate / 1000;
+
+        while (rendered + _periodFrames <= due) {
+            int late = due - rendered > bufferFrames;
+            if (_renderPeriod(_periodFrames, late) != 0) break;
+            rendered += _periodFrames;
+        }
+
+        long long next = (rendered + _periodFrames) * 1000 / rate - elapsed;
+        sleepMillis(next > 1 ? (unsigned long) next : 1);
+    }
+}
+
+// Sinks
+
+int CmdFX_sink_open(int sink, const char* filePath, int realtime) {
+    if (_sink) return -1;
+    if (sink != CMDFX_SOUND_SINK_MEMORY && sink != CMDFX_SOUND_SINK_FILE)
+        return -1;
+    if (sink == CMDFX_SOUND_SINK_FILE && !filePath) return -1;
+
+    int rate = CmdFX_mixer_getRate();
+    _periodFrames = CmdFX_mixer_getPeriodFrames();
+    _period = malloc(_FRAMES_SIZE(_periodFrames));
+    if (!_period) return -1;
+
+    if (sink == CMDFX_SOUND_SINK_MEMORY) {
+        _ring = malloc(_FRAMES_SIZE(CMDFX_SOUND_SINK_FRAMES));
+        _ringStart = 0;
+        _ringFrames = 0;
+        if (!_ring) {
+            CmdFX_sink_close();
+            return -1;
+        }
+    }
+    else {
+        // the header is written again with the size once the file is closed
+        _file = fopen(filePath, "wb");
+        _fileFrames = 0;
+        if (!_file || CmdFX_wave_writeHeader(_file, rate, 0) != 0) {
+            fprintf(stderr, "Failed to open audio sink '%s'\n", filePath);
+            CmdFX_sink_close();
+            return -1;
+        }
+    }
+
+    _sink = sink;
+    _realtime = realtime;
+
+    // on demand, nothing is buffered ahead of the caller
+    _Platform_lockSound();
+    int bufferFrames = realtime ? _periodFrames * CMDFX_MIXER_PERIODS : 0;
+    CmdFX_mixer_setDevice(rate, _periodFrames, bufferFrames);
+    _running = realtime;
+    _Platform_unlockSound();
+
+    if (realtime && _Platform_startSinkThread(_sinkLoop) != 0) {
+        fprintf(stderr, "Failed to create audio sink thread\n");
+        _running = 0;
+        CmdFX_sink_close();
+        return -1;
+    }
+
+    return 0;
+}
+
+void CmdFX_sink_close() {
+    if (_running) {
+        _Platform_lockSound();
+        _running = 0;
+        _Platform_unlockSound();
+
+        _Platform_joinSinkThread();
+    }
+
+    if (_file) {
+        rewind(_file);
+        CmdFX_wave_writeHeader(_file, CmdFX_mixer_getRate(), _fileFrames);
+        fclose(_file);
+        _file = NULL;
+    }
+
+    _Platform_lockSound();
+    free(_ring);
+    _ring = NULL;
+    _ringFrames = 0;
+    _Platform_unlockSound();
+
+    free(_period);
+    _period = NULL;
+    _sink = 0;
+    _realtime = 0;
+}
+
+int CmdFX_sink_render(int frames) {
+    if (!_sink || _realtime || frames < 0) return -1;
+
+    int left = frames;
+    while (left > 0) {
+        int count = left < _periodFrames ? left : _periodFrames;
+        if (_renderPeriod(count, 0) != 0) return -1;
+
+        left -= count;
+    }
+
+    return frames;
+}
+
+int CmdFX_sink_read(short* samples, int frames) {
+    if (_sink != CMDFX_SOUND_SINK_MEMORY || !samples || frames < 0) return -1;
+
+    _Platform_lockSound();
+    int count = frames < _ringFrames ? frames : _ringFrames;
+    int first = CMDFX_SOUND_SINK_FRAMES - _ringStart;
+    if (first > count) first = count;
+
+    memcpy(
+        samples, _ring + _ringStart * CMDFX_MIXER_CHANNELS, _FRAMES_SIZE(first)
+    );
+    memcpy(
+        samples + first * CMDFX_MIXER_CHANNELS, _ring,
+        _FRAMES_SIZE(count - first)
+    );
+
+    _ringStart = (_ringStart + count) % CMDFX_SOUND_SINK_FRAMES;
+    _ringFrames -= count;
+    _Platform_unlockSound();
+
+    return count;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file sink.h
+ * @brief Internal sinks that render the mix without an audio device.
+ *
+ * This is a private header. A sink takes the place of the platform backend:
+ * it owns the output while it is open, and renders the mixer into a ring in
+ * memory or a WAV file instead of a device. Sinks render either on demand,
+ * as fast as the caller asks, or in real time on a background thread, a
+ * period at a time at the mixer rate.
+ *
+ * These functions take the sound lock themselves; callers must not hold it.
+ */
+#pragma once
+
+/**
+ * @brief Opens a sink as the output of the mixer.
+ *
+ * Only one sink is open at a time, and never while the platform output is.
+ *
+ * @param sink `CMDFX_SOUND_SINK_MEMORY` or `CMDFX_SOUND_SINK_FILE`.
+ * @param filePath The path of the WAV file to write, for the file sink.
+ * @param realtime `1` to render on a background thread, `0` to render on
+ * demand.
+ * @return `0` if successful, or `-1` if an error occurred.
+ */
+int CmdFX_sink_open(int sink, const char* filePath, int realtime);
+
+/**
+ * @brief Closes the open sink.
+ *
+ * The background thread is stopped, and the file sink's header is filled in
+ * before the file is closed.
+ */
+void CmdFX_sink_close();
+
+/**
+ * @brief Renders frames of the mix to an on-demand sink.
+ * @param frames The number of frames to render.
+ * @return The number of frames rendered, or `-1` if no on-demand sink is
+ * open or the file could not be written.
+ */
+int CmdFX_sink_render(int frames);
+
+/**
+ * @brief Reads and removes the oldest frames from the memory sink.
+ * @param samples The interleaved stereo output, `frames * 2` samples long.
+ * @param frames The most frames to read.
+ * @return The number of frames read, or `-1` if the memory sink isn't open.
+ */
+int CmdFX_sink_read(short* samples, int frames);
@@ -3,237 +3,444 @@
 #include <string.h>
 
 #include "cmdfx/sound/sound.h"
+#include "common/sound/mixer.h"
+#include "common/sound/sink.h"
+#include "common/sound/stream.h"
+#include "common/sound/wave.h"
 
 // Internal sound management structures
-typedef struct _SoundInstance {
+
+// a decoded sound in the bank; its handle is its index + 1, which is also
+// the tag of its voices in the mixer
+typedef struct _Sound {
     char* filePath;
-    int isPlaying;
-    int isPaused;
-    int loopCount;
+    unsigned long long hash;
+    CmdFX_MixerSample sample; // empty for streamed sounds
+    int streamed;
     double volume;
-    void* platformData;
-    struct _SoundInstance* next;
-} _SoundInstance;
+    double pan;
+} _Sound;
+
+// sounds are allocated one by one, so voices can point at their samples
+// while the bank grows; unloaded handles stay NULL and are never reused
+static _Sound** _sounds = NULL;
+static int _soundCount = 0;
+static int _soundCapacity = 0;
+
+// open-addressed index from path to handle; 0 marks an empty slot
+static int* _pathIndex = NULL;
+static int _pathCapacity = 0;
 
-static _SoundInstance* _soundInstances = NULL;
 static double _globalVolume = 1.0;
 static int _soundSystemInitialized = 0;
 
+// where the mix goes when the output is opened
+static int _sink = CMDFX_SOUND_SINK_DEVICE;
+static char* _sinkPath = NULL;
+static int _sinkRealtime = 0;
+
 // Forward declarations for platform-specific functions
+
+// opens the shared output stream and starts the thread that renders the mixer
 extern int _Platform_initSoundSystem();
 extern void _Platform_shutdownSoundSystem();
-extern int _Platform_playSound(
-    const char* soundFile, int loopCount, void** platformData
-);
-extern int _Platform_pauseSound(void* platformData);
-extern int _Platform_resumeSound(void* platformData);
-extern int _Platform_stopSound(void* platformData);
-extern int _Platform_setSoundVolume(void* platformData, double volume);
-extern void _Platform_freeSoundData(void* platformData);
+// guards the mixer against the audio thread
+extern void _Platform_lockSound();
+extern void _Platform_unlockSound();
 
 // Internal helper functions
 static int _initSoundSystem() {
     if (_soundSystemInitialized) return 0;
 
-    int result = _Platform_initSoundSystem();
+    int result = _sink == CMDFX_SOUND_SINK_DEVICE
+                     ? _Platform_initSoundSystem()
+                     : CmdFX_sink_open(_sink, _sinkPath, _sinkRealtime);
     if (result == 0) {
         _soundSystemInitialized = 1;
     }
     return result;
 }
 
-static _SoundInstance* _findSoundInstance(const char* soundFile) {
-    if (!soundFile) return NULL;
+// closes the output; the mixer keeps its voices
+static void _shutdownSoundSystem() {
+    if (!_soundSystemInitialized) return;
 
-    _SoundInstance* current = _soundInstances;
-    while (current) {
-        if (current->filePath && strcmp(current->filePath, soundFile) == 0) {
-            return current;
-        }
-        current = current->next;
-    }
-    return NULL;
+    if (_sink == CMDFX_SOUND_SINK_DEVICE) _Platform_shutdownSoundSystem();
+    else CmdFX_sink_close();
+
+    _soundSystemInitialized = 0;
 }
 
-static _SoundInstance* _createSoundInstance(const char* soundFile) {
-    if (!soundFile) return NULL;
+// decodes a whole WAV file into a sample
+static int _readSound(const char* soundFile, CmdFX_MixerSample* sample) {
+    FILE* file = fopen(soundFile, "rb");
+    if (!file) {
+        fprintf(stderr, "Failed to open audio file '%s'\n", soundFile);
+        return -1;
+    }
+
+    CmdFX_WaveInfo info;
+    if (CmdFX_wave_readInfo(file, &info) != 0) {
+        fprintf(stderr, "Unsupported audio file '%s'\n", soundFile);
+        fclose(file);
+        return -1;
+    }
 
-    _SoundInstance* instance = malloc(sizeof(_SoundInstance));
-    if (!instance) return NULL;
+    // compressed data is kept as it is, and decoded by the voices
+    int compressed = info.format == CMDFX_WAVE_IMA_ADPCM;
+
+    unsigned char* data = malloc(info.dataSize);
+    short* samples = NULL;
+    if (!compressed) samples = malloc(sizeof(short) * 2 * info.frames);
+    if (!data || (!compressed && !samples)) {
+        free(data);
+        free(samples);
+        fclose(file);
+        return -1;
+    }
 
-    instance->filePath = malloc(strlen(soundFile) + 1);
-    if (!instance->filePath) {
-        free(instance);
-        return NULL;
+    fseek(file, info.dataOffset, SEEK_SET);
+    if (fread(data, 1, info.dataSize, file) != (size_t) info.dataSize) {
+        fprintf(stderr, "Failed to read audio file '%s'\n", soundFile);
+        free(data);
+        free(samples);
+        fclose(file);
+        return -1;
     }
 
-    strcpy(instance->filePath, soundFile);
-    instance->isPlaying = 0;
-    instance->isPaused = 0;
-    instance->loopCount = 0;
-    instance->volume = 1.0;
-    instance->platformData = NULL;
-    instance->next = _soundInstances;
-    _soundInstances = instance;
+    fclose(file);
+    sample->frames = info.frames;
+    sample->rate = info.rate;
+
+    if (compressed) {
+        sample->blocks = data;
+        sample->blockSize = info.frameSize;
+        sample->blockFrames = info.blockFrames;
+        sample->channels = info.channels;
+        return 0;
+    }
 
-    return instance;
+    CmdFX_wave_convert(&info, data, samples, info.frames);
+    free(data);
+
+    sample->samples = samples;
+    return 0;
 }
 
-static void _removeSoundInstance(_SoundInstance* instance) {
-    if (!instance) return;
+// Sample Bank
 
-    if (_soundInstances == instance) {
-        _soundInstances = instance->next;
-    }
-    else {
-        _SoundInstance* current = _soundInstances;
-        while (current && current->next != instance) {
-            current = current->next;
-        }
-        if (current) {
-            current->next = instance->next;
-        }
+// 64-bit FNV-1a
+static unsigned long long _hashPath(const char* path) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (const unsigned char* c = (const unsigned char*) path; *c; c++) {
+        hash ^= *c;
+        hash *= 1099511628211ULL;
     }
 
-    if (instance->platformData) {
-        _Platform_freeSoundData(instance->platformData);
+    return hash;
+}
+
+static _Sound* _getSound(int handle) {
+    if (handle < 1 || handle > _soundCount) return NULL;
+    return _sounds[handle - 1];
+}
+
+static int _indexSlot(int* index, int capacity, unsigned long long hash) {
+    int mask = capacity - 1;
+    int slot = (int) (hash & mask);
+    while (index[slot] != 0) slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+// rebuilds the path index from the loaded sounds
+static int _indexSounds(int capacity) {
+    int* index = calloc(capacity, sizeof(int));
+    if (!index) return -1;
+
+    for (int i = 0; i < _soundCount; i++) {
+        if (!_sounds[i]) continue;
+        index[_indexSlot(index, capacity, _sounds[i]->hash)] = i + 1;
     }
-    free(instance->filePath);
-    free(instance);
+
+    free(_pathIndex);
+    _pathIndex = index;
+    _pathCapacity = capacity;
+    return 0;
 }
 
-// Public API implementations
-int Sound_play(const char* soundFile) {
-    return Sound_playLooped(soundFile, 1);
+// finds the handle of a loaded sound, or 0
+static int _findSound(const char* soundFile) {
+    if (!soundFile || !_pathIndex) return 0;
+
+    unsigned long long hash = _hashPath(soundFile);
+    int mask = _pathCapacity - 1;
+    for (int slot = (int) (hash & mask); _pathIndex[slot] != 0;
+         slot = (slot + 1) & mask) {
+        _Sound* sound = _sounds[_pathIndex[slot] - 1];
+        if (sound && sound->hash == hash &&
+            strcmp(sound->filePath, soundFile) == 0)
+            return _pathIndex[slot];
+    }
+
+    return 0;
 }
 
-int Sound_playLooped(const char* soundFile, int loopCount) {
-    if (!soundFile) return -1;
-    if (loopCount == 0) return -1;
+static _Sound* _findSoundByPath(const char* soundFile) {
+    return _getSound(_findSound(soundFile));
+}
 
-    if (_initSoundSystem() != 0) return -2;
+static int _addSound(_Sound* sound) {
+    if (_soundCount == _soundCapacity) {
+        int capacity = _soundCapacity == 0 ? 16 : _soundCapacity * 2;
+        _Sound** temp = realloc(_sounds, sizeof(_Sound*) * capacity);
+        if (!temp) return -1;
 
-    _SoundInstance* instance = _findSoundInstance(soundFile);
-    if (!instance) {
-        instance = _createSoundInstance(soundFile);
-        if (!instance) return -3;
+        _sounds = temp;
+        _soundCapacity = capacity;
     }
 
-    // Stop current playback if any
-    if (instance->isPlaying) {
-        Sound_stop(soundFile);
+    // the index stays at most half full, so probes stay short
+    if ((_soundCount + 1) * 2 > _pathCapacity) {
+        int capacity = _pathCapacity == 0 ? 32 : _pathCapacity * 2;
+        if (_indexSounds(capacity) != 0) return -1;
     }
 
-    instance->loopCount = loopCount;
-    int result =
-        _Platform_playSound(soundFile, loopCount, &instance->platformData);
-    if (result == 0) {
-        instance->isPlaying = 1;
-        instance->isPaused = 0;
-        // Apply current volume settings
-        _Platform_setSoundVolume(
-            instance->platformData, instance->volume * _globalVolume
-        );
+    _sounds[_soundCount++] = sound;
+    _pathIndex[_indexSlot(_pathIndex, _pathCapacity, sound->hash)] =
+        _soundCount;
+
+    return _soundCount;
+}
+
+static void _freeSound(_Sound* sound) {
+    free(sound->sample.samples);
+    free(sound->sample.blocks);
+    free(sound->filePath);
+    free(sound);
+}
+
+// counts the voices of a sound; tag 0 counts every sound
+static int _countVoices(int tag, int paused) {
+    if (!_soundSystemInitialized) return 0;
+
+    _Platform_lockSound();
+    int count = CmdFX_mixer_count(tag, paused);
+    _Platform_unlockSound();
+
+    return count;
+}
+
+// checks that a streamed file can be played before it is added
+static int _checkSound(const char* soundFile, CmdFX_WaveInfo* info) {
+    FILE* file = fopen(soundFile, "rb");
+    if (!file) {
+        fprintf(stderr, "Failed to open audio file '%s'\n", soundFile);
+        return -1;
     }
 
+    int result = CmdFX_wave_readInfo(file, info);
+    fclose(file);
+
+    if (result != 0)
+        fprintf(stderr, "Unsupported audio file '%s'\n", soundFile);
+
     return result;
 }
 
-int Sound_pause(const char* soundFile) {
+static int _loadSound(const char* soundFile, int streamed) {
     if (!soundFile) return -1;
 
-    _SoundInstance* instance = _findSoundInstance(soundFile);
-    if (!instance || !instance->isPlaying || instance->isPaused) return -1;
+    int handle = _findSound(soundFile);
+    if (handle != 0) return handle;
 
-    int result = _Platform_pauseSound(instance->platformData);
-    if (result == 0) {
-        instance->isPaused = 1;
+    _Sound* sound = calloc(1, sizeof(_Sound));
+    if (!sound) return -3;
+
+    sound->filePath = malloc(strlen(soundFile) + 1);
+    if (!sound->filePath) {
+        free(sound);
+        return -3;
     }
 
-    return result;
-}
+    // decoded once and shared by every voice; streams are only checked
+    int result = 0;
+    if (streamed) {
+        CmdFX_WaveInfo info;
+        result = _checkSound(soundFile, &info);
 
-int Sound_pauseAll() {
-    int totalResult = 0;
-
-    _SoundInstance* current = _soundInstances;
-    while (current) {
-        if (current->isPlaying && !current->isPaused) {
-            int result = Sound_pause(current->filePath);
-            if (result != 0) totalResult = result;
-        }
-        current = current->next;
+        // compressed sounds are small enough to keep whole
+        if (result == 0 && info.format == CMDFX_WAVE_IMA_ADPCM) streamed = 0;
+    }
+
+    if (result == 0 && !streamed)
+        result = _readSound(soundFile, &sound->sample);
+    if (result != 0) {
+        free(sound->filePath);
+        free(sound);
+        return -3;
+    }
+
+    strcpy(sound->filePath, soundFile);
+    sound->streamed = streamed;
+    sound->hash = _hashPath(soundFile);
+    sound->volume = 1.0;
+    sound->pan = 0.0;
+
+    handle = _addSound(sound);
+    if (handle < 0) {
+        _freeSound(sound);
+        return -3;
     }
 
-    return totalResult;
+    return handle;
 }
 
-int Sound_resume(const char* soundFile) {
-    if (!soundFile) return -1;
+int Sound_load(const char* soundFile) {
+    return _loadSound(soundFile, 0);
+}
 
-    _SoundInstance* instance = _findSoundInstance(soundFile);
-    if (!instance || !instance->isPlaying || !instance->isPaused) return -1;
+int Sound_loadStreamed(const char* soundFile) {
+    return _loadSound(soundFile, 1);
+}
 
-    int result = _Platform_resumeSound(instance->platformData);
-    if (result == 0) {
-        instance->isPaused = 0;
+int Sound_unload(int handle) {
+    _Sound* sound = _getSound(handle);
+    if (!sound) return -1;
+
+    // no voice may read the sample once it is freed
+    if (_soundSystemInitialized) {
+        _Platform_lockSound();
+        CmdFX_mixer_stop(handle);
+        _Platform_unlockSound();
     }
 
-    return result;
+    _sounds[handle - 1] = NULL;
+    _freeSound(sound);
+
+    return _indexSounds(_pathCapacity);
 }
 
-int Sound_resumeAll() {
-    int totalResult = 0;
-
-    _SoundInstance* current = _soundInstances;
-    while (current) {
-        if (current->isPlaying && current->isPaused) {
-            int result = Sound_resume(current->filePath);
-            if (result != 0) totalResult = result;
-        }
-        current = current->next;
+int Sound_playHandle(int handle) {
+    return Sound_playHandleLooped(handle, 1);
+}
+
+int Sound_playHandleLooped(int handle, int loopCount) {
+    _Sound* sound = _getSound(handle);
+    if (!sound) return -1;
+    if (loopCount == 0 || loopCount < -1) return -1;
+
+    if (_initSoundSystem() != 0) return -2;
+
+    if (sound->streamed) {
+        int result = CmdFX_stream_play(
+            sound->filePath, loopCount, sound->volume, sound->pan, handle
+        );
+        return result == 0 ? 0 : -3;
     }
 
-    return totalResult;
+    // overlapping plays of the same sound each get their own voice
+    _Platform_lockSound();
+    int voice = CmdFX_mixer_play(
+        &sound->sample, loopCount, sound->volume, sound->pan, handle
+    );
+    _Platform_unlockSound();
+
+    return voice >= 0 ? 0 : -3;
 }
 
-int Sound_stop(const char* soundFile) {
+int Sound_stopHandle(int handle) {
+    if (!_getSound(handle) || !_soundSystemInitialized) return -1;
+
+    _Platform_lockSound();
+    int count = CmdFX_mixer_stop(handle);
+    _Platform_unlockSound();
+
+    return count > 0 ? 0 : -1;
+}
+
+// Public API implementations
+int Sound_play(const char* soundFile) {
+    return Sound_playLooped(soundFile, 1);
+}
+
+int Sound_playLooped(const char* soundFile, int loopCount) {
     if (!soundFile) return -1;
+    if (loopCount == 0 || loopCount < -1) return -1;
 
-    _SoundInstance* instance = _findSoundInstance(soundFile);
-    if (!instance || !instance->isPlaying) return -1;
+    if (_initSoundSystem() != 0) return -2;
 
-    int result = _Platform_stopSound(instance->platformData);
-    if (result == 0) {
-        instance->isPlaying = 0;
-        instance->isPaused = 0;
-    }
+    int handle = Sound_load(soundFile);
+    if (handle < 0) return handle;
 
-    return result;
+    return Sound_playHandleLooped(handle, loopCount);
+}
+
+static int _pauseSound(int tag, int paused) {
+    if (!_soundSystemInitialized) return 0;
+
+    _Platform_lockSound();
+    int count = CmdFX_mixer_pause(tag, paused);
+    _Platform_unlockSound();
+
+    return count;
+}
+
+int Sound_pause(const char* soundFile) {
+    int handle = _findSound(soundFile);
+    if (handle == 0) return -1;
+
+    return _pauseSound(handle, 1) > 0 ? 0 : -1;
+}
+
+int Sound_pauseAll() {
+    _pauseSound(0, 1);
+    return 0;
+}
+
+int Sound_resume(const char* soundFile) {
+    int handle = _findSound(soundFile);
+    if (handle == 0) return -1;
+
+    return _pauseSound(handle, 0) > 0 ? 0 : -1;
+}
+
+int Sound_resumeAll() {
+    _pauseSound(0, 0);
+    return 0;
+}
+
+int Sound_stop(const char* soundFile) {
+    int handle = _findSound(soundFile);
+    if (handle == 0) return -1;
+
+    return Sound_stopHandle(handle);
 }
 
 int Sound_stopAll() {
-    int totalResult = 0;
-
-    _SoundInstance* current = _soundInstances;
-    while (current) {
-        if (current->isPlaying) {
-            int result = Sound_stop(current->filePath);
-            if (result != 0) totalResult = result;
-        }
-        current = current->next;
-    }
+    if (!_soundSystemInitialized) return 0;
+
+    _Platform_lockSound();
+    CmdFX_mixer_stop(0);
+    _Platform_unlockSound();
 
-    return totalResult;
+    return 0;
+}
+
+int Sound_isPlaying(const char* soundFile) {
+    int handle = _findSound(soundFile);
+    if (handle == 0) return 0;
+
+    return _countVoices(handle, 0) > 0;
 }
 
 int Sound_getVolume(const char* soundFile, double* volume) {
-    if (!soundFile || !volume) return -1;
+    if (!volume) return -1;
 
-    _SoundInstance* instance = _findSoundInstance(soundFile);
-    if (!instance) return -1;
+    _Sound* sound = _findSoundByPath(soundFile);
+    if (!sound) return -1;
 
-    *volume = instance->volume;
+    *volume = sound->volume;
     return 0;
 }
 
@@ -244,20 +451,23 @@ int Sound_getVolumeAll(double* volume) {
     return 0;
 }
 
-int Sound_setVolume(const char* soundFile, double volume) {
-    if (!soundFile || volume < 0.0 || volume > 1.0) return -1;
+static void _applyGain(int handle) {
+    if (!_soundSystemInitialized) return;
 
-    _SoundInstance* instance = _findSoundInstance(soundFile);
-    if (!instance) return -1;
+    _Sound* sound = _getSound(handle);
+    _Platform_lockSound();
+    CmdFX_mixer_setGain(handle, sound->volume, sound->pan);
+    _Platform_unlockSound();
+}
+
+int Sound_setVolume(const char* soundFile, double volume) {
+    if (volume < 0.0 || volume > 1.0) return -1;
 
-    instance->volume = volume;
+    int handle = _findSound(soundFile);
+    if (handle == 0) return -1;
 
-    // Apply volume if sound is currently playing
-    if (instance->isPlaying && instance->platformData) {
-        return _Platform_setSoundVolume(
-            instance->platformData, volume * _globalVolume
-        );
-    }
+    _getSound(handle)->volume = volume;
+    _applyGain(handle);
 
     return 0;
 }
@@ -267,32 +477,163 @@ int Sound_setVolumeAll(double volume) {
 
     _globalVolume = volume;
 
-    // Apply to all currently playing sounds
-    _SoundInstance* current = _soundInstances;
-    while (current) {
-        if (current->isPlaying && current->platformData) {
-            _Platform_setSoundVolume(
-                current->platformData, current->volume * _globalVolume
-            );
-        }
-        current = current->next;
+    // the master gain is applied to the mix, never to the samples
+    if (_soundSystemInitialized) {
+        _Platform_lockSound();
+        CmdFX_mixer_setMasterGain(volume);
+        _Platform_unlockSound();
+    }
+    else {
+        CmdFX_mixer_setMasterGain(volume);
     }
 
     return 0;
 }
 
-// Cleanup function (should be called on shutdown)
-void Sound_cleanup() {
-    Sound_stopAll();
+int Sound_getPan(const char* soundFile, double* pan) {
+    if (!pan) return -1;
+
+    _Sound* sound = _findSoundByPath(soundFile);
+    if (!sound) return -1;
+
+    *pan = sound->pan;
+    return 0;
+}
+
+int Sound_setPan(const char* soundFile, double pan) {
+    if (pan < -1.0 || pan > 1.0) return -1;
+
+    int handle = _findSound(soundFile);
+    if (handle == 0) return -1;
+
+    _getSound(handle)->pan = pan;
+    _applyGain(handle);
+
+    return 0;
+}
 
-    while (_soundInstances) {
-        _SoundInstance* next = _soundInstances->next;
-        _removeSoundInstance(_soundInstances);
-        _soundInstances = next;
+// Voices
+
+int Sound_getVoiceLimit() {
+    return CmdFX_mixer_getVoiceLimit();
+}
+
+int Sound_setVoiceLimit(int limit) {
+    if (!_soundSystemInitialized) return CmdFX_mixer_setVoiceLimit(limit);
+
+    _Platform_lockSound();
+    int result = CmdFX_mixer_setVoiceLimit(limit);
+    _Platform_unlockSound();
+
+    return result;
+}
+
+int Sound_getActiveVoices() {
+    return _countVoices(0, -1);
+}
+
+// Output
+
+int Sound_getLatency() {
+    return CmdFX_mixer_getLatency();
+}
+
+int Sound_setLatency(int milliseconds) {
+    // the target is only read when the output is opened
+    if (CmdFX_mixer_setLatency(milliseconds) != 0) return -1;
+    if (!_soundSystemInitialized) return 0;
+
+    _shutdownSoundSystem();
+    return _initSoundSystem() == 0 ? 0 : -2;
+}
+
+int Sound_getStats(CmdFX_SoundStats* stats) {
+    if (!stats) return -1;
+
+    if (!_soundSystemInitialized) {
+        memset(stats, 0, sizeof(CmdFX_SoundStats));
+        stats->rate = CmdFX_mixer_getRate();
+        return 0;
     }
 
-    if (_soundSystemInitialized) {
-        _Platform_shutdownSoundSystem();
-        _soundSystemInitialized = 0;
+    _Platform_lockSound();
+    CmdFX_mixer_getStats(stats);
+    _Platform_unlockSound();
+
+    return 0;
+}
+
+void Sound_resetStats() {
+    if (!_soundSystemInitialized) return;
+
+    _Platform_lockSound();
+    CmdFX_mixer_resetStats();
+    _Platform_unlockSound();
+}
+
+// Sinks
+
+int Sound_getSink() {
+    return _sink;
+}
+
+int Sound_setSink(int sink, const char* filePath, int realtime) {
+    if (sink < CMDFX_SOUND_SINK_DEVICE || sink > CMDFX_SOUND_SINK_FILE)
+        return -1;
+    if (sink == CMDFX_SOUND_SINK_FILE && !filePath) return -1;
+
+    char* path = NULL;
+    if (filePath) {
+        path = malloc(strlen(filePath) + 1);
+        if (!path) return -3;
+
+        strcpy(path, filePath);
     }
+
+    int reopen = _soundSystemInitialized;
+    _shutdownSoundSystem();
+
+    free(_sinkPath);
+    _sinkPath = path;
+    _sink = sink;
+    _sinkRealtime = realtime != 0;
+
+    if (!reopen) return 0;
+    return _initSoundSystem() == 0 ? 0 : -2;
+}
+
+int Sound_renderSink(int frames) {
+    if (frames < 0) return -1;
+    if (_sink == CMDFX_SOUND_SINK_DEVICE || _sinkRealtime) return -1;
+    if (_initSoundSystem() != 0) return -2;
+
+    return CmdFX_sink_render(frames);
+}
+
+int Sound_readSink(short* samples, int frames) {
+    if (!samples || frames < 0) return -1;
+    if (_sink != CMDFX_SOUND_SINK_MEMORY) return -1;
+    if (!_soundSystemInitialized) return 0;
+
+    return CmdFX_sink_read(samples, frames);
+}
+
+void Sound_cleanup() {
+    Sound_stopAll();
+    CmdFX_stream_shutdown();
+
+    // the audio thread is gone before any sample is freed
+    _shutdownSoundSystem();
+
+    for (int i = 0; i < _soundCount; i++)
+        if (_sounds[i]) _freeSound(_sounds[i]);
+
+    free(_sounds);
+    _sounds = NULL;
+    _soundCount = 0;
+    _soundCapacity = 0;
+
+    free(_pathIndex);
+    _pathIndex = NULL;
+    _pathCapacity = 0;
 }
@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cmdfx/core/util.h"
+#include "common/sound/mixer.h"
+#include "common/sound/stream.h"
+#include "common/sound/wave.h"
+
+#define _FRAME_SIZE (sizeof(short) * CMDFX_MIXER_CHANNELS)
+// how often the reader tops up the rings; well under a chunk's length
+#define _READER_INTERVAL 10
+
+typedef struct _SoundStream {
+    CmdFX_MixerStream stream;
+    FILE* file;
+    CmdFX_WaveInfo info;
+    unsigned char* raw; // one chunk of file data, before conversion
+    long read;  // bytes of data read in the current loop
+    int loops;  // loops left after the current one, or -1 forever
+    int fill;   // the next chunk the reader fills
+    struct _SoundStream* next;
+} _SoundStream;
+
+// guarded by the sound lock; streams are only unlinked by the reader
+static _SoundStream* _streams = NULL;
+static int _readerRunning = 0;
+static int _readerStarted = 0;
+
+// declared in src/<platform>/sound/sound.c
+extern void _Platform_lockSound();
+extern void _Platform_unlockSound();
+extern int _Platform_startStreamThread(void (*func)());
+extern void _Platform_joinStreamThread();
+
+static void _freeStream(_SoundStream* stream) {
+    if (stream->file) fclose(stream->file);
+    free(stream->raw);
+    free(stream->stream.data);
+    free(stream);
+}
+
+// Reading
+
+// reads and converts the next chunk, seeking back to the data for each loop
+static int _readChunk(_SoundStream* stream, short* dst) {
+    int frameSize = stream->info.frameSize;
+    int frames = 0;
+
+    while (frames < CMDFX_MIXER_STREAM_FRAMES) {
+        long left = stream->info.dataSize - stream->read;
+        if (left <= 0) {
+            if (stream->loops == 0) break;
+            if (stream->loops > 0) stream->loops--;
+
+            fseek(stream->file, stream->info.dataOffset, SEEK_SET);
+            stream->read = 0;
+            continue;
+        }
+
+        long want = (CMDFX_MIXER_STREAM_FRAMES - frames) * (long) frameSize;
+        if (want > left) want = left;
+
+        long got = (long) fread(stream->raw, 1, want, stream->file);
+        got -= got % frameSize;
+
+        // a truncated file ends the stream instead of looping on nothing
+        if (got == 0) {
+            stream->loops = 0;
+            stream->read = stream->info.dataSize;
+            break;
+        }
+
+        int count = (int) (got / frameSize);
+        CmdFX_wave_convert(
+            &stream->info, stream->raw, dst + frames * CMDFX_MIXER_CHANNELS,
+            count
+        );
+
+        frames += count;
+        stream->read += got;
+    }
+
+    return frames;
+}
+
+// fills every chunk the mixer has handed back, outside the sound lock
+static void _fillStream(_SoundStream* stream) {
+    CmdFX_MixerStream* ring = &stream->stream;
+
+    while (1) {
+        _Platform_lockSound();
+        int fill = stream->fill;
+        int empty = !ring->released && !ring->ended && ring->frames[fill] == 0;
+        _Platform_unlockSound();
+
+        if (!empty) return;
+
+        int offset = fill * CMDFX_MIXER_STREAM_FRAMES * CMDFX_MIXER_CHANNELS;
+        int frames = _readChunk(stream, ring->data + offset);
+        int exhausted =
+            stream->loops == 0 && stream->read >= stream->info.dataSize;
+
+        _Platform_lockSound();
+        ring->frames[fill] = frames;
+        if (exhausted) ring->ended = 1;
+        _Platform_unlockSound();
+
+        stream->fill = (fill + 1) % CMDFX_MIXER_STREAM_CHUNKS;
+    }
+}
+
+static void _readerLoop() {
+    while (1) {
+        _SoundStream* released = NULL;
+
+        _Platform_lockSound();
+        if (!_readerRunning) {
+            _Platform_unlockSound();
+            break;
+        }
+
+        // unlink the streams no voice plays anymore
+        _SoundStream** link = &_streams;
+        while (*link) {
+            _SoundStream* stream = *link;
+            if (!stream->stream.released) {
+                link = &stream->next;
+                continue;
+            }
+
+            *link = stream->next;
+            stream->next = released;
+            released = stream;
+        }
+
+        // new streams are only pushed in front, so the rest stays valid
+        _SoundStream* head = _streams;
+        _Platform_unlockSound();
+
+        while (released) {
+            _SoundStream* next = released->next;
+            _freeStream(released);
+            released = next;
+        }
+
+        for (_SoundStream* stream = head; stream; stream = stream->next)
+            _fillStream(stream);
+
+        sleepMillis(_READER_INTERVAL);
+    }
+}
+
+static int _startReader() {
+    if (_readerStarted) return 0;
+
+    _Platform_lockSound();
+    _readerRunning = 1;
+    _Platform_unlockSound();
+
+    if (_Platform_startStreamThread(_readerLoop) != 0) {
+        fprintf(stderr, "Failed to create stream thread\n");
+        _readerRunning = 0;
+        return -1;
+    }
+
+    _readerStarted = 1;
+    return 0;
+}
+
+// Streams
+
+int CmdFX_stream_play(
+    const char* soundFile, int loops, double gain, double pan, int tag
+) {
+    if (!soundFile) return -1;
+    if (loops == 0 || loops < -1) return -1;
+    if (_startReader() != 0) return -1;
+
+    _SoundStream* stream = calloc(1, sizeof(_SoundStream));
+    if (!stream) return -1;
+
+    stream->stream.data = malloc(
+        _FRAME_SIZE * CMDFX_MIXER_STREAM_FRAMES * CMDFX_MIXER_STREAM_CHUNKS
+    );
+    stream->file = fopen(soundFile, "rb");
+    if (!stream->stream.data || !stream->file) {
+        if (!stream->file)
+            fprintf(stderr, "Failed to open audio file '%s'\n", soundFile);
+
+        _freeStream(stream);
+        return -1;
+    }
+
+    // compressed data is kept in the bank instead
+    if (CmdFX_wave_readInfo(stream->file, &stream->info) != 0 ||
+        stream->info.format == CMDFX_WAVE_IMA_ADPCM) {
+        _freeStream(stream);
+        return -1;
+    }
+
+    stream->stream.rate = stream->info.rate;
+    stream->raw = malloc(stream->info.frameSize * CMDFX_MIXER_STREAM_FRAMES);
+    if (!stream->raw) {
+        _freeStream(stream);
+        return -1;
+    }
+
+    fseek(stream->file, stream->info.dataOffset, SEEK_SET);
+    stream->loops = loops == -1 ? -1 : loops - 1;
+
+    // the stream isn't shared yet, so the first chunks are read right away
+    _fillStream(stream);
+
+    _Platform_lockSound();
+    int voice = CmdFX_mixer_playStream(&stream->stream, gain, pan, tag);
+    if (voice >= 0) {
+        stream->next = _streams;
+        _streams = stream;
+    }
+    _Platform_unlockSound();
+
+    if (voice < 0) {
+        _freeStream(stream);
+        return -1;
+    }
+
+    return 0;
+}
+
+void CmdFX_stream_shutdown() {
+    if (_readerStarted) {
+        _Platform_lockSound();
+        _readerRunning = 0;
+        _Platform_unlockSound();
+
+        _Platform_joinStreamThread();
+        _readerStarted = 0;
+    }
+
+    while (_streams) {
+        _SoundStream* next = _streams->next;
+        _freeStream(_streams);
+        _streams = next;
+    }
+}
@@ -0,0 +1,37 @@
+/**
+ * @file stream.h
+ * @brief Internal streaming source for the sound engine.
+ *
+ * This is a private header. Streams play long sounds without decoding them
+ * whole: a background reader thread keeps a small double-buffered ring of
+ * decoded chunks ahead of the mixer, seeking back to the start of the data to
+ * loop, so the audio thread never waits on the disk.
+ *
+ * These functions take the sound lock themselves; callers must not hold it.
+ */
+#pragma once
+
+/**
+ * @brief Starts a voice streaming a WAV file.
+ *
+ * The first chunks are read before the voice starts, so it plays without a
+ * gap. The reader thread is started on first use.
+ *
+ * @param soundFile The path to the file.
+ * @param loops The number of times to play the file, or `-1` to loop
+ * forever.
+ * @param gain The gain of the voice, from `0` to `1`.
+ * @param pan The balance of the voice, from `-1` (left) to `1` (right).
+ * @param tag The tag used to control the voice. Must be positive.
+ * @return `0` if successful, or `-1` if an error occurred.
+ */
+int CmdFX_stream_play(
+    const char* soundFile, int loops, double gain, double pan, int tag
+);
+
+/**
+ * @brief Stops the reader thread and frees every stream.
+ *
+ * Every stream voice must be stopped first.
+ */
+void CmdFX_stream_shutdown();
@@ -0,0 +1,306 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "common/sound/wave.h"
+
+// the GUID of a WAVE_FORMAT_EXTENSIBLE file starts with the real format tag
+#define _FORMAT_EXTENSIBLE 0xFFFE
+
+static unsigned int _readU16(const unsigned char* p) {
+    return p[0] | (p[1] << 8);
+}
+
+static unsigned long _readU32(const unsigned char* p) {
+    return p[0] | (p[1] << 8) | ((unsigned long) p[2] << 16) |
+           ((unsigned long) p[3] << 24);
+}
+
+// the frames in the first bytes of an IMA ADPCM block: a raw frame in the
+// header, then 8 frames for every 4 bytes of each channel
+static int _blockFrames(long bytes, int channels) {
+    long header = 4L * channels;
+    if (bytes < header) return 0;
+
+    return (int) (1 + (bytes - header) / header * 8);
+}
+
+// Format
+
+static int _readFormat(
+    FILE* file, unsigned long size, CmdFX_WaveInfo* info
+) {
+    unsigned char fmt[40] = {0};
+    unsigned long length = size < sizeof(fmt) ? size : sizeof(fmt);
+    if (size < 16 || fread(fmt, 1, length, file) != length) return -1;
+
+    int format = (int) _readU16(fmt);
+    if (format == _FORMAT_EXTENSIBLE) {
+        if (size < 40) return -1;
+        format = (int) _readU16(fmt + 24);
+    }
+
+    info->format = format;
+    info->channels = (int) _readU16(fmt + 2);
+    info->rate = (int) _readU32(fmt + 4);
+    info->frameSize = (int) _readU16(fmt + 12);
+    info->bits = (int) _readU16(fmt + 14);
+
+    // the rest of the chunk is skipped by the caller
+    fseek(file, (long) (size - length), SEEK_CUR);
+    return 0;
+}
+
+static int _checkFormat(const CmdFX_WaveInfo* info) {
+    if (info->channels < 1 || info->rate < 1) return -1;
+
+    switch (info->format) {
+        case CMDFX_WAVE_PCM:
+            if (info->bits != 8 && info->bits != 16 && info->bits != 24 &&
+                info->bits != 32)
+                return -1;
+            break;
+        case CMDFX_WAVE_FLOAT:
+            if (info->bits != 32 && info->bits != 64) return -1;
+            break;
+        case CMDFX_WAVE_IMA_ADPCM:
+            if (info->bits != 4 || info->channels > 2) return -1;
+
+            // whole groups of 4 bytes per channel follow the header
+            if (info->frameSize % (4 * info->channels) != 0) return -1;
+
+            int frames = _blockFrames(info->frameSize, info->channels);
+            return frames > 1 && frames <= CMDFX_WAVE_MAX_BLOCK_FRAMES ? 0 : -1;
+        default: return -1;
+    }
+
+    if (info->frameSize != info->channels * (info->bits / 8)) return -1;
+    return 0;
+}
+
+int CmdFX_wave_readInfo(FILE* file, CmdFX_WaveInfo* info) {
+    if (!file || !info) return -1;
+
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    unsigned char riff[12];
+    if (fread(riff, 1, 12, file) != 12) return -1;
+    if (memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0)
+        return -1;
+
+    memset(info, 0, sizeof(CmdFX_WaveInfo));
+    int hasFormat = 0;
+
+    unsigned char header[8];
+    while (fread(header, 1, 8, file) == 8) {
+        unsigned long size = _readU32(header + 4);
+
+        if (memcmp(header, "fmt ", 4) == 0) {
+            if (_readFormat(file, size, info) != 0) return -1;
+            hasFormat = 1;
+        }
+        else if (memcmp(header, "data", 4) == 0) {
+            // the format always comes first in a valid file
+            if (!hasFormat || _checkFormat(info) != 0) return -1;
+
+            info->blockFrames = 1;
+            if (info->format == CMDFX_WAVE_IMA_ADPCM)
+                info->blockFrames =
+                    _blockFrames(info->frameSize, info->channels);
+
+            long offset = ftell(file);
+            long available = fileSize - offset;
+            long dataSize = (long) size;
+            if (dataSize > available || dataSize < 0) dataSize = available;
+
+            info->dataOffset = offset;
+            info->frames = (int) (dataSize / info->frameSize);
+            info->dataSize = info->frames * (long) info->frameSize;
+
+            // a short last block still holds frames
+            if (info->format == CMDFX_WAVE_IMA_ADPCM) {
+                long rest = dataSize - info->dataSize;
+                int blocks = info->frames;
+
+                info->frames = blocks * info->blockFrames +
+                               _blockFrames(rest, info->channels);
+                if (rest >= 4L * info->channels) info->dataSize = dataSize;
+            }
+
+            return info->frames > 0 ? 0 : -1;
+        }
+        else
+            fseek(file, (long) size, SEEK_CUR);
+
+        // chunks are padded to an even size
+        if (size & 1) fseek(file, 1, SEEK_CUR);
+    }
+
+    return -1;
+}
+
+// Conversion
+
+static short _clampSample(double value) {
+    if (value > 32767.0) return 32767;
+    if (value < -32768.0) return -32768;
+    return (short) value;
+}
+
+static short _convertSample(
+    const unsigned char* p, int format, int bits
+) {
+    if (format == CMDFX_WAVE_FLOAT) {
+        if (bits == 32) {
+            uint32_t raw = (uint32_t) _readU32(p);
+            float value;
+            memcpy(&value, &raw, sizeof(value));
+            return _clampSample(value * 32767.0);
+        }
+
+        uint64_t raw = _readU32(p) | ((uint64_t) _readU32(p + 4) << 32);
+        double value;
+        memcpy(&value, &raw, sizeof(value));
+        return _clampSample(value * 32767.0);
+    }
+
+    // integer PCM keeps its top 16 bits; 8-bit data is unsigned
+    switch (bits) {
+        case 8: return (short) ((p[0] - 128) * 256);
+        case 16: return (short) _readU16(p);
+        case 24: return (short) (p[1] | (p[2] << 8));
+        default: return (short) (p[2] | (p[3] << 8));
+    }
+}
+
+void CmdFX_wave_convert(
+    const CmdFX_WaveInfo* info, const unsigned char* src, short* dst,
+    int frames
+) {
+    int bytes = info->bits / 8;
+    int right = info->channels > 1 ? bytes : 0;
+
+    for (int i = 0; i < frames; i++) {
+        const unsigned char* frame = src + i * info->frameSize;
+        dst[i * 2] = _convertSample(frame, info->format, info->bits);
+        dst[i * 2 + 1] =
+            _convertSample(frame + right, info->format, info->bits);
+    }
+}
+
+// IMA ADPCM
+
+static const short _stepSizes[89] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,
+    19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+    337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+    876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+    2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+    5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const signed char _indexSteps[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static void _decodeNibble(int nibble, int* predictor, int* index) {
+    int step = _stepSizes[*index];
+    int diff = step >> 3;
+    if (nibble & 1) diff += step >> 2;
+    if (nibble & 2) diff += step >> 1;
+    if (nibble & 4) diff += step;
+
+    int value = *predictor + (nibble & 8 ? -diff : diff);
+    *predictor = value > 32767 ? 32767 : value < -32768 ? -32768 : value;
+
+    int next = *index + _indexSteps[nibble];
+    *index = next < 0 ? 0 : next > 88 ? 88 : next;
+}
+
+void CmdFX_wave_decodeBlock(
+    const unsigned char* block, int channels, short* dst, int frames
+) {
+    if (frames < 1) return;
+
+    const unsigned char* data = block + 4 * channels;
+    for (int c = 0; c < channels; c++) {
+        const unsigned char* header = block + 4 * c;
+        int predictor = (short) _readU16(header);
+        int index = header[2] > 88 ? 88 : header[2];
+        dst[c] = (short) predictor;
+
+        // each channel has 4 bytes, 8 frames, in every group; low nibbles
+        // come first
+        int frame = 1;
+        for (int group = 0; frame < frames; group++) {
+            const unsigned char* bytes = data + (group * channels + c) * 4;
+            for (int i = 0; i < 8 && frame < frames; i++, frame++) {
+                int nibble = (bytes[i / 2] >> (i % 2 * 4)) & 0xF;
+                _decodeNibble(nibble, &predictor, &index);
+                dst[frame * 2 + c] = (short) predictor;
+            }
+        }
+    }
+
+    if (channels == 1)
+        for (int i = 0; i < frames; i++) dst[i * 2 + 1] = dst[i * 2];
+}
+
+// Writing
+
+static void _writeU16(unsigned char* p, unsigned int value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+}
+
+static void _writeU32(unsigned char* p, unsigned long value) {
+    _writeU16(p, value & 0xFFFF);
+    _writeU16(p + 2, (value >> 16) & 0xFFFF);
+}
+
+int CmdFX_wave_writeHeader(FILE* file, int rate, long frames) {
+    if (!file || rate < 1 || frames < 0) return -1;
+
+    // the mixer's output: interleaved 16-bit stereo
+    unsigned long frameSize = 2 * sizeof(short);
+    unsigned long dataSize = (unsigned long) frames * frameSize;
+
+    unsigned char header[44];
+    memcpy(header, "RIFF", 4);
+    _writeU32(header + 4, 36 + dataSize);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    _writeU32(header + 16, 16);
+    _writeU16(header + 20, CMDFX_WAVE_PCM);
+    _writeU16(header + 22, 2);
+    _writeU32(header + 24, (unsigned long) rate);
+    _writeU32(header + 28, (unsigned long) rate * frameSize);
+    _writeU16(header + 32, frameSize);
+    _writeU16(header + 34, 16);
+    memcpy(header + 36, "data", 4);
+    _writeU32(header + 40, dataSize);
+
+    return fwrite(header, 1, sizeof(header), file) == sizeof(header) ? 0 : -1;
+}
+
+int CmdFX_wave_writeFrames(FILE* file, const short* samples, int frames) {
+    if (!file || !samples || frames < 0) return -1;
+
+    unsigned char bytes[1024];
+    int samplesLeft = frames * 2;
+    while (samplesLeft > 0) {
+        int count = samplesLeft < 512 ? samplesLeft : 512;
+        for (int i = 0; i < count; i++)
+            _writeU16(bytes + i * 2, (unsigned short) samples[i]);
+
+        if (fwrite(bytes, 2, count, file) != (size_t) count) return -1;
+
+        samples += count;
+        samplesLeft -= count;
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file wave.h
+ * @brief Internal WAV file reader and writer for the sound engine.
+ *
+ * This is a private header. It walks the RIFF chunks of a WAV file to find
+ * its format and audio data, and converts frames of that data to the 16-bit
+ * stereo the mixer plays, so the sample bank can decode a file whole and
+ * streams can decode it a chunk at a time. Sample rates are left as they
+ * are; the mixer resamples voices to the device rate as it plays them.
+ *
+ * IMA ADPCM data is kept compressed in the bank instead, and decoded a block
+ * at a time by the mixer.
+ *
+ * The file sink writes the mixer's output back out as 16-bit stereo WAV.
+ */
+#pragma once
+
+#include <stdio.h>
+
+/** Integer PCM data. */
+#define CMDFX_WAVE_PCM 1
+/** IEEE floating point data. */
+#define CMDFX_WAVE_FLOAT 3
+/** IMA ADPCM data, 4 bits per sample in blocks that decode on their own. */
+#define CMDFX_WAVE_IMA_ADPCM 0x11
+
+/** The most frames an IMA ADPCM block may hold. */
+#define CMDFX_WAVE_MAX_BLOCK_FRAMES 2048
+
+/** The format and location of the audio data of a WAV file. */
+typedef struct CmdFX_WaveInfo {
+    int format;      // one of the CMDFX_WAVE_* formats
+    int channels;    // interleaved channels in a frame
+    int rate;        // frames per second
+    int bits;        // bits per sample
+    int frameSize;   // bytes per frame, or per block of ADPCM data
+    int blockFrames; // frames per block of ADPCM data, else 1
+    long dataOffset; // in bytes, from the start of the file
+    long dataSize;   // in bytes, a whole number of frames
+    int frames;      // frames in the data
+} CmdFX_WaveInfo;
+
+/**
+ * @brief Reads the format and data location of a WAV file.
+ *
+ * Chunks other than `fmt ` and `data` are skipped. 8-, 16-, 24- and 32-bit
+ * integer PCM and 32- and 64-bit float data are supported, including
+ * `WAVE_FORMAT_EXTENSIBLE` files, with any number of channels, as is mono or
+ * stereo IMA ADPCM with blocks of up to `CMDFX_WAVE_MAX_BLOCK_FRAMES` frames.
+ * A data chunk that claims more bytes than the file holds is cut to the file.
+ *
+ * @param file The file, at any position.
+ * @param info The format to fill.
+ * @return `0` if successful, or `-1` if the file is not a supported WAV file
+ * or holds no audio data.
+ */
+int CmdFX_wave_readInfo(FILE* file, CmdFX_WaveInfo* info);
+
+/**
+ * @brief Converts frames of WAV data to interleaved 16-bit stereo.
+ *
+ * Mono is played on both sides, and channels past the first two are
+ * dropped. IMA ADPCM data is decoded with `CmdFX_wave_decodeBlock` instead.
+ *
+ * @param info The format of the data.
+ * @param src The data, `frames * info->frameSize` bytes long.
+ * @param dst The output, `frames * 2` samples long.
+ * @param frames The number of frames to convert.
+ */
+void CmdFX_wave_convert(
+    const CmdFX_WaveInfo* info, const unsigned char* src, short* dst,
+    int frames
+);
+
+/**
+ * @brief Decodes the first frames of an IMA ADPCM block to 16-bit stereo.
+ *
+ * Each block starts with a raw frame and decodes on its own, so any block
+ * can be decoded without the ones before it. Mono is played on both sides.
+ *
+ * @param block The block.
+ * @param channels The number of channels, `1` or `2`.
+ * @param dst The output, `frames * 2` samples long.
+ * @param frames The number of frames to decode, at most the frames in the
+ * block.
+ */
+void CmdFX_wave_decodeBlock(
+    const unsigned char* block, int channels, short* dst, int frames
+);
+
+// Writing
+
+/**
+ * @brief Writes the header of a 16-bit stereo PCM WAV file.
+ *
+ * The header is 44 bytes long and is followed by the data. Write it again
+ * once the data is written to fill in its size.
+ *
+ * @param file The file, at its start.
+ * @param rate The rate of the data, in frames per second.
+ * @param frames The number of frames in the data.
+ * @return `0` if successful, or `-1` if the header could not be written.
+ */
+int CmdFX_wave_writeHeader(FILE* file, int rate, long frames);
+
+/**
+ * @brief Writes interleaved 16-bit stereo frames as little-endian data.
+ * @param file The file, after the header or previous frames.
+ * @param samples The frames, `frames * 2` samples long.
+ * @param frames The number of frames to write.
+ * @return `0` if successful, or `-1` if the frames could not be written.
+ */
+int CmdFX_wave_writeFrames(FILE* file, const short* samples, int frames);
@@ -6,6 +6,10 @@
 #include "cmdfx/core/util.h"
 #include "cmdfx/physics/engine.h"
 #include "cmdfx/ui/button.h"
+#include "common/core/shared.h"
+
+// in sprites.c; measures a character grid
+extern void _getSpriteDimensions(char** data, int* width, int* height);
 
 #define _BUTTON_REGISTRY_MUTEX 8
 static CmdFX_Button** _registeredButtons = 0;
@@ -21,6 +25,169 @@ int Canvas_getRegisteredButtonsCount() {
     return _registeredButtonsCount;
 }
 
+// Spatial Index
+
+// registered buttons are bucketed by the coarse grid cells their rectangles
+// cover, so hit testing only scans the buttons near the queried position
+// instead of every registered button; guarded by _BUTTON_REGISTRY_MUTEX
+#define _BUTTON_BUCKET_WIDTH 8
+#define _BUTTON_BUCKET_HEIGHT 4
+
+typedef struct {
+    CmdFX_Button** buttons;
+    int count;
+    int capacity;
+} _ButtonBucket;
+
+// the rectangle a button was indexed with, kept so it can be unindexed even
+// after its position or sprite dimensions have changed
+typedef struct {
+    CmdFX_Button* button;
+    int x;
+    int y;
+    int width;
+    int height;
+} _IndexedButton;
+
+static _ButtonBucket* _buttonBuckets = 0;
+static int _buttonBucketColumns = 0;
+static int _buttonBucketRows = 0;
+
+static _IndexedButton* _indexedButtons = 0;
+static int _indexedButtonsCount = 0;
+static int _indexedButtonsCapacity = 0;
+
+static int _growButtonBuckets(int columns, int rows) {
+    if (columns <= _buttonBucketColumns && rows <= _buttonBucketRows) return 0;
+    if (columns < _buttonBucketColumns) columns = _buttonBucketColumns;
+    if (rows < _buttonBucketRows) rows = _buttonBucketRows;
+
+    _ButtonBucket* buckets = calloc(columns * rows, sizeof(_ButtonBucket));
+    if (buckets == 0) return -1;
+
+    for (int i = 0; i < _buttonBucketRows; i++)
+        for (int j = 0; j < _buttonBucketColumns; j++)
+            buckets[i * columns + j] =
+                _buttonBuckets[i * _buttonBucketColumns + j];
+
+    free(_buttonBuckets);
+    _buttonBuckets = buckets;
+    _buttonBucketColumns = columns;
+    _buttonBucketRows = rows;
+
+    return 0;
+}
+
+static int _bucketInsert(_ButtonBucket* bucket, CmdFX_Button* button) {
+    if (bucket->count >= bucket->capacity) {
+        int capacity = bucket->capacity == 0 ? 4 : bucket->capacity * 2;
+        CmdFX_Button** temp =
+            realloc(bucket->buttons, sizeof(CmdFX_Button*) * capacity);
+        if (temp == 0) return -1;
+
+        bucket->buttons = temp;
+        bucket->capacity = capacity;
+    }
+
+    bucket->buttons[bucket->count++] = button;
+    return 0;
+}
+
+static void _bucketErase(_ButtonBucket* bucket, CmdFX_Button* button) {
+    for (int i = 0; i < bucket->count; i++) {
+        if (bucket->buttons[i] != button) continue;
+
+        bucket->buttons[i] = bucket->buttons[--bucket->count];
+        return;
+    }
+}
+
+static void _unindexButton(CmdFX_Button* button) {
+    int index = -1;
+    for (int i = 0; i < _indexedButtonsCount; i++) {
+        if (_indexedButtons[i].button == button) {
+            index = i;
+            break;
+        }
+    }
+    if (index == -1) return;
+
+    _IndexedButton entry = _indexedButtons[index];
+    int x0 = entry.x / _BUTTON_BUCKET_WIDTH;
+    int y0 = entry.y / _BUTTON_BUCKET_HEIGHT;
+    int x1 = (entry.x + entry.width - 1) / _BUTTON_BUCKET_WIDTH;
+    int y1 = (entry.y + entry.height - 1) / _BUTTON_BUCKET_HEIGHT;
+
+    for (int i = y0; i <= y1; i++)
+        for (int j = x0; j <= x1; j++)
+            _bucketErase(&_buttonBuckets[i * _buttonBucketColumns + j], button);
+
+    _indexedButtons[index] = _indexedButtons[--_indexedButtonsCount];
+}
+
+static int _indexButton(CmdFX_Button* button) {
+    _unindexButton(button);
+
+    int x = button->x;
+    int y = button->y;
+    int width = button->sprite->width;
+    int height = button->sprite->height;
+    if (x < 0 || y < 0 || width < 1 || height < 1) return 0;
+
+    if (_indexedButtonsCount >= _indexedButtonsCapacity) {
+        int capacity =
+            _indexedButtonsCapacity == 0 ? 16 : _indexedButtonsCapacity * 2;
+        _IndexedButton* temp =
+            realloc(_indexedButtons, sizeof(_IndexedButton) * capacity);
+        if (temp == 0) return -1;
+
+        _indexedButtons = temp;
+        _indexedButtonsCapacity = capacity;
+    }
+
+    int x0 = x / _BUTTON_BUCKET_WIDTH;
+    int y0 = y / _BUTTON_BUCKET_HEIGHT;
+    int x1 = (x + width - 1) / _BUTTON_BUCKET_WIDTH;
+    int y1 = (y + height - 1) / _BUTTON_BUCKET_HEIGHT;
+    if (_growButtonBuckets(x1 + 1, y1 + 1) != 0) return -1;
+
+    for (int i = y0; i <= y1; i++) {
+        for (int j = x0; j <= x1; j++) {
+            _ButtonBucket* bucket =
+                &_buttonBuckets[i * _buttonBucketColumns + j];
+            if (_bucketInsert(bucket, button) == 0) continue;
+
+            // roll back; erasing from a bucket never filled is a no-op
+            for (int k = y0; k <= y1; k++)
+                for (int l = x0; l <= x1; l++)
+                    _bucketErase(
+                        &_buttonBuckets[k * _buttonBucketColumns + l], button
+                    );
+            return -1;
+        }
+    }
+
+    _IndexedButton entry = {button, x, y, width, height};
+    _indexedButtons[_indexedButtonsCount++] = entry;
+
+    return 0;
+}
+
+static _ButtonBucket* _bucketAt(int x, int y) {
+    int column = x / _BUTTON_BUCKET_WIDTH;
+    int row = y / _BUTTON_BUCKET_HEIGHT;
+    if (column >= _buttonBucketColumns || row >= _buttonBucketRows) return 0;
+
+    return &_buttonBuckets[row * _buttonBucketColumns + column];
+}
+
+static int _buttonContains(CmdFX_Button* button, int x, int y) {
+    if (x < button->x || x >= button->x + button->sprite->width) return 0;
+    if (y < button->y || y >= button->y + button->sprite->height) return 0;
+
+    return 1;
+}
+
 CmdFX_Button* Button_create(
     CmdFX_Sprite* sprite, CmdFX_ButtonCallback callback
 ) {
@@ -65,6 +232,13 @@ CmdFX_Button* Button_createFilled(
 void Button_free(CmdFX_Button* button) {
     if (button == 0) return;
 
+    CmdFX_tryLockMutex(_BUTTON_REGISTRY_MUTEX);
+    _unindexButton(button);
+    if (button->id >= 0 && button->id < _registeredButtonsCount &&
+        _registeredButtons[button->id] == button)
+        _registeredButtons[button->id] = 0;
+    CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
+
     Sprite_free(button->sprite);
     free(button->callback);
     free(button);
@@ -74,7 +248,8 @@ int Button_draw(int x, int y, CmdFX_Button* button) {
     if (button == 0) return -1;
     if (button->sprite == 0) return -1;
 
-    if (Sprite_draw(x, y, button->sprite) != 0) return -1;
+    // Sprite_draw returns 1 on success
+    if (!Sprite_draw(x, y, button->sprite)) return -1;
 
     CmdFX_tryLockMutex(_BUTTON_POSITION_MUTEX);
     button->x = x;
@@ -83,30 +258,28 @@ int Button_draw(int x, int y, CmdFX_Button* button) {
 
     CmdFX_tryLockMutex(_BUTTON_REGISTRY_MUTEX);
     int spritesCount = Canvas_getDrawnSpritesCount();
-    if (_registeredButtons == 0) {
-        _registeredButtons = malloc(sizeof(CmdFX_Button*) * spritesCount);
-        if (_registeredButtons == 0) {
-            CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
-            return -1;
-        }
-        _registeredButtonsCount = spritesCount;
-    }
-    if (_registeredButtonsCount != spritesCount) {
+    if (_registeredButtonsCount < spritesCount) {
         CmdFX_Button** temp =
             realloc(_registeredButtons, sizeof(CmdFX_Button*) * spritesCount);
         if (temp == 0) {
             CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
             return -1;
         }
+
+        for (int i = _registeredButtonsCount; i < spritesCount; i++)
+            temp[i] = 0;
+
         _registeredButtons = temp;
         _registeredButtonsCount = spritesCount;
     }
 
     button->id = button->sprite->id - 1;
     _registeredButtons[button->id] = button;
+
+    int res = _indexButton(button);
     CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
 
-    return 0;
+    return res;
 }
 
 int Button_remove(CmdFX_Button* button) {
@@ -114,8 +287,11 @@ int Button_remove(CmdFX_Button* button) {
     if (button->sprite == 0) return -1;
 
     CmdFX_tryLockMutex(_BUTTON_REGISTRY_MUTEX);
-    _registeredButtons[button->id] = 0;
+    if (button->id >= 0 && button->id < _registeredButtonsCount &&
+        _registeredButtons[button->id] == button)
+        _registeredButtons[button->id] = 0;
     button->id = -1;
+    _unindexButton(button);
     CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
 
     Sprite_remove(button->sprite);
@@ -133,6 +309,15 @@ int Button_hide(CmdFX_Button* button) {
     if (button == 0) return -1;
     if (button->sprite == 0) return -1;
 
+    // a hidden button keeps its id, so showing it registers it again, but
+    // leaves the index so it no longer receives clicks
+    CmdFX_tryLockMutex(_BUTTON_REGISTRY_MUTEX);
+    if (button->id >= 0 && button->id < _registeredButtonsCount &&
+        _registeredButtons[button->id] == button)
+        _registeredButtons[button->id] = 0;
+    _unindexButton(button);
+    CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
+
     Sprite_remove(button->sprite);
     return 0;
 }
@@ -141,49 +326,66 @@ int Button_show(CmdFX_Button* button) {
     if (button == 0) return -1;
     if (button->sprite == 0) return -1;
 
-    return Sprite_draw(button->x, button->y, button->sprite);
+    if (button->id >= 0) return Button_draw(button->x, button->y, button);
+
+    // Sprite_draw returns 1 on success
+    return Sprite_draw(button->x, button->y, button->sprite) ? 0 : -1;
 }
 
-CmdFX_Button** Canvas_getAllButtonsAt(int x, int y) {
+int Canvas_collectButtonsAt(int x, int y, CmdFX_Button** buffer, int size) {
     if (x < 0 || y < 0) return 0;
-    if (_registeredButtons == 0) return 0;
-    if (_registeredButtonsCount < 1) return 0;
 
-    CmdFX_Button** matching =
-        calloc(_registeredButtonsCount, sizeof(CmdFX_Sprite*));
+    CmdFX_tryLockMutex(_BUTTON_REGISTRY_MUTEX);
+    _ButtonBucket* bucket = _bucketAt(x, y);
+    if (bucket == 0) {
+        CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
+        return 0;
+    }
 
-    for (int i = 0; i < _registeredButtonsCount; i++) {
-        CmdFX_Button* button = _registeredButtons[i];
-        if (button->id == 0) continue;
+    int found = 0;
+    for (int i = 0; i < bucket->count; i++) {
+        CmdFX_Button* button = bucket->buttons[i];
+        if (!_buttonContains(button, x, y)) continue;
 
-        if (x >= button->x && x < button->x + button->sprite->width)
-            if (y >= button->y && y < button->y + button->sprite->height)
-                matching[i] = button;
+        if (buffer != 0 && found < size) buffer[found] = button;
+        found++;
     }
+    CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
+
+    return found;
+}
+
+CmdFX_Button** Canvas_getAllButtonsAt(int x, int y) {
+    int found = Canvas_collectButtonsAt(x, y, 0, 0);
+    if (found < 1) return 0;
+
+    CmdFX_Button** matching = calloc(found + 1, sizeof(CmdFX_Button*));
+    if (matching == 0) return 0;
 
+    Canvas_collectButtonsAt(x, y, matching, found);
     return matching;
 }
 
 CmdFX_Button* Canvas_getButtonAt(int x, int y) {
     if (x < 0 || y < 0) return 0;
-    if (_registeredButtons == 0) return 0;
-    if (_registeredButtonsCount < 1) return 0;
 
-    CmdFX_Button** matching = Canvas_getAllButtonsAt(x, y);
+    CmdFX_tryLockMutex(_BUTTON_REGISTRY_MUTEX);
+    _ButtonBucket* bucket = _bucketAt(x, y);
+    if (bucket == 0) {
+        CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
+        return 0;
+    }
 
-    CmdFX_Button* button = 0;
-    for (int i = 0; i < _registeredButtonsCount; i++) {
-        if (matching[i] == 0) continue;
-        if (button == 0) {
-            button = matching[i];
-            continue;
-        }
+    CmdFX_Button* top = 0;
+    for (int i = 0; i < bucket->count; i++) {
+        CmdFX_Button* button = bucket->buttons[i];
+        if (!_buttonContains(button, x, y)) continue;
 
-        if (matching[i]->sprite->z > button->sprite->z) button = matching[i];
+        if (top == 0 || button->sprite->z > top->sprite->z) top = button;
     }
+    CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
 
-    free(matching);
-    return 0;
+    return top;
 }
 
 int Button_setData(CmdFX_Button* button, char** data, char*** ansi) {
@@ -192,28 +394,45 @@ int Button_setData(CmdFX_Button* button, char** data, char*** ansi) {
     if (data == 0) return -1;
 
     CmdFX_Sprite* sprite = button->sprite;
+    if (!_Sprite_ownData(sprite)) return -1;
+
+    int width = 0;
+    int height = 0;
+    _getSpriteDimensions(data, &width, &height);
+    int resized = width != sprite->width || height != sprite->height;
+
+    // old styles are dropped when replaced, or when they no longer fit
+    if (sprite->ansi != 0 && (ansi != 0 || resized)) {
+        for (int i = 0; i < sprite->height; i++) {
+            if (sprite->ansi[i] == 0) continue;
+            for (int j = 0; j < sprite->width; j++) free(sprite->ansi[i][j]);
+            free(sprite->ansi[i]);
+        }
+        free(sprite->ansi);
+        sprite->ansi = 0;
+    }
+    if (ansi != 0) sprite->ansi = ansi;
+
     for (int i = 0; i < sprite->height; i++) {
         if (sprite->data[i] == 0) continue;
         free(sprite->data[i]);
     }
     free(sprite->data);
     sprite->data = data;
+    sprite->width = width;
+    sprite->height = height;
 
-    if (ansi != 0) {
-        int height = getStringArrayHeight(sprite->ansi);
-        int width = getStringArrayWidth(sprite->ansi);
-        for (int i = 0; i < height; i++) {
-            for (int j = 0; j < width; j++) free(sprite->ansi[i][j]);
-            free(sprite->ansi[i]);
-        }
-        free(sprite->ansi);
+    if (Button_isHidden(button)) return 0;
 
-        sprite->ansi = ansi;
-    }
+    // Sprite_draw returns 1 on success
+    if (!Sprite_draw(button->x, button->y, sprite)) return -1;
+    if (button->id < 0) return 0;
 
-    if (Sprite_draw(button->x, button->y, sprite) != 0) return -1;
+    CmdFX_tryLockMutex(_BUTTON_REGISTRY_MUTEX);
+    int res = _indexButton(button);
+    CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
 
-    return 0;
+    return res;
 }
 
 int Button_moveTo(CmdFX_Button* button, int x, int y) {
@@ -225,6 +444,13 @@ int Button_moveTo(CmdFX_Button* button, int x, int y) {
     button->y = y;
     CmdFX_tryUnlockMutex(_BUTTON_POSITION_MUTEX);
 
+    // a hidden button stays out of the index until it is shown again
+    if (button->id >= 0 && !Button_isHidden(button)) {
+        CmdFX_tryLockMutex(_BUTTON_REGISTRY_MUTEX);
+        _indexButton(button);
+        CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
+    }
+
     Sprite_moveTo(button->sprite, x, y);
     return 0;
 }
@@ -238,6 +464,13 @@ int Button_moveBy(CmdFX_Button* button, int dx, int dy) {
     button->y += dy;
     CmdFX_tryUnlockMutex(_BUTTON_POSITION_MUTEX);
 
+    // a hidden button stays out of the index until it is shown again
+    if (button->id >= 0 && !Button_isHidden(button)) {
+        CmdFX_tryLockMutex(_BUTTON_REGISTRY_MUTEX);
+        _indexButton(button);
+        CmdFX_tryUnlockMutex(_BUTTON_REGISTRY_MUTEX);
+    }
+
     Sprite_moveBy(button->sprite, dx, dy);
     return 0;
 }
@@ -77,11 +77,13 @@ int Scene_addButton(int uid, CmdFX_Button* button, int x, int y) {
     if (button == 0) return -1;
     if (Scene_getRegisteredScene(uid) == 0) return -1;
 
+    // the registry is created on first use, so it must exist before the
+    // count is read
+    _checkSceneButtons(uid);
+
     int count = _sceneButtonsCount[uid];
     if (count >= MAX_BUTTONS_PER_SCENE) return -1;
 
-    _checkSceneButtons(uid);
-
     CmdFX_tryLockMutex(_BUTTON_SCENE_REGISTRY_MUTEX);
     _sceneButtonCoordinates[uid][count][0] = x;
     _sceneButtonCoordinates[uid][count][1] = y;
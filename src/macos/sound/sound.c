@@ -1,195 +1,113 @@
 #include <AudioToolbox/AudioToolbox.h>
 #include <AudioUnit/AudioUnit.h>
 #include <CoreAudio/CoreAudio.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "cmdfx/sound/sound.h"
-
-// macOS-specific sound data structure
-typedef struct _MacOSSoundData {
-    AudioUnit audioUnit;
-    AudioFileID audioFile;
-    AudioStreamBasicDescription fileFormat;
-    UInt64 totalFrames;
-    UInt64 currentFrame;
-    int loopCount;
-    int currentLoop;
-    double volume;
-    int isPlaying;
-    int isPaused;
-} _MacOSSoundData;
+#include "common/core/trace.h"
+#include "common/sound/mixer.h"
 
 static int _soundSystemInitialized = 0;
+static AudioUnit _audioUnit = NULL;
+static pthread_mutex_t _soundMutex = PTHREAD_MUTEX_INITIALIZER;
+// the device time the next render callback should start at
+static Float64 _expectedTime = -1;
 
-int _Platform_initSoundSystem() {
-    if (_soundSystemInitialized) return 0;
+void _Platform_lockSound() {
+    pthread_mutex_lock(&_soundMutex);
+}
 
-    // Initialize Core Audio
-    AudioComponentInstance* out = NULL;
-    AudioComponentDescription desc = {
-        .componentType = kAudioUnitType_Output,
-        .componentSubType = kAudioUnitSubType_DefaultOutput,
-        .componentManufacturer = kAudioUnitManufacturer_Apple,
-    };
-    OSStatus status =
-        AudioComponentInstanceNew(AudioComponentFindNext(NULL, &desc), out);
+void _Platform_unlockSound() {
+    pthread_mutex_unlock(&_soundMutex);
+}
 
-    if (status != noErr) {
-        fprintf(
-            stderr, "Failed to initialize Core Audio system: %d\n", (int) status
-        );
+// Stream Thread
+
+static pthread_t _streamThread;
+static void (*_streamFunc)() = NULL;
+
+static void* _streamThreadMain(void* arg) {
+    (void) arg;
+
+    _streamFunc();
+    return NULL;
+}
+
+int _Platform_startStreamThread(void (*func)()) {
+    _streamFunc = func;
+    if (pthread_create(&_streamThread, NULL, _streamThreadMain, NULL) != 0)
         return -1;
-    }
 
-    _soundSystemInitialized = 1;
     return 0;
 }
 
-void _Platform_shutdownSoundSystem() {
-    if (!_soundSystemInitialized) return;
+void _Platform_joinStreamThread() {
+    pthread_join(_streamThread, NULL);
+}
 
-    // Core Audio cleanup is handled per-instance
-    _soundSystemInitialized = 0;
+// Sink Thread
+
+static pthread_t _sinkThread;
+static void (*_sinkFunc)() = NULL;
+
+static void* _sinkThreadMain(void* arg) {
+    (void) arg;
+
+    _sinkFunc();
+    return NULL;
 }
 
-// Audio render callback
+int _Platform_startSinkThread(void (*func)()) {
+    _sinkFunc = func;
+    if (pthread_create(&_sinkThread, NULL, _sinkThreadMain, NULL) != 0)
+        return -1;
+
+    return 0;
+}
+
+void _Platform_joinSinkThread() {
+    pthread_join(_sinkThread, NULL);
+}
+
+// Audio render callback, run on the Core Audio thread
 static OSStatus _audioRenderCallback(
     void* inRefCon, AudioUnitRenderActionFlags* ioActionFlags,
     const AudioTimeStamp* inTimeStamp, UInt32 inBusNumber,
     UInt32 inNumberFrames, AudioBufferList* ioData
 ) {
+    (void) inRefCon;
     (void) ioActionFlags;
-    (void) inTimeStamp;
     (void) inBusNumber;
-    (void) inNumberFrames;
-
-    _MacOSSoundData* soundData = (_MacOSSoundData*) inRefCon;
-
-    if (!soundData || !soundData->isPlaying || soundData->isPaused) {
-        // Silence
-        for (UInt32 i = 0; i < ioData->mNumberBuffers; i++) {
-            memset(
-                ioData->mBuffers[i].mData, 0, ioData->mBuffers[i].mDataByteSize
-            );
-        }
-        return noErr;
-    }
+    CmdFX_trace_nameThread("sound");
 
-    UInt32 bytesToRead = ioData->mBuffers[0].mDataByteSize;
-    UInt32 bytesRead = 0;
+    // a jump in the device clock means frames were skipped since the last
+    // callback, so the device ran dry
+    Float64 time = inTimeStamp->mSampleTime;
+    int skipped = (inTimeStamp->mFlags & kAudioTimeStampSampleTimeValid) &&
+                  _expectedTime >= 0 && time > _expectedTime;
+    _expectedTime = time + inNumberFrames;
 
-    OSStatus status = AudioFileReadBytes(
-        soundData->audioFile, false,
-        soundData->currentFrame * soundData->fileFormat.mBytesPerFrame,
-        &bytesToRead, ioData->mBuffers[0].mData
-    );
-
-    if (status == noErr) {
-        bytesRead = bytesToRead;
-        soundData->currentFrame +=
-            bytesRead / soundData->fileFormat.mBytesPerFrame;
-
-        // Apply volume
-        if (soundData->volume != 1.0) {
-            float* samples = (float*) ioData->mBuffers[0].mData;
-            UInt32 sampleCount = bytesRead / sizeof(float);
-            for (UInt32 i = 0; i < sampleCount; i++) {
-                samples[i] *= soundData->volume;
-            }
-        }
-
-        // Check if we've reached the end
-        if (soundData->currentFrame >= soundData->totalFrames) {
-            if (soundData->loopCount == -1 ||
-                soundData->currentLoop < soundData->loopCount - 1) {
-                soundData->currentFrame = 0; // Reset to beginning
-                soundData->currentLoop++;
-            }
-            else {
-                soundData->isPlaying = 0; // Stop playback
-            }
-        }
-    }
-    else {
-        // Error reading file, stop playback
-        soundData->isPlaying = 0;
-        memset(ioData->mBuffers[0].mData, 0, ioData->mBuffers[0].mDataByteSize);
-    }
+    // the stream format is interleaved, so there is a single buffer
+    pthread_mutex_lock(&_soundMutex);
+    if (skipped) CmdFX_mixer_countUnderrun();
+    CmdFX_mixer_render((short*) ioData->mBuffers[0].mData, inNumberFrames);
+    pthread_mutex_unlock(&_soundMutex);
 
     return noErr;
 }
 
-int _Platform_playSound(
-    const char* soundFile, int loopCount, void** platformData
-) {
-    if (!soundFile || !platformData) return -1;
-
-    _MacOSSoundData* soundData = malloc(sizeof(_MacOSSoundData));
-    if (!soundData) return -1;
-
-    memset(soundData, 0, sizeof(_MacOSSoundData));
-    soundData->loopCount = loopCount;
-    soundData->currentLoop = 0;
-    soundData->volume = 1.0;
-    soundData->isPlaying = 0;
-    soundData->isPaused = 0;
-
-    // Open audio file
-    CFStringRef filePath = CFStringCreateWithCString(
-        kCFAllocatorDefault, soundFile, kCFStringEncodingUTF8
-    );
-    CFURLRef fileURL = CFURLCreateWithFileSystemPath(
-        kCFAllocatorDefault, filePath, kCFURLPOSIXPathStyle, false
-    );
-
-    OSStatus status = AudioFileOpenURL(
-        fileURL, kAudioFileReadPermission, 0, &soundData->audioFile
-    );
-    CFRelease(fileURL);
-    CFRelease(filePath);
-
-    if (status != noErr) {
-        fprintf(
-            stderr, "Failed to open audio file '%s': %d\n", soundFile,
-            (int) status
-        );
-        free(soundData);
-        return -1;
-    }
-
-    // Get audio format
-    UInt32 propSize = sizeof(soundData->fileFormat);
-    status = AudioFileGetProperty(
-        soundData->audioFile, kAudioFilePropertyDataFormat, &propSize,
-        &soundData->fileFormat
-    );
-
-    if (status != noErr) {
-        fprintf(stderr, "Failed to get audio file format: %d\n", (int) status);
-        AudioFileClose(soundData->audioFile);
-        free(soundData);
-        return -1;
-    }
-
-    // Get total frames
-    propSize = sizeof(soundData->totalFrames);
-    status = AudioFileGetProperty(
-        soundData->audioFile, kAudioFilePropertyAudioDataPacketCount, &propSize,
-        &soundData->totalFrames
-    );
+static void _disposeAudioUnit() {
+    AudioComponentInstanceDispose(_audioUnit);
+    _audioUnit = NULL;
+}
 
-    if (status != noErr) {
-        fprintf(
-            stderr, "Failed to get audio file frame count: %d\n", (int) status
-        );
-        AudioFileClose(soundData->audioFile);
-        free(soundData);
-        return -1;
-    }
+int _Platform_initSoundSystem() {
+    if (_soundSystemInitialized) return 0;
 
-    // Create audio unit
+    // one output unit is shared by every sound
     AudioComponentDescription desc = {
         .componentType = kAudioUnitType_Output,
         .componentSubType = kAudioUnitSubType_DefaultOutput,
@@ -199,114 +117,98 @@ int _Platform_playSound(
     AudioComponent component = AudioComponentFindNext(NULL, &desc);
     if (!component) {
         fprintf(stderr, "Failed to find audio component\n");
-        AudioFileClose(soundData->audioFile);
-        free(soundData);
         return -1;
     }
 
-    status = AudioComponentInstanceNew(component, &soundData->audioUnit);
+    OSStatus status = AudioComponentInstanceNew(component, &_audioUnit);
     if (status != noErr) {
         fprintf(stderr, "Failed to create audio unit: %d\n", (int) status);
-        AudioFileClose(soundData->audioFile);
-        free(soundData);
+        _audioUnit = NULL;
         return -1;
     }
 
-    // Set render callback
-    AURenderCallbackStruct callback = {
-        .inputProc = _audioRenderCallback, .inputProcRefCon = soundData
+    // the mixer renders interleaved 16-bit stereo
+    int rate = CmdFX_mixer_getRate();
+    AudioStreamBasicDescription format = {
+        .mSampleRate = rate,
+        .mFormatID = kAudioFormatLinearPCM,
+        .mFormatFlags = kLinearPCMFormatFlagIsSignedInteger |
+                        kLinearPCMFormatFlagIsPacked,
+        .mFramesPerPacket = 1,
+        .mChannelsPerFrame = CMDFX_MIXER_CHANNELS,
+        .mBitsPerChannel = 16,
+        .mBytesPerFrame = CMDFX_MIXER_CHANNELS * sizeof(short),
+        .mBytesPerPacket = CMDFX_MIXER_CHANNELS * sizeof(short)
     };
 
     status = AudioUnitSetProperty(
-        soundData->audioUnit, kAudioUnitProperty_SetRenderCallback,
-        kAudioUnitScope_Input, 0, &callback, sizeof(callback)
+        _audioUnit, kAudioUnitProperty_StreamFormat, kAudioUnitScope_Input, 0,
+        &format, sizeof(format)
+    );
+    if (status != noErr) {
+        fprintf(stderr, "Failed to set stream format: %d\n", (int) status);
+        _disposeAudioUnit();
+        return -1;
+    }
+
+    // the device pulls a period at a time; its buffer is sized from it. The
+    // device may not support the size, so the one it chose is read back
+    UInt32 period = CmdFX_mixer_getPeriodFrames();
+    AudioUnitSetProperty(
+        _audioUnit, kAudioDevicePropertyBufferFrameSize,
+        kAudioUnitScope_Global, 0, &period, sizeof(period)
     );
 
+    UInt32 size = sizeof(period);
+    AudioUnitGetProperty(
+        _audioUnit, kAudioDevicePropertyBufferFrameSize,
+        kAudioUnitScope_Global, 0, &period, &size
+    );
+    CmdFX_mixer_setDevice(
+        rate, (int) period, (int) period * CMDFX_MIXER_PERIODS
+    );
+
+    AURenderCallbackStruct callback = {
+        .inputProc = _audioRenderCallback, .inputProcRefCon = NULL
+    };
+
+    status = AudioUnitSetProperty(
+        _audioUnit, kAudioUnitProperty_SetRenderCallback, kAudioUnitScope_Input,
+        0, &callback, sizeof(callback)
+    );
     if (status != noErr) {
         fprintf(stderr, "Failed to set render callback: %d\n", (int) status);
-        AudioComponentInstanceDispose(soundData->audioUnit);
-        AudioFileClose(soundData->audioFile);
-        free(soundData);
+        _disposeAudioUnit();
         return -1;
     }
 
-    // Initialize and start audio unit
-    status = AudioUnitInitialize(soundData->audioUnit);
+    status = AudioUnitInitialize(_audioUnit);
     if (status != noErr) {
         fprintf(stderr, "Failed to initialize audio unit: %d\n", (int) status);
-        AudioComponentInstanceDispose(soundData->audioUnit);
-        AudioFileClose(soundData->audioFile);
-        free(soundData);
+        _disposeAudioUnit();
         return -1;
     }
 
-    status = AudioOutputUnitStart(soundData->audioUnit);
+    _expectedTime = -1;
+    status = AudioOutputUnitStart(_audioUnit);
     if (status != noErr) {
         fprintf(stderr, "Failed to start audio unit: %d\n", (int) status);
-        AudioUnitUninitialize(soundData->audioUnit);
-        AudioComponentInstanceDispose(soundData->audioUnit);
-        AudioFileClose(soundData->audioFile);
-        free(soundData);
+        AudioUnitUninitialize(_audioUnit);
+        _disposeAudioUnit();
         return -1;
     }
 
-    soundData->isPlaying = 1;
-    *platformData = soundData;
-
-    return 0;
-}
-
-int _Platform_pauseSound(void* platformData) {
-    if (!platformData) return -1;
-
-    _MacOSSoundData* soundData = (_MacOSSoundData*) platformData;
-    soundData->isPaused = 1;
-
-    return 0;
-}
-
-int _Platform_resumeSound(void* platformData) {
-    if (!platformData) return -1;
-
-    _MacOSSoundData* soundData = (_MacOSSoundData*) platformData;
-    soundData->isPaused = 0;
-
-    return 0;
-}
-
-int _Platform_stopSound(void* platformData) {
-    if (!platformData) return -1;
-
-    _MacOSSoundData* soundData = (_MacOSSoundData*) platformData;
-    soundData->isPlaying = 0;
-    soundData->isPaused = 0;
-
-    AudioOutputUnitStop(soundData->audioUnit);
-
-    return 0;
-}
-
-int _Platform_setSoundVolume(void* platformData, double volume) {
-    if (!platformData || volume < 0.0 || volume > 1.0) return -1;
-
-    _MacOSSoundData* soundData = (_MacOSSoundData*) platformData;
-    soundData->volume = volume;
-
+    _soundSystemInitialized = 1;
     return 0;
 }
 
-void _Platform_freeSoundData(void* platformData) {
-    if (!platformData) return;
-
-    _MacOSSoundData* soundData = (_MacOSSoundData*) platformData;
-
-    if (soundData->isPlaying) {
-        AudioOutputUnitStop(soundData->audioUnit);
-    }
+void _Platform_shutdownSoundSystem() {
+    if (!_soundSystemInitialized) return;
 
-    AudioUnitUninitialize(soundData->audioUnit);
-    AudioComponentInstanceDispose(soundData->audioUnit);
-    AudioFileClose(soundData->audioFile);
+    // stopping waits for the render callback to return
+    AudioOutputUnitStop(_audioUnit);
+    AudioUnitUninitialize(_audioUnit);
+    _disposeAudioUnit();
 
-    free(soundData);
+    _soundSystemInitialized = 0;
 }
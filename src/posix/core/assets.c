@@ -0,0 +1,36 @@
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "common/core/shared.h"
+
+// File Mapping
+
+void* CmdFX_mapFile(const char* path, unsigned long* size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return 0;
+    }
+
+    // MAP_PRIVATE makes stray writes copy the touched page instead of
+    // changing the file
+    void* data = mmap(
+        0, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0
+    );
+    close(fd);
+    if (data == MAP_FAILED) return 0;
+
+    *size = (unsigned long) st.st_size;
+    return data;
+}
+
+void CmdFX_unmapFile(void* data, unsigned long size) {
+    if (data == 0) return;
+    munmap(data, size);
+}
@@ -1,4 +1,5 @@
 #include "cmdfx/core/canvas.h"
+#include "cmdfx/core/scenes.h"
 
 #include "common/core/curses_backend.h"
 
@@ -38,4 +39,9 @@ int Canvas_isCursorVisible() {
 
 void Canvas_clearScreen() {
     CmdFX_curses_clear();
+
+    // everything on screen is gone, so every drawn scene needs repainting
+    int width, height;
+    CmdFX_curses_getSize(&width, &height);
+    Canvas_markScenesDirty(0, 0, width + 1, height + 1);
 }
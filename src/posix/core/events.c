@@ -8,6 +8,8 @@
 #include "cmdfx/ui/button.h"
 #include "cmdfx/ui/switch.h"
 #include "common/core/curses_backend.h"
+#include "common/core/stats.h"
+#include "common/core/trace.h"
 
 // Core Events
 
@@ -43,6 +45,10 @@ static void _dispatchResize(const CmdFX_CursesEvent* e) {
     _prevHeight = e->height;
 }
 
+// buttons overlapping a single cell rarely exceed this; larger stacks fall
+// back to a heap allocation
+#define _MOUSE_BUTTONS_BUFFER 32
+
 static int _prevMouseX = -1;
 static int _prevMouseY = -1;
 
@@ -53,8 +59,14 @@ static void _dispatchMouse(const CmdFX_CursesEvent* e) {
     CmdFX_Event event = {CMDFX_EVENT_MOUSE, time, &mouseEvent};
     dispatchCmdFXEvent(&event);
 
-    // button events
-    CmdFX_Button** allButtons = Canvas_getAllButtonsAt(e->mouseX, e->mouseY);
+    // button events; collected up front since callbacks may move buttons
+    CmdFX_Button* nearby[_MOUSE_BUTTONS_BUFFER + 1] = {0};
+    CmdFX_Button** allButtons = nearby;
+    if (Canvas_collectButtonsAt(
+            e->mouseX, e->mouseY, nearby, _MOUSE_BUTTONS_BUFFER
+        ) > _MOUSE_BUTTONS_BUFFER)
+        allButtons = Canvas_getAllButtonsAt(e->mouseX, e->mouseY);
+
     if (allButtons != 0) {
         int j = 0;
         while (allButtons[j] != 0) {
@@ -78,7 +90,7 @@ static void _dispatchMouse(const CmdFX_CursesEvent* e) {
             j++;
         }
     }
-    free(allButtons);
+    if (allButtons != nearby) free(allButtons);
 
     _prevMouseX = e->mouseX;
     _prevMouseY = e->mouseY;
@@ -91,9 +103,12 @@ int _eventsRunning = 0;
 void* _eventLoop(void* arg) {
     (void) arg;
     _eventsRunning = 1;
+    CmdFX_trace_nameThread("events");
 
     while (_eventsRunning) {
         // drain every event curses has queued, then yield
+        unsigned long long start = CmdFX_stats_begin();
+        int drained = 0;
         CmdFX_CursesEvent e;
         while (CmdFX_curses_poll(&e)) {
             switch (e.type) {
@@ -102,7 +117,9 @@ void* _eventLoop(void* arg) {
                 case CMDFX_CURSES_EVENT_RESIZE: _dispatchResize(&e); break;
                 default: break;
             }
+            drained++;
         }
+        if (drained > 0) CmdFX_stats_end(CMDFX_FRAME_STAGE_INPUT, start);
 
         sleepMillis(EVENT_TICK);
     }
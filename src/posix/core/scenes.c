@@ -5,12 +5,14 @@
 
 #include "cmdfx/core/scenes.h"
 #include "cmdfx/core/util.h"
+#include "common/core/trace.h"
 
 int _scenesRunning = 0;
 
 void* _sceneLoop(void* arg) {
     (void) arg;
     _scenesRunning = 1;
+    CmdFX_trace_nameThread("scenes");
 
     int sleep = (int) ((1000.0 / CmdFX_getTickSpeed()) * 1000);
 
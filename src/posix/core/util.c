@@ -5,6 +5,7 @@
 #include <time.h>
 
 #include "cmdfx/core/util.h"
+#include "common/core/trace.h"
 
 // Time
 
@@ -17,7 +18,18 @@ unsigned long currentTimeMillis() {
 
 unsigned long long currentTimeNanos() {
     struct timespec ts;
-    if (clock_gettime(CLOCK_REALTIME, &ts) == 0) return ts.tv_nsec;
+    if (clock_gettime(CLOCK_REALTIME, &ts) == 0)
+        return (unsigned long long) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+
+    return 0;
+}
+
+// a clock that only moves forward, for timing intervals; unlike
+// currentTimeNanos it does not jump when the system time is set
+unsigned long long _Platform_monotonicNanos() {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+        return (unsigned long long) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
 
     return 0;
 }
@@ -179,3 +191,21 @@ int CmdFX_detachThread(ThreadID thread) {
     pthread_detach(thread);
     return 0;
 }
+
+// Tracing
+
+static pthread_key_t _traceKey;
+static pthread_once_t _traceKeyOnce = PTHREAD_ONCE_INIT;
+static int _traceKeyReady = 0;
+
+static void _createTraceKey() {
+    _traceKeyReady =
+        pthread_key_create(&_traceKey, CmdFX_trace_releaseBuffer) == 0;
+}
+
+int _Platform_releaseAtThreadExit(void* buffer) {
+    pthread_once(&_traceKeyOnce, _createTraceKey);
+    if (!_traceKeyReady) return -1;
+
+    return pthread_setspecific(_traceKey, buffer) == 0 ? 0 : -1;
+}
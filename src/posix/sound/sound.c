@@ -1,447 +1,315 @@
-#include <pthread.h>
-#include <stdint.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <unistd.h>
-
-// Enable ALSA only if headers are available (Linux)
-#if defined(__linux__)
-    #if defined(__has_include)
-        #if __has_include(<alsa/asoundlib.h>)
-            #define CMDFX_HAVE_ALSA 1
-            #include <alsa/asoundlib.h>
+// macOS builds its own backend from src/macos
+#ifndef __APPLE__
+
+    #define _POSIX_C_SOURCE 200809L
+
+    #include <errno.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <stdio.h>
+    #include <stdlib.h>
+    #include <string.h>
+    #include <time.h>
+
+    // Enable ALSA only if headers are available (Linux)
+    #if defined(__linux__)
+        #if defined(__has_include)
+            #if __has_include(<alsa/asoundlib.h>)
+                #define CMDFX_HAVE_ALSA 1
+                #include <alsa/asoundlib.h>
+            #endif
         #endif
     #endif
-#endif
-
-#include "cmdfx/sound/sound.h"
 
-// POSIX-specific sound data structure
-typedef struct _PosixSoundData {
-#ifdef CMDFX_HAVE_ALSA
-    snd_pcm_t* pcm_handle;
-    snd_pcm_hw_params_t* hw_params;
-#endif
-    FILE* audioFile;
-    char* audioBuffer;
-    size_t bufferSize;
-    size_t currentPosition;
-    int loopCount;
-    int currentLoop;
-    double volume;
-    int isPlaying;
-    int isPaused;
-    pthread_t playbackThread;
-    pthread_mutex_t mutex;
-    pthread_cond_t cond;
-    int shouldStop;
-} _PosixSoundData;
+    #include "cmdfx/sound/sound.h"
+    #include "common/core/trace.h"
+    #include "common/sound/mixer.h"
 
 static int _soundSystemInitialized = 0;
-static pthread_mutex_t _systemMutex = PTHREAD_MUTEX_INITIALIZER;
+static int _audioRunning = 0;
+static pthread_t _audioThread;
+static pthread_mutex_t _soundMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// the output as opened, sized from the mixer's target latency
+static short* _period = NULL;
+static int _periodFrames = 0;
+static int _bufferFrames = 0;
+
+    #ifdef CMDFX_HAVE_ALSA
+static snd_pcm_t* _pcmHandle = NULL;
+    #else
+static int _rate = 0;
+
+static long long _nanosBetween(
+    const struct timespec* from, const struct timespec* to
+) {
+    return (to->tv_sec - from->tv_sec) * 1000000000LL + to->tv_nsec -
+           from->tv_nsec;
+}
+    #endif
 
-int _Platform_initSoundSystem() {
-    pthread_mutex_lock(&_systemMutex);
+void _Platform_lockSound() {
+    pthread_mutex_lock(&_soundMutex);
+}
 
-    if (_soundSystemInitialized) {
-        pthread_mutex_unlock(&_systemMutex);
-        return 0;
-    }
+void _Platform_unlockSound() {
+    pthread_mutex_unlock(&_soundMutex);
+}
 
-#ifdef CMDFX_HAVE_ALSA
-    snd_pcm_t* test_handle;
-    int err = snd_pcm_open(
-        &test_handle, "default", SND_PCM_STREAM_PLAYBACK, SND_PCM_NONBLOCK
-    );
-    if (err < 0) {
-        fprintf(stderr, "Failed to initialize ALSA: %s\n", snd_strerror(err));
-        pthread_mutex_unlock(&_systemMutex);
+// Stream Thread
+
+static pthread_t _streamThread;
+static void (*_streamFunc)() = NULL;
+
+static void* _streamThreadMain(void* arg) {
+    (void) arg;
+
+    _streamFunc();
+    return NULL;
+}
+
+int _Platform_startStreamThread(void (*func)()) {
+    _streamFunc = func;
+    if (pthread_create(&_streamThread, NULL, _streamThreadMain, NULL) != 0)
         return -1;
-    }
-    snd_pcm_close(test_handle);
-#endif
 
-    _soundSystemInitialized = 1;
-    pthread_mutex_unlock(&_systemMutex);
     return 0;
 }
 
-void _Platform_shutdownSoundSystem() {
-    pthread_mutex_lock(&_systemMutex);
-    _soundSystemInitialized = 0;
-    pthread_mutex_unlock(&_systemMutex);
+void _Platform_joinStreamThread() {
+    pthread_join(_streamThread, NULL);
 }
 
-// Simple WAV header parser
-typedef struct {
-    char chunk_id[4];
-    uint32_t chunk_size;
-    char format[4];
-    char subchunk1_id[4];
-    uint32_t subchunk1_size;
-    uint16_t audio_format;
-    uint16_t num_channels;
-    uint32_t sample_rate;
-    uint32_t byte_rate;
-    uint16_t block_align;
-    uint16_t bits_per_sample;
-    char subchunk2_id[4];
-    uint32_t subchunk2_size;
-} WaveHeader;
-
-// Playback thread function
-void* _playbackThread(void* arg) {
-    _PosixSoundData* soundData = (_PosixSoundData*) arg;
-
-    pthread_mutex_lock(&soundData->mutex);
-
-    while (soundData->isPlaying && !soundData->shouldStop) {
-        if (soundData->isPaused) {
-            pthread_cond_wait(&soundData->cond, &soundData->mutex);
-            continue;
-        }
+// Sink Thread
 
-#ifdef CMDFX_HAVE_ALSA
-        if (soundData->pcm_handle) {
-            snd_pcm_sframes_t frames_to_write = 1024; // Chunk size
-            size_t bytes_to_write =
-                frames_to_write * 4; // Assuming 16-bit stereo
-
-            if (soundData->currentPosition + bytes_to_write >
-                soundData->bufferSize) {
-                bytes_to_write =
-                    soundData->bufferSize - soundData->currentPosition;
-                frames_to_write = bytes_to_write / 4;
-            }
+static pthread_t _sinkThread;
+static void (*_sinkFunc)() = NULL;
 
-            if (bytes_to_write > 0) {
-                // Apply volume
-                short* samples = (short*) (soundData->audioBuffer +
-                                           soundData->currentPosition);
-                size_t sample_count = bytes_to_write / sizeof(short);
+static void* _sinkThreadMain(void* arg) {
+    (void) arg;
 
-                if (soundData->volume != 1.0) {
-                    for (size_t i = 0; i < sample_count; i++) {
-                        samples[i] = (short) (samples[i] * soundData->volume);
-                    }
-                }
+    _sinkFunc();
+    return NULL;
+}
 
-                snd_pcm_sframes_t frames_written = snd_pcm_writei(
-                    soundData->pcm_handle, samples, frames_to_write
-                );
+int _Platform_startSinkThread(void (*func)()) {
+    _sinkFunc = func;
+    if (pthread_create(&_sinkThread, NULL, _sinkThreadMain, NULL) != 0)
+        return -1;
 
-                if (frames_written > 0) {
-                    soundData->currentPosition += frames_written * 4;
-                }
-                else if (frames_written == -EPIPE) {
-                    // Buffer underrun
-                    snd_pcm_prepare(soundData->pcm_handle);
-                }
-            }
+    return 0;
+}
 
-            // Check if we've reached the end
-            if (soundData->currentPosition >= soundData->bufferSize) {
-                if (soundData->loopCount == -1 ||
-                    soundData->currentLoop < soundData->loopCount - 1) {
-                    soundData->currentPosition =
-                        sizeof(WaveHeader); // Skip header
-                    soundData->currentLoop++;
-                }
-                else {
-                    soundData->isPlaying = 0;
-                    break;
-                }
-            }
+void _Platform_joinSinkThread() {
+    pthread_join(_sinkThread, NULL);
+}
+
+// Audio Thread
+
+// the one thread that feeds the output stream
+static void* _audioThreadMain(void* arg) {
+    (void) arg;
+    CmdFX_trace_nameThread("sound");
+
+    // best effort; only privileged processes may use a real-time policy
+    struct sched_param param = {0};
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+
+    #ifndef CMDFX_HAVE_ALSA
+    // without a device, keep the mixer running at its real rate; periods
+    // are paced by absolute deadlines, so wakeups don't drift
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    long periodNanos = (long) (_periodFrames * 1000000000LL / _rate);
+    #endif
+
+    while (1) {
+    #ifdef CMDFX_HAVE_ALSA
+        // less than a period queued means this write is a near miss
+        int late = 0;
+        if (snd_pcm_state(_pcmHandle) == SND_PCM_STATE_RUNNING) {
+            snd_pcm_sframes_t avail = snd_pcm_avail_update(_pcmHandle);
+            late = avail > _bufferFrames - _periodFrames;
         }
-#else
-        usleep(23000); // ~23ms for roughly 44.1kHz timing
+    #else
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        int late = _nanosBetween(&deadline, &now) > periodNanos;
+        if (late) deadline = now;
+    #endif
 
-        size_t chunk_size = 1024 * 4; // Simulate processing chunks
-        soundData->currentPosition += chunk_size;
+        pthread_mutex_lock(&_soundMutex);
+        if (!_audioRunning) {
+            pthread_mutex_unlock(&_soundMutex);
+            break;
+        }
 
-        if (soundData->currentPosition >= soundData->bufferSize) {
-            if (soundData->loopCount == -1 ||
-                soundData->currentLoop < soundData->loopCount - 1) {
-                soundData->currentPosition = sizeof(WaveHeader);
-                soundData->currentLoop++;
-            }
-            else {
-                soundData->isPlaying = 0;
-                break;
+        if (late) CmdFX_mixer_countLateWrite();
+        CmdFX_mixer_render(_period, _periodFrames);
+        pthread_mutex_unlock(&_soundMutex);
+
+    #ifdef CMDFX_HAVE_ALSA
+        // blocks until the device has room, which paces the thread
+        short* data = _period;
+        snd_pcm_sframes_t left = _periodFrames;
+        while (left > 0) {
+            snd_pcm_sframes_t written = snd_pcm_writei(_pcmHandle, data, left);
+            if (written < 0) {
+                if (written == -EPIPE) {
+                    pthread_mutex_lock(&_soundMutex);
+                    CmdFX_mixer_countUnderrun();
+                    pthread_mutex_unlock(&_soundMutex);
+                }
+
+                written = snd_pcm_recover(_pcmHandle, (int) written, 1);
+                if (written < 0) break;
+                continue;
             }
+
+            data += written * CMDFX_MIXER_CHANNELS;
+            left -= written;
+        }
+    #else
+        deadline.tv_nsec += periodNanos;
+        while (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_nsec -= 1000000000L;
+            deadline.tv_sec++;
         }
-#endif
 
-        pthread_mutex_unlock(&soundData->mutex);
-        usleep(1000); // Small delay to prevent busy waiting
-        pthread_mutex_lock(&soundData->mutex);
+        int slept;
+        do {
+            slept = clock_nanosleep(
+                CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL
+            );
+        } while (slept == EINTR);
+    #endif
     }
 
-    pthread_mutex_unlock(&soundData->mutex);
     return NULL;
 }
 
-int _Platform_playSound(
-    const char* soundFile, int loopCount, void** platformData
-) {
-    if (!soundFile || !platformData) return -1;
-
-    _PosixSoundData* soundData = malloc(sizeof(_PosixSoundData));
-    if (!soundData) return -1;
-
-    memset(soundData, 0, sizeof(_PosixSoundData));
-    soundData->loopCount = loopCount;
-    soundData->currentLoop = 0;
-    soundData->volume = 1.0;
-    soundData->isPlaying = 0;
-    soundData->isPaused = 0;
-    soundData->shouldStop = 0;
-
-    pthread_mutex_init(&soundData->mutex, NULL);
-    pthread_cond_init(&soundData->cond, NULL);
-
-    // Open and read audio file
-    soundData->audioFile = fopen(soundFile, "rb");
-    if (!soundData->audioFile) {
-        fprintf(stderr, "Failed to open audio file '%s'\n", soundFile);
-        pthread_mutex_destroy(&soundData->mutex);
-        pthread_cond_destroy(&soundData->cond);
-        free(soundData);
-        return -1;
-    }
-
-    // Get file size
-    fseek(soundData->audioFile, 0, SEEK_END);
-    soundData->bufferSize = ftell(soundData->audioFile);
-    fseek(soundData->audioFile, 0, SEEK_SET);
-
-    // Read entire file into memory
-    soundData->audioBuffer = malloc(soundData->bufferSize);
-    if (!soundData->audioBuffer) {
-        fprintf(stderr, "Failed to allocate audio buffer\n");
-        fclose(soundData->audioFile);
-        pthread_mutex_destroy(&soundData->mutex);
-        pthread_cond_destroy(&soundData->cond);
-        free(soundData);
-        return -1;
-    }
+    #ifdef CMDFX_HAVE_ALSA
+// asks the device for the target latency; it may round the sizes
+static int _configureDevice() {
+    snd_pcm_hw_params_t* hw;
+    snd_pcm_hw_params_alloca(&hw);
+    snd_pcm_hw_params_any(_pcmHandle, hw);
 
-    if (fread(
-            soundData->audioBuffer, 1, soundData->bufferSize,
-            soundData->audioFile
-        ) != soundData->bufferSize) {
-        fprintf(stderr, "Failed to read audio file\n");
-        free(soundData->audioBuffer);
-        fclose(soundData->audioFile);
-        pthread_mutex_destroy(&soundData->mutex);
-        pthread_cond_destroy(&soundData->cond);
-        free(soundData);
-        return -1;
-    }
+    int err = snd_pcm_hw_params_set_access(
+        _pcmHandle, hw, SND_PCM_ACCESS_RW_INTERLEAVED
+    );
+    if (err == 0)
+        err = snd_pcm_hw_params_set_format(_pcmHandle, hw, SND_PCM_FORMAT_S16);
+    if (err == 0)
+        err = snd_pcm_hw_params_set_channels(
+            _pcmHandle, hw, CMDFX_MIXER_CHANNELS
+        );
 
-    fclose(soundData->audioFile);
-    soundData->audioFile = NULL;
+    unsigned int rate = CMDFX_MIXER_RATE;
+    if (err == 0)
+        err = snd_pcm_hw_params_set_rate_near(_pcmHandle, hw, &rate, NULL);
+    if (err < 0) return err;
+
+    // the period is sized for the rate the device actually runs at
+    CmdFX_mixer_setRate((int) rate);
+    snd_pcm_uframes_t period = CmdFX_mixer_getPeriodFrames();
+    snd_pcm_uframes_t buffer = period * CMDFX_MIXER_PERIODS;
+
+    err = snd_pcm_hw_params_set_period_size_near(_pcmHandle, hw, &period, NULL);
+    if (err == 0)
+        err = snd_pcm_hw_params_set_buffer_size_near(_pcmHandle, hw, &buffer);
+    if (err == 0) err = snd_pcm_hw_params(_pcmHandle, hw);
+    if (err < 0) return err;
+
+    snd_pcm_hw_params_get_period_size(hw, &period, NULL);
+    snd_pcm_hw_params_get_buffer_size(hw, &buffer);
+
+    // start as soon as one period is queued, and wake once one fits
+    snd_pcm_sw_params_t* sw;
+    snd_pcm_sw_params_alloca(&sw);
+    snd_pcm_sw_params_current(_pcmHandle, sw);
+    snd_pcm_sw_params_set_start_threshold(_pcmHandle, sw, period);
+    snd_pcm_sw_params_set_avail_min(_pcmHandle, sw, period);
+
+    err = snd_pcm_sw_params(_pcmHandle, sw);
+    if (err < 0) return err;
+
+    _periodFrames = (int) period;
+    _bufferFrames = (int) buffer;
+    CmdFX_mixer_setDevice((int) rate, _periodFrames, _bufferFrames);
+    return 0;
+}
+    #endif
 
-    // Parse WAV header to skip it
-    if (soundData->bufferSize >= sizeof(WaveHeader)) {
-        WaveHeader* header = (WaveHeader*) soundData->audioBuffer;
-        if (strncmp(header->chunk_id, "RIFF", 4) == 0 &&
-            strncmp(header->format, "WAVE", 4) == 0) {
-            soundData->currentPosition = sizeof(WaveHeader);
-        }
-    }
+static void _closeDevice() {
+    #ifdef CMDFX_HAVE_ALSA
+    snd_pcm_close(_pcmHandle);
+    _pcmHandle = NULL;
+    #endif
 
-#ifdef CMDFX_HAVE_ALSA
-    // Initialize ALSA
-    int err = snd_pcm_open(
-        &soundData->pcm_handle, "default", SND_PCM_STREAM_PLAYBACK, 0
-    );
-    if (err < 0) {
-        fprintf(stderr, "Failed to open ALSA device: %s\n", snd_strerror(err));
-        free(soundData->audioBuffer);
-        pthread_mutex_destroy(&soundData->mutex);
-        pthread_cond_destroy(&soundData->cond);
-        free(soundData);
-        return -1;
-    }
+    free(_period);
+    _period = NULL;
+}
 
-    // Allocate hardware parameters
-    err = snd_pcm_hw_params_malloc(&soundData->hw_params);
-    if (err < 0) {
-        fprintf(
-            stderr, "Failed to allocate hw params: %s\n", snd_strerror(err)
-        );
-        snd_pcm_close(soundData->pcm_handle);
-        free(soundData->audioBuffer);
-        pthread_mutex_destroy(&soundData->mutex);
-        pthread_cond_destroy(&soundData->cond);
-        free(soundData);
-        return -1;
-    }
+int _Platform_initSoundSystem() {
+    if (_soundSystemInitialized) return 0;
 
-    // Initialize hardware parameters
-    err = snd_pcm_hw_params_any(soundData->pcm_handle, soundData->hw_params);
+    #ifdef CMDFX_HAVE_ALSA
+    int err = snd_pcm_open(&_pcmHandle, "default", SND_PCM_STREAM_PLAYBACK, 0);
     if (err < 0) {
-        fprintf(
-            stderr, "Failed to initialize hw params: %s\n", snd_strerror(err)
-        );
-        snd_pcm_hw_params_free(soundData->hw_params);
-        snd_pcm_close(soundData->pcm_handle);
-        free(soundData->audioBuffer);
-        pthread_mutex_destroy(&soundData->mutex);
-        pthread_cond_destroy(&soundData->cond);
-        free(soundData);
+        fprintf(stderr, "Failed to initialize ALSA: %s\n", snd_strerror(err));
+        _pcmHandle = NULL;
         return -1;
     }
 
-    // Set hardware parameters (assuming 16-bit stereo 44.1kHz)
-    snd_pcm_hw_params_set_access(
-        soundData->pcm_handle, soundData->hw_params,
-        SND_PCM_ACCESS_RW_INTERLEAVED
-    );
-    snd_pcm_hw_params_set_format(
-        soundData->pcm_handle, soundData->hw_params, SND_PCM_FORMAT_S16_LE
-    );
-    snd_pcm_hw_params_set_channels(
-        soundData->pcm_handle, soundData->hw_params, 2
-    );
-    unsigned int rate = 44100;
-    snd_pcm_hw_params_set_rate_near(
-        soundData->pcm_handle, soundData->hw_params, &rate, 0
-    );
-
-    // Apply hardware parameters
-    err = snd_pcm_hw_params(soundData->pcm_handle, soundData->hw_params);
+    err = _configureDevice();
     if (err < 0) {
         fprintf(stderr, "Failed to set hw params: %s\n", snd_strerror(err));
-        snd_pcm_hw_params_free(soundData->hw_params);
-        snd_pcm_close(soundData->pcm_handle);
-        free(soundData->audioBuffer);
-        pthread_mutex_destroy(&soundData->mutex);
-        pthread_cond_destroy(&soundData->cond);
-        free(soundData);
+        _closeDevice();
         return -1;
     }
+    #else
+    _rate = CmdFX_mixer_getRate();
+    _periodFrames = CmdFX_mixer_getPeriodFrames();
+    _bufferFrames = _periodFrames * CMDFX_MIXER_PERIODS;
+    CmdFX_mixer_setDevice(_rate, _periodFrames, _bufferFrames);
+    #endif
 
-    snd_pcm_hw_params_free(soundData->hw_params);
-    soundData->hw_params = NULL;
-
-    // Prepare PCM device
-    err = snd_pcm_prepare(soundData->pcm_handle);
-    if (err < 0) {
-        fprintf(
-            stderr, "Failed to prepare PCM device: %s\n", snd_strerror(err)
-        );
-        snd_pcm_close(soundData->pcm_handle);
-        free(soundData->audioBuffer);
-        pthread_mutex_destroy(&soundData->mutex);
-        pthread_cond_destroy(&soundData->cond);
-        free(soundData);
+    _period = malloc(sizeof(short) * _periodFrames * CMDFX_MIXER_CHANNELS);
+    if (!_period) {
+        fprintf(stderr, "Failed to allocate audio period\n");
+        _closeDevice();
         return -1;
     }
-#endif
-
-    // Start playback thread
-    soundData->isPlaying = 1;
-    if (pthread_create(
-            &soundData->playbackThread, NULL, _playbackThread, soundData
-        ) != 0) {
-        fprintf(stderr, "Failed to create playback thread\n");
 
-#ifdef CMDFX_HAVE_ALSA
-        snd_pcm_close(soundData->pcm_handle);
-#endif
-
-        free(soundData->audioBuffer);
-        pthread_mutex_destroy(&soundData->mutex);
-        pthread_cond_destroy(&soundData->cond);
-        free(soundData);
+    _audioRunning = 1;
+    if (pthread_create(&_audioThread, NULL, _audioThreadMain, NULL) != 0) {
+        fprintf(stderr, "Failed to create audio thread\n");
+        _audioRunning = 0;
+        _closeDevice();
         return -1;
     }
 
-    *platformData = soundData;
-    return 0;
-}
-
-int _Platform_pauseSound(void* platformData) {
-    if (!platformData) return -1;
-
-    _PosixSoundData* soundData = (_PosixSoundData*) platformData;
-
-    pthread_mutex_lock(&soundData->mutex);
-    soundData->isPaused = 1;
-    pthread_mutex_unlock(&soundData->mutex);
-
-    return 0;
-}
-
-int _Platform_resumeSound(void* platformData) {
-    if (!platformData) return -1;
-
-    _PosixSoundData* soundData = (_PosixSoundData*) platformData;
-
-    pthread_mutex_lock(&soundData->mutex);
-    soundData->isPaused = 0;
-    pthread_cond_signal(&soundData->cond);
-    pthread_mutex_unlock(&soundData->mutex);
-
+    _soundSystemInitialized = 1;
     return 0;
 }
 
-int _Platform_stopSound(void* platformData) {
-    if (!platformData) return -1;
-
-    _PosixSoundData* soundData = (_PosixSoundData*) platformData;
-
-    pthread_mutex_lock(&soundData->mutex);
-    soundData->isPlaying = 0;
-    soundData->shouldStop = 1;
-    pthread_cond_signal(&soundData->cond);
-    pthread_mutex_unlock(&soundData->mutex);
-
-    // Wait for thread to finish
-    pthread_join(soundData->playbackThread, NULL);
-
-    return 0;
-}
+void _Platform_shutdownSoundSystem() {
+    if (!_soundSystemInitialized) return;
 
-int _Platform_setSoundVolume(void* platformData, double volume) {
-    if (!platformData || volume < 0.0 || volume > 1.0) return -1;
+    pthread_mutex_lock(&_soundMutex);
+    _audioRunning = 0;
+    pthread_mutex_unlock(&_soundMutex);
 
-    _PosixSoundData* soundData = (_PosixSoundData*) platformData;
+    pthread_join(_audioThread, NULL);
 
-    pthread_mutex_lock(&soundData->mutex);
-    soundData->volume = volume;
-    pthread_mutex_unlock(&soundData->mutex);
+    #ifdef CMDFX_HAVE_ALSA
+    snd_pcm_drain(_pcmHandle);
+    #endif
+    _closeDevice();
 
-    return 0;
+    _soundSystemInitialized = 0;
 }
 
-void _Platform_freeSoundData(void* platformData) {
-    if (!platformData) return;
-
-    _PosixSoundData* soundData = (_PosixSoundData*) platformData;
-
-    // Stop playback if still running
-    if (soundData->isPlaying) {
-        _Platform_stopSound(platformData);
-    }
-
-#ifdef CMDFX_HAVE_ALSA
-    if (soundData->pcm_handle) {
-        snd_pcm_close(soundData->pcm_handle);
-    }
 #endif
-
-    free(soundData->audioBuffer);
-
-    if (soundData->audioFile) {
-        fclose(soundData->audioFile);
-    }
-
-    pthread_mutex_destroy(&soundData->mutex);
-    pthread_cond_destroy(&soundData->cond);
-
-    free(soundData);
-}
@@ -0,0 +1,38 @@
+#include <windows.h>
+
+#include "common/core/shared.h"
+
+// File Mapping
+
+void* CmdFX_mapFile(const char* path, unsigned long* size) {
+    HANDLE file = CreateFileA(
+        path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, 0
+    );
+    if (file == INVALID_HANDLE_VALUE) return 0;
+
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length) || length.QuadPart <= 0) {
+        CloseHandle(file);
+        return 0;
+    }
+
+    // PAGE_WRITECOPY and FILE_MAP_COPY make stray writes copy the touched
+    // page instead of changing the file
+    HANDLE mapping = CreateFileMappingA(file, 0, PAGE_WRITECOPY, 0, 0, 0);
+    CloseHandle(file);
+    if (mapping == 0) return 0;
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == 0) return 0;
+
+    *size = (unsigned long) length.QuadPart;
+    return data;
+}
+
+void CmdFX_unmapFile(void* data, unsigned long size) {
+    (void) size;
+    if (data == 0) return;
+    UnmapViewOfFile(data);
+}
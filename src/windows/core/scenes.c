@@ -6,11 +6,13 @@
 
 #include "cmdfx/core/scenes.h"
 #include "cmdfx/core/util.h"
+#include "common/core/trace.h"
 
 int _scenesRunning = 0;
 
 unsigned __stdcall _sceneLoop(void* arg) {
     _scenesRunning = 1;
+    CmdFX_trace_nameThread("scenes");
 
     int sleep = (int) ((1000.0 / CmdFX_getTickSpeed()));
 
@@ -6,6 +6,7 @@
 #include <windows.h>
 
 #include "cmdfx/core/util.h"
+#include "common/core/trace.h"
 
 // Time
 
@@ -24,6 +25,20 @@ unsigned long long currentTimeNanos() {
     return time.QuadPart * 100;
 }
 
+// a clock that only moves forward, for timing intervals; unlike
+// currentTimeNanos it does not jump when the system time is set
+unsigned long long _Platform_monotonicNanos() {
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (!QueryPerformanceFrequency(&frequency)) return 0;
+    if (!QueryPerformanceCounter(&counter)) return 0;
+
+    unsigned long long ticks = (unsigned long long) counter.QuadPart;
+    unsigned long long rate = (unsigned long long) frequency.QuadPart;
+    return ticks / rate * 1000000000ULL +
+           ticks % rate * 1000000000ULL / rate;
+}
+
 // Sleep
 
 void sleepMillis(unsigned long millis) {
@@ -204,3 +219,29 @@ int CmdFX_detachThread(ThreadID thread) {
 
     return 0;
 }
+
+// Tracing
+
+static INIT_ONCE _traceKeyOnce = INIT_ONCE_STATIC_INIT;
+static DWORD _traceKey = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI _releaseTraceBuffer(PVOID buffer) {
+    if (buffer != 0) CmdFX_trace_releaseBuffer(buffer);
+}
+
+static BOOL CALLBACK
+    _createTraceKey(PINIT_ONCE once, PVOID param, PVOID* context) {
+    (void) once;
+    (void) param;
+    (void) context;
+
+    _traceKey = FlsAlloc(_releaseTraceBuffer);
+    return _traceKey != FLS_OUT_OF_INDEXES;
+}
+
+int _Platform_releaseAtThreadExit(void* buffer) {
+    if (!InitOnceExecuteOnce(&_traceKeyOnce, _createTraceKey, 0, 0))
+        return -1;
+
+    return FlsSetValue(_traceKey, buffer) ? 0 : -1;
+}
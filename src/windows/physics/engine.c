@@ -9,6 +9,8 @@
 #include "cmdfx/core/util.h"
 #include "cmdfx/physics/engine.h"
 #include "cmdfx/physics/motion.h"
+#include "common/core/stats.h"
+#include "common/core/trace.h"
 
 static atomic_int _physicsRunning = 0;
 static HANDLE _physicsThread = NULL;
@@ -17,17 +19,22 @@ unsigned __stdcall _physicsLoop(void* arg) {
     (void) arg;
 
     int sleep = (int) ((1000.0 / CmdFX_getTickSpeed()) * 1000000);
+    CmdFX_trace_nameThread("physics");
 
     while (atomic_load(&_physicsRunning)) {
+        unsigned long long span = CmdFX_trace_begin();
         CmdFX_Sprite** modified = Engine_tick();
 
         if (modified != 0) {
             // apply motion synchronously for a deterministic integration order
+            unsigned long long start = CmdFX_stats_begin();
             for (int i = 0; modified[i] != 0; i++)
                 Engine_applyMotion(modified[i]);
+            CmdFX_stats_end(CMDFX_FRAME_STAGE_APPLY_MOTION, start);
 
             free(modified);
         }
+        CmdFX_trace_end("physics_tick", "physics", span);
 
         fflush(stdout);
         sleepNanos(sleep);
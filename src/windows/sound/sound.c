@@ -3,351 +3,247 @@
 #include <windows.h>
 #include <mmsystem.h>
 // clang-format on
+#include <process.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "cmdfx/sound/sound.h"
+#include "common/core/trace.h"
+#include "common/sound/mixer.h"
 
 #pragma comment(lib, "winmm.lib")
 
-// Windows-specific sound data structure
-typedef struct _WindowsSoundData {
-    HWAVEOUT hWaveOut;
-    WAVEFORMATEX waveFormat;
-    WAVEHDR waveHeader;
-    HANDLE hFile;
-    HANDLE hMapFile;
-    LPVOID lpMapAddress;
-    DWORD fileSize;
-    DWORD currentPosition;
-    int loopCount;
-    int currentLoop;
-    double volume;
-    int isPlaying;
-    int isPaused;
-    CRITICAL_SECTION criticalSection;
-} _WindowsSoundData;
+// buffers queued on the device, so one plays while the next is mixed; they
+// split the mixer's target latency between them
+#define _PERIOD_COUNT 3
 
 static int _soundSystemInitialized = 0;
-
-int _Platform_initSoundSystem() {
-    if (_soundSystemInitialized) return 0;
-
-    // Windows multimedia system is always available
-    _soundSystemInitialized = 1;
-    return 0;
+static volatile LONG _audioRunning = 0;
+static HANDLE _audioThread = NULL;
+static HANDLE _audioEvent = NULL;
+static HWAVEOUT _waveOut = NULL;
+static WAVEHDR _headers[_PERIOD_COUNT];
+static short* _periods = NULL; // _PERIOD_COUNT periods of interleaved stereo
+static int _periodFrames = 0;
+static CRITICAL_SECTION _soundLock;
+static INIT_ONCE _soundLockOnce = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK _initSoundLock(PINIT_ONCE once, PVOID param, PVOID* ctx) {
+    (void) once;
+    (void) param;
+    (void) ctx;
+
+    InitializeCriticalSection(&_soundLock);
+    return TRUE;
 }
 
-void _Platform_shutdownSoundSystem() {
-    if (!_soundSystemInitialized) return;
-
-    // Cleanup is handled per-instance
-    _soundSystemInitialized = 0;
+void _Platform_lockSound() {
+    InitOnceExecuteOnce(&_soundLockOnce, _initSoundLock, NULL, NULL);
+    EnterCriticalSection(&_soundLock);
 }
 
-// Wave output callback
-void CALLBACK _waveOutCallback(
-    HWAVEOUT hwo, UINT uMsg, DWORD_PTR dwInstance, DWORD_PTR dwParam1,
-    DWORD_PTR dwParam2
-) {
-    _WindowsSoundData* soundData = (_WindowsSoundData*) dwInstance;
-
-    if (uMsg == WOM_DONE && soundData) {
-        EnterCriticalSection(&soundData->criticalSection);
-
-        if (soundData->isPlaying && !soundData->isPaused) {
-            // Check if we should loop
-            if (soundData->loopCount == -1 ||
-                soundData->currentLoop < soundData->loopCount - 1) {
-                soundData->currentLoop++;
-                soundData->currentPosition = 0;
-
-                // Reset and play again
-                waveOutUnprepareHeader(
-                    soundData->hWaveOut, &soundData->waveHeader, sizeof(WAVEHDR)
-                );
-                soundData->waveHeader.lpData = (LPSTR) soundData->lpMapAddress;
-                soundData->waveHeader.dwBufferLength = soundData->fileSize;
-                soundData->waveHeader.dwFlags = 0;
-
-                waveOutPrepareHeader(
-                    soundData->hWaveOut, &soundData->waveHeader, sizeof(WAVEHDR)
-                );
-                waveOutWrite(
-                    soundData->hWaveOut, &soundData->waveHeader, sizeof(WAVEHDR)
-                );
-            }
-            else {
-                soundData->isPlaying = 0;
-            }
-        }
-
-        LeaveCriticalSection(&soundData->criticalSection);
-    }
+void _Platform_unlockSound() {
+    LeaveCriticalSection(&_soundLock);
 }
 
-int _Platform_playSound(
-    const char* soundFile, int loopCount, void** platformData
-) {
-    if (!soundFile || !platformData) return -1;
-
-    _WindowsSoundData* soundData = malloc(sizeof(_WindowsSoundData));
-    if (!soundData) return -1;
-
-    memset(soundData, 0, sizeof(_WindowsSoundData));
-    soundData->loopCount = loopCount;
-    soundData->currentLoop = 0;
-    soundData->volume = 1.0;
-    soundData->isPlaying = 0;
-    soundData->isPaused = 0;
-    soundData->currentPosition = 0;
-
-    InitializeCriticalSection(&soundData->criticalSection);
-
-    // Convert filename to wide character
-    int wideCharCount = MultiByteToWideChar(CP_UTF8, 0, soundFile, -1, NULL, 0);
-    LPWSTR wideFileName = malloc(wideCharCount * sizeof(WCHAR));
-    if (!wideFileName) {
-        DeleteCriticalSection(&soundData->criticalSection);
-        free(soundData);
-        return -1;
-    }
-    MultiByteToWideChar(CP_UTF8, 0, soundFile, -1, wideFileName, wideCharCount);
-
-    // Open file
-    soundData->hFile = CreateFileW(
-        wideFileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
-        FILE_ATTRIBUTE_NORMAL, NULL
-    );
-
-    free(wideFileName);
+// Stream Thread
 
-    if (soundData->hFile == INVALID_HANDLE_VALUE) {
-        fprintf(
-            stderr, "Failed to open audio file '%s': %lu\n", soundFile,
-            GetLastError()
-        );
-        DeleteCriticalSection(&soundData->criticalSection);
-        free(soundData);
-        return -1;
-    }
-
-    // Get file size
-    soundData->fileSize = GetFileSize(soundData->hFile, NULL);
-    if (soundData->fileSize == INVALID_FILE_SIZE) {
-        fprintf(stderr, "Failed to get file size: %lu\n", GetLastError());
-        CloseHandle(soundData->hFile);
-        DeleteCriticalSection(&soundData->criticalSection);
-        free(soundData);
-        return -1;
-    }
+static HANDLE _streamThread = NULL;
+static void (*_streamFunc)() = NULL;
 
-    // Create file mapping
-    soundData->hMapFile =
-        CreateFileMapping(soundData->hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+unsigned __stdcall _streamLoop(void* arg) {
+    (void) arg;
 
-    if (!soundData->hMapFile) {
-        fprintf(stderr, "Failed to create file mapping: %lu\n", GetLastError());
-        CloseHandle(soundData->hFile);
-        DeleteCriticalSection(&soundData->criticalSection);
-        free(soundData);
-        return -1;
-    }
+    _streamFunc();
+    return 0;
+}
 
-    // Map file to memory
-    soundData->lpMapAddress =
-        MapViewOfFile(soundData->hMapFile, FILE_MAP_READ, 0, 0, 0);
+int _Platform_startStreamThread(void (*func)()) {
+    _streamFunc = func;
 
-    if (!soundData->lpMapAddress) {
-        fprintf(stderr, "Failed to map file to memory: %lu\n", GetLastError());
-        CloseHandle(soundData->hMapFile);
-        CloseHandle(soundData->hFile);
-        DeleteCriticalSection(&soundData->criticalSection);
-        free(soundData);
-        return -1;
-    }
+    uintptr_t thread = _beginthreadex(NULL, 0, _streamLoop, NULL, 0, NULL);
+    if (thread == 0) return -1;
 
-    // Set up wave format (assuming 16-bit stereo 44.1kHz WAV)
-    soundData->waveFormat.wFormatTag = WAVE_FORMAT_PCM;
-    soundData->waveFormat.nChannels = 2;
-    soundData->waveFormat.nSamplesPerSec = 44100;
-    soundData->waveFormat.wBitsPerSample = 16;
-    soundData->waveFormat.nBlockAlign =
-        soundData->waveFormat.nChannels *
-        (soundData->waveFormat.wBitsPerSample / 8);
-    soundData->waveFormat.nAvgBytesPerSec =
-        soundData->waveFormat.nSamplesPerSec *
-        soundData->waveFormat.nBlockAlign;
-    soundData->waveFormat.cbSize = 0;
-
-    // Open wave output device
-    MMRESULT result = waveOutOpen(
-        &soundData->hWaveOut, WAVE_MAPPER, &soundData->waveFormat,
-        (DWORD_PTR) _waveOutCallback, (DWORD_PTR) soundData, CALLBACK_FUNCTION
-    );
+    _streamThread = (HANDLE) thread;
+    return 0;
+}
 
-    if (result != MMSYSERR_NOERROR) {
-        fprintf(stderr, "Failed to open wave output device: %u\n", result);
-        UnmapViewOfFile(soundData->lpMapAddress);
-        CloseHandle(soundData->hMapFile);
-        CloseHandle(soundData->hFile);
-        DeleteCriticalSection(&soundData->criticalSection);
-        free(soundData);
-        return -1;
-    }
+void _Platform_joinStreamThread() {
+    WaitForSingleObject(_streamThread, INFINITE);
+    CloseHandle(_streamThread);
+    _streamThread = NULL;
+}
 
-    // Set up wave header
-    soundData->waveHeader.lpData = (LPSTR) soundData->lpMapAddress;
-    soundData->waveHeader.dwBufferLength = soundData->fileSize;
-    soundData->waveHeader.dwFlags = 0;
-    soundData->waveHeader.dwLoops = 0;
+// Sink Thread
 
-    // Prepare header
-    result = waveOutPrepareHeader(
-        soundData->hWaveOut, &soundData->waveHeader, sizeof(WAVEHDR)
-    );
-    if (result != MMSYSERR_NOERROR) {
-        fprintf(stderr, "Failed to prepare wave header: %u\n", result);
-        waveOutClose(soundData->hWaveOut);
-        UnmapViewOfFile(soundData->lpMapAddress);
-        CloseHandle(soundData->hMapFile);
-        CloseHandle(soundData->hFile);
-        DeleteCriticalSection(&soundData->criticalSection);
-        free(soundData);
-        return -1;
-    }
+static HANDLE _sinkThread = NULL;
+static void (*_sinkFunc)() = NULL;
 
-    // Set volume
-    DWORD volumeValue = (DWORD) (soundData->volume * 0xFFFF);
-    waveOutSetVolume(soundData->hWaveOut, MAKELONG(volumeValue, volumeValue));
-
-    // Start playback
-    result = waveOutWrite(
-        soundData->hWaveOut, &soundData->waveHeader, sizeof(WAVEHDR)
-    );
-    if (result != MMSYSERR_NOERROR) {
-        fprintf(stderr, "Failed to start wave playback: %u\n", result);
-        waveOutUnprepareHeader(
-            soundData->hWaveOut, &soundData->waveHeader, sizeof(WAVEHDR)
-        );
-        waveOutClose(soundData->hWaveOut);
-        UnmapViewOfFile(soundData->lpMapAddress);
-        CloseHandle(soundData->hMapFile);
-        CloseHandle(soundData->hFile);
-        DeleteCriticalSection(&soundData->criticalSection);
-        free(soundData);
-        return -1;
-    }
-
-    soundData->isPlaying = 1;
-    *platformData = soundData;
+unsigned __stdcall _sinkLoop(void* arg) {
+    (void) arg;
 
+    _sinkFunc();
     return 0;
 }
 
-int _Platform_pauseSound(void* platformData) {
-    if (!platformData) return -1;
+int _Platform_startSinkThread(void (*func)()) {
+    _sinkFunc = func;
 
-    _WindowsSoundData* soundData = (_WindowsSoundData*) platformData;
-
-    EnterCriticalSection(&soundData->criticalSection);
-
-    if (soundData->isPlaying && !soundData->isPaused) {
-        waveOutPause(soundData->hWaveOut);
-        soundData->isPaused = 1;
-    }
-
-    LeaveCriticalSection(&soundData->criticalSection);
+    uintptr_t thread = _beginthreadex(NULL, 0, _sinkLoop, NULL, 0, NULL);
+    if (thread == 0) return -1;
 
+    _sinkThread = (HANDLE) thread;
     return 0;
 }
 
-int _Platform_resumeSound(void* platformData) {
-    if (!platformData) return -1;
+void _Platform_joinSinkThread() {
+    WaitForSingleObject(_sinkThread, INFINITE);
+    CloseHandle(_sinkThread);
+    _sinkThread = NULL;
+}
 
-    _WindowsSoundData* soundData = (_WindowsSoundData*) platformData;
+// Audio Thread
 
-    EnterCriticalSection(&soundData->criticalSection);
+static void _queuePeriod(WAVEHDR* header) {
+    _Platform_lockSound();
+    CmdFX_mixer_render((short*) header->lpData, _periodFrames);
+    _Platform_unlockSound();
 
-    if (soundData->isPlaying && soundData->isPaused) {
-        waveOutRestart(soundData->hWaveOut);
-        soundData->isPaused = 0;
-    }
+    waveOutWrite(_waveOut, header, sizeof(WAVEHDR));
+}
 
-    LeaveCriticalSection(&soundData->criticalSection);
+// the one thread that feeds the output stream; it wakes when a buffer is done
+unsigned __stdcall _audioLoop(void* arg) {
+    (void) arg;
+    CmdFX_trace_nameThread("sound");
 
-    return 0;
-}
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
 
-int _Platform_stopSound(void* platformData) {
-    if (!platformData) return -1;
+    for (int i = 0; i < _PERIOD_COUNT; i++) _queuePeriod(&_headers[i]);
 
-    _WindowsSoundData* soundData = (_WindowsSoundData*) platformData;
+    while (InterlockedCompareExchange(&_audioRunning, 0, 0)) {
+        WaitForSingleObject(_audioEvent, INFINITE);
 
-    EnterCriticalSection(&soundData->criticalSection);
+        // with every buffer done the device ran dry; with all but one, the
+        // next buffer is queued behind less than a period
+        int done = 0;
+        for (int i = 0; i < _PERIOD_COUNT; i++)
+            if (_headers[i].dwFlags & WHDR_DONE) done++;
 
-    if (soundData->isPlaying) {
-        waveOutReset(soundData->hWaveOut);
-        soundData->isPlaying = 0;
-        soundData->isPaused = 0;
-        soundData->currentLoop = 0;
-        soundData->currentPosition = 0;
-    }
+        if (done >= _PERIOD_COUNT - 1) {
+            _Platform_lockSound();
+            if (done == _PERIOD_COUNT) CmdFX_mixer_countUnderrun();
+            else CmdFX_mixer_countLateWrite();
+            _Platform_unlockSound();
+        }
 
-    LeaveCriticalSection(&soundData->criticalSection);
+        for (int i = 0; i < _PERIOD_COUNT; i++) {
+            if (!InterlockedCompareExchange(&_audioRunning, 0, 0)) break;
+            if (_headers[i].dwFlags & WHDR_DONE) _queuePeriod(&_headers[i]);
+        }
+    }
 
     return 0;
 }
 
-int _Platform_setSoundVolume(void* platformData, double volume) {
-    if (!platformData || volume < 0.0 || volume > 1.0) return -1;
-
-    _WindowsSoundData* soundData = (_WindowsSoundData*) platformData;
+static void _closeWaveOut() {
+    waveOutReset(_waveOut);
+    for (int i = 0; i < _PERIOD_COUNT; i++)
+        waveOutUnprepareHeader(_waveOut, &_headers[i], sizeof(WAVEHDR));
 
-    EnterCriticalSection(&soundData->criticalSection);
+    waveOutClose(_waveOut);
+    _waveOut = NULL;
 
-    soundData->volume = volume;
+    CloseHandle(_audioEvent);
+    _audioEvent = NULL;
 
-    // Set hardware volume
-    DWORD volumeValue = (DWORD) (volume * 0xFFFF);
-    waveOutSetVolume(soundData->hWaveOut, MAKELONG(volumeValue, volumeValue));
-
-    LeaveCriticalSection(&soundData->criticalSection);
-
-    return 0;
+    free(_periods);
+    _periods = NULL;
 }
 
-void _Platform_freeSoundData(void* platformData) {
-    if (!platformData) return;
+int _Platform_initSoundSystem() {
+    if (_soundSystemInitialized) return 0;
 
-    _WindowsSoundData* soundData = (_WindowsSoundData*) platformData;
+    _audioEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (!_audioEvent) {
+        fprintf(stderr, "Failed to create audio event: %lu\n", GetLastError());
+        return -1;
+    }
 
-    EnterCriticalSection(&soundData->criticalSection);
+    // one device is shared by every sound; the mixer renders 16-bit stereo
+    int rate = CmdFX_mixer_getRate();
+    WAVEFORMATEX format = {0};
+    format.wFormatTag = WAVE_FORMAT_PCM;
+    format.nChannels = CMDFX_MIXER_CHANNELS;
+    format.nSamplesPerSec = rate;
+    format.wBitsPerSample = 16;
+    format.nBlockAlign = format.nChannels * (format.wBitsPerSample / 8);
+    format.nAvgBytesPerSec = format.nSamplesPerSec * format.nBlockAlign;
+    format.cbSize = 0;
 
-    if (soundData->isPlaying) {
-        waveOutReset(soundData->hWaveOut);
+    MMRESULT result = waveOutOpen(
+        &_waveOut, WAVE_MAPPER, &format, (DWORD_PTR) _audioEvent, 0,
+        CALLBACK_EVENT
+    );
+    if (result != MMSYSERR_NOERROR) {
+        fprintf(stderr, "Failed to open wave output device: %u\n", result);
+        CloseHandle(_audioEvent);
+        _audioEvent = NULL;
+        return -1;
     }
 
-    waveOutUnprepareHeader(
-        soundData->hWaveOut, &soundData->waveHeader, sizeof(WAVEHDR)
-    );
-    waveOutClose(soundData->hWaveOut);
+    _periodFrames =
+        CmdFX_mixer_getPeriodFrames() * CMDFX_MIXER_PERIODS / _PERIOD_COUNT;
+    size_t periodSize = sizeof(short) * _periodFrames * CMDFX_MIXER_CHANNELS;
 
-    if (soundData->lpMapAddress) {
-        UnmapViewOfFile(soundData->lpMapAddress);
+    _periods = malloc(periodSize * _PERIOD_COUNT);
+    if (!_periods) {
+        fprintf(stderr, "Failed to allocate audio periods\n");
+        _closeWaveOut();
+        return -1;
     }
 
-    if (soundData->hMapFile) {
-        CloseHandle(soundData->hMapFile);
+    memset(_headers, 0, sizeof(_headers));
+    CmdFX_mixer_setDevice(rate, _periodFrames, _periodFrames * _PERIOD_COUNT);
+
+    for (int i = 0; i < _PERIOD_COUNT; i++) {
+        _headers[i].lpData = (LPSTR) _periods + periodSize * i;
+        _headers[i].dwBufferLength = (DWORD) periodSize;
+
+        result = waveOutPrepareHeader(_waveOut, &_headers[i], sizeof(WAVEHDR));
+        if (result != MMSYSERR_NOERROR) {
+            fprintf(stderr, "Failed to prepare wave header: %u\n", result);
+            _closeWaveOut();
+            return -1;
+        }
     }
 
-    if (soundData->hFile && soundData->hFile != INVALID_HANDLE_VALUE) {
-        CloseHandle(soundData->hFile);
+    InterlockedExchange(&_audioRunning, 1);
+    uintptr_t thread = _beginthreadex(NULL, 0, _audioLoop, NULL, 0, NULL);
+    if (thread == 0) {
+        fprintf(stderr, "Failed to create audio thread\n");
+        InterlockedExchange(&_audioRunning, 0);
+        _closeWaveOut();
+        return -1;
     }
 
-    LeaveCriticalSection(&soundData->criticalSection);
-    DeleteCriticalSection(&soundData->criticalSection);
+    _audioThread = (HANDLE) thread;
+    _soundSystemInitialized = 1;
+    return 0;
+}
 
-    free(soundData);
+void _Platform_shutdownSoundSystem() {
+    if (!_soundSystemInitialized) return;
+
+    InterlockedExchange(&_audioRunning, 0);
+    SetEvent(_audioEvent);
+
+    WaitForSingleObject(_audioThread, INFINITE);
+    CloseHandle(_audioThread);
+    _audioThread = NULL;
+
+    _closeWaveOut();
+    _soundSystemInitialized = 0;
 }
@@ -0,0 +1,56 @@
+#include <stdio.h>
+
+#include "../test.h"
+#include "cmdfx/core/animation/reveal.h"
+
+int main() {
+    int r = 0;
+
+    // Shapes
+    int line = Canvas_hLine_reveal(1, 1, 10, '-', 1);
+    r |= assertTrue(line > 0);
+    r |= assertTrue(Canvas_isRevealing(line));
+    r |= assertEquals(Canvas_getRevealedCells(line), 0);
+
+    r |= assertEquals(Canvas_updateReveals(0.25), 1);
+    r |= assertEquals(Canvas_getRevealedCells(line), 2);
+    r |= assertEquals(Canvas_updateReveals(0.5), 1);
+    r |= assertEquals(Canvas_getRevealedCells(line), 7);
+    r |= assertEquals(Canvas_updateReveals(0.25), 0);
+    r |= assertFalse(Canvas_isRevealing(line));
+    r |= assertEquals(Canvas_getRevealedCells(line), -1);
+
+    // many reveals advance together
+    int rect = Canvas_rect_reveal(1, 1, 4, 3, '#', 2);
+    int fill = Canvas_fillRect_reveal(1, 1, 4, 3, '#', 2);
+    int diagonal = Canvas_line_reveal(1, 1, 4, 8, '*', 2);
+    int text = Canvas_drawText_reveal(1, 1, "Hello", 2);
+    int ascii = Canvas_drawAsciiText_reveal(1, 1, '@', "Hi", 2);
+    r |= assertEquals(Canvas_getRevealCount(), 5);
+
+    r |= assertEquals(Canvas_updateReveals(1), 5);
+    r |= assertEquals(Canvas_getRevealedCells(rect), 5);
+    r |= assertEquals(Canvas_getRevealedCells(fill), 6);
+    r |= assertEquals(Canvas_getRevealedCells(diagonal), 4);
+    r |= assertEquals(Canvas_getRevealedCells(text), 2);
+    r |= assertEquals(Canvas_getRevealedCells(ascii), 40);
+
+    // Cancellation
+    r |= assertEquals(Canvas_cancelReveal(text), 0);
+    r |= assertEquals(Canvas_cancelReveal(text), -1);
+    r |= assertEquals(Canvas_getRevealCount(), 4);
+    r |= assertEquals(Canvas_updateReveals(1), 0);
+
+    // Invalid Reveals
+    r |= assertEquals(Canvas_hLine_reveal(1, 1, 0, '-', 1), -1);
+    r |= assertEquals(Canvas_vLine_reveal(1, 1, 5, '|', 0), -1);
+    r |= assertEquals(Canvas_drawText_reveal(1, 1, "", 1), -1);
+    r |= assertEquals(Canvas_line_reveal(-1, 1, 2, 2, '*', 1), -1);
+
+    // lines start at the edge like the other shapes
+    int edge = Canvas_line_reveal(0, 0, 2, 0, '*', 1);
+    r |= assertTrue(edge > 0);
+    r |= assertEquals(Canvas_cancelReveal(edge), 0);
+
+    return r;
+}
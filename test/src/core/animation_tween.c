@@ -0,0 +1,74 @@
+#include <stdio.h>
+
+#include "../test.h"
+#include "cmdfx/core/animation/tween.h"
+#include "cmdfx/core/sprites.h"
+
+static int completedId = 0;
+static int followUp = 0;
+
+void onComplete(int id, CmdFX_Sprite* sprite, void* data) {
+    completedId = id;
+    followUp = Tween_setZ(sprite, *(int*) data, 0.5, EASING_LINEAR);
+}
+
+int main() {
+    int r = 0;
+
+    // Easing
+    r |= assertDoubleEquals(Tween_ease(EASING_LINEAR, 0.25), 0.25);
+    r |= assertDoubleEquals(Tween_ease(EASING_IN_QUAD, 0.5), 0.25);
+    r |= assertDoubleEquals(Tween_ease(EASING_OUT_QUAD, 0.5), 0.75);
+    r |= assertDoubleEquals(Tween_ease(EASING_IN_OUT_SINE, 0.5), 0.5);
+    r |= assertDoubleEquals(Tween_ease(EASING_OUT_CUBIC, 2), 1.0);
+    r |= assertDoubleEquals(Tween_ease(EASING_IN_CUBIC, -1), 0.0);
+
+    // Position
+    CmdFX_Sprite* sprite = Sprite_createFilled(2, 2, '#', 0, 0);
+    Sprite_draw(1, 1, sprite);
+
+    int move = Tween_moveTo(sprite, 11, 21, 1, EASING_LINEAR);
+    r |= assertTrue(move > 0);
+    r |= assertTrue(Tween_isActive(move));
+    r |= assertEquals(Tween_getCount(), 1);
+
+    r |= assertEquals(Tween_update(0.5), 1);
+    r |= assertEquals(sprite->x, 6);
+    r |= assertEquals(sprite->y, 11);
+
+    int z = 7;
+    r |= assertEquals(Tween_setCallback(move, onComplete, &z), 0);
+    r |= assertEquals(Tween_update(0.5), 1);
+    r |= assertEquals(sprite->x, 11);
+    r |= assertEquals(sprite->y, 21);
+    r |= assertFalse(Tween_isActive(move));
+    r |= assertEquals(completedId, move);
+
+    // the callback started a z tween
+    r |= assertTrue(Tween_isActive(followUp));
+    r |= assertEquals(Tween_update(0.25), 1);
+    r |= assertEquals(sprite->z, 4);
+
+    // Cancellation
+    r |= assertEquals(Tween_cancel(followUp), 0);
+    r |= assertEquals(Tween_cancel(followUp), -1);
+    r |= assertEquals(Tween_getCount(), 0);
+    r |= assertEquals(sprite->z, 4);
+
+    int a = Tween_moveTo(sprite, 1, 1, 1, EASING_IN_OUT_QUAD);
+    int b = Tween_setZ(sprite, 0, 1, EASING_LINEAR);
+    r |= assertNotEquals(a, b);
+    r |= assertEquals(Tween_getCount(), 2);
+    r |= assertEquals(Tween_setCallback(a, onComplete, &z), 0);
+
+    // freeing the sprite cancels its tweens without calling back
+    completedId = 0;
+    Sprite_free(sprite);
+    r |= assertEquals(Tween_getCount(), 0);
+    r |= assertEquals(Tween_update(1), 0);
+    r |= assertEquals(completedId, 0);
+
+    r |= assertEquals(Tween_moveTo(0, 1, 1, 1, EASING_LINEAR), -1);
+
+    return r;
+}
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "../test.h"
+#include "cmdfx/core/assets.h"
+#include "cmdfx/core/builder.h"
+#include "cmdfx/core/costumes.h"
+
+int main() {
+    int r = 0;
+
+    const char* text = "assets_test.txt";
+    const char* path = "assets_test.cfxa";
+
+    FILE* file = fopen(text, "wb");
+    if (file == 0) return 1;
+    fputs("/-\\\n| |\n\\_/\n", file);
+    fclose(file);
+
+    r |= assertEquals(Asset_convertFromText(text, path, 4), 0);
+    r |= assertNull(Asset_load("missing.cfxa"));
+    r |= assertNull(Asset_load(text));
+
+    CmdFX_Asset* asset = Asset_load(path);
+    r |= assertNotNull(asset);
+    r |= assertEquals(asset->kind, ASSET_SPRITE);
+    r |= assertEquals(asset->width, 3);
+    r |= assertEquals(asset->height, 3);
+    r |= assertEquals(asset->frameCount, 1);
+    r |= assertEquals(asset->z, 4);
+
+    // sprites point into the asset instead of copying it
+    CmdFX_Sprite* a = Asset_createSprite(asset);
+    CmdFX_Sprite* b = Asset_createSprite(asset);
+    r |= assertNotNull(a);
+    r |= assertNotNull(b);
+    r |= assertPointersMatch(a->data, asset->frames[0]);
+    r |= assertPointersMatch(b->data, asset->frames[0]);
+    r |= assertEquals(a->width, 3);
+    r |= assertEquals(a->z, 4);
+    r |= assertStringsMatch(a->data[1], "| |");
+
+    // a modified sprite copies its data first
+    r |= assertEquals(Sprite_setChar(a, 1, 1, 'o'), 1);
+    r |= assertFalse(a->data == asset->frames[0]);
+    r |= assertStringsMatch(a->data[1], "|o|");
+    r |= assertStringsMatch(b->data[1], "| |");
+    r |= assertStringsMatch(asset->frames[0][1], "| |");
+
+    r |= assertEquals(Sprite_setAnsi(a, 0, 0, "\033[31m"), 1);
+    r |= assertStringsMatch(a->ansi[0][0], "\033[31m");
+    r |= assertNull(b->ansi[0][0]);
+
+    // the asset stays mapped while a sprite still borrows it
+    r |= assertEquals(Asset_free(asset), 0);
+    r |= assertStringsMatch(b->data[2], "\\_/");
+    Sprite_free(b);
+
+    // styles and costumes round trip
+    r |= assertEquals(Sprite_createCostumes(a, 2) != 0, 1);
+    char* frame[] = {"ooo", "ooo", "ooo", 0};
+    char** costume = createCharArrayCopy(frame);
+    r |= assertEquals(Sprite_setCostumeAt(a, 1, costume, 0), 0);
+    r |= assertEquals(Asset_saveSprite(a, path), 0);
+
+    asset = Asset_load(path);
+    r |= assertNotNull(asset);
+    r |= assertEquals(asset->frameCount, 2);
+    r |= assertStringsMatch(asset->ansiFrames[0][0][0], "\033[31m");
+    r |= assertNull(asset->ansiFrames[0][0][1]);
+
+    CmdFX_Sprite* c = Asset_createSprite(asset);
+    r |= assertNotNull(c);
+    r |= assertEquals(Sprite_switchCostumeTo(c, 1), 0);
+    r |= assertStringsMatch(c->data[0], "ooo");
+    Sprite_free(c);
+    Sprite_free(a);
+    Asset_free(asset);
+
+    // scenes
+    CmdFX_Scene* scene = Scene_createFilled(4, 2, '#', 0, 3);
+    r |= assertEquals(Asset_saveScene(scene, path), 0);
+    Scene_free(scene);
+
+    asset = Asset_load(path);
+    r |= assertNotNull(asset);
+    r |= assertEquals(asset->kind, ASSET_SCENE);
+
+    scene = Asset_createScene(asset);
+    r |= assertNotNull(scene);
+    r |= assertEquals(scene->width, 4);
+    r |= assertEquals(scene->height, 2);
+    r |= assertEquals(scene->z, 3);
+    r |= assertPointersMatch(scene->data, asset->frames[0]);
+
+    r |= assertEquals(Scene_setChar(scene, 3, 1, '@'), 0);
+    r |= assertEquals(scene->data[1][3], '@');
+    r |= assertEquals(asset->frames[0][1][3], '#');
+
+    Scene_free(scene);
+    Asset_free(asset);
+
+    remove(text);
+    remove(path);
+
+    return r;
+}
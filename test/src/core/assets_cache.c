@@ -0,0 +1,74 @@
+#include <stdio.h>
+
+#include "../test.h"
+#include "cmdfx/core/assets.h"
+
+static int writeFile(const char* path, const char* text) {
+    FILE* file = fopen(path, "wb");
+    if (file == 0) return -1;
+
+    fputs(text, file);
+    fclose(file);
+    return 0;
+}
+
+int main() {
+    int r = 0;
+
+    const char* path = "assets_cache_a.txt";
+    const char* copy = "assets_cache_b.txt";
+    if (writeFile(path, "<o>\n/ \\\n") != 0) return 1;
+    if (writeFile(copy, "<o>\n/ \\\n") != 0) return 1;
+
+    r |= assertNull(Asset_loadSprite("missing.txt", 0));
+    r |= assertFalse(Asset_isCached(path));
+
+    // every sprite from the same file shares one copy of its data
+    CmdFX_Sprite* a = Asset_loadSprite(path, 1);
+    CmdFX_Sprite* b = Asset_loadSprite(path, 2);
+    r |= assertNotNull(a);
+    r |= assertNotNull(b);
+    r |= assertTrue(Asset_isCached(path));
+    r |= assertPointersMatch(a->data, b->data);
+    r |= assertEquals(a->width, 3);
+    r |= assertEquals(a->height, 2);
+    r |= assertEquals(a->z, 1);
+    r |= assertEquals(b->z, 2);
+    r |= assertStringsMatch(b->data[1], "/ \\");
+
+    // cached paths are not read again
+    if (writeFile(path, "changed\n") != 0) return 1;
+    CmdFX_Asset* asset = Asset_loadCached(path);
+    r |= assertNotNull(asset);
+    r |= assertPointersMatch(asset->frames[0], a->data);
+    r |= assertEquals(Asset_free(asset), 0);
+
+    // the same content under another path is shared too
+    CmdFX_Sprite* c = Asset_loadSprite(copy, 0);
+    r |= assertNotNull(c);
+    r |= assertPointersMatch(c->data, a->data);
+    r |= assertTrue(Asset_isCached(copy));
+
+    // modified sprites stop sharing
+    r |= assertEquals(Sprite_setChar(a, 1, 0, '*'), 1);
+    r |= assertStringsMatch(a->data[0], "<*>");
+    r |= assertStringsMatch(b->data[0], "<o>");
+
+    // the asset leaves the cache with its last reference
+    Sprite_free(a);
+    Sprite_free(b);
+    r |= assertTrue(Asset_isCached(path));
+    Sprite_free(c);
+    r |= assertFalse(Asset_isCached(path));
+    r |= assertFalse(Asset_isCached(copy));
+
+    CmdFX_Sprite* d = Asset_loadSprite(path, 0);
+    r |= assertNotNull(d);
+    r |= assertStringsMatch(d->data[0], "changed");
+    Sprite_free(d);
+
+    remove(path);
+    remove(copy);
+
+    return r;
+}
@@ -0,0 +1,115 @@
+#include <stdlib.h>
+
+#include "../test.h"
+#include "cmdfx/core/builder.h"
+#include "cmdfx/core/sprites.h"
+#include "cmdfx/core/util.h"
+
+static void freeStr(char*** a, int w, int h) {
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) free(a[y][x]);
+        free(a[y]);
+    }
+    free(a);
+}
+
+int main() {
+    int r = 0;
+
+    // horizontal gradients run from the first color to the last
+    int colors[3] = {0xFF0000, 0x00FF00, 0x0000FF};
+    int grid[5 * 3];
+    r |= assertEquals(
+        Color2DBuilder_gradient(grid, 5, 3, 2, colors, 0, GRADIENT_HORIZONTAL),
+        0
+    );
+    r |= assertEquals(grid[0], 0xFF0000);
+    r |= assertEquals(grid[2], lerp_color(0xFF0000, 0x00FF00, 0.5));
+    r |= assertEquals(grid[4], 0x00FF00);
+    r |= assertEquals(grid[14], 0x00FF00);
+
+    // the middle color sits at its percentage
+    double percentages[3] = {0.25, 0.75, 0};
+    r |= assertEquals(
+        Color2DBuilder_gradient(
+            grid, 5, 1, 3, colors, percentages, GRADIENT_HORIZONTAL
+        ),
+        0
+    );
+    r |= assertEquals(grid[1], 0x00FF00);
+    r |= assertEquals(grid[4], 0x0000FF);
+
+    // taller than wide, one color per row
+    int tall[2 * 6];
+    r |= assertEquals(
+        Color2DBuilder_gradient(
+            tall, 2, 6, 2, colors, 0, GRADIENT_VERTICAL_REVERSE
+        ),
+        0
+    );
+    r |= assertEquals(tall[0], 0x00FF00);
+    r |= assertEquals(tall[1], 0x00FF00);
+    r |= assertEquals(tall[11], 0xFF0000);
+
+    int radial[4 * 4];
+    r |= assertEquals(
+        Color2DBuilder_gradient(radial, 4, 4, 1, colors, 0, GRADIENT_RADIAL), 0
+    );
+    r |= assertEquals(radial[15], 0xFF0000);
+    r |= assertEquals(
+        Color2DBuilder_gradient(radial, 4, 4, 0, colors, 0, GRADIENT_RADIAL),
+        -1
+    );
+
+    // Characters; the far half stays on the last character
+    char** chars = Char2DBuilder_createFilled(6, 1, ' ');
+    r |= assertEquals(
+        Char2DBuilder_gradient(
+            chars, 0, 0, 6, 1, 'a', 'z', GRADIENT_HORIZONTAL
+        ),
+        0
+    );
+    r |= assertEquals(chars[0][0], 'a');
+    r |= assertEquals(chars[0][5], 'z');
+    free(chars[0]);
+    free(chars);
+
+    // Strings
+    char*** array = String2DBuilder_createFilled(4, 2, "x");
+    r |= assertEquals(
+        String2DBuilder_gradientForeground(
+            array, 0, 0, 4, 2, 0xFF0000, 0x0000FF, GRADIENT_HORIZONTAL
+        ),
+        0
+    );
+    r |= assertStringsMatch(array[0][0], "\033[38;2;255;0;0m");
+    r |= assertStringsMatch(array[1][3], "\033[38;2;0;0;255m");
+
+    r |= assertEquals(
+        String2DBuilder_multiGradientBackground(
+            array, 1, 0, 3, 1, 3, colors, GRADIENT_HORIZONTAL
+        ),
+        0
+    );
+    r |= assertStringsMatch(array[0][2], "\033[48;2;0;255;0m");
+    r |= assertStringsMatch(array[0][0], "\033[38;2;255;0;0m");
+    freeStr(array, 4, 2);
+
+    // Sprites
+    CmdFX_Sprite* sprite = Sprite_create(
+        Char2DBuilder_createFilled(3, 3, '#'),
+        String2DBuilder_createFilled(3, 3, ""), 0
+    );
+    r |= assertEquals(
+        Sprite_setBackgroundGradient(
+            sprite, 1, 1, 4, 4, GRADIENT_VERTICAL, 2, 0x000000, 0xFFFFFF
+        ),
+        1
+    );
+    r |= assertStringsMatch(sprite->ansi[0][0], "");
+    r |= assertStringsMatch(sprite->ansi[1][1], "\033[48;2;0;0;0m");
+    r |= assertStringsMatch(sprite->ansi[2][2], "\033[48;2;85;85;85m");
+    Sprite_free(sprite);
+
+    return r;
+}
@@ -0,0 +1,121 @@
+#include <stdlib.h>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include "../test.h"
+#include "cmdfx/core/builder.h"
+#include "cmdfx/core/sprites.h"
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+static void freeChars(char** a) {
+    for (int y = 0; a[y] != 0; y++) free(a[y]);
+    free(a);
+}
+
+static void freeStr(char*** a, int w, int h) {
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) free(a[y][x]);
+        free(a[y]);
+    }
+    free(a);
+}
+
+int main() {
+    int r = 0;
+
+    // rotation samples the source for every cell, so nothing is lost
+    char** grid = Char2DBuilder_create(3, 3);
+    const char* rows[] = {"abc", "def", "ghi"};
+    for (int y = 0; y < 3; y++)
+        for (int x = 0; x < 3; x++) grid[y][x] = rows[y][x];
+
+    r |= assertEquals(Char2DBuilder_rotate(grid, M_PI / 2), 0);
+    r |= assertStringsMatch(grid[0], "gda");
+    r |= assertStringsMatch(grid[1], "heb");
+    r |= assertStringsMatch(grid[2], "ifc");
+
+    r |= assertEquals(Char2DBuilder_rotate(grid, 0), 0);
+    r |= assertStringsMatch(grid[1], "heb");
+    freeChars(grid);
+
+    // targets outside a wide grid are never written
+    char** wide = Char2DBuilder_createFilled(8, 2, '#');
+    r |= assertEquals(Char2DBuilder_rotate(wide, M_PI / 4), 0);
+    r |= assertEquals(getCharArrayHeight(wide), 2);
+    r |= assertEquals(getCharArrayWidth(wide), 8);
+    freeChars(wide);
+
+    // short rows are read and written only up to their terminator
+    char** ragged = Char2DBuilder_createFilled(3, 3, '#');
+    ragged[1][1] = '\0';
+    r |= assertEquals(Char2DBuilder_rotate(ragged, M_PI), 0);
+    r |= assertStringsMatch(ragged[0], "###");
+    r |= assertEquals(ragged[1][1], 0);
+    freeChars(ragged);
+
+    char*** jagged = String2DBuilder_createFilled(3, 3, "\033[31m");
+    for (int x = 1; x < 3; x++) free(jagged[1][x]);
+    jagged[1] = realloc(jagged[1], sizeof(char*) * 2);
+    jagged[1][1] = 0;
+
+    r |= assertEquals(String2DBuilder_rotate(jagged, M_PI), 0);
+    r |= assertStringsMatch(jagged[0][0], "\033[31m");
+    r |= assertNull(jagged[1][1]);
+    for (int y = 0; y < 3; y++) {
+        for (int x = 0; x < 3 && jagged[y][x] != 0; x++) free(jagged[y][x]);
+        free(jagged[y]);
+    }
+    free(jagged);
+
+    // scaling builds terminated grids of the new size
+    char** small = Char2DBuilder_create(2, 2);
+    small[0][0] = 'a';
+    small[0][1] = 'b';
+    small[1][0] = 'c';
+    small[1][1] = 'd';
+
+    char** big = Char2DBuilder_scale(small, 2);
+    r |= assertNotNull(big);
+    r |= assertEquals(getCharArrayHeight(big), 4);
+    r |= assertStringsMatch(big[0], "aabb");
+    r |= assertStringsMatch(big[3], "ccdd");
+
+    char** half = Char2DBuilder_scale(big, 0.5);
+    r |= assertEquals(getCharArrayHeight(half), 2);
+    r |= assertStringsMatch(half[0], "ab");
+    r |= assertStringsMatch(half[1], "cd");
+    freeChars(half);
+
+    char*** styles = String2DBuilder_createFilled(2, 1, "\033[31m");
+    char*** bigStyles = String2DBuilder_scale(styles, 3);
+    r |= assertNotNull(bigStyles);
+    r |= assertEquals(getStringArrayHeight(bigStyles), 3);
+    r |= assertStringsMatch(bigStyles[2][5], "\033[31m");
+    r |= assertNull(bigStyles[0][6]);
+    freeStr(bigStyles, 6, 3);
+
+    // sprites transform glyphs and styles together
+    CmdFX_Sprite* sprite = Sprite_create(
+        Char2DBuilder_createFilled(4, 2, '#'),
+        String2DBuilder_createFilled(4, 2, "\033[32m"), 0
+    );
+
+    r |= assertEquals(Sprite_scale(sprite, 2), 0);
+    r |= assertEquals(sprite->width, 8);
+    r |= assertEquals(sprite->height, 4);
+    r |= assertEquals(sprite->data[3][7], '#');
+    r |= assertStringsMatch(sprite->ansi[3][7], "\033[32m");
+
+    for (int i = 0; i < 8; i++)
+        r |= assertEquals(Sprite_rotate(sprite, M_PI / 8), 0);
+    r |= assertEquals(sprite->width, 8);
+    r |= assertEquals(sprite->height, 4);
+
+    Sprite_free(sprite);
+
+    return r;
+}
@@ -0,0 +1,36 @@
+#include <stdlib.h>
+
+#include "../test.h"
+#include "cmdfx/core/events.h"
+
+static int calls = 0;
+
+static int listener(CmdFX_Event* event) {
+    (void) event;
+    calls++;
+    return 0;
+}
+
+int main() {
+    int r = 0;
+
+    r |= assertEquals(addCmdFXEventListener(5, listener), 0);
+    r |= assertEquals(addCmdFXEventListener(5, listener), 1);
+    r |= assertEquals(addCmdFXEventListener(5, listener), 2);
+
+    // removed listeners are freed and no longer called
+    r |= assertEquals(removeCmdFXEventListener(5, 1), 1);
+    r |= assertEquals(removeCmdFXEventListener(5, 2), 0);
+
+    CmdFX_Event event = {5, 0, 0};
+    free((void*) dispatchCmdFXEvent(&event));
+    r |= assertEquals(calls, 2);
+
+    // the rest are freed on shutdown
+    shutdownCmdFXEvents();
+
+    r |= assertNull((void*) dispatchCmdFXEvent(&event));
+    r |= assertEquals(calls, 2);
+
+    return r;
+}
@@ -0,0 +1,68 @@
+#include "../test.h"
+#include "cmdfx/core/canvas.h"
+#include "cmdfx/core/scenes.h"
+
+// internal; a real screen that writes nowhere, and a way to read it back
+extern int CmdFX_curses_openOffscreen(int width, int height);
+extern char CmdFX_curses_getCharAt(int x, int y);
+extern void CmdFX_curses_shutdown();
+
+int main() {
+    int r = 0;
+
+    // without a screen (e.g. PDCurses) only the headless paths are covered
+    int screen = CmdFX_curses_openOffscreen(80, 24);
+
+    CmdFX_Scene* scene = Scene_createFilled(200, 100, '.', 0, 0);
+
+    // only registered scenes can be backed
+    r |= assertEquals(Scene_setBacked(scene, 1), -1);
+    r |= assertFalse(Scene_isBacked(scene));
+
+    Scene_register(scene);
+    r |= assertEquals(Scene_setBacked(scene, 1), 0);
+    r |= assertTrue(Scene_isBacked(scene));
+    r |= assertEquals(Scene_setBacked(scene, 1), 0);
+
+    // drawing and panning work with or without a terminal
+    r |= assertEquals(Scene_drawPortion(scene, 0, 0, 0, 0, 40, 20), 0);
+    r |= assertEquals(Scene_scroll(scene->uid, 5, 3), 0);
+    r |= assertEquals(Scene_setChar(scene, 10, 10, '#'), 0);
+    r |= assertEquals(scene->data[10][10], '#');
+
+    r |= assertEquals(Scene_setBacked(scene, 0), 0);
+    r |= assertFalse(Scene_isBacked(scene));
+
+    Scene_setBacked(scene, 1);
+    Scene_unregister(scene);
+    r |= assertFalse(Scene_isBacked(scene));
+
+    Scene_free(scene);
+
+    if (screen) {
+        // blank cells of a backed scene leave what's underneath, like an
+        // unbacked scene
+        Canvas_setChar(50, 5, 'X');
+
+        CmdFX_Scene* sparse = Scene_createFilled(4, 4, ' ', 0, 0);
+        Scene_setChar(sparse, 0, 0, '#');
+        Scene_register(sparse);
+        r |= assertEquals(Scene_setBacked(sparse, 1), 0);
+
+        r |= assertEquals(Scene_draw(sparse, 48, 3), 0);
+        r |= assertEquals(CmdFX_curses_getCharAt(48, 3), '#');
+        r |= assertEquals(CmdFX_curses_getCharAt(50, 5), 'X');
+
+        // a cleared cell is erased from the screen
+        r |= assertEquals(Scene_setChar(sparse, 0, 0, ' '), 0);
+        r |= assertEquals(CmdFX_curses_getCharAt(48, 3), ' ');
+
+        Scene_unregister(sparse);
+        Scene_remove(sparse);
+        Scene_free(sparse);
+
+        CmdFX_curses_shutdown();
+    }
+
+    return r;
+}
@@ -0,0 +1,37 @@
+#include "../test.h"
+#include "cmdfx/core/scenes.h"
+
+int main() {
+    int r = 0;
+
+    CmdFX_Scene* scene = Scene_createFilled(10, 5, '#', 0, 0);
+    r |= assertEquals(Scene_isDirty(scene), 0);
+    r |= assertEquals(Scene_markDirty(scene, 0, 0, 2, 2), -1);
+
+    Scene_register(scene);
+    Scene_draw(scene, 0, 0);
+    r |= assertEquals(Scene_isDirty(scene), 0);
+
+    r |= assertEquals(Scene_markDirty(scene, 1, 1, 2, 2), 0);
+    r |= assertEquals(Scene_isDirty(scene), 1);
+    r |= assertEquals(Scene_markDirty(scene, 1, 1, 0, 2), -1);
+
+    tickCmdFXSceneEngine();
+    r |= assertEquals(Scene_isDirty(scene), 0);
+
+    // regions outside the scene are ignored
+    Canvas_markScenesDirty(20, 20, 5, 5);
+    r |= assertEquals(Scene_isDirty(scene), 0);
+
+    Canvas_markScenesDirty(8, 4, 5, 5);
+    r |= assertEquals(Scene_isDirty(scene), 1);
+
+    tickCmdFXSceneEngine();
+    r |= assertEquals(Scene_isDirty(scene), 0);
+
+    Scene_remove(scene);
+    Scene_unregister(scene);
+    Scene_free(scene);
+
+    return r;
+}
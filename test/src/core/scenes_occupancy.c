@@ -0,0 +1,72 @@
+#include "../test.h"
+#include "cmdfx/core/scenes.h"
+#include "cmdfx/core/util.h"
+
+// draws a scene at growing positions, so the maps are rebuilt while queried
+static void wander(void* arg) {
+    CmdFX_Scene* scene = (CmdFX_Scene*) arg;
+    for (int i = 0; i < 200; i++) {
+        Scene_draw(scene, i % 40, i % 20);
+        Scene_remove(scene);
+    }
+}
+
+int main() {
+    int r = 0;
+
+    CmdFX_Scene* back = Scene_createFilled(10, 10, '#', 0, 0);
+    CmdFX_Scene* middle = Scene_createFilled(4, 4, '@', 0, 1);
+    CmdFX_Scene* front = Scene_createFilled(2, 2, '%', 0, 2);
+
+    Scene_draw(back, 0, 0);
+    Scene_draw(middle, 2, 2);
+    Scene_draw(front, 3, 3);
+
+    r |= assertPointersMatch(Scene_getSceneAt(0, 0), back);
+    r |= assertPointersMatch(Scene_getSceneAt(2, 2), middle);
+    r |= assertPointersMatch(Scene_getSceneAt(3, 3), front);
+    r |= assertPointersMatch(Scene_getSceneAt(10, 10), 0);
+    r |= assertTrue(Scene_isOnBottomAt(back, 3, 3));
+    r |= assertFalse(Scene_isOnBottomAt(front, 3, 3));
+
+    // removing a scene exposes the ones underneath
+    Scene_remove(front);
+    r |= assertPointersMatch(Scene_getSceneAt(3, 3), middle);
+    Scene_remove(middle);
+    r |= assertPointersMatch(Scene_getSceneAt(3, 3), back);
+
+    // moving a scene outside of the previous bounds
+    Scene_draw(middle, 12, 12);
+    r |= assertPointersMatch(Scene_getSceneAt(3, 3), back);
+    r |= assertPointersMatch(Scene_getSceneAt(13, 13), middle);
+
+    // z changed directly after drawing
+    Scene_draw(front, 0, 0);
+    r |= assertPointersMatch(Scene_getSceneAt(0, 0), front);
+    front->z = -1;
+    r |= assertPointersMatch(Scene_getSceneAt(0, 0), back);
+    r |= assertTrue(Scene_isOnBottomAt(front, 0, 0));
+    r |= assertTrue(Scene_isOnTopAt(back, 1, 1));
+
+    Scene_free(front);
+    r |= assertPointersMatch(Scene_getSceneAt(0, 0), back);
+
+    // queries are safe while another thread draws and removes scenes
+    CmdFX_initThreadSafe();
+    CmdFX_Scene* wanderer = Scene_createFilled(3, 3, '*', 0, 5);
+    ThreadID thread = CmdFX_launchThread(wander, wanderer);
+    for (int i = 0; i < 2000; i++) {
+        CmdFX_Scene* top = Scene_getSceneAt(i % 40, i % 20);
+        if (top != 0 && top != back && top != wanderer && top != middle)
+            r |= assertTrue(0);
+    }
+    CmdFX_joinThread(thread);
+    CmdFX_destroyThreadSafe();
+
+    Scene_free(wanderer);
+    Scene_free(middle);
+    Scene_free(back);
+    r |= assertPointersMatch(Scene_getSceneAt(0, 0), 0);
+
+    return r;
+}
@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../test.h"
+#include "cmdfx/core/canvas.h"
+#include "cmdfx/core/scenes.h"
+#include "cmdfx/core/sprites.h"
+#include "cmdfx/ui/button.h"
+#include "cmdfx/ui/scenes.h"
+
+// internal; a real screen that writes nowhere, and a way to read it back
+extern int CmdFX_curses_openOffscreen(int width, int height);
+extern char CmdFX_curses_getCharAt(int x, int y);
+extern void CmdFX_curses_shutdown();
+
+#define X 5
+#define Y 3
+#define WIDTH 20
+#define HEIGHT 10
+
+// where the viewport of the scene starts
+static int viewX = 0;
+static int viewY = 0;
+
+static void onClick(
+    void* button, CmdFX_MouseEvent* event, unsigned long long time
+) {
+    (void) button;
+    (void) event;
+    (void) time;
+}
+
+// counts the viewport cells that differ from what a full redraw paints,
+// leaving out cells covered by `cover`
+static int countMismatches(CmdFX_Scene* scene, char cover) {
+    int mismatches = 0;
+    for (int i = 0; i < HEIGHT; i++)
+        for (int j = 0; j < WIDTH; j++) {
+            char c = CmdFX_curses_getCharAt(X + j, Y + i);
+            if (cover != 0 && c == cover) continue;
+            if (c != scene->data[viewY + i][viewX + j]) mismatches++;
+        }
+
+    return mismatches;
+}
+
+// scrolls with a mark on screen: shifting what is on screen carries the
+// mark along, while a full redraw paints over it
+static int scroll(CmdFX_Scene* scene, int dx, int dy, int inPlace) {
+    int r = 0;
+
+    Canvas_setChar(X + 10, Y + 5, '@');
+    r |= assertEquals(Scene_scroll(scene->uid, dx, dy), 0);
+    viewX += dx;
+    viewY += dy;
+
+    if (inPlace) {
+        int x = 10 - dx;
+        int y = 5 - dy;
+        r |= assertEquals(CmdFX_curses_getCharAt(X + x, Y + y), '@');
+        Canvas_setChar(X + x, Y + y, scene->data[viewY + y][viewX + x]);
+    }
+
+    return r;
+}
+
+int main() {
+    int r = 0;
+
+    // the in-place scroll needs a screen to shift (e.g. not PDCurses)
+    if (!CmdFX_curses_openOffscreen(80, 24)) return 0;
+
+    CmdFX_Scene* scene = Scene_create(60, 30);
+    for (int i = 0; i < 30; i++)
+        for (int j = 0; j < 60; j++)
+            Scene_setChar(scene, j, i, 'a' + (i * 7 + j * 3) % 26);
+    Scene_register(scene);
+
+    r |= assertEquals(Scene_drawPortion(scene, X, Y, 0, 0, WIDTH, HEIGHT), 0);
+    r |= assertEquals(countMismatches(scene, 0), 0);
+
+    // rows, columns and diagonals shift what is on screen
+    int steps[6][2] = {{0, 1}, {1, 0}, {1, 1}, {0, -1}, {-1, 0}, {-1, -1}};
+    for (int i = 0; i < 6; i++) {
+        r |= scroll(scene, steps[i][0], steps[i][1], 1);
+        r |= assertEquals(countMismatches(scene, 0), 0);
+    }
+
+    // a sprite over the viewport would be shifted along with it
+    r |= scroll(scene, 2, 2, 1);
+    CmdFX_Sprite* sprite = Sprite_createFilled(2, 2, '#', 0, 0);
+    Sprite_draw(X + 2, Y + 2, sprite);
+
+    r |= scroll(scene, 1, 0, 0);
+    r |= assertEquals(countMismatches(scene, '#'), 0);
+
+    Sprite_remove(sprite);
+    Sprite_free(sprite);
+
+    // so would the buttons of the scene
+    CmdFX_Button* button = Button_createFilled(2, 2, '*', 0, 0, onClick);
+    r |= assertEquals(Scene_addButton(scene->uid, button, 30, 20), 0);
+
+    r |= scroll(scene, 0, 1, 0);
+    r |= assertEquals(countMismatches(scene, '*'), 0);
+
+    Scene_removeButton(scene->uid, button);
+    Button_free(button);
+
+    // without them, the scene shifts in place again
+    r |= scroll(scene, -1, -1, 1);
+    r |= assertEquals(countMismatches(scene, 0), 0);
+
+    Scene_unregister(scene);
+    Scene_remove(scene);
+    Scene_free(scene);
+    CmdFX_curses_shutdown();
+
+    return r;
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../test.h"
+#include "cmdfx/core/builder.h"
+#include "cmdfx/core/costumes.h"
+#include "cmdfx/core/sprites.h"
+
+int main() {
+    int r = 0;
+
+    // Registry Growth
+    CmdFX_Sprite* sprites[20];
+    for (int i = 0; i < 20; i++)
+        sprites[i] = Sprite_create(Char2DBuilder_createFilled(1, 1, '.'), 0, 0);
+
+    CmdFX_Sprite* last = sprites[19];
+    r |= assertNotNull(Sprite_createCostumes(last, 2));
+    r |= assertNotNull(Sprite_getCostumes(last));
+    r |= assertNull(Sprite_getCostumes(sprites[18]));
+
+    for (int i = 0; i < 20; i++) Sprite_free(sprites[i]);
+
+    // Atlas
+    CmdFX_Sprite* sprite =
+        Sprite_create(Char2DBuilder_createFilled(2, 2, '#'), 0, 0);
+
+    char** frame1 = Char2DBuilder_createFilled(2, 2, '@');
+    char** frame2 = Char2DBuilder_createFilled(3, 4, '%');
+    char*** ansi2 = String2DBuilder_createFilled(3, 4, "\033[31m");
+    char** frames[] = {frame1, frame2};
+    char*** ansiFrames[] = {0, ansi2};
+
+    CmdFX_SpriteCostumes* costumes =
+        Sprite_createCostumeAtlas(sprite, frames, ansiFrames, 2);
+    r |= assertNotNull(costumes);
+    r |= assertEquals(costumes->costumeCount, 3);
+    r |= assertNull(Sprite_createCostumeAtlas(sprite, frames, ansiFrames, 2));
+    r |= assertTrue(Sprite_isShared(sprite));
+
+    // costumes are copies and stay in one block
+    r |= assertFalse(costumes->costumes[1] == frame1);
+    r |= assertCharArraysMatch(costumes->costumes[1], frame1);
+    r |= assertCharArraysMatch(costumes->costumes[2], frame2);
+    r |= assertStringsMatch(costumes->ansiCostumes[2][3][2], "\033[31m");
+    r |= assertNull(costumes->ansiCostumes[1]);
+    r |= assertTrue(costumes->costumes[0][1] < costumes->costumes[2][0]);
+
+    // switching swaps pointers and sizes
+    r |= assertEquals(Sprite_switchCostumeTo(sprite, 2), 0);
+    r |= assertPointersMatch(sprite->data, costumes->costumes[2]);
+    r |= assertPointersMatch(sprite->ansi, costumes->ansiCostumes[2]);
+    r |= assertEquals(sprite->width, 3);
+    r |= assertEquals(sprite->height, 4);
+    r |= assertEquals(Sprite_getCurrentCostumeIndex(sprite), 2);
+
+    r |= assertEquals(Sprite_switchCostumeTo(sprite, 1), 0);
+    r |= assertEquals(sprite->width, 2);
+    r |= assertEquals(sprite->height, 2);
+    r |= assertEquals(Sprite_getCurrentCostumeIndex(sprite), 1);
+
+    // writing gives the active costume its own copy
+    char** atlasFrame = costumes->costumes[1];
+    r |= assertEquals(Sprite_setChar(sprite, 0, 0, 'X'), 1);
+    r |= assertFalse(Sprite_isShared(sprite));
+    r |= assertFalse(costumes->costumes[1] == atlasFrame);
+    r |= assertPointersMatch(sprite->data, costumes->costumes[1]);
+    r |= assertEquals(costumes->costumes[1][0][0], 'X');
+    r |= assertEquals(atlasFrame[0][0], '@');
+    r |= assertEquals(Sprite_getCurrentCostumeIndex(sprite), 1);
+
+    r |= assertEquals(Sprite_switchCostumeTo(sprite, 0), 0);
+    r |= assertTrue(Sprite_isShared(sprite));
+    r |= assertEquals(sprite->data[1][1], '#');
+    r |= assertEquals(Sprite_switchCostumeTo(sprite, 1), 0);
+    r |= assertFalse(Sprite_isShared(sprite));
+    r |= assertEquals(sprite->data[0][0], 'X');
+
+    Sprite_free(sprite);
+
+    // the sprite keeps its atlas frame after the costumes are freed
+    CmdFX_Sprite* sprite2 =
+        Sprite_create(Char2DBuilder_createFilled(2, 2, '#'), 0, 0);
+    r |= assertNotNull(Sprite_createCostumeAtlas(sprite2, frames, 0, 2));
+    r |= assertEquals(Sprite_switchCostumeTo(sprite2, 2), 0);
+    r |= assertEquals(Sprite_freeCostumes(sprite2), 0);
+    r |= assertCharArraysMatch(sprite2->data, frame2);
+    Sprite_free(sprite2);
+
+    for (int i = 0; i < 2; i++) free(frame1[i]);
+    free(frame1);
+    for (int i = 0; i < 4; i++) {
+        free(frame2[i]);
+        for (int j = 0; j < 3; j++) free(ansi2[i][j]);
+        free(ansi2[i]);
+    }
+    free(frame2);
+    free(ansi2);
+
+    return r;
+}
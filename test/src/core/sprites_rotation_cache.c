@@ -0,0 +1,114 @@
+#include <stdlib.h>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include "../test.h"
+#include "cmdfx/core/builder.h"
+#include "cmdfx/core/costumes.h"
+#include "cmdfx/core/sprites.h"
+#include "cmdfx/core/util.h"
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+static void bake(void* arg) {
+    CmdFX_Sprite* sprite = (CmdFX_Sprite*) arg;
+    for (int i = 0; i < 500; i++) Sprite_bakeRotationCache(sprite);
+}
+
+int main() {
+    int r = 0;
+
+    char** data = Char2DBuilder_create(3, 3);
+    const char* rows[] = {"abc", "def", "ghi"};
+    for (int y = 0; y < 3; y++)
+        for (int x = 0; x < 3; x++) data[y][x] = rows[y][x];
+
+    CmdFX_Sprite* sprite =
+        Sprite_create(data, String2DBuilder_createFilled(3, 3, "\033[31m"), 0);
+
+    r |= assertEquals(Sprite_setRotation(sprite, 0), -1);
+    r |= assertEquals(Sprite_getRotationSteps(sprite), 0);
+    r |= assertEquals(Sprite_createRotationCache(sprite, 0), -1);
+
+    // Frame Swaps
+    r |= assertEquals(Sprite_createRotationCache(sprite, 4), 0);
+    r |= assertEquals(Sprite_getRotationSteps(sprite), 4);
+    r |= assertTrue(Sprite_isShared(sprite));
+    r |= assertStringsMatch(sprite->data[0], "abc");
+
+    r |= assertEquals(Sprite_setRotation(sprite, M_PI / 2), 1);
+    r |= assertStringsMatch(sprite->data[0], "gda");
+    r |= assertStringsMatch(sprite->data[2], "ifc");
+    r |= assertStringsMatch(sprite->ansi[1][1], "\033[31m");
+
+    // angles are absolute, so repeated calls don't accumulate
+    char** quarter = sprite->data;
+    r |= assertEquals(Sprite_setRotation(sprite, M_PI / 2), 1);
+    r |= assertPointersMatch(sprite->data, quarter);
+
+    // angles snap to the nearest step and wrap around
+    r |= assertEquals(Sprite_setRotation(sprite, 2 * M_PI + 0.1), 0);
+    r |= assertStringsMatch(sprite->data[0], "abc");
+    r |= assertEquals(Sprite_setRotation(sprite, -M_PI / 2), 3);
+    r |= assertStringsMatch(sprite->data[0], "cfi");
+
+    // only the unrotated and used frames were computed so far
+    r |= assertEquals(Sprite_bakeRotationCache(sprite), 1);
+    r |= assertEquals(Sprite_bakeRotationCache(sprite), 0);
+    r |= assertEquals(Sprite_setRotation(sprite, M_PI), 2);
+    r |= assertStringsMatch(sprite->data[0], "ihg");
+
+    // Copy-on-Write
+    r |= assertEquals(Sprite_setChar(sprite, 0, 0, 'X'), 1);
+    r |= assertFalse(Sprite_isShared(sprite));
+    r |= assertStringsMatch(sprite->data[0], "Xhg");
+
+    // the cached frames are untouched, and the edited copy is released
+    r |= assertEquals(Sprite_setRotation(sprite, M_PI), 2);
+    r |= assertStringsMatch(sprite->data[0], "ihg");
+
+    // the new cache snapshots the frame the sprite is showing
+    r |= assertEquals(Sprite_createRotationCache(sprite, 2), 0);
+    r |= assertEquals(Sprite_getRotationSteps(sprite), 2);
+    r |= assertEquals(Sprite_setRotation(sprite, M_PI), 1);
+    r |= assertStringsMatch(sprite->data[0], "abc");
+
+    // freeing the cache leaves the sprite with its own copy
+    r |= assertEquals(Sprite_freeRotationCache(sprite), 0);
+    r |= assertEquals(Sprite_freeRotationCache(sprite), -1);
+    r |= assertFalse(Sprite_isShared(sprite));
+    r |= assertStringsMatch(sprite->data[2], "ghi");
+    r |= assertStringsMatch(sprite->ansi[2][2], "\033[31m");
+
+    Sprite_free(sprite);
+
+    // Costumes
+    CmdFX_Sprite* costumed = Sprite_createFilled(4, 2, '#', 0, 0);
+    r |= assertNotNull(Sprite_createCostumes(costumed, 2));
+    r |= assertEquals(Sprite_createRotationCache(costumed, 8), 0);
+    r |= assertEquals(Sprite_setRotation(costumed, M_PI / 4), 1);
+    r |= assertEquals(Sprite_switchCostumeTo(costumed, 0), 0);
+    r |= assertFalse(Sprite_isShared(costumed));
+    r |= assertEquals(Sprite_setRotation(costumed, 0), 0);
+    r |= assertStringsMatch(costumed->data[1], "####");
+
+    Sprite_free(costumed);
+
+    // a cache replaced while another thread bakes it lives until the bake ends
+    CmdFX_initThreadSafe();
+    CmdFX_Sprite* spun = Sprite_createFilled(8, 4, '#', 0, 0);
+    r |= assertEquals(Sprite_createRotationCache(spun, 64), 0);
+
+    ThreadID thread = CmdFX_launchThread(bake, spun);
+    for (int i = 0; i < 500; i++)
+        r |= assertEquals(Sprite_createRotationCache(spun, 64), 0);
+    CmdFX_joinThread(thread);
+
+    Sprite_free(spun);
+    CmdFX_destroyThreadSafe();
+
+    return r;
+}
@@ -0,0 +1,50 @@
+#include "../test.h"
+#include "cmdfx/core/sprites.h"
+
+int main() {
+    int r = 0;
+
+    CmdFX_SpriteTemplate* bullet = SpriteTemplate_createFilled(2, 1, '=', 0);
+    r |= assertNotNull(bullet);
+    r |= assertEquals(bullet->width, 2);
+    r |= assertEquals(bullet->height, 1);
+
+    // instances share the template's data
+    CmdFX_Sprite* a = SpriteTemplate_instantiate(bullet, 1);
+    CmdFX_Sprite* b = SpriteTemplate_instantiate(bullet, 2);
+    r |= assertNotNull(a);
+    r |= assertNotNull(b);
+    r |= assertFalse(a->uid == b->uid);
+    r |= assertPointersMatch(a->data, bullet->data);
+    r |= assertPointersMatch(b->ansi, bullet->ansi);
+    r |= assertEquals(a->width, 2);
+    r |= assertEquals(b->z, 2);
+    r |= assertTrue(Sprite_isShared(a));
+
+    // modified instances copy the data first
+    r |= assertEquals(Sprite_setChar(a, 0, 0, '-'), 1);
+    r |= assertFalse(Sprite_isShared(a));
+    r |= assertEquals(a->data[0][0], '-');
+    r |= assertEquals(bullet->data[0][0], '=');
+    r |= assertEquals(b->data[0][0], '=');
+
+    r |= assertEquals(Sprite_setAnsi(b, 0, 0, "\033[33m"), 1);
+    r |= assertFalse(Sprite_isShared(b));
+    r |= assertStringsMatch(b->ansi[0][0], "\033[33m");
+    r |= assertNull(bullet->ansi[0][0]);
+
+    // instances outlive the template
+    CmdFX_Sprite* c = SpriteTemplate_instantiate(bullet, 0);
+    SpriteTemplate_free(bullet);
+    r |= assertEquals(c->data[0][1], '=');
+    r |= assertTrue(Sprite_isShared(c));
+
+    Sprite_free(a);
+    Sprite_free(b);
+    Sprite_free(c);
+
+    r |= assertNull(SpriteTemplate_create(0, 0));
+    r |= assertFalse(Sprite_isShared(0));
+
+    return r;
+}
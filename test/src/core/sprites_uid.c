@@ -45,5 +45,15 @@ int main() {
     Sprite_free(sprite8);
     Sprite_free(sprite9);
 
+    // freeing many sprites shrinks the taken list without losing its tail
+    CmdFX_Sprite* many[64];
+    for (int i = 0; i < 64; i++) many[i] = Sprite_create(0, 0, 0);
+    for (int i = 0; i < 64; i += 2) Sprite_free(many[i]);
+    for (int i = 1; i < 64; i += 2) Sprite_free(many[i]);
+
+    CmdFX_Sprite* sprite10 = Sprite_create(0, 0, 0);
+    r |= assertEquals(sprite10->uid, 1);
+    Sprite_free(sprite10);
+
     return r;
 }
\ No newline at end of file
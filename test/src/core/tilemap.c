@@ -0,0 +1,81 @@
+#include <stdio.h>
+
+#include "../test.h"
+#include "cmdfx/core/tilemap.h"
+
+#define WORLD_WIDTH 200
+#define WORLD_HEIGHT 150
+
+static char tileAt(int x, int y) {
+    return (char) ('a' + ((x * 7 + y * 3) % 26));
+}
+
+int main() {
+    int r = 0;
+
+    const char* path = "tilemap_test.txt";
+    FILE* file = fopen(path, "wb");
+    if (file == 0) return 1;
+
+    for (int y = 0; y < WORLD_HEIGHT; y++) {
+        for (int x = 0; x < WORLD_WIDTH; x++) fputc(tileAt(x, y), file);
+        fputc('\n', file);
+    }
+    fclose(file);
+
+    r |= assertPointersMatch(TileMap_loadFromFile("missing.txt", 10, 5), 0);
+
+    CmdFX_TileMap* map = TileMap_loadFromFile(path, 40, 20);
+    r |= assertNotNull(map);
+    r |= assertEquals(map->width, WORLD_WIDTH);
+    r |= assertEquals(map->height, WORLD_HEIGHT);
+    r |= assertEquals(map->scene->data[0][0], tileAt(0, 0));
+    r |= assertEquals(map->scene->data[19][39], tileAt(39, 19));
+
+    // only the chunks around the viewport are loaded
+    r |= assertEquals(map->chunkCount, 3 * 2);
+
+    r |= assertEquals(TileMap_setCamera(map, 100, 90), 0);
+    r |= assertEquals(map->scene->data[0][0], tileAt(100, 90));
+    r |= assertEquals(map->scene->data[7][31], tileAt(131, 97));
+    r |= assertEquals(map->chunkCount, 4 * 4);
+
+    for (int i = 0; i < map->chunkCount; i++) {
+        CmdFX_TileChunk* chunk = map->chunks[i];
+        r |= assertTrue(chunk->x >= 2 && chunk->x <= 5);
+        r |= assertTrue(chunk->y >= 1 && chunk->y <= 4);
+    }
+
+    // tiles outside of the world are blank
+    r |= assertEquals(TileMap_moveCamera(map, 90, 0), 0);
+    r |= assertEquals(map->scene->data[0][0], tileAt(190, 90));
+    r |= assertEquals(map->scene->data[0][10], ' ');
+
+    // tiles are read from the file when their chunk is not loaded
+    r |= assertEquals(TileMap_getTile(map, 3, 4), tileAt(3, 4));
+    r |= assertEquals(TileMap_getTile(map, 195, 95), tileAt(195, 95));
+    r |= assertEquals(TileMap_getTile(map, WORLD_WIDTH, 0), 0);
+
+    char tile = tileAt(190, 90);
+    r |= assertEquals(TileMap_setTileAnsi(map, tile, "\033[31m"), 0);
+    r |= assertStringsMatch(map->scene->ansiData[0][0], "\033[31m");
+    r |= assertTrue(
+        map->scene->ansiData[0][0] != map->palette[(unsigned char) tile]
+    );
+    r |= assertEquals(TileMap_setTileAnsi(map, tile, 0), 0);
+    r |= assertPointersMatch(map->scene->ansiData[0][0], 0);
+
+    // the viewport owns its cells, so scene setters may replace them
+    r |= assertEquals(TileMap_setTileAnsi(map, tile, "\033[32m"), 0);
+    r |= assertEquals(Scene_setForegroundAll(map->scene, 0xFF0000), 0);
+    r |= assertStringsMatch(map->scene->ansiData[0][0], "\033[38;2;255;0;0m");
+
+    r |= assertEquals(TileMap_draw(map, 0, 0), 0);
+    r |= assertEquals(TileMap_moveCamera(map, -5, -5), 0);
+    r |= assertEquals(TileMap_remove(map), 0);
+
+    TileMap_free(map);
+    remove(path);
+
+    return r;
+}
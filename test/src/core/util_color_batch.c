@@ -0,0 +1,66 @@
+#include <stdio.h>
+
+#include "../test.h"
+#include "cmdfx/core/util.h"
+
+int main() {
+    int r = 0;
+
+    // batches give the same colors as the scalar functions
+    int colors[200];
+    for (int i = 0; i < 200; i++)
+        colors[i] = (i * 0x0A3F17 + 0x123456) & 0xFFFFFF;
+    colors[0] = 0x000000;
+    colors[1] = 0xFFFFFF;
+    colors[2] = 0x808080;
+
+    double h[200], s[200], v[200];
+    int back[200];
+    rgb_to_hsv_batch(colors, h, s, v, 200);
+    hsv_to_rgb_batch(h, s, v, back, 200);
+
+    int mismatches = 0;
+    for (int i = 0; i < 200; i++) {
+        double h0, s0, v0;
+        rgb_to_hsv(colors[i], &h0, &s0, &v0);
+        if (h0 != h[i] || s0 != s[i] || v0 != v[i]) mismatches++;
+        if (back[i] != hsv_to_rgb(h[i], s[i], v[i])) mismatches++;
+    }
+    r |= assertEquals(mismatches, 0);
+
+    // hues outside one turn wrap like hsv_to_rgb
+    double wrapH[3] = {-120, 360, 720 + 60};
+    double full[3] = {1, 1, 1};
+    int wrapped[3];
+    hsv_to_rgb_batch(wrapH, full, full, wrapped, 3);
+    r |= assertEquals(wrapped[0], 0x0000FF);
+    r |= assertEquals(wrapped[1], 0xFF0000);
+    r |= assertEquals(wrapped[2], hsv_to_rgb(60, 1, 1));
+
+    // every sector, and saturations at or below zero, match hsv_to_rgb
+    double hues[8] = {0, 59.5, 60, 150, 222, 299.9, 330, -0.0};
+    double sats[8] = {0.5, 1, 0.25, -1, 0.75, 0, -0.0, 0.5};
+    double vals[8] = {1, 0.5, 0.8, 0.3, 1, 0.9, 0.6, 0.4};
+    int sectors[8];
+    hsv_to_rgb_batch(hues, sats, vals, sectors, 8);
+
+    mismatches = 0;
+    for (int i = 0; i < 8; i++)
+        if (sectors[i] != hsv_to_rgb(hues[i], sats[i], vals[i])) mismatches++;
+    r |= assertEquals(mismatches, 0);
+
+    // interpolation across more than one chunk
+    double t[150];
+    int lerped[150];
+    for (int i = 0; i < 150; i++) t[i] = i / 149.0;
+    lerp_color_batch(0xFF0000, 0x00FF00, t, lerped, 150);
+
+    mismatches = 0;
+    for (int i = 0; i < 150; i++)
+        if (lerped[i] != lerp_color(0xFF0000, 0x00FF00, t[i])) mismatches++;
+    r |= assertEquals(mismatches, 0);
+    r |= assertEquals(lerped[0], 0xFF0000);
+    r |= assertEquals(lerped[149], 0x00FF00);
+
+    return r;
+}
@@ -0,0 +1,74 @@
+#include <stdlib.h>
+
+#include "../test.h"
+#include "cmdfx/core/sprites.h"
+#include "cmdfx/core/util.h"
+#include "cmdfx/physics/engine.h"
+
+static int isOrdered(CmdFX_StageStats* stage) {
+    return stage->p50 <= stage->p95 && stage->p95 <= stage->p99 &&
+           stage->p99 <= stage->max && stage->mean <= stage->max;
+}
+
+int main() {
+    int r = 0;
+    CmdFX_FrameStats stats;
+
+    r |= assertEquals(CmdFX_getFrameStats(0), -1);
+    r |= assertStringsMatch(
+        CmdFX_getFrameStageName(CMDFX_FRAME_STAGE_ENGINE_TICK),
+        "engine_tick"
+    );
+    r |= assertStringsMatch(
+        CmdFX_getFrameStageName(CMDFX_FRAME_STAGE_FLUSH), "flush"
+    );
+    r |= assertNull((void*) CmdFX_getFrameStageName(CMDFX_FRAME_STAGE_COUNT));
+
+    CmdFX_Sprite* sprite = Sprite_createFilled(3, 3, '#', 0, 0);
+    Sprite_draw(1, 1, sprite);
+
+    // nothing is timed until enabled
+    r |= assertFalse(CmdFX_isFrameStatsEnabled());
+    free(Engine_tick());
+    r |= assertEquals(CmdFX_getFrameStats(&stats), 0);
+    r |= assertEquals(stats.stages[CMDFX_FRAME_STAGE_ENGINE_TICK].count, 0);
+
+    CmdFX_setFrameStatsEnabled(1);
+    r |= assertTrue(CmdFX_isFrameStatsEnabled());
+    for (int i = 0; i < 10; i++) free(Engine_tick());
+
+    r |= assertEquals(CmdFX_getFrameStats(&stats), 0);
+    CmdFX_StageStats* tick = &stats.stages[CMDFX_FRAME_STAGE_ENGINE_TICK];
+    r |= assertEquals(tick->count, 10);
+    r |= assertEquals(tick->samples, 10);
+    r |= assertTrue(isOrdered(tick));
+    r |= assertEquals(stats.stages[CMDFX_FRAME_STAGE_SCENE_TICK].count, 0);
+
+    // the summary covers the latest samples only
+    for (int i = 0; i < CMDFX_FRAME_STATS_SAMPLES + 500; i++)
+        free(Engine_tick());
+    r |= assertEquals(CmdFX_getFrameStats(&stats), 0);
+    r |= assertEquals(tick->count, CMDFX_FRAME_STATS_SAMPLES + 510);
+    r |= assertEquals(tick->samples, CMDFX_FRAME_STATS_SAMPLES);
+    r |= assertTrue(isOrdered(tick));
+
+    CmdFX_resetFrameStats();
+    r |= assertEquals(CmdFX_getFrameStats(&stats), 0);
+    r |= assertEquals(tick->count, 0);
+    r |= assertDoubleEquals(tick->max, 0);
+
+    // the physics thread times both of its stages
+    Engine_start();
+    sleepMillis(300);
+    Engine_end();
+
+    r |= assertEquals(CmdFX_getFrameStats(&stats), 0);
+    r |= assertGreaterThan(tick->count, 0);
+    r |= assertGreaterThan(
+        stats.stages[CMDFX_FRAME_STAGE_APPLY_MOTION].count, 0
+    );
+
+    CmdFX_setFrameStatsEnabled(0);
+    Sprite_free(sprite);
+    return r;
+}
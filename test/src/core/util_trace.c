@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../test.h"
+#include "cmdfx/core/events.h"
+#include "cmdfx/core/sprites.h"
+#include "cmdfx/core/util.h"
+#include "cmdfx/physics/engine.h"
+
+#define PATH "trace.json"
+#define MUTEX 20
+
+// internal; the trace buffers threads record into, and thread names
+extern int CmdFX_trace_countBuffers();
+extern void CmdFX_trace_nameThread(const char* name);
+
+static int listener(CmdFX_Event* event) {
+    (void) event;
+    return 0;
+}
+
+static void contend(void* arg) {
+    (void) arg;
+    CmdFX_tryLockMutex(MUTEX);
+    CmdFX_tryUnlockMutex(MUTEX);
+}
+
+static void tick(void* arg) {
+    if (arg != 0) CmdFX_trace_nameThread((const char*) arg);
+    free(Engine_tick());
+}
+
+static void runThreads(int count, const char* name) {
+    for (int i = 0; i < count; i++) {
+        ThreadID thread = CmdFX_launchThread(tick, (void*) name);
+        CmdFX_joinThread(thread);
+    }
+}
+
+static char* readAll(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == 0) return 0;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* text = calloc(size + 1, 1);
+    if (text != 0) fread(text, 1, size, file);
+    fclose(file);
+    return text;
+}
+
+static int assertContains(const char* text, const char* part) {
+    return assertTrue(text != 0 && strstr(text, part) != 0);
+}
+
+int main() {
+    int r = 0;
+
+    r |= assertEquals(CmdFX_startTrace(0), -1);
+    r |= assertEquals(CmdFX_stopTrace(), -1);
+    r |= assertFalse(CmdFX_isTracing());
+
+    CmdFX_Sprite* sprite = Sprite_createFilled(3, 3, '#', 0, 0);
+    Sprite_draw(1, 1, sprite);
+    addCmdFXEventListener(1000, listener);
+
+    r |= assertEquals(CmdFX_startTrace(PATH), 0);
+    r |= assertTrue(CmdFX_isTracing());
+    r |= assertEquals(CmdFX_startTrace(PATH), -1);
+
+    free(Engine_tick());
+
+    CmdFX_Event event = {1000, 0, 0};
+    free((void*) dispatchCmdFXEvent(&event));
+
+    Engine_start();
+    sleepMillis(100);
+    Engine_end();
+
+    // hold the mutex long enough that the other thread waits on it
+    CmdFX_initThreadSafe();
+    CmdFX_tryLockMutex(MUTEX);
+    ThreadID thread = CmdFX_launchThread(contend, 0);
+    sleepMillis(20);
+    CmdFX_tryUnlockMutex(MUTEX);
+    CmdFX_joinThread(thread);
+
+    r |= assertEquals(CmdFX_stopTrace(), 0);
+    r |= assertFalse(CmdFX_isTracing());
+    r |= assertEquals(CmdFX_stopTrace(), -1);
+
+    char* text = readAll(PATH);
+    r |= assertContains(text, "{\"traceEvents\":[");
+    r |= assertContains(text, "\"name\":\"Engine_tick\"");
+    r |= assertContains(text, "\"name\":\"physics_tick\"");
+    r |= assertContains(text, "\"name\":\"dispatch\"");
+    r |= assertContains(text, "\"name\":\"listener\"");
+    r |= assertContains(text, "\"args\":{\"event\":1000}");
+    r |= assertContains(text, "\"args\":{\"name\":\"physics\"}");
+    r |= assertContains(text, "\"args\":{\"mutex\":20}");
+    r |= assertContains(text, "\"droppedEvents\":\"0\"");
+    free(text);
+
+    // a second trace starts empty
+    r |= assertEquals(CmdFX_startTrace(PATH), 0);
+    r |= assertEquals(CmdFX_stopTrace(), 0);
+    text = readAll(PATH);
+    r |= assertTrue(text != 0 && strstr(text, "Engine_tick") == 0);
+    free(text);
+
+    // exited threads hand their buffers on once their events are written
+    r |= assertEquals(CmdFX_startTrace(PATH), 0);
+    runThreads(8, 0);
+    r |= assertEquals(CmdFX_stopTrace(), 0);
+    int buffers = CmdFX_trace_countBuffers();
+
+    r |= assertEquals(CmdFX_startTrace(PATH), 0);
+    runThreads(8, 0);
+    r |= assertEquals(CmdFX_stopTrace(), 0);
+    r |= assertEquals(CmdFX_trace_countBuffers(), buffers);
+
+    // a restarted thread of the same name keeps its buffer within a trace
+    r |= assertEquals(CmdFX_startTrace(PATH), 0);
+    runThreads(8, 0);
+    runThreads(8, "worker");
+    r |= assertEquals(CmdFX_stopTrace(), 0);
+    r |= assertTrue(CmdFX_trace_countBuffers() <= buffers + 1);
+
+    text = readAll(PATH);
+    r |= assertContains(text, "\"args\":{\"name\":\"worker\"}");
+    free(text);
+
+    remove(PATH);
+    CmdFX_destroyThreadSafe();
+    Sprite_free(sprite);
+    return r;
+}
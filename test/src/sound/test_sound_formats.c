@@ -0,0 +1,203 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "../test.h"
+#include "cmdfx/sound/sound.h"
+
+#define PATH "formats.wav"
+
+static void putU16(unsigned char* p, unsigned int value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+}
+
+static void putU32(unsigned char* p, unsigned long value) {
+    putU16(p, value & 0xFFFF);
+    putU16(p + 2, (value >> 16) & 0xFFFF);
+}
+
+// align is the size of a block of compressed data, or 0 for a frame
+static int writeWave(
+    int format, int channels, int bits, int align, int rate, const void* data,
+    int size
+) {
+    FILE* file = fopen(PATH, "wb");
+    if (!file) return -1;
+
+    int frameSize = align ? align : channels * bits / 8;
+    unsigned char header[44];
+    memcpy(header, "RIFF", 4);
+    putU32(header + 4, 36 + size);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    putU32(header + 16, 16);
+    putU16(header + 20, format);
+    putU16(header + 22, channels);
+    putU32(header + 24, rate);
+    putU32(header + 28, rate * frameSize);
+    putU16(header + 32, frameSize);
+    putU16(header + 34, bits);
+    memcpy(header + 36, "data", 4);
+    putU32(header + 40, size);
+
+    fwrite(header, 1, sizeof(header), file);
+    fwrite(data, 1, size, file);
+    fclose(file);
+    return 0;
+}
+
+// plays the file once on the memory sink and reads back what it mixed to
+static int render(short* out, int frames) {
+    int handle = Sound_load(PATH);
+    if (handle < 1) return -1;
+
+    Sound_playHandle(handle);
+    Sound_renderSink(frames);
+    int read = Sound_readSink(out, frames);
+
+    Sound_unload(handle);
+    remove(PATH);
+    return read;
+}
+
+int main() {
+    int r = 0;
+    short out[64];
+
+    r |= assertEquals(Sound_setSink(CMDFX_SOUND_SINK_MEMORY, NULL, 0), 0);
+
+    // 8-bit data is unsigned; mono plays on both sides
+    unsigned char pcm8[] = {0x80, 0x81, 0x7F, 0xFF};
+    writeWave(1, 1, 8, 0, 44100, pcm8, sizeof(pcm8));
+    r |= assertEquals(render(out, 4), 4);
+    r |= assertEquals(out[0], 0);
+    r |= assertEquals(out[2], 256);
+    r |= assertEquals(out[4], -256);
+    r |= assertEquals(out[6], 127 * 256);
+    r |= assertEquals(out[7], 127 * 256);
+
+    // 16-bit stereo keeps both sides
+    unsigned char pcm16[8];
+    putU16(pcm16, 1000);
+    putU16(pcm16 + 2, (unsigned short) -2000);
+    putU16(pcm16 + 4, 32767);
+    putU16(pcm16 + 6, (unsigned short) -32768);
+    writeWave(1, 2, 16, 0, 44100, pcm16, sizeof(pcm16));
+    r |= assertEquals(render(out, 2), 2);
+    r |= assertEquals(out[0], 1000);
+    r |= assertEquals(out[1], -2000);
+    r |= assertEquals(out[2], 32767);
+    r |= assertEquals(out[3], -32768);
+
+    // 24- and 32-bit data keep their top 16 bits
+    unsigned char pcm24[] = {0xAB, 0x34, 0x12};
+    writeWave(1, 1, 24, 0, 44100, pcm24, sizeof(pcm24));
+    r |= assertEquals(render(out, 1), 1);
+    r |= assertEquals(out[0], 0x1234);
+
+    unsigned char pcm32[] = {0xFF, 0xFF, 0x00, 0x80};
+    writeWave(1, 1, 32, 0, 44100, pcm32, sizeof(pcm32));
+    r |= assertEquals(render(out, 1), 1);
+    r |= assertEquals(out[0], -32768);
+
+    // float data is scaled to 16 bits and clipped
+    float floats[] = {0.5f, -1.0f, 2.0f};
+    writeWave(3, 1, 32, 0, 44100, floats, sizeof(floats));
+    r |= assertEquals(render(out, 3), 3);
+    r |= assertEquals(out[0], 16383);
+    r |= assertEquals(out[2], -32767);
+    r |= assertEquals(out[4], 32767);
+
+    // other rates are resampled, so a 22050 Hz sound lasts twice as long
+    unsigned char slow[32];
+    for (int i = 0; i < 16; i++) putU16(slow + i * 2, 500);
+    writeWave(1, 1, 16, 0, 22050, slow, sizeof(slow));
+    r |= assertEquals(render(out, 32), 32);
+    r |= assertEquals(out[0], 500);
+    r |= assertEquals(out[40], 500);
+    r |= assertEquals(out[62], 500);
+
+    // IMA ADPCM is decoded a block at a time; the last block may be short
+    unsigned char pattern[32];
+    for (int i = 0; i < 32; i++) pattern[i] = i % 2 ? 0x0F : 0x07;
+
+    unsigned char mono[80];
+    putU16(mono, 1000);
+    mono[2] = 0;
+    mono[3] = 0;
+    memcpy(mono + 4, pattern, 32);
+    putU16(mono + 36, (unsigned short) -2000);
+    mono[38] = 10;
+    mono[39] = 0;
+    memcpy(mono + 40, pattern, 32);
+    putU16(mono + 72, 300);
+    mono[74] = 0;
+    mono[75] = 0;
+    memcpy(mono + 76, pattern, 4);
+
+    short adpcm[139 * 2];
+    writeWave(0x11, 1, 4, 36, 44100, mono, sizeof(mono));
+    r |= assertEquals(render(adpcm, 139), 139);
+    r |= assertEquals(adpcm[0], 1000);
+    r |= assertEquals(adpcm[1], 1000);
+    r |= assertEquals(adpcm[2], 1011);
+    r |= assertEquals(adpcm[4], 1013);
+    r |= assertEquals(adpcm[6], 988);
+    r |= assertEquals(adpcm[126], -23096);
+    r |= assertEquals(adpcm[128], -19001);
+    r |= assertEquals(adpcm[130], -2000);
+    r |= assertEquals(adpcm[132], -1966);
+    r |= assertEquals(adpcm[258], -19001);
+    r |= assertEquals(adpcm[260], 300);
+    r |= assertEquals(adpcm[262], 311);
+    r |= assertEquals(adpcm[276], 263);
+
+    // resampling reaches into the next block instead of holding the last
+    // frame of this one
+    writeWave(0x11, 1, 4, 36, 22050, mono, sizeof(mono));
+    r |= assertEquals(render(adpcm, 131), 131);
+    r |= assertEquals(adpcm[128 * 2], -19001);
+    r |= assertEquals(adpcm[129 * 2], -10500);
+    r |= assertEquals(adpcm[130 * 2], -2000);
+
+    // stereo blocks interleave 4 bytes of each channel
+    unsigned char stereo[40];
+    putU16(stereo, 500);
+    stereo[2] = 0;
+    stereo[3] = 0;
+    putU16(stereo + 4, (unsigned short) -500);
+    stereo[6] = 20;
+    stereo[7] = 0;
+    for (int i = 0; i < 32; i++)
+        stereo[8 + i] = i % 8 < 4 ? pattern[i % 2] : pattern[i % 2] << 4;
+
+    writeWave(0x11, 2, 4, 40, 44100, stereo, sizeof(stereo));
+    r |= assertEquals(render(adpcm, 33), 33);
+    r |= assertEquals(adpcm[0], 500);
+    r |= assertEquals(adpcm[1], -500);
+    r |= assertEquals(adpcm[2], 511);
+    r |= assertEquals(adpcm[3], -494);
+    r |= assertEquals(adpcm[18], 662);
+    r |= assertEquals(adpcm[19], -713);
+    r |= assertEquals(adpcm[64], -19001);
+    r |= assertEquals(adpcm[65], -23096);
+
+    // compressed sounds are kept in memory even when streamed
+    writeWave(0x11, 2, 4, 40, 44100, stereo, sizeof(stereo));
+    int streamed = Sound_loadStreamed(PATH);
+    r |= assertGreaterThan(streamed, 0);
+    r |= assertEquals(Sound_playHandle(streamed), 0);
+    Sound_renderSink(2);
+    r |= assertEquals(Sound_readSink(out, 2), 2);
+    r |= assertEquals(out[2], 511);
+    Sound_unload(streamed);
+    remove(PATH);
+
+    // anything else is rejected
+    unsigned char mp3[] = {0, 0, 0, 0};
+    writeWave(0x55, 1, 16, 0, 44100, mp3, sizeof(mp3));
+    r |= assertTrue(Sound_load(PATH) < 1);
+    remove(PATH);
+
+    Sound_cleanup();
+    return r;
+}
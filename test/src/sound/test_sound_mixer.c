@@ -0,0 +1,142 @@
+#include <stdio.h>
+
+#include "../test.h"
+#include "cmdfx/sound/sound.h"
+
+#define FRAMES 4000
+
+static void writeU16(FILE* file, unsigned int value) {
+    fputc(value & 0xFF, file);
+    fputc((value >> 8) & 0xFF, file);
+}
+
+static void writeU32(FILE* file, unsigned long value) {
+    writeU16(file, value & 0xFFFF);
+    writeU16(file, (value >> 16) & 0xFFFF);
+}
+
+// a mono 16-bit sound holding one level at the mixer rate, so every frame
+// of the mix is the sum of the voices' levels at their gains
+static int writeLevel(const char* path, short level) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return -1;
+
+    fwrite("RIFF", 1, 4, file);
+    writeU32(file, 36 + FRAMES * 2);
+    fwrite("WAVEfmt ", 1, 8, file);
+    writeU32(file, 16);
+    writeU16(file, 1);
+    writeU16(file, 1);
+    writeU32(file, 44100);
+    writeU32(file, 44100 * 2);
+    writeU16(file, 2);
+    writeU16(file, 16);
+    fwrite("data", 1, 4, file);
+    writeU32(file, FRAMES * 2);
+
+    for (int i = 0; i < FRAMES; i++) writeU16(file, (unsigned short) level);
+
+    fclose(file);
+    return 0;
+}
+
+// renders a few frames and checks that each of them holds the levels
+static int assertMix(short left, short right) {
+    short out[16 * 2];
+    Sound_renderSink(16);
+    Sound_readSink(out, 16);
+
+    int r = 0;
+    for (int i = 0; i < 16; i++) {
+        r |= assertEquals(out[i * 2], left);
+        r |= assertEquals(out[i * 2 + 1], right);
+    }
+
+    return r;
+}
+
+int main() {
+    int r = 0;
+
+    r |= assertEquals(writeLevel("mixer_a.wav", 1000), 0);
+    r |= assertEquals(writeLevel("mixer_b.wav", 2000), 0);
+    r |= assertEquals(writeLevel("mixer_c.wav", 4000), 0);
+
+    r |= assertEquals(Sound_setSink(CMDFX_SOUND_SINK_MEMORY, NULL, 0), 0);
+    int a = Sound_load("mixer_a.wav");
+    int b = Sound_load("mixer_b.wav");
+    int c = Sound_load("mixer_c.wav");
+    r |= assertGreaterThan(a, 0);
+    r |= assertGreaterThan(b, 0);
+    r |= assertGreaterThan(c, 0);
+
+    // Gain and Balance
+    r |= assertEquals(Sound_playHandleLooped(a, -1), 0);
+    r |= assertMix(1000, 1000);
+
+    r |= assertEquals(Sound_setVolume("mixer_a.wav", 0.5), 0);
+    r |= assertMix(500, 500);
+
+    r |= assertEquals(Sound_setPan("mixer_a.wav", 1), 0);
+    r |= assertMix(0, 500);
+
+    r |= assertEquals(Sound_setPan("mixer_a.wav", -0.5), 0);
+    r |= assertMix(500, 250);
+
+    r |= assertTrue(Sound_setPan("mixer_a.wav", 1.5) != 0);
+    r |= assertTrue(Sound_setVolume("mixer_a.wav", -0.5) != 0);
+
+    r |= assertEquals(Sound_setVolumeAll(0.5), 0);
+    r |= assertMix(250, 125);
+
+    Sound_setVolumeAll(1);
+    Sound_setVolume("mixer_a.wav", 1);
+    Sound_setPan("mixer_a.wav", 0);
+    Sound_stopAll();
+    r |= assertMix(0, 0);
+
+    // Voice Limit
+    r |= assertTrue(Sound_setVoiceLimit(0) != 0);
+    r |= assertTrue(Sound_setVoiceLimit(65) != 0);
+    r |= assertEquals(Sound_setVoiceLimit(2), 0);
+    r |= assertEquals(Sound_getVoiceLimit(), 2);
+
+    // the oldest of equally loud voices is stolen
+    Sound_playHandleLooped(a, -1);
+    Sound_playHandleLooped(b, -1);
+    r |= assertEquals(Sound_getActiveVoices(), 2);
+    r |= assertMix(3000, 3000);
+
+    r |= assertEquals(Sound_playHandleLooped(c, -1), 0);
+    r |= assertEquals(Sound_getActiveVoices(), 2);
+    r |= assertFalse(Sound_isPlaying("mixer_a.wav"));
+    r |= assertMix(6000, 6000);
+    Sound_stopAll();
+
+    // the quietest voice is stolen before an older, louder one
+    Sound_setVolume("mixer_b.wav", 0.25);
+    Sound_playHandleLooped(a, -1);
+    Sound_playHandleLooped(b, -1);
+    r |= assertMix(1500, 1500);
+
+    Sound_playHandleLooped(c, -1);
+    r |= assertTrue(Sound_isPlaying("mixer_a.wav"));
+    r |= assertFalse(Sound_isPlaying("mixer_b.wav"));
+    r |= assertMix(5000, 5000);
+
+    // lowering the limit keeps the voices that are playing
+    r |= assertEquals(Sound_setVoiceLimit(1), 0);
+    r |= assertEquals(Sound_getActiveVoices(), 2);
+    Sound_playHandleLooped(b, -1);
+    r |= assertEquals(Sound_getActiveVoices(), 2);
+    r |= assertMix(4500, 4500);
+
+    Sound_setVoiceLimit(32);
+    Sound_cleanup();
+    Sound_setSink(CMDFX_SOUND_SINK_DEVICE, NULL, 0);
+    remove("mixer_a.wav");
+    remove("mixer_b.wav");
+    remove("mixer_c.wav");
+
+    return r;
+}
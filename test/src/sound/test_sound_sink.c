@@ -0,0 +1,183 @@
+#include <stdio.h>
+
+#include "../test.h"
+#include "cmdfx/core/util.h"
+#include "cmdfx/sound/sound.h"
+
+#define FRAMES 3000
+// longer than a stream's ring of chunks, so it streams through every chunk
+#define STREAM_FRAMES 10000
+#define STREAM_LOOPS 2
+
+static void writeU16(FILE* file, unsigned int value) {
+    fputc(value & 0xFF, file);
+    fputc((value >> 8) & 0xFF, file);
+}
+
+static void writeU32(FILE* file, unsigned long value) {
+    writeU16(file, value & 0xFFFF);
+    writeU16(file, (value >> 16) & 0xFFFF);
+}
+
+static short rampAt(int i) {
+    return (short) ((i * 37) % 20000 - 10000);
+}
+
+// a mono 16-bit ramp at the mixer rate, so it plays back unchanged
+static int writeRamp(const char* path, short* samples, int frames) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return -1;
+
+    fwrite("RIFF", 1, 4, file);
+    writeU32(file, 36 + frames * 2);
+    fwrite("WAVEfmt ", 1, 8, file);
+    writeU32(file, 16);
+    writeU16(file, 1);
+    writeU16(file, 1);
+    writeU32(file, 44100);
+    writeU32(file, 44100 * 2);
+    writeU16(file, 2);
+    writeU16(file, 16);
+    fwrite("data", 1, 4, file);
+    writeU32(file, frames * 2);
+
+    for (int i = 0; i < frames; i++) {
+        short sample = rampAt(i);
+        if (samples) samples[i] = sample;
+        writeU16(file, (unsigned short) sample);
+    }
+
+    fclose(file);
+    return 0;
+}
+
+// counts the frames that differ from the ramp, then from silence
+static int countMismatches(const short* out, const short* ramp, int frames) {
+    int mismatches = 0;
+    for (int i = 0; i < frames; i++) {
+        short expected = i < FRAMES ? ramp[i] : 0;
+        if (out[i * 2] != expected || out[i * 2 + 1] != expected)
+            mismatches++;
+    }
+
+    return mismatches;
+}
+
+int main() {
+    int r = 0;
+
+    short ramp[FRAMES];
+    short out[(FRAMES + 1000) * 2];
+    r |= assertEquals(writeRamp("sink_ramp.wav", ramp, FRAMES), 0);
+
+    // invalid sinks
+    r |= assertTrue(Sound_setSink(-1, NULL, 0) != 0);
+    r |= assertTrue(Sound_setSink(CMDFX_SOUND_SINK_FILE, NULL, 0) != 0);
+    r |= assertTrue(Sound_renderSink(100) != 0);
+
+    // the memory sink holds the exact mix
+    r |= assertEquals(Sound_setSink(CMDFX_SOUND_SINK_MEMORY, NULL, 0), 0);
+    r |= assertEquals(Sound_getSink(), CMDFX_SOUND_SINK_MEMORY);
+
+    int handle = Sound_load("sink_ramp.wav");
+    r |= assertGreaterThan(handle, 0);
+    r |= assertEquals(Sound_playHandle(handle), 0);
+
+    r |= assertEquals(Sound_renderSink(FRAMES + 1000), FRAMES + 1000);
+    r |= assertEquals(Sound_readSink(out, FRAMES + 1000), FRAMES + 1000);
+    r |= assertEquals(countMismatches(out, ramp, FRAMES + 1000), 0);
+    r |= assertEquals(Sound_readSink(out, 10), 0);
+    r |= assertEquals(Sound_getActiveVoices(), 0);
+
+    CmdFX_SoundStats stats;
+    r |= assertEquals(Sound_getStats(&stats), 0);
+    r |= assertGreaterThan(stats.periods, 0);
+    r |= assertEquals(stats.underruns, 0);
+
+    // two voices of the same sound sum
+    Sound_playHandle(handle);
+    Sound_playHandle(handle);
+    Sound_renderSink(100);
+    Sound_readSink(out, 100);
+    r |= assertEquals(out[80], ramp[40] * 2);
+    Sound_stopAll();
+
+    // the file sink writes a WAV file that plays back the same
+    r |= assertEquals(
+        Sound_setSink(CMDFX_SOUND_SINK_FILE, "sink_out.wav", 0), 0
+    );
+    r |= assertEquals(Sound_playHandle(handle), 0);
+    r |= assertEquals(Sound_renderSink(FRAMES), FRAMES);
+
+    r |= assertEquals(Sound_setSink(CMDFX_SOUND_SINK_MEMORY, NULL, 0), 0);
+    int copy = Sound_load("sink_out.wav");
+    r |= assertGreaterThan(copy, 0);
+    r |= assertEquals(Sound_playHandle(copy), 0);
+    r |= assertEquals(Sound_renderSink(FRAMES), FRAMES);
+    r |= assertEquals(Sound_readSink(out, FRAMES), FRAMES);
+    r |= assertEquals(countMismatches(out, ramp, FRAMES), 0);
+
+    // a streamed sound plays every loop through the chunk ring unchanged;
+    // it is rendered a little at a time, so the reader keeps ahead
+    r |= assertEquals(writeRamp("sink_stream.wav", NULL, STREAM_FRAMES), 0);
+    int streamed = Sound_loadStreamed("sink_stream.wav");
+    r |= assertGreaterThan(streamed, 0);
+    r |= assertEquals(Sound_playHandleLooped(streamed, STREAM_LOOPS), 0);
+
+    int total = STREAM_FRAMES * STREAM_LOOPS + 1000;
+    int mismatches = 0;
+    for (int done = 0; done < total;) {
+        int count = total - done < 1000 ? total - done : 1000;
+        sleepMillis(40);
+        Sound_renderSink(count);
+        r |= assertEquals(Sound_readSink(out, count), count);
+
+        for (int i = 0; i < count; i++) {
+            int frame = done + i;
+            short expected = frame < STREAM_FRAMES * STREAM_LOOPS
+                                 ? rampAt(frame % STREAM_FRAMES)
+                                 : 0;
+            if (out[i * 2] != expected || out[i * 2 + 1] != expected)
+                mismatches++;
+        }
+        done += count;
+    }
+    r |= assertEquals(mismatches, 0);
+    r |= assertFalse(Sound_isPlaying("sink_stream.wav"));
+
+    // in real time, the sink fills by itself and can't be rendered to
+    r |= assertEquals(Sound_setSink(CMDFX_SOUND_SINK_MEMORY, NULL, 1), 0);
+    r |= assertTrue(Sound_renderSink(100) != 0);
+    Sound_playHandleLooped(handle, -1);
+    sleepMillis(100);
+    r |= assertGreaterThan(Sound_readSink(out, 1000), 0);
+
+    // the sink is reopened with buffers sized from the new latency
+    r |= assertTrue(Sound_setLatency(0) != 0);
+    for (int latency = 40; latency >= 10; latency -= 30) {
+        r |= assertEquals(Sound_setLatency(latency), 0);
+        r |= assertEquals(Sound_getLatency(), latency);
+        r |= assertTrue(Sound_isPlaying("sink_ramp.wav"));
+
+        r |= assertEquals(Sound_getStats(&stats), 0);
+        int period = latency * stats.rate / 1000 / 2;
+        r |= assertEquals(stats.periodFrames, period);
+        r |= assertEquals(stats.bufferFrames, period * 2);
+        r |= assertDoubleEquals(stats.latency, period * 2000.0 / stats.rate);
+        r |= assertTrue(stats.latency > latency - 1);
+        r |= assertTrue(stats.latency <= latency);
+
+        sleepMillis(100);
+        r |= assertEquals(Sound_getStats(&stats), 0);
+        r |= assertGreaterThan(stats.periods, 0);
+    }
+    Sound_setLatency(20);
+
+    Sound_cleanup();
+    Sound_setSink(CMDFX_SOUND_SINK_DEVICE, NULL, 0);
+    remove("sink_ramp.wav");
+    remove("sink_out.wav");
+    remove("sink_stream.wav");
+
+    return r;
+}
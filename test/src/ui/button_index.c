@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../test.h"
+#include "cmdfx/ui/button.h"
+
+void onClick(void* button, CmdFX_MouseEvent* event, unsigned long long time) {
+    (void) button;
+    (void) event;
+    (void) time;
+}
+
+int main() {
+    int r = 0;
+
+    CmdFX_Button* back = Button_createFilled(10, 4, '#', 0, 0, onClick);
+    CmdFX_Button* front = Button_createFilled(3, 2, '@', 0, 5, onClick);
+    CmdFX_Button* far = Button_createFilled(2, 2, '*', 0, 0, onClick);
+
+    r |= assertEquals(Button_draw(2, 2, back), 0);
+    r |= assertEquals(Button_draw(4, 3, front), 0);
+    r |= assertEquals(Button_draw(40, 20, far), 0);
+
+    // topmost lookup
+    r |= assertPointersMatch(Canvas_getButtonAt(2, 2), back);
+    r |= assertPointersMatch(Canvas_getButtonAt(5, 4), front);
+    r |= assertPointersMatch(Canvas_getButtonAt(41, 21), far);
+    r |= assertNull(Canvas_getButtonAt(12, 2));
+    r |= assertNull(Canvas_getButtonAt(200, 200));
+
+    // all buttons at a position
+    CmdFX_Button* buffer[4] = {0};
+    r |= assertEquals(Canvas_collectButtonsAt(5, 4, buffer, 4), 2);
+    r |= assertEquals(Canvas_collectButtonsAt(5, 4, 0, 0), 2);
+    r |= assertEquals(Canvas_collectButtonsAt(5, 4, buffer, 1), 2);
+    r |= assertEquals(Canvas_collectButtonsAt(30, 30, buffer, 4), 0);
+
+    CmdFX_Button** all = Canvas_getAllButtonsAt(5, 4);
+    r |= assertNotNull(all);
+    r |= assertNotNull(all[0]);
+    r |= assertNotNull(all[1]);
+    r |= assertNull(all[2]);
+    free(all);
+
+    // moving updates the index
+    Button_moveTo(front, 20, 10);
+    r |= assertPointersMatch(Canvas_getButtonAt(5, 4), back);
+    r |= assertPointersMatch(Canvas_getButtonAt(21, 11), front);
+
+    Button_moveBy(front, 1, 1);
+    r |= assertNull(Canvas_getButtonAt(20, 10));
+    r |= assertPointersMatch(Canvas_getButtonAt(23, 12), front);
+
+    // hidden buttons receive no clicks until shown again
+    r |= assertEquals(Button_hide(far), 0);
+    r |= assertTrue(Button_isHidden(far));
+    r |= assertNull(Canvas_getButtonAt(41, 21));
+    r |= assertEquals(Canvas_collectButtonsAt(41, 21, buffer, 4), 0);
+
+    r |= assertEquals(Button_show(far), 0);
+    r |= assertFalse(Button_isHidden(far));
+    r |= assertPointersMatch(Canvas_getButtonAt(41, 21), far);
+
+    // moving a hidden button does not put it back in the index
+    Button_hide(far);
+    r |= assertEquals(Button_moveTo(far, 50, 20), 0);
+    r |= assertNull(Canvas_getButtonAt(51, 21));
+    r |= assertEquals(Button_moveBy(far, -10, 0), 0);
+    r |= assertNull(Canvas_getButtonAt(41, 21));
+
+    r |= assertEquals(Button_show(far), 0);
+    r |= assertPointersMatch(Canvas_getButtonAt(41, 21), far);
+
+    // new data reindexes the button at its new size
+    char** wide = malloc(sizeof(char*) * 2);
+    wide[0] = malloc(7);
+    for (int i = 0; i < 6; i++) wide[0][i] = '-';
+    wide[0][6] = '\0';
+    wide[1] = 0;
+
+    r |= assertEquals(Button_setData(far, wide, 0), 0);
+    r |= assertEquals(far->sprite->width, 6);
+    r |= assertEquals(far->sprite->height, 1);
+    r |= assertPointersMatch(Canvas_getButtonAt(45, 20), far);
+    r |= assertNull(Canvas_getButtonAt(40, 21));
+
+    // removing drops it from the index
+    Button_remove(back);
+    r |= assertNull(Canvas_getButtonAt(2, 2));
+    r |= assertEquals(Canvas_collectButtonsAt(5, 4, buffer, 4), 0);
+
+    Button_free(front);
+    r |= assertNull(Canvas_getButtonAt(23, 12));
+
+    Button_free(back);
+    Button_free(far);
+
+    return r;
+}